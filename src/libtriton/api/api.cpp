@@ -6,6 +6,7 @@
 */
 
 #include <triton/api.hpp>
+#include <triton/cpuSize.hpp>
 #include <triton/exceptions.hpp>
 
 #include <list>
@@ -335,6 +336,9 @@ namespace triton {
 
   triton::uint512 API::getConcreteRegisterValue(const triton::arch::Register& reg, bool execCallbacks) const {
     this->checkArchitecture();
+    /* The concrete value of a pending flag is known once its expression is built */
+    if (this->symbolic && (this->arch.isFlag(reg) || reg.getId() == triton::arch::ID_REG_EFLAGS))
+      this->symbolic->buildLazyFlags();
     return this->arch.getConcreteRegisterValue(reg, execCallbacks);
   }
 
@@ -342,29 +346,36 @@ namespace triton {
   void API::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value) {
     this->checkArchitecture();
     this->arch.setConcreteMemoryValue(addr, value);
+    this->disassCache->invalidate(addr, BYTE_SIZE);
   }
 
 
   void API::setConcreteMemoryValue(const triton::arch::MemoryAccess& mem, const triton::uint512& value) {
     this->checkArchitecture();
     this->arch.setConcreteMemoryValue(mem, value);
+    this->disassCache->invalidate(mem.getAddress(), mem.getSize());
   }
 
 
   void API::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const std::vector<triton::uint8>& values) {
     this->checkArchitecture();
     this->arch.setConcreteMemoryAreaValue(baseAddr, values);
+    this->disassCache->invalidate(baseAddr, values.size());
   }
 
 
   void API::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
     this->checkArchitecture();
     this->arch.setConcreteMemoryAreaValue(baseAddr, area, size);
+    this->disassCache->invalidate(baseAddr, size);
   }
 
 
   void API::setConcreteRegisterValue(const triton::arch::Register& reg, const triton::uint512& value) {
     this->checkArchitecture();
+    /* A pending flag would overwrite the new value once built */
+    if (this->symbolic && (this->arch.isFlag(reg) || reg.getId() == triton::arch::ID_REG_EFLAGS))
+      this->symbolic->buildLazyFlags();
     this->arch.setConcreteRegisterValue(reg, value);
   }
 
@@ -383,7 +394,23 @@ namespace triton {
 
   void API::disassembly(triton::arch::Instruction& inst) const {
     this->checkArchitecture();
-    this->arch.disassembly(inst);
+
+    if (!this->modes.isModeEnabled(triton::modes::DISASSEMBLY_CACHE)) {
+      this->arch.disassembly(inst);
+      return;
+    }
+
+    /* Only call the disassembler if the instruction is not already in the cache */
+    if (!this->disassCache->lookup(inst)) {
+      this->arch.disassembly(inst);
+      this->disassCache->record(inst);
+    }
+  }
+
+
+  std::map<std::string, triton::usize> API::getDisassemblyCacheStats(void) const {
+    this->checkArchitecture();
+    return this->disassCache->getStats();
   }
 
 
@@ -412,6 +439,10 @@ namespace triton {
     this->z3Interface = new(std::nothrow) triton::ast::Z3Interface(this->symbolic);
     if (this->z3Interface == nullptr)
       throw triton::exceptions::API("API::initEngines(): No enough memory.");
+
+    this->disassCache = new(std::nothrow) triton::arch::DisassemblyCache();
+    if (this->disassCache == nullptr)
+      throw triton::exceptions::API("API::initEngines(): No enough memory.");
   }
 
 
@@ -422,12 +453,14 @@ namespace triton {
       delete this->symbolic;
       delete this->taint;
       delete this->z3Interface;
+      delete this->disassCache;
 
       this->irBuilder           = nullptr;
       this->solver              = nullptr;
       this->symbolic            = nullptr;
       this->taint               = nullptr;
       this->z3Interface         = nullptr;
+      this->disassCache         = nullptr;
     }
 
     // Use default modes.
@@ -450,11 +483,38 @@ namespace triton {
 
   bool API::processing(triton::arch::Instruction& inst) {
     this->checkArchitecture();
-    this->arch.disassembly(inst);
+    this->disassembly(inst);
     return this->irBuilder->buildSemantics(inst);
   }
 
 
+  triton::usize API::processBlock(std::vector<triton::arch::TraceRecord>& block, const std::function<void(triton::arch::TraceRecord&)>& callback) {
+    triton::usize count = 0;
+
+    this->checkArchitecture();
+
+    for (auto& record : block) {
+      /* Apply the deltas of the context recorded before the instruction */
+      for (const auto& reg : record.registers)
+        this->setConcreteRegisterValue(reg.first, reg.second);
+
+      for (const auto& area : record.memory)
+        this->setConcreteMemoryAreaValue(area.first, area.second);
+
+      if (this->processing(record.instruction))
+        count++;
+
+      if (record.callback && callback)
+        callback(record);
+
+      /* A block does not pin the nodes of the whole trace */
+      record.instruction.clear();
+    }
+
+    return count;
+  }
+
+
 
   /* IR builder API ================================================================================= */
 
@@ -479,6 +539,12 @@ namespace triton {
   /* AST garbage collector API ====================================================================== */
 
   void API::freeAllAstNodes(void) {
+    /* The translation cache of the solver session retains nodes */
+    if (this->solver)
+      this->solver->resetSolver();
+    /* So does the cache of the unrolled ASTs */
+    if (this->symbolic)
+      this->symbolic->clearUnrolledAsts();
     this->astCtxt.getAstGarbageCollector().freeAllAstNodes();
   }
 
@@ -503,11 +569,16 @@ namespace triton {
   }
 
 
-  const std::set<triton::ast::AbstractNode*>& API::getAllocatedAstNodes(void) const {
+  std::set<triton::ast::AbstractNode*> API::getAllocatedAstNodes(void) const {
     return this->astCtxt.getAstGarbageCollector().getAllocatedAstNodes();
   }
 
 
+  std::map<std::string, triton::usize> API::getAstArenaStats(void) const {
+    return this->astCtxt.getAstGarbageCollector().getAstArenaStats();
+  }
+
+
   std::map<std::string, triton::usize> API::getAstDictionariesStats(void) const {
     return this->astCtxt.getAstGarbageCollector().getAstDictionariesStats();
   }
@@ -765,6 +836,7 @@ namespace triton {
 
   std::map<triton::arch::registers_e, triton::engines::symbolic::SymbolicExpression*> API::getSymbolicRegisters(void) const {
     this->checkSymbolic();
+    this->symbolic->buildLazyFlags();
     return this->symbolic->getSymbolicRegisters();
   }
 
@@ -777,6 +849,7 @@ namespace triton {
 
   triton::usize API::getSymbolicRegisterId(const triton::arch::Register& reg) const {
     this->checkSymbolic();
+    this->symbolic->buildLazyFlag(reg);
     return this->symbolic->getSymbolicRegisterId(reg);
   }
 
@@ -801,6 +874,7 @@ namespace triton {
 
   triton::uint512 API::getSymbolicRegisterValue(const triton::arch::Register& reg) {
     this->checkSymbolic();
+    this->symbolic->buildLazyFlag(reg);
     return this->symbolic->getSymbolicRegisterValue(reg);
   }
 
@@ -868,6 +942,12 @@ namespace triton {
   }
 
 
+  void API::clearUnrolledAsts(void) {
+    this->checkSymbolic();
+    this->symbolic->clearUnrolledAsts();
+  }
+
+
   void API::enableSymbolicEngine(bool flag) {
     this->checkSymbolic();
     this->symbolic->enable(flag);
@@ -900,6 +980,7 @@ namespace triton {
 
   bool API::isRegisterSymbolized(const triton::arch::Register& reg) const {
     this->checkSymbolic();
+    this->symbolic->buildLazyFlag(reg);
     return this->symbolic->isRegisterSymbolized(reg);
   }
 
@@ -966,13 +1047,13 @@ namespace triton {
   }
 
 
-  const std::map<triton::usize, triton::engines::symbolic::SymbolicExpression*>& API::getSymbolicExpressions(void) const {
+  const triton::engines::symbolic::SymbolicTable<triton::engines::symbolic::SymbolicExpression>& API::getSymbolicExpressions(void) const {
     this->checkSymbolic();
     return this->symbolic->getSymbolicExpressions();
   }
 
 
-  const std::map<triton::usize, triton::engines::symbolic::SymbolicVariable*>& API::getSymbolicVariables(void) const {
+  const triton::engines::symbolic::SymbolicTable<triton::engines::symbolic::SymbolicVariable>& API::getSymbolicVariables(void) const {
     this->checkSymbolic();
     return this->symbolic->getSymbolicVariables();
   }
@@ -999,6 +1080,84 @@ namespace triton {
   }
 
 
+  void API::addSolverConstraint(triton::ast::AbstractNode* node) {
+    this->checkSolver();
+    this->solver->addSolverConstraint(node);
+  }
+
+
+  void API::pushSolver(void) {
+    this->checkSolver();
+    this->solver->pushSolver();
+  }
+
+
+  void API::popSolver(triton::uint32 count) {
+    this->checkSolver();
+    this->solver->popSolver(count);
+  }
+
+
+  triton::uint32 API::getSolverScopes(void) const {
+    this->checkSolver();
+    return this->solver->getSolverScopes();
+  }
+
+
+  bool API::isSolverSat(void) {
+    this->checkSolver();
+    return this->solver->isSolverSat();
+  }
+
+
+  std::map<triton::uint32, triton::engines::solver::SolverModel> API::getSolverModel(void) {
+    this->checkSolver();
+    return this->solver->getSolverModel();
+  }
+
+
+  void API::resetSolver(void) {
+    this->checkSolver();
+    this->solver->resetSolver();
+  }
+
+
+  void API::setSolverCacheSize(triton::usize size) {
+    this->checkSolver();
+    this->solver->setSolverCacheSize(size);
+  }
+
+
+  triton::usize API::getSolverCacheSize(void) const {
+    this->checkSolver();
+    return this->solver->getSolverCacheSize();
+  }
+
+
+  void API::setSolverCacheFile(const std::string& path) {
+    this->checkSolver();
+    this->solver->setSolverCacheFile(path);
+  }
+
+
+  const std::string& API::getSolverCacheFile(void) const {
+    this->checkSolver();
+    return this->solver->getSolverCacheFile();
+  }
+
+
+  void API::clearSolverCache(void) {
+    this->checkSolver();
+    this->solver->clearSolverCache();
+  }
+
+
+  std::map<std::string, triton::usize> API::getSolverCacheStats(void) const {
+    this->checkSolver();
+    return this->solver->getSolverCacheStats();
+  }
+
+
 
   /* Z3 interface API ============================================================================== */
 
@@ -1035,7 +1194,7 @@ namespace triton {
   }
 
 
-  const std::set<triton::uint64>& API::getTaintedMemory(void) const {
+  std::set<triton::uint64> API::getTaintedMemory(void) const {
     this->checkTaint();
     return this->taint->getTaintedMemory();
   }
@@ -1121,6 +1280,30 @@ namespace triton {
   }
 
 
+  bool API::taintMemoryWithLabel(const triton::arch::MemoryAccess& mem, triton::uint32 label) {
+    this->checkTaint();
+    return this->taint->taintMemoryWithLabel(mem, label);
+  }
+
+
+  bool API::taintRegisterWithLabel(const triton::arch::Register& reg, triton::uint32 label) {
+    this->checkTaint();
+    return this->taint->taintRegisterWithLabel(reg, label);
+  }
+
+
+  std::set<triton::uint32> API::getMemoryTaintLabels(const triton::arch::MemoryAccess& mem) const {
+    this->checkTaint();
+    return this->taint->getMemoryTaintLabels(mem);
+  }
+
+
+  std::set<triton::uint32> API::getRegisterTaintLabels(const triton::arch::Register& reg) const {
+    this->checkTaint();
+    return this->taint->getRegisterTaintLabels(reg);
+  }
+
+
   bool API::untaintMemory(triton::uint64 addr) {
     this->checkTaint();
     return this->taint->untaintMemory(addr);
@@ -0,0 +1,160 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <cstring>
+
+#include <triton/disassemblyCache.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    DisassemblyCache::DisassemblyCache(triton::usize capacity) {
+      this->capacity = capacity;
+      this->clear();
+    }
+
+
+    DisassemblyCache::DisassemblyCache(const DisassemblyCache& other) {
+      this->copy(other);
+    }
+
+
+    DisassemblyCache& DisassemblyCache::operator=(const DisassemblyCache& other) {
+      this->copy(other);
+      return *this;
+    }
+
+
+    void DisassemblyCache::copy(const DisassemblyCache& other) {
+      this->entries.clear();
+      this->lru.clear();
+
+      /* The LRU iterators of other are not valid for this instance, so rebuild them */
+      for (auto it = other.lru.rbegin(); it != other.lru.rend(); it++) {
+        this->lru.push_front(*it);
+        this->entries.insert(std::make_pair(*it, std::make_pair(other.entries.at(*it).first, this->lru.begin())));
+      }
+
+      this->capacity      = other.capacity;
+      this->hits          = other.hits;
+      this->misses        = other.misses;
+      this->evictions     = other.evictions;
+      this->invalidations = other.invalidations;
+    }
+
+
+    bool DisassemblyCache::lookup(triton::arch::Instruction& inst) {
+      auto it = this->entries.find(inst.getAddress());
+
+      if (it != this->entries.end()) {
+        const triton::arch::Instruction& cached = it->second.first;
+
+        /* The opcode bytes must still be the same, otherwise the code has been modified */
+        if (inst.getOpcode() != nullptr && inst.getSize() >= cached.getSize() &&
+            std::memcmp(inst.getOpcode(), cached.getOpcode(), cached.getSize()) == 0) {
+          inst.setSize(cached.getSize());
+          inst.setType(cached.getType());
+          inst.setPrefix(cached.getPrefix());
+          inst.setDisassembly(cached.getDisassembly());
+          inst.setBranch(cached.isBranch());
+          inst.setControlFlow(cached.isControlFlow());
+          inst.operands = cached.operands;
+
+          /* Move the entry at the front of the LRU list */
+          this->lru.splice(this->lru.begin(), this->lru, it->second.second);
+          this->hits++;
+          return true;
+        }
+      }
+
+      this->misses++;
+      return false;
+    }
+
+
+    void DisassemblyCache::record(const triton::arch::Instruction& inst) {
+      if (this->capacity == 0)
+        return;
+
+      /* Only keep what the disassembler has produced */
+      triton::arch::Instruction cached(inst.getOpcode(), inst.getSize());
+      cached.setAddress(inst.getAddress());
+      cached.setType(inst.getType());
+      cached.setPrefix(inst.getPrefix());
+      cached.setDisassembly(inst.getDisassembly());
+      cached.setBranch(inst.isBranch());
+      cached.setControlFlow(inst.isControlFlow());
+      cached.operands = inst.operands;
+
+      /* An entry at the same address is replaced */
+      auto it = this->entries.find(inst.getAddress());
+      if (it != this->entries.end()) {
+        this->lru.splice(this->lru.begin(), this->lru, it->second.second);
+        it->second.first = cached;
+        return;
+      }
+
+      /* Evict the least recently used entry */
+      if (this->entries.size() >= this->capacity) {
+        this->entries.erase(this->lru.back());
+        this->lru.pop_back();
+        this->evictions++;
+      }
+
+      this->lru.push_front(inst.getAddress());
+      this->entries.insert(std::make_pair(inst.getAddress(), std::make_pair(cached, this->lru.begin())));
+    }
+
+
+    void DisassemblyCache::invalidate(triton::uint64 baseAddr, triton::usize size) {
+      if (size == 0 || this->entries.empty())
+        return;
+
+      /* An instruction starting up to MAX_INSTRUCTION_SIZE bytes before baseAddr may overlap the area */
+      triton::uint64 lower = (baseAddr > MAX_INSTRUCTION_SIZE) ? (baseAddr - MAX_INSTRUCTION_SIZE) : 0;
+      triton::uint64 upper = baseAddr + size;
+
+      auto it = this->entries.lower_bound(lower);
+      while (it != this->entries.end() && (upper <= baseAddr || it->first < upper)) {
+        if (it->first + it->second.first.getSize() > baseAddr) {
+          this->lru.erase(it->second.second);
+          it = this->entries.erase(it);
+          this->invalidations++;
+        }
+        else
+          it++;
+      }
+    }
+
+
+    void DisassemblyCache::clear(void) {
+      this->entries.clear();
+      this->lru.clear();
+      this->hits          = 0;
+      this->misses        = 0;
+      this->evictions     = 0;
+      this->invalidations = 0;
+    }
+
+
+    std::map<std::string, triton::usize> DisassemblyCache::getStats(void) const {
+      std::map<std::string, triton::usize> stats;
+
+      stats["capacity"]      = this->capacity;
+      stats["entries"]       = this->entries.size();
+      stats["evictions"]     = this->evictions;
+      stats["hits"]          = this->hits;
+      stats["invalidations"] = this->invalidations;
+      stats["misses"]        = this->misses;
+
+      return stats;
+    }
+
+  }; /* arch namespace */
+}; /* triton namespace */
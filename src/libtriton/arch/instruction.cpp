@@ -5,8 +5,10 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <cstring>
 
+#include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/immediate.hpp>
 #include <triton/instruction.hpp>
@@ -47,6 +49,11 @@ namespace triton {
     }
 
 
+    Instruction::~Instruction() {
+      this->releaseNodes();
+    }
+
+
     void Instruction::copy(const Instruction& other) {
       this->address             = other.address;
       this->branch              = other.branch;
@@ -67,6 +74,17 @@ namespace triton {
 
       this->disassembly.clear();
       this->disassembly.str(other.disassembly.str());
+
+      /* The copy shares the nodes of the original, it takes its own references */
+      if (this != &other) {
+        this->releaseNodes();
+        if (!other.nodesLifetime.expired()) {
+          for (auto* node : other.nodes)
+            node->retain();
+          this->nodes         = other.nodes;
+          this->nodesLifetime = other.nodesLifetime;
+        }
+      }
     }
 
 
@@ -445,6 +463,79 @@ namespace triton {
       this->writtenRegisters.clear();
 
       std::memset(this->opcode, 0x00, sizeof(this->opcode));
+
+      this->releaseNodes();
+    }
+
+
+    void Instruction::retainNodes(void) {
+      std::vector<triton::ast::AbstractNode*> nodes;
+
+      for (const auto& operand : this->operands) {
+        if (operand.getType() == triton::arch::OP_MEM && operand.getConstMemory().getLeaAst())
+          nodes.push_back(operand.getConstMemory().getLeaAst());
+      }
+
+      for (const auto& item : this->loadAccess)
+        nodes.push_back(item.second);
+
+      for (const auto& item : this->readRegisters)
+        nodes.push_back(item.second);
+
+      for (const auto& item : this->readImmediates)
+        nodes.push_back(item.second);
+
+      for (const auto& item : this->storeAccess)
+        nodes.push_back(item.second);
+
+      for (const auto& item : this->writtenRegisters)
+        nodes.push_back(item.second);
+
+      nodes.erase(std::remove(nodes.begin(), nodes.end(), nullptr), nodes.end());
+
+      /* Retain the new references before giving back the old ones, the nodes may be the same */
+      for (auto* node : nodes)
+        node->retain();
+
+      this->releaseNodes();
+
+      if (!nodes.empty()) {
+        this->nodes         = nodes;
+        this->nodesLifetime = nodes.front()->getContext().getAstArena().getLifetime();
+      }
+    }
+
+
+    void Instruction::clear(void) {
+      for (auto& operand : this->operands) {
+        if (operand.getType() == triton::arch::OP_MEM)
+          operand.getMemory().setLeaAst(nullptr);
+      }
+
+      this->loadAccess.clear();
+      this->readImmediates.clear();
+      this->readRegisters.clear();
+      this->storeAccess.clear();
+      this->symbolicExpressions.clear();
+      this->writtenRegisters.clear();
+
+      this->releaseNodes();
+    }
+
+
+    void Instruction::releaseNodes(void) {
+      std::vector<triton::ast::AbstractNode*> nodes;
+
+      nodes.swap(this->nodes);
+
+      /* The nodes are already gone with their arena (e.g. the context has been destroyed) */
+      if (this->nodesLifetime.expired())
+        return;
+
+      for (auto* node : nodes)
+        node->release();
+
+      this->nodesLifetime.reset();
     }
 
 
@@ -6,6 +6,7 @@
 */
 
 #include <new>
+#include <vector>
 
 #include <triton/exceptions.hpp>
 #include <triton/irBuilder.hpp>
@@ -13,6 +14,7 @@
 #include <triton/operandWrapper.hpp>
 #include <triton/register.hpp>
 #include <triton/x86Semantics.hpp>
+#include <triton/x86TaintSummaries.hpp>
 #include <triton/astContext.hpp>
 
 
@@ -27,7 +29,7 @@ namespace triton {
                          triton::engines::taint::TaintEngine* taintEngine)
       : modes(modes),
         astGarbageCollector(astCtxt.getAstGarbageCollector()),
-        backupAstGarbageCollector(modes, true) {
+        backupAstGarbageCollector(modes, astCtxt.getAstArena(), true) {
 
       if (architecture == nullptr)
         throw triton::exceptions::IrBuilder("IrBuilder::IrBuilder(): The architecture API must be defined.");
@@ -39,18 +41,17 @@ namespace triton {
         throw triton::exceptions::IrBuilder("IrBuilder::IrBuilder(): The taint engines API must be defined.");
 
       this->architecture              = architecture;
-      this->backupSymbolicEngine      = new(std::nothrow) triton::engines::symbolic::SymbolicEngine(architecture, modes, astCtxt, nullptr, true);
+      this->numberOfPathConstraints   = 0;
       this->symbolicEngine            = symbolicEngine;
       this->taintEngine               = taintEngine;
       this->x86Isa                    = new(std::nothrow) triton::arch::x86::x86Semantics(architecture, symbolicEngine, taintEngine, astCtxt);
 
-      if (this->x86Isa == nullptr || this->backupSymbolicEngine == nullptr)
+      if (this->x86Isa == nullptr)
         throw triton::exceptions::IrBuilder("IrBuilder::IrBuilder(): Not enough memory.");
     }
 
 
     IrBuilder::~IrBuilder() {
-      delete this->backupSymbolicEngine;
       delete this->x86Isa;
     }
 
@@ -61,6 +62,12 @@ namespace triton {
       if (this->architecture->getArchitecture() == triton::arch::ARCH_INVALID)
         throw triton::exceptions::IrBuilder("IrBuilder::buildSemantics(): You must define an architecture.");
 
+      /* Taint-only path from the opcode summaries, the semantics are not built */
+      if (!this->symbolicEngine->isEnabled() && this->modes.isModeEnabled(triton::modes::TAINT_SUMMARIES)) {
+        if (this->buildTaint(inst))
+          return true;
+      }
+
       /* Initialize the target address of memory operands */
       for (auto& operand : inst.operands) {
         if (operand.getType() == triton::arch::OP_MEM) {
@@ -72,25 +79,68 @@ namespace triton {
       this->preIrInit(inst);
 
       /* Processing */
+      try {
+        switch (this->architecture->getArchitecture()) {
+          case triton::arch::ARCH_X86:
+          case triton::arch::ARCH_X86_64:
+            ret = this->x86Isa->buildSemantics(inst);
+            break;
+
+          default:
+            throw triton::exceptions::IrBuilder("IrBuilder::buildSemantics(): Architecture not supported.");
+            break;
+        }
+      }
+      catch (...) {
+        /* The concrete path and the collect of the labels must not leak into the next instructions */
+        this->symbolicEngine->enableConcretePath(false);
+        this->taintEngine->collectLabels(false);
+        throw;
+      }
+
+      /* Post IR processing */
+      this->postIrInit(inst);
+
+      return ret;
+    }
+
+
+    bool IrBuilder::buildTaint(triton::arch::Instruction& inst) {
+      const triton::engines::taint::TaintSummary* summary = nullptr;
+
       switch (this->architecture->getArchitecture()) {
         case triton::arch::ARCH_X86:
         case triton::arch::ARCH_X86_64:
-          ret = this->x86Isa->buildSemantics(inst);
+          summary = &triton::arch::x86::getTaintSummary(inst.getType());
           break;
 
         default:
-          throw triton::exceptions::IrBuilder("IrBuilder::buildSemantics(): Architecture not supported.");
+          throw triton::exceptions::IrBuilder("IrBuilder::buildTaint(): Architecture not supported.");
           break;
       }
 
-      /* Post IR processing */
-      this->postIrInit(inst);
+      /* The opcode must be processed by the semantics */
+      if (!summary->isValid(inst.operands.size()))
+        return false;
 
-      return ret;
+      this->initInstruction(inst);
+      this->taintEngine->collectLabels(true);
+
+      try {
+        inst.setTaint(this->taintEngine->spreadTaint(*summary, inst));
+      }
+      catch (...) {
+        this->taintEngine->collectLabels(false);
+        throw;
+      }
+
+      this->taintEngine->collectLabels(false);
+
+      return true;
     }
 
 
-    void IrBuilder::preIrInit(triton::arch::Instruction& inst) {
+    void IrBuilder::initInstruction(triton::arch::Instruction& inst) {
       /* Clear previous expressions if exist */
       inst.symbolicExpressions.clear();
 
@@ -104,17 +154,36 @@ namespace triton {
       /* Update instruction address if undefined */
       if (!inst.getAddress())
         inst.setAddress(this->architecture->getConcreteRegisterValue(this->architecture->getParentRegister(ID_REG_IP)).convert_to<triton::uint64>());
+    }
+
+
+    void IrBuilder::preIrInit(triton::arch::Instruction& inst) {
+      this->initInstruction(inst);
+
+      /* The written operands which are tainted by a flag take the labels read by the instruction */
+      this->taintEngine->collectLabels(true);
 
-      /* Backup the symbolic engine in the case where only the taint is available. */
+      /*
+       * Taint-only path. The expressions only update the concrete state, the symbolic state
+       * is left as is. The nodes allocated by the instruction are deleted afterwards.
+       */
       if (!this->symbolicEngine->isEnabled()) {
-        *this->backupSymbolicEngine = *this->symbolicEngine;
+        this->numberOfPathConstraints = this->symbolicEngine->getNumberOfPathConstraints();
         this->backupAstGarbageCollector = this->astGarbageCollector;
+        this->symbolicEngine->enableConcretePath(true);
       }
+
+      /*
+       * Concrete path. As the expressions which are not symbolized are removed once the
+       * instruction is processed, they only update the concrete state while they are created.
+       */
+      else if (this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED))
+        this->symbolicEngine->enableConcretePath(true);
     }
 
 
     void IrBuilder::postIrInit(triton::arch::Instruction& inst) {
-      std::set<triton::ast::AbstractNode*> uniqueNodes;
+      std::vector<triton::ast::AbstractNode*> nodes;
       std::vector<triton::engines::symbolic::SymbolicExpression*> newVector;
 
       auto& loadAccess        = inst.getLoadAccess();
@@ -125,6 +194,9 @@ namespace triton {
 
       /* Set the taint */
       inst.setTaint();
+      this->taintEngine->collectLabels(false);
+
+      this->symbolicEngine->enableConcretePath(false);
 
       // ----------------------------------------------------------------------
 
@@ -135,7 +207,7 @@ namespace triton {
        */
       if (!this->symbolicEngine->isEnabled()) {
         /* Clear memory operands */
-        this->collectNodes(uniqueNodes, inst.operands, false);
+        this->collectNodes(nodes, inst.operands, false);
 
         /* Clear implicit and explicit semantics */
         loadAccess.clear();
@@ -144,11 +216,13 @@ namespace triton {
         storeAccess.clear();
         writtenRegisters.clear();
 
-        /* Symbolic Expressions */
-        this->removeSymbolicExpressions(inst, uniqueNodes);
+        /* Symbolic Expressions, they have not been recorded */
+        inst.symbolicExpressions.clear();
+        this->symbolicEngine->clearConcreteExpressions();
 
-        /* Restore backup */
-        *this->symbolicEngine = *this->backupSymbolicEngine;
+        /* Path constraints */
+        while (this->symbolicEngine->getNumberOfPathConstraints() > this->numberOfPathConstraints)
+          this->symbolicEngine->popPathConstraint();
       }
 
       // ----------------------------------------------------------------------
@@ -160,33 +234,34 @@ namespace triton {
        */
       if (this->symbolicEngine->isEnabled() && this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED)) {
         /* Clear memory operands */
-        this->collectUnsymbolizedNodes(uniqueNodes, inst.operands);
+        this->collectUnsymbolizedNodes(nodes, inst.operands);
 
         /* Clear implicit and explicit semantics - MEM */
-        this->collectUnsymbolizedNodes(loadAccess);
+        this->collectUnsymbolizedNodes(nodes, loadAccess);
 
         /* Clear implicit and explicit semantics - REG */
-        this->collectUnsymbolizedNodes(readRegisters);
+        this->collectUnsymbolizedNodes(nodes, readRegisters);
 
         /* Clear implicit and explicit semantics - IMM */
-        this->collectUnsymbolizedNodes(readImmediates);
+        this->collectUnsymbolizedNodes(nodes, readImmediates);
 
         /* Clear implicit and explicit semantics - MEM */
-        this->collectUnsymbolizedNodes(storeAccess);
+        this->collectUnsymbolizedNodes(nodes, storeAccess);
 
         /* Clear implicit and explicit semantics - REG */
-        this->collectUnsymbolizedNodes(writtenRegisters);
+        this->collectUnsymbolizedNodes(nodes, writtenRegisters);
 
         /* Clear symbolic expressions */
         for (auto* se : inst.symbolicExpressions) {
-          if (se->isSymbolized() == false) {
-            this->astGarbageCollector.extractUniqueAstNodes(uniqueNodes, se->getAst());
+          if (se->isSymbolized() == false)
             this->symbolicEngine->removeSymbolicExpression(se->getId());
-          }
           else
             newVector.push_back(se);
         }
         inst.symbolicExpressions = newVector;
+
+        /* Delete the expressions of the concrete path, their nodes which are exposed by the instruction have been collected */
+        this->symbolicEngine->clearConcreteExpressions();
       }
 
       // ----------------------------------------------------------------------
@@ -198,59 +273,73 @@ namespace triton {
        */
       else if (this->modes.isModeEnabled(triton::modes::ONLY_ON_TAINTED) && !inst.isTainted()) {
         /* Memory operands */
-        this->collectNodes(uniqueNodes, inst.operands, true);
+        this->collectNodes(nodes, inst.operands, true);
 
         /* Implicit and explicit semantics - MEM */
-        this->collectNodes(uniqueNodes, loadAccess);
+        this->collectNodes(nodes, loadAccess);
 
         /* Implicit and explicit semantics - REG */
-        this->collectNodes(uniqueNodes, readRegisters);
+        this->collectNodes(nodes, readRegisters);
 
         /* Implicit and explicit semantics - IMM */
-        this->collectNodes(uniqueNodes, readImmediates);
+        this->collectNodes(nodes, readImmediates);
 
         /* Implicit and explicit semantics - MEM */
-        this->collectNodes(uniqueNodes, storeAccess);
+        this->collectNodes(nodes, storeAccess);
 
         /* Implicit and explicit semantics - REG */
-        this->collectNodes(uniqueNodes, writtenRegisters);
+        this->collectNodes(nodes, writtenRegisters);
 
         /* Symbolic Expressions */
-        this->removeSymbolicExpressions(inst, uniqueNodes);
+        this->removeSymbolicExpressions(inst);
       }
 
       // ----------------------------------------------------------------------
 
-      /* Free collected nodes */
-      this->astGarbageCollector.freeAstNodes(uniqueNodes);
+      /*
+       * Free collected nodes. They have been retained while the expressions
+       * were removed, releasing them frees those which are not referenced
+       * anymore (and their children which are only referenced by them).
+       */
+      for (auto* node : nodes)
+        node->release();
+
+      /* The nodes exposed by the instruction must outlive their expressions */
+      if (this->symbolicEngine->isEnabled())
+        inst.retainNodes();
 
-      if (!this->symbolicEngine->isEnabled())
+      /* Delete the nodes allocated by the instruction */
+      else
         this->astGarbageCollector = this->backupAstGarbageCollector;
     }
 
 
-    void IrBuilder::removeSymbolicExpressions(triton::arch::Instruction& inst, std::set<triton::ast::AbstractNode*>& uniqueNodes) {
-      for (const auto* se : inst.symbolicExpressions) {
-        this->astGarbageCollector.extractUniqueAstNodes(uniqueNodes, se->getAst());
+    void IrBuilder::removeSymbolicExpressions(triton::arch::Instruction& inst) {
+      for (const auto* se : inst.symbolicExpressions)
         this->symbolicEngine->removeSymbolicExpression(se->getId());
-      }
       inst.symbolicExpressions.clear();
     }
 
 
     template <typename T>
-    void IrBuilder::collectNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, T& items) const {
-      for (const auto& item : items)
-        this->astGarbageCollector.extractUniqueAstNodes(uniqueNodes, std::get<1>(item));
+    void IrBuilder::collectNodes(std::vector<triton::ast::AbstractNode*>& nodes, T& items) const {
+      for (const auto& item : items) {
+        if (std::get<1>(item)) {
+          std::get<1>(item)->retain();
+          nodes.push_back(std::get<1>(item));
+        }
+      }
       items.clear();
     }
 
 
-    void IrBuilder::collectNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, std::vector<triton::arch::OperandWrapper>& operands, bool gc) const {
+    void IrBuilder::collectNodes(std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::arch::OperandWrapper>& operands, bool gc) const {
       for (auto& operand : operands) {
         if (operand.getType() == triton::arch::OP_MEM) {
-          if (gc)
-            this->astGarbageCollector.extractUniqueAstNodes(uniqueNodes, operand.getMemory().getLeaAst());
+          if (gc && operand.getMemory().getLeaAst()) {
+            operand.getMemory().getLeaAst()->retain();
+            nodes.push_back(operand.getMemory().getLeaAst());
+          }
           operand.getMemory().setLeaAst(nullptr);
         }
       }
@@ -258,12 +347,16 @@ namespace triton {
 
 
     template <typename T>
-    void IrBuilder::collectUnsymbolizedNodes(T& items) const {
+    void IrBuilder::collectUnsymbolizedNodes(std::vector<triton::ast::AbstractNode*>& nodes, T& items) const {
       T newItems;
 
       for (const auto& item : items) {
         if (std::get<1>(item) && std::get<1>(item)->isSymbolized() == true)
           newItems.insert(item);
+        else if (std::get<1>(item)) {
+          std::get<1>(item)->retain();
+          nodes.push_back(std::get<1>(item));
+        }
       }
 
       items.clear();
@@ -271,11 +364,12 @@ namespace triton {
     }
 
 
-    void IrBuilder::collectUnsymbolizedNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, std::vector<triton::arch::OperandWrapper>& operands) const {
+    void IrBuilder::collectUnsymbolizedNodes(std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::arch::OperandWrapper>& operands) const {
       for (auto& operand : operands) {
         if (operand.getType() == triton::arch::OP_MEM) {
           if (operand.getMemory().getLeaAst() && operand.getMemory().getLeaAst()->isSymbolized() == false) {
-            this->astGarbageCollector.extractUniqueAstNodes(uniqueNodes, operand.getMemory().getLeaAst());
+            operand.getMemory().getLeaAst()->retain();
+            nodes.push_back(operand.getMemory().getLeaAst());
             operand.getMemory().setLeaAst(nullptr);
           }
         }
@@ -0,0 +1,253 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <new>
+
+#include <triton/exceptions.hpp>
+#include <triton/pagedMemory.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    /* Returns the mask of `size` bits starting at `bit` in a 64-bit word */
+    static inline triton::uint64 bitmapMask(triton::usize bit, triton::usize size) {
+      if (size >= 64)
+        return ~static_cast<triton::uint64>(0);
+      return ((static_cast<triton::uint64>(1) << size) - 1) << bit;
+    }
+
+
+    PagedMemory::Page::Page() {
+      std::memset(this->data, 0x00, sizeof(this->data));
+      std::memset(this->mapped, 0x00, sizeof(this->mapped));
+      this->count = 0;
+    }
+
+
+    void PagedMemory::Page::map(triton::usize offset, triton::usize size) {
+      triton::usize end = offset + size;
+
+      while (offset < end) {
+        triton::usize bit  = offset % 64;
+        triton::usize n    = std::min(64 - bit, end - offset);
+        triton::uint64 mask = bitmapMask(bit, n);
+        triton::uint64& word = this->mapped[offset / 64];
+
+        this->count += std::bitset<64>(mask & ~word).count();
+        word |= mask;
+        offset += n;
+      }
+    }
+
+
+    void PagedMemory::Page::unmap(triton::usize offset, triton::usize size) {
+      triton::usize end = offset + size;
+
+      std::memset(this->data + offset, 0x00, size);
+
+      while (offset < end) {
+        triton::usize bit  = offset % 64;
+        triton::usize n    = std::min(64 - bit, end - offset);
+        triton::uint64 mask = bitmapMask(bit, n);
+        triton::uint64& word = this->mapped[offset / 64];
+
+        this->count -= std::bitset<64>(mask & word).count();
+        word &= ~mask;
+        offset += n;
+      }
+    }
+
+
+    bool PagedMemory::Page::isMapped(triton::usize offset, triton::usize size) const {
+      triton::usize end = offset + size;
+
+      /* Fast path, the whole page is mapped */
+      if (this->count == MEMORY_PAGE_SIZE)
+        return true;
+
+      while (offset < end) {
+        triton::usize bit  = offset % 64;
+        triton::usize n    = std::min(64 - bit, end - offset);
+        triton::uint64 mask = bitmapMask(bit, n);
+
+        if ((this->mapped[offset / 64] & mask) != mask)
+          return false;
+        offset += n;
+      }
+
+      return true;
+    }
+
+
+    PagedMemory::PagedMemory() {
+    }
+
+
+    PagedMemory::PagedMemory(const PagedMemory& other) {
+      this->copy(other);
+    }
+
+
+    PagedMemory::~PagedMemory() {
+      this->clear();
+    }
+
+
+    PagedMemory& PagedMemory::operator=(const PagedMemory& other) {
+      if (this != &other)
+        this->copy(other);
+      return *this;
+    }
+
+
+    void PagedMemory::copy(const PagedMemory& other) {
+      this->clear();
+
+      for (auto it = other.pages.begin(); it != other.pages.end(); it++) {
+        Page* page = new(std::nothrow) Page(*it->second);
+        if (page == nullptr)
+          throw triton::exceptions::Cpu("PagedMemory::copy(): Not enough memory.");
+        this->pages[it->first] = page;
+      }
+    }
+
+
+    PagedMemory::Page* PagedMemory::getPage(triton::uint64 addr) const {
+      auto it = this->pages.find(addr >> MEMORY_PAGE_SHIFT);
+      if (it == this->pages.end())
+        return nullptr;
+      return it->second;
+    }
+
+
+    PagedMemory::Page* PagedMemory::getOrCreatePage(triton::uint64 addr) {
+      Page*& page = this->pages[addr >> MEMORY_PAGE_SHIFT];
+
+      if (page == nullptr) {
+        page = new(std::nothrow) Page();
+        if (page == nullptr) {
+          this->pages.erase(addr >> MEMORY_PAGE_SHIFT);
+          throw triton::exceptions::Cpu("PagedMemory::getOrCreatePage(): Not enough memory.");
+        }
+      }
+
+      return page;
+    }
+
+
+    triton::uint8 PagedMemory::read(triton::uint64 addr) const {
+      const Page* page = this->getPage(addr);
+
+      if (page == nullptr)
+        return 0x00;
+
+      return page->data[addr & (MEMORY_PAGE_SIZE - 1)];
+    }
+
+
+    void PagedMemory::read(triton::uint64 addr, triton::uint8* values, triton::usize size) const {
+      while (size) {
+        triton::usize offset = addr & (MEMORY_PAGE_SIZE - 1);
+        triton::usize n      = std::min(MEMORY_PAGE_SIZE - offset, size);
+        const Page* page     = this->getPage(addr);
+
+        /* Unmapped bytes are always zero, even inside an allocated page */
+        if (page == nullptr)
+          std::memset(values, 0x00, n);
+        else
+          std::memcpy(values, page->data + offset, n);
+
+        values += n;
+        addr   += n;
+        size   -= n;
+      }
+    }
+
+
+    void PagedMemory::write(triton::uint64 addr, triton::uint8 value) {
+      Page* page           = this->getOrCreatePage(addr);
+      triton::usize offset = addr & (MEMORY_PAGE_SIZE - 1);
+
+      page->data[offset] = value;
+      page->map(offset, 1);
+    }
+
+
+    void PagedMemory::write(triton::uint64 addr, const triton::uint8* values, triton::usize size) {
+      while (size) {
+        triton::usize offset = addr & (MEMORY_PAGE_SIZE - 1);
+        triton::usize n      = std::min(MEMORY_PAGE_SIZE - offset, size);
+        Page* page           = this->getOrCreatePage(addr);
+
+        std::memcpy(page->data + offset, values, n);
+        page->map(offset, n);
+
+        values += n;
+        addr   += n;
+        size   -= n;
+      }
+    }
+
+
+    bool PagedMemory::isMapped(triton::uint64 baseAddr, triton::usize size) const {
+      while (size) {
+        triton::usize offset = baseAddr & (MEMORY_PAGE_SIZE - 1);
+        triton::usize n      = std::min(MEMORY_PAGE_SIZE - offset, size);
+        const Page* page     = this->getPage(baseAddr);
+
+        if (page == nullptr || !page->isMapped(offset, n))
+          return false;
+
+        baseAddr += n;
+        size     -= n;
+      }
+
+      return true;
+    }
+
+
+    void PagedMemory::unmap(triton::uint64 baseAddr, triton::usize size) {
+      while (size) {
+        triton::usize offset = baseAddr & (MEMORY_PAGE_SIZE - 1);
+        triton::usize n      = std::min(MEMORY_PAGE_SIZE - offset, size);
+        Page* page           = this->getPage(baseAddr);
+
+        if (page != nullptr) {
+          /* Release the page if it is entirely unmapped */
+          if (n != MEMORY_PAGE_SIZE)
+            page->unmap(offset, n);
+
+          if (n == MEMORY_PAGE_SIZE || page->count == 0) {
+            this->pages.erase(baseAddr >> MEMORY_PAGE_SHIFT);
+            delete page;
+          }
+        }
+
+        baseAddr += n;
+        size     -= n;
+      }
+    }
+
+
+    void PagedMemory::clear(void) {
+      for (auto it = this->pages.begin(); it != this->pages.end(); it++)
+        delete it->second;
+      this->pages.clear();
+    }
+
+
+    triton::usize PagedMemory::getNumberOfPages(void) const {
+      return this->pages.size();
+    }
+
+  }; /* arch namespace */
+}; /* triton namespace */
@@ -0,0 +1,27 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <triton/traceRecord.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    TraceRecord::TraceRecord() {
+      this->callback = false;
+    }
+
+
+    TraceRecord::TraceRecord(triton::uint64 address, const triton::uint8* opcode, triton::uint32 opSize)
+      : instruction(opcode, opSize) {
+      this->instruction.setAddress(address);
+      this->callback = false;
+    }
+
+  }; /* arch namespace */
+}; /* triton namespace */
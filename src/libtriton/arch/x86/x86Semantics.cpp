@@ -837,26 +837,28 @@ namespace triton {
          * Create the semantic.
          * af = 0x10 == (0x10 & (regDst ^ op1 ^ op2))
          */
-        auto node = this->astCtxt.ite(
-                      this->astCtxt.equal(
-                        this->astCtxt.bv(0x10, bvSize),
-                        this->astCtxt.bvand(
-                          this->astCtxt.bv(0x10, bvSize),
-                          this->astCtxt.bvxor(
-                            this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)),
-                            this->astCtxt.bvxor(op1, op2)
-                          )
-                        )
-                      ),
-                      this->astCtxt.bv(1, 1),
-                      this->astCtxt.bv(0, 1)
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_AF), "Adjust flag");
+        auto node = [this, bvSize, low, high, op1, op2](triton::ast::AbstractNode* res) {
+          return this->astCtxt.ite(
+                 this->astCtxt.equal(
+                   this->astCtxt.bv(0x10, bvSize),
+                   this->astCtxt.bvand(
+                     this->astCtxt.bv(0x10, bvSize),
+                     this->astCtxt.bvxor(
+                       this->astCtxt.extract(high, low, res),
+                       this->astCtxt.bvxor(op1, op2)
+                     )
+                   )
+                 ),
+                 this->astCtxt.bv(1, 1),
+                 this->astCtxt.bv(0, 1)
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_AF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_AF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_AF), {op1, op2}, node, isTainted, "Adjust flag");
       }
 
 
@@ -978,23 +980,25 @@ namespace triton {
          * Create the semantic.
          * cf = MSB((op1 & op2) ^ ((op1 ^ op2 ^ parent) & (op1 ^ op2)));
          */
-        auto node = this->astCtxt.extract(bvSize-1, bvSize-1,
-                      this->astCtxt.bvxor(
-                        this->astCtxt.bvand(op1, op2),
-                        this->astCtxt.bvand(
-                          this->astCtxt.bvxor(
-                            this->astCtxt.bvxor(op1, op2),
-                            this->astCtxt.extract(high, low, this->astCtxt.reference(*parent))
-                          ),
-                        this->astCtxt.bvxor(op1, op2))
-                      )
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_CF), "Carry flag");
+        auto node = [this, bvSize, low, high, op1, op2](triton::ast::AbstractNode* res) {
+          return this->astCtxt.extract(bvSize-1, bvSize-1,
+                 this->astCtxt.bvxor(
+                   this->astCtxt.bvand(op1, op2),
+                   this->astCtxt.bvand(
+                     this->astCtxt.bvxor(
+                       this->astCtxt.bvxor(op1, op2),
+                       this->astCtxt.extract(high, low, res)
+                     ),
+                   this->astCtxt.bvxor(op1, op2))
+                 )
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_CF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_CF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_CF), {op1, op2}, node, isTainted, "Carry flag");
       }
 
 
@@ -1480,21 +1484,23 @@ namespace triton {
          * Create the semantic.
          * cf = extract(bvSize, bvSize (((op1 ^ op2 ^ res) ^ ((op1 ^ res) & (op1 ^ op2)))))
          */
-        auto node = this->astCtxt.extract(bvSize-1, bvSize-1,
-                      this->astCtxt.bvxor(
-                        this->astCtxt.bvxor(op1, this->astCtxt.bvxor(op2, this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)))),
-                        this->astCtxt.bvand(
-                          this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, this->astCtxt.reference(*parent))),
-                          this->astCtxt.bvxor(op1, op2)
-                        )
-                      )
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_CF), "Carry flag");
+        auto node = [this, bvSize, low, high, op1, op2](triton::ast::AbstractNode* res) {
+          return this->astCtxt.extract(bvSize-1, bvSize-1,
+                 this->astCtxt.bvxor(
+                   this->astCtxt.bvxor(op1, this->astCtxt.bvxor(op2, this->astCtxt.extract(high, low, res))),
+                   this->astCtxt.bvand(
+                     this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, res)),
+                     this->astCtxt.bvxor(op1, op2)
+                   )
+                 )
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_CF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_CF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_CF), {op1, op2}, node, isTainted, "Carry flag");
       }
 
 
@@ -1513,18 +1519,20 @@ namespace triton {
          * Create the semantic.
          * of = MSB((op1 ^ ~op2) & (op1 ^ regDst))
          */
-        auto node = this->astCtxt.extract(bvSize-1, bvSize-1,
-                      this->astCtxt.bvand(
-                        this->astCtxt.bvxor(op1, this->astCtxt.bvnot(op2)),
-                        this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)))
-                      )
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_OF), "Overflow flag");
+        auto node = [this, bvSize, low, high, op1, op2](triton::ast::AbstractNode* res) {
+          return this->astCtxt.extract(bvSize-1, bvSize-1,
+                 this->astCtxt.bvand(
+                   this->astCtxt.bvxor(op1, this->astCtxt.bvnot(op2)),
+                   this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, res))
+                 )
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_OF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_OF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_OF), {op1, op2}, node, isTainted, "Overflow flag");
       }
 
 
@@ -1884,18 +1892,20 @@ namespace triton {
          * Create the semantic.
          * of = high:bool((op1 ^ op2) & (op1 ^ regDst))
          */
-        auto node = this->astCtxt.extract(bvSize-1, bvSize-1,
-                      this->astCtxt.bvand(
-                        this->astCtxt.bvxor(op1, op2),
-                        this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)))
-                      )
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_OF), "Overflow flag");
+        auto node = [this, bvSize, low, high, op1, op2](triton::ast::AbstractNode* res) {
+          return this->astCtxt.extract(bvSize-1, bvSize-1,
+                 this->astCtxt.bvand(
+                   this->astCtxt.bvxor(op1, op2),
+                   this->astCtxt.bvxor(op1, this->astCtxt.extract(high, low, res))
+                 )
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_OF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_OF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_OF), {op1, op2}, node, isTainted, "Overflow flag");
       }
 
 
@@ -1913,24 +1923,27 @@ namespace triton {
          * pf is set to one if there is an even number of bit set to 1 in the least
          * significant byte of the result.
          */
-        auto node = this->astCtxt.bv(1, 1);
-        for (triton::uint32 counter = 0; counter <= BYTE_SIZE_BIT-1; counter++) {
-          node = this->astCtxt.bvxor(
-                   node,
-                   this->astCtxt.extract(0, 0,
-                     this->astCtxt.bvlshr(
-                       this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)),
-                       this->astCtxt.bv(counter, BYTE_SIZE_BIT)
-                     )
-                  )
-                );
-        }
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_PF), "Parity flag");
+        auto node = [this, low, high](triton::ast::AbstractNode* res) {
+          auto node = this->astCtxt.bv(1, 1);
+          for (triton::uint32 counter = 0; counter <= BYTE_SIZE_BIT-1; counter++) {
+            node = this->astCtxt.bvxor(
+                     node,
+                     this->astCtxt.extract(0, 0,
+                       this->astCtxt.bvlshr(
+                         this->astCtxt.extract(high, low, res),
+                         this->astCtxt.bv(counter, BYTE_SIZE_BIT)
+                       )
+                    )
+                  );
+          }
+          return node;
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_PF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_PF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_PF), {}, node, isTainted, "Parity flag");
       }
 
 
@@ -1988,13 +2001,15 @@ namespace triton {
          * Create the semantic.
          * sf = high:bool(regDst)
          */
-        auto node = this->astCtxt.extract(high, high, this->astCtxt.reference(*parent));
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_SF), "Sign flag");
+        auto node = [this, high](triton::ast::AbstractNode* res) {
+          return this->astCtxt.extract(high, high, res);
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_SF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_SF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_SF), {}, node, isTainted, "Sign flag");
       }
 
 
@@ -2109,20 +2124,22 @@ namespace triton {
          * Create the semantic.
          * zf = 0 == regDst
          */
-        auto node = this->astCtxt.ite(
-                      this->astCtxt.equal(
-                        this->astCtxt.extract(high, low, this->astCtxt.reference(*parent)),
-                        this->astCtxt.bv(0, bvSize)
-                      ),
-                      this->astCtxt.bv(1, 1),
-                      this->astCtxt.bv(0, 1)
-                    );
-
-        /* Create the symbolic expression */
-        auto expr = this->symbolicEngine->createSymbolicFlagExpression(inst, node, this->architecture->getRegister(ID_REG_ZF), "Zero flag");
+        auto node = [this, bvSize, low, high](triton::ast::AbstractNode* res) {
+          return this->astCtxt.ite(
+                 this->astCtxt.equal(
+                   this->astCtxt.extract(high, low, res),
+                   this->astCtxt.bv(0, bvSize)
+                 ),
+                 this->astCtxt.bv(1, 1),
+                 this->astCtxt.bv(0, 1)
+               );
+        };
 
         /* Spread the taint from the parent to the child */
-        expr->isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_ZF), parent->isTainted);
+        bool isTainted = this->taintEngine->setTaintRegister(this->architecture->getRegister(ID_REG_ZF), parent->isTainted);
+
+        /* Create the symbolic expression */
+        this->symbolicEngine->createSymbolicLazyFlagExpression(inst, parent, this->architecture->getRegister(ID_REG_ZF), {}, node, isTainted, "Zero flag");
       }
 
 
@@ -0,0 +1,236 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <vector>
+
+#include <triton/x86Specifications.hpp>
+#include <triton/x86TaintSummaries.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+    namespace x86 {
+
+      using triton::engines::taint::TaintSummary;
+
+
+      /* The arithmetic flags */
+      static const std::vector<triton::arch::registers_e> allFlags    = {ID_REG_AF, ID_REG_CF, ID_REG_OF, ID_REG_PF, ID_REG_SF, ID_REG_ZF};
+      static const std::vector<triton::arch::registers_e> incFlags    = {ID_REG_AF, ID_REG_OF, ID_REG_PF, ID_REG_SF, ID_REG_ZF};
+      static const std::vector<triton::arch::registers_e> logicFlags  = {ID_REG_PF, ID_REG_SF, ID_REG_ZF};
+      static const std::vector<triton::arch::registers_e> clearFlags  = {ID_REG_CF, ID_REG_OF};
+      static const std::vector<triton::arch::registers_e> shiftFlags  = {ID_REG_CF, ID_REG_OF, ID_REG_PF, ID_REG_SF, ID_REG_ZF};
+      static const std::vector<triton::arch::registers_e> rotateFlags = {ID_REG_CF, ID_REG_OF};
+
+
+      static inline void setSummary(std::vector<TaintSummary>& table, triton::uint32 type, triton::engines::taint::summary_e effect, triton::uint32 minOperands=1) {
+        table[type] = TaintSummary(effect, minOperands);
+      }
+
+
+      static inline void setFlags(std::vector<TaintSummary>& table, triton::uint32 type,
+                                  const std::vector<triton::arch::registers_e>& written,
+                                  const std::vector<triton::arch::registers_e>& cleared={}) {
+        table[type].writtenFlags = written;
+        table[type].clearedFlags = cleared;
+      }
+
+
+      /* Conditional instructions: setcc, cmovcc and jcc of a same condition read the same flags */
+      static inline void setCondition(std::vector<TaintSummary>& table, triton::uint32 set, triton::uint32 cmov, triton::uint32 jcc,
+                                      const std::vector<triton::arch::registers_e>& flags) {
+        /* The destination only depends on the flags */
+        setSummary(table, set, triton::engines::taint::SUMMARY_ASSIGN);
+        table[set].readFlags = flags;
+
+        /* Over-approximation of the conditional move, the destination keeps its taint or takes the one of the source */
+        setSummary(table, cmov, triton::engines::taint::SUMMARY_UNION);
+
+        /* The program counter depends on the flags */
+        setSummary(table, jcc, triton::engines::taint::SUMMARY_BRANCH);
+        table[jcc].readFlags = flags;
+      }
+
+
+      static std::vector<TaintSummary> buildTaintSummaries(void) {
+        using namespace triton::engines::taint;
+
+        std::vector<TaintSummary> table(ID_INST_LAST_ITEM);
+
+        /* Moves */
+        for (auto type : {ID_INS_MOV, ID_INS_MOVABS, ID_INS_MOVZX, ID_INS_MOVSX, ID_INS_MOVSXD, ID_INS_MOVD, ID_INS_MOVQ,
+                          ID_INS_MOVAPD, ID_INS_MOVAPS, ID_INS_MOVDQA, ID_INS_MOVDQU, ID_INS_MOVUPD, ID_INS_MOVUPS,
+                          ID_INS_MOVNTI, ID_INS_MOVNTDQ, ID_INS_MOVNTPD, ID_INS_MOVNTPS, ID_INS_MOVNTQ, ID_INS_MOVDDUP,
+                          ID_INS_MOVSHDUP, ID_INS_MOVSLDUP, ID_INS_MOVMSKPD, ID_INS_MOVMSKPS, ID_INS_MOVDQ2Q, ID_INS_MOVQ2DQ,
+                          ID_INS_LDDQU, ID_INS_VMOVDQA, ID_INS_VMOVDQU, ID_INS_PMOVMSKB, ID_INS_PSHUFD, ID_INS_PSHUFHW,
+                          ID_INS_PSHUFLW, ID_INS_PSHUFW, ID_INS_VPSHUFD, ID_INS_PMOVSXBD, ID_INS_PMOVSXBQ, ID_INS_PMOVSXBW,
+                          ID_INS_PMOVSXDQ, ID_INS_PMOVSXWD, ID_INS_PMOVSXWQ, ID_INS_PMOVZXBD, ID_INS_PMOVZXBQ, ID_INS_PMOVZXBW,
+                          ID_INS_PMOVZXDQ, ID_INS_PMOVZXWD, ID_INS_PMOVZXWQ})
+          setSummary(table, type, SUMMARY_ASSIGN);
+
+        /* Partial moves, the destination keeps the taint of its other bytes */
+        for (auto type : {ID_INS_MOVHPS, ID_INS_MOVLPS, ID_INS_MOVHPD, ID_INS_MOVLPD, ID_INS_MOVHLPS, ID_INS_MOVLHPS})
+          setSummary(table, type, SUMMARY_UNION);
+
+        /* Vector operations */
+        for (auto type : {ID_INS_PAND, ID_INS_PANDN, ID_INS_POR, ID_INS_PXOR, ID_INS_ANDPD, ID_INS_ANDPS, ID_INS_ANDNPD,
+                          ID_INS_ANDNPS, ID_INS_ORPD, ID_INS_ORPS, ID_INS_XORPD, ID_INS_XORPS, ID_INS_PADDB, ID_INS_PADDD,
+                          ID_INS_PADDQ, ID_INS_PADDW, ID_INS_PSUBB, ID_INS_PSUBD, ID_INS_PSUBQ, ID_INS_PSUBW, ID_INS_PAVGB,
+                          ID_INS_PAVGW, ID_INS_PCMPEQB, ID_INS_PCMPEQD, ID_INS_PCMPEQW, ID_INS_PCMPGTB, ID_INS_PCMPGTD,
+                          ID_INS_PCMPGTW, ID_INS_PMAXSB, ID_INS_PMAXSD, ID_INS_PMAXSW, ID_INS_PMAXUB, ID_INS_PMAXUD,
+                          ID_INS_PMAXUW, ID_INS_PMINSB, ID_INS_PMINSD, ID_INS_PMINSW, ID_INS_PMINUB, ID_INS_PMINUD,
+                          ID_INS_PMINUW, ID_INS_PUNPCKHBW, ID_INS_PUNPCKHDQ, ID_INS_PUNPCKHQDQ, ID_INS_PUNPCKHWD,
+                          ID_INS_PUNPCKLBW, ID_INS_PUNPCKLDQ, ID_INS_PUNPCKLQDQ, ID_INS_PUNPCKLWD, ID_INS_UNPCKHPD,
+                          ID_INS_UNPCKHPS, ID_INS_UNPCKLPD, ID_INS_UNPCKLPS, ID_INS_PSLLDQ, ID_INS_PSRLDQ})
+          setSummary(table, type, SUMMARY_UNION);
+
+        for (auto type : {ID_INS_VPAND, ID_INS_VPANDN, ID_INS_VPOR, ID_INS_VPXOR})
+          setSummary(table, type, SUMMARY_ASSIGN);
+
+        for (auto type : {ID_INS_PXOR, ID_INS_XORPD, ID_INS_XORPS, ID_INS_VPXOR, ID_INS_PSUBB, ID_INS_PSUBD, ID_INS_PSUBQ, ID_INS_PSUBW})
+          table[type].zeroIdiom = true;
+
+        /* Arithmetic */
+        for (auto type : {ID_INS_ADD, ID_INS_ADC, ID_INS_SUB, ID_INS_SBB, ID_INS_NEG}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, allFlags);
+        }
+        table[ID_INS_SUB].zeroIdiom = true;
+        table[ID_INS_ADC].readFlags = {ID_REG_CF};
+        table[ID_INS_SBB].readFlags = {ID_REG_CF};
+
+        for (auto type : {ID_INS_INC, ID_INS_DEC}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, incFlags);
+        }
+
+        setSummary(table, ID_INS_CMP, SUMMARY_NONE, 0);
+        setFlags(table, ID_INS_CMP, allFlags);
+
+        /* imul with one operand writes rdx:rax, the other forms are summarized as an over-approximation */
+        setSummary(table, ID_INS_IMUL, SUMMARY_UNION, 2);
+        setFlags(table, ID_INS_IMUL, {ID_REG_CF, ID_REG_OF});
+
+        /* Logic */
+        for (auto type : {ID_INS_AND, ID_INS_OR, ID_INS_XOR}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, logicFlags, clearFlags);
+        }
+        table[ID_INS_XOR].zeroIdiom = true;
+
+        setSummary(table, ID_INS_TEST, SUMMARY_NONE, 0);
+        setFlags(table, ID_INS_TEST, logicFlags, clearFlags);
+
+        setSummary(table, ID_INS_ANDN, SUMMARY_ASSIGN);
+        setFlags(table, ID_INS_ANDN, {ID_REG_SF, ID_REG_ZF}, clearFlags);
+
+        setSummary(table, ID_INS_NOT, SUMMARY_UNION);
+
+        /* Shifts and rotates */
+        for (auto type : {ID_INS_SHL, ID_INS_SAL, ID_INS_SHR, ID_INS_SAR, ID_INS_SHLD, ID_INS_SHRD}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, shiftFlags);
+        }
+
+        for (auto type : {ID_INS_ROL, ID_INS_ROR, ID_INS_RCL, ID_INS_RCR}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, rotateFlags);
+        }
+        table[ID_INS_RCL].readFlags = {ID_REG_CF};
+        table[ID_INS_RCR].readFlags = {ID_REG_CF};
+
+        for (auto type : {ID_INS_SHLX, ID_INS_SHRX, ID_INS_SARX, ID_INS_RORX})
+          setSummary(table, type, SUMMARY_ASSIGN);
+
+        /* Bits */
+        setSummary(table, ID_INS_BSWAP, SUMMARY_UNION);
+
+        for (auto type : {ID_INS_BSF, ID_INS_BSR, ID_INS_TZCNT}) {
+          setSummary(table, type, SUMMARY_ASSIGN);
+          setFlags(table, type, {ID_REG_ZF});
+        }
+        table[ID_INS_TZCNT].writtenFlags = {ID_REG_CF, ID_REG_ZF};
+
+        for (auto type : {ID_INS_BLSI, ID_INS_BLSMSK, ID_INS_BLSR}) {
+          setSummary(table, type, SUMMARY_ASSIGN);
+          setFlags(table, type, {ID_REG_CF, ID_REG_SF, ID_REG_ZF}, {ID_REG_OF});
+        }
+        setFlags(table, ID_INS_BLSMSK, {ID_REG_CF, ID_REG_SF}, {ID_REG_OF, ID_REG_ZF});
+
+        setSummary(table, ID_INS_BEXTR, SUMMARY_ASSIGN);
+        setFlags(table, ID_INS_BEXTR, {ID_REG_ZF}, clearFlags);
+
+        setSummary(table, ID_INS_BT, SUMMARY_NONE, 0);
+        setFlags(table, ID_INS_BT, {ID_REG_CF});
+
+        for (auto type : {ID_INS_BTC, ID_INS_BTR, ID_INS_BTS}) {
+          setSummary(table, type, SUMMARY_UNION);
+          setFlags(table, type, {ID_REG_CF});
+        }
+
+        /* Flags */
+        for (auto type : {ID_INS_CLC, ID_INS_STC})
+          setSummary(table, type, SUMMARY_NONE, 0);
+        table[ID_INS_CLC].clearedFlags = {ID_REG_CF};
+        table[ID_INS_STC].clearedFlags = {ID_REG_CF};
+
+        for (auto type : {ID_INS_CLD, ID_INS_STD})
+          setSummary(table, type, SUMMARY_NONE, 0);
+        table[ID_INS_CLD].clearedFlags = {ID_REG_DF};
+        table[ID_INS_STD].clearedFlags = {ID_REG_DF};
+
+        setSummary(table, ID_INS_CMC, SUMMARY_NONE, 0);
+
+        /* Conditions */
+        setCondition(table, ID_INS_SETA,  ID_INS_CMOVA,  ID_INS_JA,  {ID_REG_CF, ID_REG_ZF});
+        setCondition(table, ID_INS_SETAE, ID_INS_CMOVAE, ID_INS_JAE, {ID_REG_CF});
+        setCondition(table, ID_INS_SETB,  ID_INS_CMOVB,  ID_INS_JB,  {ID_REG_CF});
+        setCondition(table, ID_INS_SETBE, ID_INS_CMOVBE, ID_INS_JBE, {ID_REG_CF, ID_REG_ZF});
+        setCondition(table, ID_INS_SETE,  ID_INS_CMOVE,  ID_INS_JE,  {ID_REG_ZF});
+        setCondition(table, ID_INS_SETNE, ID_INS_CMOVNE, ID_INS_JNE, {ID_REG_ZF});
+        setCondition(table, ID_INS_SETG,  ID_INS_CMOVG,  ID_INS_JG,  {ID_REG_OF, ID_REG_SF, ID_REG_ZF});
+        setCondition(table, ID_INS_SETGE, ID_INS_CMOVGE, ID_INS_JGE, {ID_REG_OF, ID_REG_SF});
+        setCondition(table, ID_INS_SETL,  ID_INS_CMOVL,  ID_INS_JL,  {ID_REG_OF, ID_REG_SF});
+        setCondition(table, ID_INS_SETLE, ID_INS_CMOVLE, ID_INS_JLE, {ID_REG_OF, ID_REG_SF, ID_REG_ZF});
+        setCondition(table, ID_INS_SETO,  ID_INS_CMOVO,  ID_INS_JO,  {ID_REG_OF});
+        setCondition(table, ID_INS_SETNO, ID_INS_CMOVNO, ID_INS_JNO, {ID_REG_OF});
+        setCondition(table, ID_INS_SETP,  ID_INS_CMOVP,  ID_INS_JP,  {ID_REG_PF});
+        setCondition(table, ID_INS_SETNP, ID_INS_CMOVNP, ID_INS_JNP, {ID_REG_PF});
+        setCondition(table, ID_INS_SETS,  ID_INS_CMOVS,  ID_INS_JS,  {ID_REG_SF});
+        setCondition(table, ID_INS_SETNS, ID_INS_CMOVNS, ID_INS_JNS, {ID_REG_SF});
+
+        /* Control flow and stack */
+        setSummary(table, ID_INS_JMP,  SUMMARY_BRANCH);
+        setSummary(table, ID_INS_CALL, SUMMARY_CALL);
+        setSummary(table, ID_INS_RET,  SUMMARY_RET, 0);
+        setSummary(table, ID_INS_PUSH, SUMMARY_PUSH);
+        setSummary(table, ID_INS_POP,  SUMMARY_POP);
+        setSummary(table, ID_INS_LEA,  SUMMARY_LEA, 2);
+        setSummary(table, ID_INS_XCHG, SUMMARY_XCHG, 2);
+
+        /* No taint effect */
+        for (auto type : {ID_INS_NOP, ID_INS_PAUSE, ID_INS_LFENCE, ID_INS_MFENCE, ID_INS_SFENCE, ID_INS_PREFETCH,
+                          ID_INS_PREFETCHNTA, ID_INS_PREFETCHT0, ID_INS_PREFETCHT1, ID_INS_PREFETCHT2, ID_INS_PREFETCHW})
+          setSummary(table, type, SUMMARY_NONE, 0);
+
+        return table;
+      }
+
+
+      const triton::engines::taint::TaintSummary& getTaintSummary(triton::uint32 type) {
+        static const std::vector<TaintSummary> table = buildTaintSummaries();
+
+        if (type >= table.size())
+          return table[ID_INST_INVALID];
+
+        return table[type];
+      }
+
+    }; /* x86 namespace */
+  }; /* arch namespace */
+}; /* triton namespace */
@@ -5,8 +5,14 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
@@ -19,30 +25,304 @@
 namespace triton {
   namespace ast {
 
+    /* Returns a mask of `size` bits, `size` is at most 64 */
+    static inline triton::uint64 mask64(triton::uint32 size) {
+      if (size >= 64)
+        return ~static_cast<triton::uint64>(0);
+      return (static_cast<triton::uint64>(1) << size) - 1;
+    }
+
+
+    /* Shifts left a 64-bit value, like uint512 does the result is 0 when shifting by 64 or more */
+    static inline triton::uint64 shiftLeft64(triton::uint64 value, triton::uint64 shift) {
+      return (shift >= 64) ? 0 : (value << shift);
+    }
+
+
+    /* Shifts right a 64-bit value, like uint512 does the result is 0 when shifting by 64 or more */
+    static inline triton::uint64 shiftRight64(triton::uint64 value, triton::uint64 shift) {
+      return (shift >= 64) ? 0 : (value >> shift);
+    }
+
+
+    /* Sign extends a value of `size` bits to 64 bits */
+    static inline triton::sint64 signExtend64(triton::uint64 value, triton::uint32 size) {
+      if (size < 64 && ((value >> (size - 1)) & 1))
+        value |= ~mask64(size);
+      return static_cast<triton::sint64>(value);
+    }
+
+
+    /* ====== Node storage */
+
+
+    AstValue::AstValue() {
+      this->value = 0;
+      this->wide  = nullptr;
+    }
+
+
+    AstValue::AstValue(const AstValue& other) {
+      this->value = other.value;
+      this->wide  = nullptr;
+      if (other.wide)
+        *this = *other.wide;
+    }
+
+
+    AstValue::~AstValue() {
+      delete this->wide;
+    }
+
+
+    AstValue& AstValue::operator=(const AstValue& other) {
+      if (this == &other)
+        return *this;
+
+      if (other.wide)
+        return *this = *other.wide;
+
+      delete this->wide;
+      this->value = other.value;
+      this->wide  = nullptr;
+
+      return *this;
+    }
+
+
+    AstValue& AstValue::operator=(const triton::uint512& value) {
+      if (value <= std::numeric_limits<triton::uint64>::max()) {
+        delete this->wide;
+        this->value = value.convert_to<triton::uint64>();
+        this->wide  = nullptr;
+        return *this;
+      }
+
+      if (this->wide == nullptr) {
+        this->wide = new(std::nothrow) triton::uint512();
+        if (this->wide == nullptr)
+          throw triton::exceptions::Ast("AstValue::operator=(): Not enough memory.");
+      }
+
+      *this->wide = value;
+      this->value = 0;
+
+      return *this;
+    }
+
+
+    AstValue& AstValue::operator=(triton::uint64 value) {
+      delete this->wide;
+      this->value = value;
+      this->wide  = nullptr;
+      return *this;
+    }
+
+
+    bool AstValue::isWide(void) const {
+      return this->wide != nullptr;
+    }
+
+
+    triton::uint64 AstValue::getLow(void) const {
+      return this->value;
+    }
+
+
+    triton::uint512 AstValue::get(void) const {
+      if (this->wide)
+        return *this->wide;
+      return this->value;
+    }
+
+
+    AstChildren::AstChildren() {
+      this->count    = 0;
+      this->capacity = AST_INLINE_CHILDREN;
+    }
+
+
+    AstChildren::AstChildren(const AstChildren& other) {
+      this->count    = 0;
+      this->capacity = AST_INLINE_CHILDREN;
+      *this = other;
+    }
+
+
+    AstChildren::~AstChildren() {
+      if (this->capacity > AST_INLINE_CHILDREN)
+        delete[] this->items.heap;
+    }
+
+
+    AstChildren& AstChildren::operator=(const AstChildren& other) {
+      if (this == &other)
+        return *this;
+
+      this->clear();
+      for (AbstractNode* child : other)
+        this->push_back(child);
+
+      return *this;
+    }
+
+
+    bool AstChildren::operator==(const AstChildren& other) const {
+      return this->count == other.count && std::equal(this->begin(), this->end(), other.begin());
+    }
+
+
+    AbstractNode** AstChildren::data(void) {
+      return (this->capacity > AST_INLINE_CHILDREN) ? this->items.heap : this->items.inlined;
+    }
+
+
+    AbstractNode* const* AstChildren::data(void) const {
+      return (this->capacity > AST_INLINE_CHILDREN) ? this->items.heap : this->items.inlined;
+    }
+
+
+    AbstractNode*& AstChildren::operator[](triton::usize index) {
+      return this->data()[index];
+    }
+
+
+    AbstractNode* const& AstChildren::operator[](triton::usize index) const {
+      return this->data()[index];
+    }
+
+
+    triton::usize AstChildren::size(void) const {
+      return this->count;
+    }
+
+
+    bool AstChildren::empty(void) const {
+      return this->count == 0;
+    }
+
+
+    void AstChildren::push_back(AbstractNode* child) {
+      /* Move the children to a bigger heap array */
+      if (this->count == this->capacity) {
+        AbstractNode** heap = new(std::nothrow) AbstractNode*[this->capacity * 2];
+        if (heap == nullptr)
+          throw triton::exceptions::Ast("AstChildren::push_back(): Not enough memory.");
+
+        std::copy(this->begin(), this->end(), heap);
+        if (this->capacity > AST_INLINE_CHILDREN)
+          delete[] this->items.heap;
+
+        this->items.heap = heap;
+        this->capacity  *= 2;
+      }
+
+      this->data()[this->count++] = child;
+    }
+
+
+    void AstChildren::clear(void) {
+      if (this->capacity > AST_INLINE_CHILDREN)
+        delete[] this->items.heap;
+      this->count    = 0;
+      this->capacity = AST_INLINE_CHILDREN;
+    }
+
+
+    AbstractNode** AstChildren::begin(void) {
+      return this->data();
+    }
+
+
+    AbstractNode** AstChildren::end(void) {
+      return this->data() + this->count;
+    }
+
+
+    AbstractNode* const* AstChildren::begin(void) const {
+      return this->data();
+    }
+
+
+    AbstractNode* const* AstChildren::end(void) const {
+      return this->data() + this->count;
+    }
+
+
+    AbstractNode* const* AstChildren::cbegin(void) const {
+      return this->begin();
+    }
+
+
+    AbstractNode* const* AstChildren::cend(void) const {
+      return this->end();
+    }
+
+
     /* ====== Abstract node */
 
     AbstractNode::AbstractNode(enum kind_e kind, AstContext& ctxt): ctxt(ctxt) {
       this->eval        = 0;
       this->kind        = kind;
+      this->parent      = nullptr;
+      this->parents     = nullptr;
+      this->refs        = 0;
       this->size        = 0;
       this->symbolized  = false;
     }
 
 
+    AbstractNode::AbstractNode(const AbstractNode& other): ctxt(other.ctxt) {
+      this->eval        = other.eval;
+      this->kind        = other.kind;
+      this->logical     = other.logical;
+      this->parent      = nullptr;
+      this->parents     = nullptr;
+      this->refs        = 0;
+      this->size        = other.size;
+      this->symbolized  = other.symbolized;
+
+      for (AbstractNode* child : other.children) {
+        this->addChild(child);
+        child->setParent(this);
+      }
+    }
+
+
     AbstractNode::AbstractNode(const AbstractNode& other, AstContext& ctxt): ctxt(ctxt) {
       this->eval        = other.eval;
       this->kind        = other.kind;
-      this->parents     = other.parents;
+      this->logical     = other.logical;
+      this->parent      = nullptr;
+      this->parents     = nullptr;
+      this->refs        = 0;
       this->size        = other.size;
       this->symbolized  = other.symbolized;
 
-      for (triton::uint32 index = 0; index < other.children.size(); index++)
-        this->children.push_back(triton::ast::newInstance(other.children[index]));
+      for (triton::uint32 index = 0; index < other.children.size(); index++) {
+        this->addChild(triton::ast::newInstance(other.children[index]));
+        this->children[index]->setParent(this);
+      }
     }
 
 
     AbstractNode::~AbstractNode() {
-      /* virtual */
+      delete this->parents;
+    }
+
+
+    void* AbstractNode::operator new(std::size_t size, AstContext& ctxt) noexcept {
+      return ctxt.getAstArena().allocate(size);
+    }
+
+
+    void AbstractNode::operator delete(void* ptr, AstContext& ctxt) noexcept {
+      triton::ast::AstArena::release(ptr);
+    }
+
+
+    void AbstractNode::operator delete(void* ptr) noexcept {
+      triton::ast::AstArena::release(ptr);
     }
 
 
@@ -51,6 +331,25 @@ namespace triton {
     }
 
 
+    void AbstractNode::retain(void) {
+      this->refs++;
+    }
+
+
+    void AbstractNode::release(void) {
+      if (this->refs == 0)
+        throw triton::exceptions::Ast("AbstractNode::release(): The node is not referenced.");
+
+      if (--this->refs == 0)
+        this->ctxt.getAstGarbageCollector().freeAstNode(this);
+    }
+
+
+    triton::usize AbstractNode::getRefCount(void) const {
+      return this->refs;
+    }
+
+
     enum kind_e AbstractNode::getKind(void) const {
       return this->kind;
     }
@@ -62,6 +361,9 @@ namespace triton {
 
 
     triton::uint512 AbstractNode::getBitvectorMask(void) const {
+      if (this->size <= 64)
+        return mask64(this->size);
+
       triton::uint512 mask = -1;
       mask = mask >> (512 - this->size);
       return mask;
@@ -69,7 +371,10 @@ namespace triton {
 
 
     bool AbstractNode::isSigned(void) const {
-      if ((this->eval >> (this->size-1)) & 1)
+      if (this->size <= 64)
+        return (this->eval.getLow() >> (this->size-1)) & 1;
+
+      if ((this->eval.get() >> (this->size-1)) & 1)
         return true;
       return false;
     }
@@ -117,38 +422,108 @@ namespace triton {
     }
 
 
+    triton::uint512 AbstractNode::hash(triton::uint32 deep) const {
+      std::unordered_map<const AbstractNode*, triton::uint512> hashes;
+      std::vector<triton::uint512> children;
+      std::vector<AbstractNode*> nodes;
+
+      /* The children are hashed before their parents, a shared node is hashed once */
+      triton::ast::nodesExtraction(const_cast<AbstractNode*>(this), nodes);
+      for (const AbstractNode* node : nodes) {
+        children.clear();
+        for (const AbstractNode* child : node->children)
+          children.push_back(triton::ast::rotl(hashes[child], 1));
+        hashes[node] = node->computeHash(children);
+      }
+
+      return triton::ast::rotl(hashes[this], deep);
+    }
+
+
     triton::uint512 AbstractNode::evaluate(void) const {
-      return this->eval;
+      return this->eval.get();
     }
 
 
-    std::vector<AbstractNode*>& AbstractNode::getChildren(void) {
+    triton::uint64 AbstractNode::evaluate64(void) const {
+      return this->eval.getLow();
+    }
+
+
+    AstChildren& AbstractNode::getChildren(void) {
       return this->children;
     }
 
 
-    std::set<AbstractNode*>& AbstractNode::getParents(void) {
-      return this->parents;
+    std::set<AbstractNode*> AbstractNode::getParents(void) const {
+      std::set<AbstractNode*> ret;
+
+      if (this->parent)
+        ret.insert(this->parent);
+
+      if (this->parents)
+        ret.insert(this->parents->begin(), this->parents->end());
+
+      return ret;
     }
 
 
     void AbstractNode::setParent(AbstractNode* p) {
-      this->parents.insert(p);
+      if (this->parent == p)
+        return;
+
+      if (this->parents && this->parents->find(p) != this->parents->end())
+        return;
+
+      if (this->parent == nullptr) {
+        this->parent = p;
+        return;
+      }
+
+      /* The node has several parents, they go into the side set */
+      if (this->parents == nullptr) {
+        this->parents = new(std::nothrow) std::unordered_set<AbstractNode*>();
+        if (this->parents == nullptr)
+          throw triton::exceptions::Ast("AbstractNode::setParent(): Not enough memory.");
+      }
+
+      this->parents->insert(p);
     }
 
 
     void AbstractNode::removeParent(AbstractNode* p) {
-      this->parents.erase(p);
+      if (this->parent == p)
+        this->parent = nullptr;
+
+      else if (this->parents) {
+        this->parents->erase(p);
+        if (this->parents->empty()) {
+          delete this->parents;
+          this->parents = nullptr;
+        }
+      }
     }
 
 
     void AbstractNode::setParent(std::set<AbstractNode*>& p) {
       for (std::set<AbstractNode*>::iterator it = p.begin(); it != p.end(); it++)
-        this->parents.insert(*it);
+        this->setParent(*it);
+    }
+
+
+    void AbstractNode::initParents(void) {
+      if (this->parent)
+        this->parent->init();
+
+      if (this->parents) {
+        for (AbstractNode* p : *this->parents)
+          p->init();
+      }
     }
 
 
     void AbstractNode::addChild(AbstractNode* child) {
+      child->retain();
       this->children.push_back(child);
     }
 
@@ -160,14 +535,22 @@ namespace triton {
       if (child == nullptr)
         throw triton::exceptions::Ast("AbstractNode::setChild(): child cannot be null.");
 
+      AbstractNode* old = this->children[index];
+
+      /* The node does not match its entry in the dictionaries anymore */
+      this->ctxt.getAstGarbageCollector().removeAstNode(this);
+
       /* Setup the parent of the child */
       child->setParent(this);
-
-      /* Remove the parent of the old child */
-      this->children[index]->removeParent(this);
+      child->retain();
 
       /* Setup the child of the parent */
       this->children[index] = child;
+
+      /* Remove the parent of the old child, which may free it */
+      if (std::find(this->children.begin(), this->children.end(), old) == this->children.end())
+        old->removeParent(this);
+      old->release();
     }
 
 
@@ -195,7 +578,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = ((this->children[0]->evaluate() + this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = ((this->children[0]->evaluate64() + this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = ((this->children[0]->evaluate() + this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -204,17 +590,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvaddNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvaddNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -237,7 +622,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (this->children[0]->evaluate() & this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->eval = (this->children[0]->evaluate64() & this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() & this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -246,17 +634,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvandNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvandNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -295,8 +682,7 @@ namespace triton {
       }
 
       if (shift >= this->size && this->children[0]->isSigned()) {
-        this->eval = -1;
-        this->eval &= this->getBitvectorMask();
+        this->eval = this->getBitvectorMask();
       }
 
       else if (shift >= this->size && !this->children[0]->isSigned()) {
@@ -310,7 +696,7 @@ namespace triton {
       else {
         this->eval = value & this->getBitvectorMask();
         for (triton::uint32 index = 0; index < shift; index++) {
-          this->eval = (((this->eval >> 1) | mask) & this->getBitvectorMask());
+          this->eval = (((this->eval.get() >> 1) | mask) & this->getBitvectorMask());
         }
       }
 
@@ -321,17 +707,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvashrNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvashrNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -354,7 +739,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (this->children[0]->evaluate() >> this->children[1]->evaluate().convert_to<triton::uint32>());
+      if (this->size <= 64)
+        this->eval = shiftRight64(this->children[0]->evaluate64(), this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() >> this->children[1]->evaluate().convert_to<triton::uint32>());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -363,17 +751,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvlshrNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvlshrNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -396,7 +783,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = ((this->children[0]->evaluate() * this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = ((this->children[0]->evaluate64() * this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = ((this->children[0]->evaluate() * this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -405,17 +795,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvmulNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvmulNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -438,7 +827,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (~(this->children[0]->evaluate() & this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (~(this->children[0]->evaluate64() & this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = (~(this->children[0]->evaluate() & this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -447,17 +839,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvnandNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvnandNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -476,7 +867,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = ((-(this->children[0]->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = ((0 - this->children[0]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = ((-(this->children[0]->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>() & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -485,17 +879,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvnegNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvnegNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -518,7 +911,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (~(this->children[0]->evaluate() | this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (~(this->children[0]->evaluate64() | this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = (~(this->children[0]->evaluate() | this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -527,17 +923,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvnorNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvnorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -556,7 +951,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (~this->children[0]->evaluate() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (~this->children[0]->evaluate64() & mask64(this->size));
+      else
+        this->eval = (~this->children[0]->evaluate() & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -565,17 +963,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvnotNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvnotNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -598,7 +995,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (this->children[0]->evaluate() | this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->eval = (this->children[0]->evaluate64() | this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() | this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -607,17 +1007,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvorNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -660,17 +1059,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvrolNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvrolNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -713,17 +1111,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvrorNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvrorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -755,8 +1152,7 @@ namespace triton {
       this->size = this->children[0]->getBitvectorSize();
 
       if (op2Signed == 0) {
-        this->eval = (op1Signed < 0 ? 1 : -1);
-        this->eval &= this->getBitvectorMask();
+        this->eval = (op1Signed < 0 ? triton::uint512(1) : this->getBitvectorMask());
       }
       else
         this->eval = ((op1Signed / op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask());
@@ -768,17 +1164,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsdivNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsdivNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -802,13 +1197,20 @@ namespace triton {
       if (this->children[0]->getBitvectorSize() != this->children[1]->getBitvectorSize())
         throw triton::exceptions::Ast("BvsgeNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->children[0]);
-      op2Signed = triton::ast::modularSignExtend(this->children[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed >= op2Signed);
+
+      if (this->children[0]->getBitvectorSize() <= 64) {
+        triton::uint32 size = this->children[0]->getBitvectorSize();
+        this->eval = (signExtend64(this->children[0]->evaluate64(), size) >= signExtend64(this->children[1]->evaluate64(), size));
+      }
+
+      else {
+        /* Sign extend */
+        op1Signed = triton::ast::modularSignExtend(this->children[0]);
+        op2Signed = triton::ast::modularSignExtend(this->children[1]);
+        this->eval = (op1Signed >= op2Signed);
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -817,17 +1219,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsgeNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsgeNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -851,13 +1252,20 @@ namespace triton {
       if (this->children[0]->getBitvectorSize() != this->children[1]->getBitvectorSize())
         throw triton::exceptions::Ast("BvsgtNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->children[0]);
-      op2Signed = triton::ast::modularSignExtend(this->children[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed > op2Signed);
+
+      if (this->children[0]->getBitvectorSize() <= 64) {
+        triton::uint32 size = this->children[0]->getBitvectorSize();
+        this->eval = (signExtend64(this->children[0]->evaluate64(), size) > signExtend64(this->children[1]->evaluate64(), size));
+      }
+
+      else {
+        /* Sign extend */
+        op1Signed = triton::ast::modularSignExtend(this->children[0]);
+        op2Signed = triton::ast::modularSignExtend(this->children[1]);
+        this->eval = (op1Signed > op2Signed);
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -866,17 +1274,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsgtNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsgtNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -899,7 +1306,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = ((this->children[0]->evaluate() << this->children[1]->evaluate().convert_to<triton::uint32>()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (shiftLeft64(this->children[0]->evaluate64(), this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = ((this->children[0]->evaluate() << this->children[1]->evaluate().convert_to<triton::uint32>()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -908,17 +1318,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvshlNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvshlNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -941,13 +1350,20 @@ namespace triton {
       if (this->children[0]->getBitvectorSize() != this->children[1]->getBitvectorSize())
         throw triton::exceptions::Ast("BvsleNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->children[0]);
-      op2Signed = triton::ast::modularSignExtend(this->children[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed <= op2Signed);
+
+      if (this->children[0]->getBitvectorSize() <= 64) {
+        triton::uint32 size = this->children[0]->getBitvectorSize();
+        this->eval = (signExtend64(this->children[0]->evaluate64(), size) <= signExtend64(this->children[1]->evaluate64(), size));
+      }
+
+      else {
+        /* Sign extend */
+        op1Signed = triton::ast::modularSignExtend(this->children[0]);
+        op2Signed = triton::ast::modularSignExtend(this->children[1]);
+        this->eval = (op1Signed <= op2Signed);
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -956,17 +1372,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsleNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsleNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -990,13 +1405,20 @@ namespace triton {
       if (this->children[0]->getBitvectorSize() != this->children[1]->getBitvectorSize())
         throw triton::exceptions::Ast("BvsltNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->children[0]);
-      op2Signed = triton::ast::modularSignExtend(this->children[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed < op2Signed);
+
+      if (this->children[0]->getBitvectorSize() <= 64) {
+        triton::uint32 size = this->children[0]->getBitvectorSize();
+        this->eval = (signExtend64(this->children[0]->evaluate64(), size) < signExtend64(this->children[1]->evaluate64(), size));
+      }
+
+      else {
+        /* Sign extend */
+        op1Signed = triton::ast::modularSignExtend(this->children[0]);
+        op2Signed = triton::ast::modularSignExtend(this->children[1]);
+        this->eval = (op1Signed < op2Signed);
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1005,17 +1427,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsltNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsltNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1058,17 +1479,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsmodNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsmodNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1111,17 +1531,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsremNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsremNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1144,7 +1563,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = ((this->children[0]->evaluate() - this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = ((this->children[0]->evaluate64() - this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = ((this->children[0]->evaluate() - this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1153,17 +1575,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvsubNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvsubNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1199,17 +1620,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvudivNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvudivNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1232,7 +1652,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() >= this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() >= this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() >= this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1241,17 +1664,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvugeNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvugeNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1274,7 +1696,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() > this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() > this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() > this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1283,17 +1708,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvugtNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvugtNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1316,7 +1740,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() <= this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() <= this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() <= this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1325,17 +1752,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvuleNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvuleNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1358,7 +1784,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() < this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() < this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() < this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1367,17 +1796,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvultNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvultNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1413,17 +1841,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvuremNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvuremNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1446,7 +1873,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (~(this->children[0]->evaluate() ^ this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (~(this->children[0]->evaluate64() ^ this->children[1]->evaluate64()) & mask64(this->size));
+      else
+        this->eval = (~(this->children[0]->evaluate() ^ this->children[1]->evaluate()) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1455,17 +1885,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvxnorNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvxnorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -1488,7 +1917,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[0]->getBitvectorSize();
-      this->eval = (this->children[0]->evaluate() ^ this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->eval = (this->children[0]->evaluate64() ^ this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() ^ this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1497,17 +1929,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvxorNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvxorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -1542,7 +1973,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = size;
-      this->eval = (value & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (value.convert_to<triton::uint64>() & mask64(this->size));
+      else
+        this->eval = (value & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1551,17 +1985,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 BvNode::hash(triton::uint32 deep) const {
+    triton::uint512 BvNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1598,9 +2031,18 @@ namespace triton {
       if (this->size > MAX_BITS_SUPPORTED)
         throw triton::exceptions::Ast("ConcatNode::init(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = this->children[0]->evaluate();
-      for (triton::uint32 index = 0; index < this->children.size()-1; index++)
-        this->eval = ((this->eval << this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate());
+      if (this->size <= 64) {
+        triton::uint64 value = this->children[0]->evaluate64();
+        for (triton::uint32 index = 0; index < this->children.size()-1; index++)
+          value = (shiftLeft64(value, this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate64());
+        this->eval = value;
+      }
+
+      else {
+        this->eval = this->children[0]->evaluate();
+        for (triton::uint32 index = 0; index < this->children.size()-1; index++)
+          this->eval = ((this->eval.get() << this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate());
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1609,17 +2051,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 ConcatNode::hash(triton::uint32 deep) const {
+    triton::uint512 ConcatNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1639,18 +2080,17 @@ namespace triton {
       this->symbolized  = false;
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
     triton::uint512 DecimalNode::getValue(void) {
-      return this->value;
+      return this->value.get();
     }
 
 
-    triton::uint512 DecimalNode::hash(triton::uint32 deep) const {
-      triton::uint512 hash = this->kind ^ this->value;
+    triton::uint512 DecimalNode::computeHash(const std::vector<triton::uint512>& hashes) const {
+      triton::uint512 hash = this->kind ^ this->value.get();
       return hash;
     }
 
@@ -1671,7 +2111,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() != this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64 && this->children[1]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() != this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() != this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1680,17 +2123,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 DistinctNode::hash(triton::uint32 deep) const {
+    triton::uint512 DistinctNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -1710,7 +2152,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->children[0]->evaluate() == this->children[1]->evaluate());
+      if (this->children[0]->getBitvectorSize() <= 64 && this->children[1]->getBitvectorSize() <= 64)
+        this->eval = (this->children[0]->evaluate64() == this->children[1]->evaluate64());
+      else
+        this->eval = (this->children[0]->evaluate() == this->children[1]->evaluate());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1719,17 +2164,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 EqualNode::hash(triton::uint32 deep) const {
+    triton::uint512 EqualNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -1754,18 +2198,23 @@ namespace triton {
       if (this->children[0]->getKind() != DECIMAL_NODE || this->children[1]->getKind() != DECIMAL_NODE)
         throw triton::exceptions::Ast("ExtractNode::init(): The highest and lower bit must be a DECIMAL_NODE.");
 
+      /* The bounds are checked before the bits are converted and shifted, low is then lower than the size of the child */
+      if (reinterpret_cast<DecimalNode*>(this->children[0])->getValue() >= this->children[2]->getBitvectorSize())
+        throw triton::exceptions::Ast("ExtractNode::init(): The size of the extraction is higher than the child expression.");
+
       high = reinterpret_cast<DecimalNode*>(this->children[0])->getValue().convert_to<triton::uint32>();
-      low  = reinterpret_cast<DecimalNode*>(this->children[1])->getValue().convert_to<triton::uint32>();
 
-      if (low > high)
+      if (reinterpret_cast<DecimalNode*>(this->children[1])->getValue() > high)
         throw triton::exceptions::Ast("ExtractNode::init(): The high bit must be greater than the low bit.");
 
+      low = reinterpret_cast<DecimalNode*>(this->children[1])->getValue().convert_to<triton::uint32>();
+
       /* Init attributes */
       this->size = ((high - low) + 1);
-      this->eval = ((this->children[2]->evaluate() >> low) & this->getBitvectorMask());
-
-      if (this->size > this->children[2]->getBitvectorSize() || high >= this->children[2]->getBitvectorSize())
-        throw triton::exceptions::Ast("ExtractNode::init(): The size of the extraction is higher than the child expression.");
+      if (this->children[2]->getBitvectorSize() <= 64)
+        this->eval = ((this->children[2]->evaluate64() >> low) & mask64(this->size));
+      else
+        this->eval = ((this->children[2]->evaluate() >> low) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1774,17 +2223,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 ExtractNode::hash(triton::uint32 deep) const {
+    triton::uint512 ExtractNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1811,7 +2259,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->children[1]->getBitvectorSize();
-      this->eval = this->children[0]->evaluate() ? this->children[1]->evaluate() : this->children[2]->evaluate();
+      if (this->size <= 64)
+        this->eval = this->children[0]->evaluate64() ? this->children[1]->evaluate64() : this->children[2]->evaluate64();
+      else
+        this->eval = this->children[0]->evaluate() ? this->children[1]->evaluate() : this->children[2]->evaluate();
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1820,17 +2271,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 IteNode::hash(triton::uint32 deep) const {
+    triton::uint512 IteNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1866,24 +2316,23 @@ namespace triton {
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
         this->children[index]->setParent(this);
         this->symbolized |= this->children[index]->isSymbolized();
-        this->eval = this->eval && this->children[index]->evaluate();
+        this->eval = this->eval.get() && this->children[index]->evaluate();
 
         if (this->children[index]->isLogical() == false)
           throw triton::exceptions::Ast("LandNode::init(): Must take logical nodes as arguments.");
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 LandNode::hash(triton::uint32 deep) const {
+    triton::uint512 LandNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -1916,17 +2365,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 LetNode::hash(triton::uint32 deep) const {
+    triton::uint512 LetNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -1958,17 +2406,16 @@ namespace triton {
 
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 LnotNode::hash(triton::uint32 deep) const {
+    triton::uint512 LnotNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -2004,24 +2451,23 @@ namespace triton {
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
         this->children[index]->setParent(this);
         this->symbolized |= this->children[index]->isSymbolized();
-        this->eval = this->eval || this->children[index]->evaluate();
+        this->eval = this->eval.get() || this->children[index]->evaluate();
 
         if (this->children[index]->isLogical() == false)
           throw triton::exceptions::Ast("LorNode::init(): Must take logical nodes as arguments.");
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 LorNode::hash(triton::uint32 deep) const {
+    triton::uint512 LorNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * this->children[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h = h * hashes[index];
+      return h;
     }
 
 
@@ -2030,33 +2476,52 @@ namespace triton {
 
     ReferenceNode::ReferenceNode(triton::engines::symbolic::SymbolicExpression& expr)
       : AbstractNode(REFERENCE_NODE, expr.getAst()->getContext())
-      , expr(expr) {
+      , expr(&expr) {
       this->init();
     }
 
 
+    ReferenceNode::ReferenceNode(const ReferenceNode& other)
+      : AbstractNode(other)
+      , expr(other.expr) {
+      if (this->expr != nullptr)
+        this->expr->getAst()->setParent(this);
+    }
+
+
     void ReferenceNode::init(void) {
       /* Init attributes */
-      this->eval        = this->expr.getAst()->evaluate();
-      this->size        = this->expr.getAst()->getBitvectorSize();
-      this->symbolized  = this->expr.getAst()->isSymbolized();
+      this->eval        = this->getSymbolicExpression().getAst()->evaluate();
+      this->size        = this->getSymbolicExpression().getAst()->getBitvectorSize();
+      this->symbolized  = this->getSymbolicExpression().getAst()->isSymbolized();
 
-      this->expr.getAst()->setParent(this);
+      this->getSymbolicExpression().getAst()->setParent(this);
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 ReferenceNode::hash(triton::uint32 deep) const {
-      triton::uint512 hash = this->kind ^ this->expr.getId();
+    triton::uint512 ReferenceNode::computeHash(const std::vector<triton::uint512>& hashes) const {
+      triton::uint512 hash = this->kind ^ this->getSymbolicExpression().getId();
       return hash;
     }
 
 
     triton::engines::symbolic::SymbolicExpression& ReferenceNode::getSymbolicExpression(void) const {
-      return this->expr;
+      if (this->expr == nullptr)
+        throw triton::exceptions::Ast("ReferenceNode::getSymbolicExpression(): The symbolic expression has been removed.");
+      return *this->expr;
+    }
+
+
+    bool ReferenceNode::isDetached(void) const {
+      return (this->expr == nullptr);
+    }
+
+
+    void ReferenceNode::detach(void) {
+      this->expr = nullptr;
     }
 
 
@@ -2076,8 +2541,7 @@ namespace triton {
       this->symbolized  = false;
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2086,12 +2550,12 @@ namespace triton {
     }
 
 
-    triton::uint512 StringNode::hash(triton::uint32 deep) const {
+    triton::uint512 StringNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind;
       triton::uint32 index = 1;
       for (std::string::const_iterator it=this->value.cbegin(); it != this->value.cend(); it++)
         h = h ^ triton::ast::pow(*it, index++);
-      return triton::ast::rotl(h, deep);
+      return h;
     }
 
 
@@ -2121,7 +2585,10 @@ namespace triton {
       if (size > MAX_BITS_SUPPORTED)
         throw triton::exceptions::Ast("SxNode::SxNode(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = ((((this->children[1]->evaluate() >> (this->children[1]->getBitvectorSize()-1)) == 0) ? this->children[1]->evaluate() : (this->children[1]->evaluate() | ~(this->children[1]->getBitvectorMask()))) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = (static_cast<triton::uint64>(signExtend64(this->children[1]->evaluate64(), this->children[1]->getBitvectorSize())) & mask64(this->size));
+      else
+        this->eval = ((((this->children[1]->evaluate() >> (this->children[1]->getBitvectorSize()-1)) == 0) ? this->children[1]->evaluate() : (this->children[1]->evaluate() | ~(this->children[1]->getBitvectorMask()))) & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -2130,17 +2597,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 SxNode::hash(triton::uint32 deep) const {
+    triton::uint512 SxNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
 
@@ -2162,8 +2628,7 @@ namespace triton {
       this->symbolized  = true;
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2172,14 +2637,14 @@ namespace triton {
     }
 
 
-    triton::uint512 VariableNode::hash(triton::uint32 deep) const {
+    triton::uint512 VariableNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind;
       triton::uint32 index = 1;
 
       for (char c : this->symVar.getName())
         h = h ^ triton::ast::pow(c, index++);
 
-      return triton::ast::rotl(h, deep);
+      return h;
     }
 
 
@@ -2209,7 +2674,10 @@ namespace triton {
       if (size > MAX_BITS_SUPPORTED)
         throw triton::exceptions::Ast("ZxNode::init(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = (this->children[1]->evaluate() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = this->children[1]->evaluate64();
+      else
+        this->eval = (this->children[1]->evaluate() & this->getBitvectorMask());
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -2218,17 +2686,16 @@ namespace triton {
       }
 
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
-    triton::uint512 ZxNode::hash(triton::uint32 deep) const {
+    triton::uint512 ZxNode::computeHash(const std::vector<triton::uint512>& hashes) const {
       triton::uint512 h = this->kind, s = this->children.size();
       if (s) h = h * s;
       for (triton::uint32 index = 0; index < this->children.size(); index++)
-        h = h * triton::ast::pow(this->children[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = h * triton::ast::pow(hashes[index], index+1);
+      return h;
     }
 
   }; /* ast namespace */
@@ -2295,58 +2762,56 @@ namespace triton {
 namespace triton {
   namespace ast {
 
-    AbstractNode* newInstance(AbstractNode* node) {
+    /* Returns a copy of the node which shares its children. The copy is not recorded yet. */
+    static inline AbstractNode* copyNode(AbstractNode* node) {
       AbstractNode* newNode = nullptr;
 
-      if (node == nullptr)
-        return nullptr;
-
       switch (node->getKind()) {
-        case BVADD_NODE:                newNode = new(std::nothrow) BvaddNode(*reinterpret_cast<BvaddNode*>(node)); break;
-        case BVAND_NODE:                newNode = new(std::nothrow) BvandNode(*reinterpret_cast<BvandNode*>(node)); break;
-        case BVASHR_NODE:               newNode = new(std::nothrow) BvashrNode(*reinterpret_cast<BvashrNode*>(node)); break;
-        case BVLSHR_NODE:               newNode = new(std::nothrow) BvlshrNode(*reinterpret_cast<BvlshrNode*>(node)); break;
-        case BVMUL_NODE:                newNode = new(std::nothrow) BvmulNode(*reinterpret_cast<BvmulNode*>(node)); break;
-        case BVNAND_NODE:               newNode = new(std::nothrow) BvnandNode(*reinterpret_cast<BvnandNode*>(node)); break;
-        case BVNEG_NODE:                newNode = new(std::nothrow) BvnegNode(*reinterpret_cast<BvnegNode*>(node)); break;
-        case BVNOR_NODE:                newNode = new(std::nothrow) BvnorNode(*reinterpret_cast<BvnorNode*>(node)); break;
-        case BVNOT_NODE:                newNode = new(std::nothrow) BvnotNode(*reinterpret_cast<BvnotNode*>(node)); break;
-        case BVOR_NODE:                 newNode = new(std::nothrow) BvorNode(*reinterpret_cast<BvorNode*>(node)); break;
-        case BVROL_NODE:                newNode = new(std::nothrow) BvrolNode(*reinterpret_cast<BvrolNode*>(node)); break;
-        case BVROR_NODE:                newNode = new(std::nothrow) BvrorNode(*reinterpret_cast<BvrorNode*>(node)); break;
-        case BVSDIV_NODE:               newNode = new(std::nothrow) BvsdivNode(*reinterpret_cast<BvsdivNode*>(node)); break;
-        case BVSGE_NODE:                newNode = new(std::nothrow) BvsgeNode(*reinterpret_cast<BvsgeNode*>(node)); break;
-        case BVSGT_NODE:                newNode = new(std::nothrow) BvsgtNode(*reinterpret_cast<BvsgtNode*>(node)); break;
-        case BVSHL_NODE:                newNode = new(std::nothrow) BvshlNode(*reinterpret_cast<BvshlNode*>(node)); break;
-        case BVSLE_NODE:                newNode = new(std::nothrow) BvsleNode(*reinterpret_cast<BvsleNode*>(node)); break;
-        case BVSLT_NODE:                newNode = new(std::nothrow) BvsltNode(*reinterpret_cast<BvsltNode*>(node)); break;
-        case BVSMOD_NODE:               newNode = new(std::nothrow) BvsmodNode(*reinterpret_cast<BvsmodNode*>(node)); break;
-        case BVSREM_NODE:               newNode = new(std::nothrow) BvsremNode(*reinterpret_cast<BvsremNode*>(node)); break;
-        case BVSUB_NODE:                newNode = new(std::nothrow) BvsubNode(*reinterpret_cast<BvsubNode*>(node)); break;
-        case BVUDIV_NODE:               newNode = new(std::nothrow) BvudivNode(*reinterpret_cast<BvudivNode*>(node)); break;
-        case BVUGE_NODE:                newNode = new(std::nothrow) BvugeNode(*reinterpret_cast<BvugeNode*>(node)); break;
-        case BVUGT_NODE:                newNode = new(std::nothrow) BvugtNode(*reinterpret_cast<BvugtNode*>(node)); break;
-        case BVULE_NODE:                newNode = new(std::nothrow) BvuleNode(*reinterpret_cast<BvuleNode*>(node)); break;
-        case BVULT_NODE:                newNode = new(std::nothrow) BvultNode(*reinterpret_cast<BvultNode*>(node)); break;
-        case BVUREM_NODE:               newNode = new(std::nothrow) BvuremNode(*reinterpret_cast<BvuremNode*>(node)); break;
-        case BVXNOR_NODE:               newNode = new(std::nothrow) BvxnorNode(*reinterpret_cast<BvxnorNode*>(node)); break;
-        case BVXOR_NODE:                newNode = new(std::nothrow) BvxorNode(*reinterpret_cast<BvxorNode*>(node)); break;
-        case BV_NODE:                   newNode = new(std::nothrow) BvNode(*reinterpret_cast<BvNode*>(node)); break;
-        case CONCAT_NODE:               newNode = new(std::nothrow) ConcatNode(*reinterpret_cast<ConcatNode*>(node)); break;
-        case DECIMAL_NODE:              newNode = new(std::nothrow) DecimalNode(*reinterpret_cast<DecimalNode*>(node)); break;
-        case DISTINCT_NODE:             newNode = new(std::nothrow) DistinctNode(*reinterpret_cast<DistinctNode*>(node)); break;
-        case EQUAL_NODE:                newNode = new(std::nothrow) EqualNode(*reinterpret_cast<EqualNode*>(node)); break;
-        case EXTRACT_NODE:              newNode = new(std::nothrow) ExtractNode(*reinterpret_cast<ExtractNode*>(node)); break;
-        case ITE_NODE:                  newNode = new(std::nothrow) IteNode(*reinterpret_cast<IteNode*>(node)); break;
-        case LAND_NODE:                 newNode = new(std::nothrow) LandNode(*reinterpret_cast<LandNode*>(node)); break;
-        case LET_NODE:                  newNode = new(std::nothrow) LetNode(*reinterpret_cast<LetNode*>(node)); break;
-        case LNOT_NODE:                 newNode = new(std::nothrow) LnotNode(*reinterpret_cast<LnotNode*>(node)); break;
-        case LOR_NODE:                  newNode = new(std::nothrow) LorNode(*reinterpret_cast<LorNode*>(node)); break;
-        case REFERENCE_NODE:            newNode = new(std::nothrow) ReferenceNode(*reinterpret_cast<ReferenceNode*>(node)); break;
-        case STRING_NODE:               newNode = new(std::nothrow) StringNode(*reinterpret_cast<StringNode*>(node)); break;
-        case SX_NODE:                   newNode = new(std::nothrow) SxNode(*reinterpret_cast<SxNode*>(node)); break;
-        case VARIABLE_NODE:             newNode = new(std::nothrow) VariableNode(*reinterpret_cast<VariableNode*>(node)); break;
-        case ZX_NODE:                   newNode = new(std::nothrow) ZxNode(*reinterpret_cast<ZxNode*>(node)); break;
+        case BVADD_NODE:                newNode = new(node->getContext()) BvaddNode(*reinterpret_cast<BvaddNode*>(node)); break;
+        case BVAND_NODE:                newNode = new(node->getContext()) BvandNode(*reinterpret_cast<BvandNode*>(node)); break;
+        case BVASHR_NODE:               newNode = new(node->getContext()) BvashrNode(*reinterpret_cast<BvashrNode*>(node)); break;
+        case BVLSHR_NODE:               newNode = new(node->getContext()) BvlshrNode(*reinterpret_cast<BvlshrNode*>(node)); break;
+        case BVMUL_NODE:                newNode = new(node->getContext()) BvmulNode(*reinterpret_cast<BvmulNode*>(node)); break;
+        case BVNAND_NODE:               newNode = new(node->getContext()) BvnandNode(*reinterpret_cast<BvnandNode*>(node)); break;
+        case BVNEG_NODE:                newNode = new(node->getContext()) BvnegNode(*reinterpret_cast<BvnegNode*>(node)); break;
+        case BVNOR_NODE:                newNode = new(node->getContext()) BvnorNode(*reinterpret_cast<BvnorNode*>(node)); break;
+        case BVNOT_NODE:                newNode = new(node->getContext()) BvnotNode(*reinterpret_cast<BvnotNode*>(node)); break;
+        case BVOR_NODE:                 newNode = new(node->getContext()) BvorNode(*reinterpret_cast<BvorNode*>(node)); break;
+        case BVROL_NODE:                newNode = new(node->getContext()) BvrolNode(*reinterpret_cast<BvrolNode*>(node)); break;
+        case BVROR_NODE:                newNode = new(node->getContext()) BvrorNode(*reinterpret_cast<BvrorNode*>(node)); break;
+        case BVSDIV_NODE:               newNode = new(node->getContext()) BvsdivNode(*reinterpret_cast<BvsdivNode*>(node)); break;
+        case BVSGE_NODE:                newNode = new(node->getContext()) BvsgeNode(*reinterpret_cast<BvsgeNode*>(node)); break;
+        case BVSGT_NODE:                newNode = new(node->getContext()) BvsgtNode(*reinterpret_cast<BvsgtNode*>(node)); break;
+        case BVSHL_NODE:                newNode = new(node->getContext()) BvshlNode(*reinterpret_cast<BvshlNode*>(node)); break;
+        case BVSLE_NODE:                newNode = new(node->getContext()) BvsleNode(*reinterpret_cast<BvsleNode*>(node)); break;
+        case BVSLT_NODE:                newNode = new(node->getContext()) BvsltNode(*reinterpret_cast<BvsltNode*>(node)); break;
+        case BVSMOD_NODE:               newNode = new(node->getContext()) BvsmodNode(*reinterpret_cast<BvsmodNode*>(node)); break;
+        case BVSREM_NODE:               newNode = new(node->getContext()) BvsremNode(*reinterpret_cast<BvsremNode*>(node)); break;
+        case BVSUB_NODE:                newNode = new(node->getContext()) BvsubNode(*reinterpret_cast<BvsubNode*>(node)); break;
+        case BVUDIV_NODE:               newNode = new(node->getContext()) BvudivNode(*reinterpret_cast<BvudivNode*>(node)); break;
+        case BVUGE_NODE:                newNode = new(node->getContext()) BvugeNode(*reinterpret_cast<BvugeNode*>(node)); break;
+        case BVUGT_NODE:                newNode = new(node->getContext()) BvugtNode(*reinterpret_cast<BvugtNode*>(node)); break;
+        case BVULE_NODE:                newNode = new(node->getContext()) BvuleNode(*reinterpret_cast<BvuleNode*>(node)); break;
+        case BVULT_NODE:                newNode = new(node->getContext()) BvultNode(*reinterpret_cast<BvultNode*>(node)); break;
+        case BVUREM_NODE:               newNode = new(node->getContext()) BvuremNode(*reinterpret_cast<BvuremNode*>(node)); break;
+        case BVXNOR_NODE:               newNode = new(node->getContext()) BvxnorNode(*reinterpret_cast<BvxnorNode*>(node)); break;
+        case BVXOR_NODE:                newNode = new(node->getContext()) BvxorNode(*reinterpret_cast<BvxorNode*>(node)); break;
+        case BV_NODE:                   newNode = new(node->getContext()) BvNode(*reinterpret_cast<BvNode*>(node)); break;
+        case CONCAT_NODE:               newNode = new(node->getContext()) ConcatNode(*reinterpret_cast<ConcatNode*>(node)); break;
+        case DECIMAL_NODE:              newNode = new(node->getContext()) DecimalNode(*reinterpret_cast<DecimalNode*>(node)); break;
+        case DISTINCT_NODE:             newNode = new(node->getContext()) DistinctNode(*reinterpret_cast<DistinctNode*>(node)); break;
+        case EQUAL_NODE:                newNode = new(node->getContext()) EqualNode(*reinterpret_cast<EqualNode*>(node)); break;
+        case EXTRACT_NODE:              newNode = new(node->getContext()) ExtractNode(*reinterpret_cast<ExtractNode*>(node)); break;
+        case ITE_NODE:                  newNode = new(node->getContext()) IteNode(*reinterpret_cast<IteNode*>(node)); break;
+        case LAND_NODE:                 newNode = new(node->getContext()) LandNode(*reinterpret_cast<LandNode*>(node)); break;
+        case LET_NODE:                  newNode = new(node->getContext()) LetNode(*reinterpret_cast<LetNode*>(node)); break;
+        case LNOT_NODE:                 newNode = new(node->getContext()) LnotNode(*reinterpret_cast<LnotNode*>(node)); break;
+        case LOR_NODE:                  newNode = new(node->getContext()) LorNode(*reinterpret_cast<LorNode*>(node)); break;
+        case REFERENCE_NODE:            newNode = new(node->getContext()) ReferenceNode(*reinterpret_cast<ReferenceNode*>(node)); break;
+        case STRING_NODE:               newNode = new(node->getContext()) StringNode(*reinterpret_cast<StringNode*>(node)); break;
+        case SX_NODE:                   newNode = new(node->getContext()) SxNode(*reinterpret_cast<SxNode*>(node)); break;
+        case VARIABLE_NODE:             newNode = new(node->getContext()) VariableNode(*reinterpret_cast<VariableNode*>(node)); break;
+        case ZX_NODE:                   newNode = new(node->getContext()) ZxNode(*reinterpret_cast<ZxNode*>(node)); break;
         default:
           throw triton::exceptions::Ast("triton::ast::newInstance(): Invalid kind node.");
       }
@@ -2354,9 +2819,89 @@ namespace triton {
       if (newNode == nullptr)
         throw triton::exceptions::Ast("triton::ast::newInstance(): No enough memory.");
 
+      return newNode;
+    }
+
+
+    AbstractNode* newInstance(AbstractNode* node) {
+      if (node == nullptr)
+        return nullptr;
+
+      AbstractNode* newNode = copyNode(node);
+      return node->getContext().getAstGarbageCollector().recordAstNode(newNode);
+    }
+
+
+    AbstractNode* newInstance(AbstractNode* node, const std::vector<AbstractNode*>& children) {
+      if (node == nullptr)
+        return nullptr;
+
+      if (children.size() != node->getChildren().size())
+        throw triton::exceptions::Ast("triton::ast::newInstance(): Invalid number of children.");
+
+      AbstractNode* newNode = copyNode(node);
+      AstChildren& current  = newNode->getChildren();
+
+      /* The copy does not depend on the children of the original node anymore */
+      for (AbstractNode* child : current)
+        child->removeParent(newNode);
+
+      for (triton::uint32 index = 0; index < children.size(); index++) {
+        AbstractNode* old = current[index];
+        children[index]->retain();
+        current[index] = children[index];
+        old->release();
+      }
+
+      /* Sizes, values and parents are computed from the new children */
+      newNode->init();
+
       return node->getContext().getAstGarbageCollector().recordAstNode(newNode);
     }
 
+
+    void nodesExtraction(AbstractNode* root, std::vector<AbstractNode*>& nodes, bool postOrder, bool unroll) {
+      std::unordered_set<AbstractNode*> visited;
+      std::vector<std::pair<AbstractNode*, triton::uint32>> worklist;
+
+      nodes.clear();
+      if (root == nullptr)
+        return;
+
+      visited.insert(root);
+      worklist.emplace_back(root, 0);
+      if (!postOrder)
+        nodes.push_back(root);
+
+      while (!worklist.empty()) {
+        AbstractNode* node    = worklist.back().first;
+        triton::uint32 index  = worklist.back().second++;
+        AbstractNode* child   = nullptr;
+
+        /* The only child of a reference is the AST of its expression */
+        if (node->getKind() == REFERENCE_NODE) {
+          if (unroll && index == 0)
+            child = reinterpret_cast<ReferenceNode*>(node)->getSymbolicExpression().getAst();
+        }
+        else if (index < node->getChildren().size())
+          child = node->getChildren()[index];
+
+        /* All the children are visited */
+        if (child == nullptr) {
+          if (postOrder)
+            nodes.push_back(node);
+          worklist.pop_back();
+          continue;
+        }
+
+        if (visited.insert(child).second) {
+          if (!postOrder)
+            nodes.push_back(child);
+          worklist.emplace_back(child, 0);
+        }
+      }
+    }
+
   }; /* ast namespace */
 }; /* triton namespace */
 
@@ -0,0 +1,203 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <new>
+
+#include <triton/ast.hpp>
+#include <triton/astArena.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    /* Rounds a size up to the arena alignment */
+    static inline triton::usize alignSize(triton::usize size) {
+      return (size + AST_ARENA_ALIGNMENT - 1) & ~(AST_ARENA_ALIGNMENT - 1);
+    }
+
+
+    AstArena::AstArena() {
+      this->cursor        = nullptr;
+      this->end           = nullptr;
+      this->head          = nullptr;
+      this->tail          = nullptr;
+      this->sequence      = 0;
+      this->allocations   = 0;
+      this->deallocations = 0;
+      this->liveNodes     = 0;
+      this->liveBytes     = 0;
+      this->lifetime      = std::make_shared<bool>(true);
+    }
+
+
+    AstArena::~AstArena() {
+      this->clear();
+    }
+
+
+    triton::usize AstArena::getHeaderSize(void) {
+      return alignSize(sizeof(Header));
+    }
+
+
+    void* AstArena::allocate(triton::usize size) {
+      triton::usize total     = AstArena::getHeaderSize() + alignSize(size);
+      triton::usize sizeClass = total / AST_ARENA_ALIGNMENT;
+      Header* header          = nullptr;
+
+      if (total > AST_ARENA_SLAB_SIZE)
+        return nullptr;
+
+      /* Reuse a free block of the same size class */
+      if (sizeClass < this->freeLists.size() && this->freeLists[sizeClass] != nullptr) {
+        header = this->freeLists[sizeClass];
+        this->freeLists[sizeClass] = header->next;
+      }
+
+      /* Otherwise bump the current slab */
+      else {
+        if (this->cursor == nullptr || static_cast<triton::usize>(this->end - this->cursor) < total) {
+          triton::uint8* slab = new(std::nothrow) triton::uint8[AST_ARENA_SLAB_SIZE];
+          if (slab == nullptr)
+            return nullptr;
+          this->slabs.push_back(slab);
+          this->cursor = slab;
+          this->end    = slab + AST_ARENA_SLAB_SIZE;
+        }
+        header = reinterpret_cast<Header*>(this->cursor);
+        this->cursor += total;
+      }
+
+      header->arena     = this;
+      header->sequence  = this->sequence++;
+      header->sizeClass = sizeClass;
+
+      /* Link the block at the end of the live list */
+      header->prev = this->tail;
+      header->next = nullptr;
+      if (this->tail != nullptr)
+        this->tail->next = header;
+      else
+        this->head = header;
+      this->tail = header;
+
+      this->allocations++;
+      this->liveNodes++;
+      this->liveBytes += total;
+
+      return reinterpret_cast<triton::uint8*>(header) + AstArena::getHeaderSize();
+    }
+
+
+    void AstArena::release(void* ptr) {
+      if (ptr == nullptr)
+        return;
+
+      Header* header = reinterpret_cast<Header*>(reinterpret_cast<triton::uint8*>(ptr) - AstArena::getHeaderSize());
+      header->arena->deallocate(header);
+    }
+
+
+    void AstArena::deallocate(Header* header) {
+      /* Unlink the block from the live list */
+      if (header->prev != nullptr)
+        header->prev->next = header->next;
+      else
+        this->head = header->next;
+
+      if (header->next != nullptr)
+        header->next->prev = header->prev;
+      else
+        this->tail = header->prev;
+
+      /* Put it into its free list */
+      if (header->sizeClass >= this->freeLists.size())
+        this->freeLists.resize(header->sizeClass + 1, nullptr);
+
+      header->prev = nullptr;
+      header->next = this->freeLists[header->sizeClass];
+      this->freeLists[header->sizeClass] = header;
+
+      this->deallocations++;
+      this->liveNodes--;
+      this->liveBytes -= header->sizeClass * AST_ARENA_ALIGNMENT;
+    }
+
+
+    triton::usize AstArena::getAllocationNumber(const void* ptr) {
+      const Header* header = reinterpret_cast<const Header*>(reinterpret_cast<const triton::uint8*>(ptr) - AstArena::getHeaderSize());
+      return header->sequence;
+    }
+
+
+    triton::usize AstArena::getSequence(void) const {
+      return this->sequence;
+    }
+
+
+    void AstArena::clear(void) {
+      /* Destroy the live nodes, their memory goes away with the slabs */
+      for (Header* header = this->head; header != nullptr;) {
+        Header* next = header->next;
+        reinterpret_cast<triton::ast::AbstractNode*>(reinterpret_cast<triton::uint8*>(header) + AstArena::getHeaderSize())->~AbstractNode();
+        header = next;
+      }
+
+      for (auto it = this->slabs.begin(); it != this->slabs.end(); it++)
+        delete[] *it;
+
+      this->deallocations += this->liveNodes;
+      this->slabs.clear();
+      this->freeLists.clear();
+      this->cursor    = nullptr;
+      this->end       = nullptr;
+      this->head      = nullptr;
+      this->tail      = nullptr;
+      this->liveNodes = 0;
+      this->liveBytes = 0;
+      this->lifetime  = std::make_shared<bool>(true);
+    }
+
+
+    std::weak_ptr<bool> AstArena::getLifetime(void) const {
+      return this->lifetime;
+    }
+
+
+    std::vector<triton::ast::AbstractNode*> AstArena::getLiveNodes(triton::usize sequence) const {
+      std::vector<triton::ast::AbstractNode*> nodes;
+      Header* header = this->tail;
+
+      /* The live list is sorted by allocation number */
+      while (header != nullptr && header->prev != nullptr && header->prev->sequence >= sequence)
+        header = header->prev;
+
+      for (; header != nullptr; header = header->next) {
+        if (header->sequence >= sequence)
+          nodes.push_back(reinterpret_cast<triton::ast::AbstractNode*>(reinterpret_cast<triton::uint8*>(header) + AstArena::getHeaderSize()));
+      }
+
+      return nodes;
+    }
+
+
+    std::map<std::string, triton::usize> AstArena::getStats(void) const {
+      std::map<std::string, triton::usize> stats;
+
+      stats["allocations"]    = this->allocations;
+      stats["deallocations"]  = this->deallocations;
+      stats["liveNodes"]      = this->liveNodes;
+      stats["liveBytes"]      = this->liveBytes;
+      stats["slabs"]          = this->slabs.size();
+      stats["slabBytes"]      = this->slabs.size() * AST_ARENA_SLAB_SIZE;
+
+      return stats;
+    }
+
+  }; /* ast namespace */
+}; /* triton namespace */
@@ -8,6 +8,8 @@
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/symbolicVariable.hpp>
 
 
 
@@ -15,18 +17,22 @@ namespace triton {
   namespace ast {
 
     AstContext::AstContext(const AstContext& other)
-      : astGarbageCollector(other.astGarbageCollector),
+      : astGarbageCollector(other.modes, this->arena),
         astRepresentation(other.astRepresentation),
-        valueMapping(other.valueMapping) {
+        valueMapping(other.valueMapping),
+        modes(other.modes) {
     }
 
 
     AstContext::AstContext(const triton::modes::Modes& modes)
-      : astGarbageCollector(modes) {
+      : astGarbageCollector(modes, this->arena),
+        modes(modes) {
     }
 
 
     AstContext& AstContext::operator=(const AstContext& other) {
+      /* Nodes belong to the arena of the context which built them, release ours */
+      this->astGarbageCollector.freeAllAstNodes();
       this->astGarbageCollector = other.astGarbageCollector;
       this->astRepresentation = other.astRepresentation;
       this->valueMapping = other.valueMapping;
@@ -34,8 +40,55 @@ namespace triton {
     }
 
 
+    AbstractNode* AstContext::lookupAstNode(triton::uint32 kind, std::initializer_list<AbstractNode*> children) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupAstNode(kind, children);
+    }
+
+
+    template <typename T>
+    AbstractNode* AstContext::lookupAstNode(triton::uint32 kind, const T& children) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupAstNode(kind, children);
+    }
+
+
+    AbstractNode* AstContext::lookupDecimalNode(const triton::uint512& value) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupDecimalNode(value);
+    }
+
+
+    AbstractNode* AstContext::lookupReferenceNode(triton::usize id) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupReferenceNode(id);
+    }
+
+
+    AbstractNode* AstContext::lookupStringNode(const std::string& value) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupStringNode(value);
+    }
+
+
+    AbstractNode* AstContext::lookupVariableNode(const std::string& name) {
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES) == false)
+        return nullptr;
+      return this->astGarbageCollector.lookupVariableNode(name);
+    }
+
+
     AbstractNode* AstContext::bv(triton::uint512 value, triton::uint32 size) {
-      AbstractNode* node = new(std::nothrow) BvNode(value, size, *this);
+      AbstractNode* node = this->lookupAstNode(BV_NODE, {this->lookupDecimalNode(value), this->lookupDecimalNode(size)});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvNode(value, size, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -43,7 +96,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvadd(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvaddNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVADD_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvaddNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -51,7 +108,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvand(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvandNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVAND_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvandNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -59,7 +120,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvashr(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvashrNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVASHR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvashrNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -67,7 +132,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvfalse(void) {
-      AbstractNode* node = new(std::nothrow) BvNode(0, 1, *this);
+      AbstractNode* node = this->lookupAstNode(BV_NODE, {this->lookupDecimalNode(0), this->lookupDecimalNode(1)});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvNode(0, 1, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -75,7 +144,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvlshr(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvlshrNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVLSHR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvlshrNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -83,7 +156,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvmul(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvmulNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVMUL_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvmulNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -91,7 +168,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvnand(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvnandNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVNAND_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvnandNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -99,7 +180,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvneg(AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvnegNode(expr);
+      AbstractNode* node = this->lookupAstNode(BVNEG_NODE, {expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvnegNode(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -107,7 +192,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvnor(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvnorNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVNOR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvnorNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -115,7 +204,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvnot(AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvnotNode(expr);
+      AbstractNode* node = this->lookupAstNode(BVNOT_NODE, {expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvnotNode(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -123,7 +216,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvor(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvorNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVOR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvorNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -131,7 +228,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvrol(triton::uint32 rot, AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvrolNode(rot, expr);
+      AbstractNode* node = this->lookupAstNode(BVROL_NODE, {this->lookupDecimalNode(rot), expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvrolNode(rot, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -139,7 +240,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvrol(AbstractNode* rot, AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvrolNode(rot, expr);
+      AbstractNode* node = this->lookupAstNode(BVROL_NODE, {rot, expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvrolNode(rot, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -147,7 +252,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvror(triton::uint32 rot, AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvrorNode(rot, expr);
+      AbstractNode* node = this->lookupAstNode(BVROR_NODE, {this->lookupDecimalNode(rot), expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvrorNode(rot, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -155,7 +264,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvror(AbstractNode* rot, AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) BvrorNode(rot, expr);
+      AbstractNode* node = this->lookupAstNode(BVROR_NODE, {rot, expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvrorNode(rot, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -163,7 +276,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsdiv(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsdivNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSDIV_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsdivNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -171,7 +288,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsge(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsgeNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSGE_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsgeNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -179,7 +300,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsgt(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsgtNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSGT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsgtNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -187,7 +312,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvshl(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvshlNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSHL_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvshlNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -195,7 +324,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsle(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsleNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSLE_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsleNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -203,7 +336,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvslt(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsltNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSLT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsltNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -211,7 +348,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsmod(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsmodNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSMOD_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsmodNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -219,7 +360,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsrem(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsremNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSREM_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsremNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -227,7 +372,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvsub(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvsubNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVSUB_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvsubNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -235,7 +384,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvtrue(void) {
-      AbstractNode* node = new(std::nothrow) BvNode(1, 1, *this);
+      AbstractNode* node = this->lookupAstNode(BV_NODE, {this->lookupDecimalNode(1), this->lookupDecimalNode(1)});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvNode(1, 1, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -243,7 +396,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvudiv(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvudivNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVUDIV_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvudivNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -251,7 +408,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvuge(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvugeNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVUGE_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvugeNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -259,7 +420,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvugt(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvugtNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVUGT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvugtNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -267,7 +432,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvule(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvuleNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVULE_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvuleNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -275,7 +444,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvult(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvultNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVULT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvultNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -283,7 +456,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvurem(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvuremNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVUREM_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvuremNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -291,7 +468,11 @@ namespace triton {
 
 
      AbstractNode* AstContext::bvxnor(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvxnorNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVXNOR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvxnorNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -299,7 +480,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::bvxor(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) BvxorNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(BVXOR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) BvxorNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -307,7 +492,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::concat(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) ConcatNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(CONCAT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) ConcatNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -318,7 +507,11 @@ namespace triton {
     template TRITON_EXPORT AbstractNode* AstContext::concat(const std::list<AbstractNode*>& exprs);
     template <typename T>
     AbstractNode* AstContext::concat(const T& exprs) {
-      AbstractNode* node = new(std::nothrow) ConcatNode(exprs, *this);
+      AbstractNode* node = this->lookupAstNode(CONCAT_NODE, exprs);
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) ConcatNode(exprs, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -326,7 +519,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::decimal(triton::uint512 value) {
-      AbstractNode* node = new(std::nothrow) DecimalNode(value, *this);
+      AbstractNode* node = this->lookupDecimalNode(value);
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) DecimalNode(value, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -334,7 +531,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::distinct(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) DistinctNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(DISTINCT_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) DistinctNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -342,7 +543,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::equal(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) EqualNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(EQUAL_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) EqualNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -354,7 +559,11 @@ namespace triton {
       if (low == 0 && (high + 1) == expr->getBitvectorSize())
         return expr;
 
-      AbstractNode* node = new(std::nothrow) ExtractNode(high, low, expr);
+      AbstractNode* node = this->lookupAstNode(EXTRACT_NODE, {this->lookupDecimalNode(high), this->lookupDecimalNode(low), expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) ExtractNode(high, low, expr);
 
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -364,7 +573,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::ite(AbstractNode* ifExpr, AbstractNode* thenExpr, AbstractNode* elseExpr) {
-      AbstractNode* node = new(std::nothrow) IteNode(ifExpr, thenExpr, elseExpr);
+      AbstractNode* node = this->lookupAstNode(ITE_NODE, {ifExpr, thenExpr, elseExpr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) IteNode(ifExpr, thenExpr, elseExpr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -372,7 +585,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::land(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) LandNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(LAND_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LandNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -383,7 +600,11 @@ namespace triton {
     template TRITON_EXPORT AbstractNode* AstContext::land(const std::list<AbstractNode*>& exprs);
     template <typename T>
     AbstractNode* AstContext::land(const T& exprs) {
-      AbstractNode* node = new(std::nothrow) LandNode(exprs, *this);
+      AbstractNode* node = this->lookupAstNode(LAND_NODE, exprs);
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LandNode(exprs, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -391,7 +612,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::let(std::string alias, AbstractNode* expr2, AbstractNode* expr3) {
-      AbstractNode* node = new(std::nothrow) LetNode(alias, expr2, expr3);
+      AbstractNode* node = this->lookupAstNode(LET_NODE, {this->lookupStringNode(alias), expr2, expr3});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LetNode(alias, expr2, expr3);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -399,7 +624,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::lnot(AbstractNode* expr) {
-      AbstractNode* node = new(std::nothrow) LnotNode(expr);
+      AbstractNode* node = this->lookupAstNode(LNOT_NODE, {expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LnotNode(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -407,7 +636,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::lor(AbstractNode* expr1, AbstractNode* expr2) {
-      AbstractNode* node = new(std::nothrow) LorNode(expr1, expr2);
+      AbstractNode* node = this->lookupAstNode(LOR_NODE, {expr1, expr2});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LorNode(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -418,7 +651,11 @@ namespace triton {
     template TRITON_EXPORT AbstractNode* AstContext::lor(const std::list<AbstractNode*>& exprs);
     template <typename T>
     AbstractNode* AstContext::lor(const T& exprs) {
-      AbstractNode* node = new(std::nothrow) LorNode(exprs, *this);
+      AbstractNode* node = this->lookupAstNode(LOR_NODE, exprs);
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) LorNode(exprs, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -426,7 +663,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::reference(triton::engines::symbolic::SymbolicExpression& expr) {
-      AbstractNode* node = new(std::nothrow) ReferenceNode(expr);
+      AbstractNode* node = this->lookupReferenceNode(expr.getId());
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) ReferenceNode(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -434,7 +675,11 @@ namespace triton {
 
 
     AbstractNode* AstContext::string(std::string value) {
-      AbstractNode* node = new(std::nothrow) StringNode(value, *this);
+      AbstractNode* node = this->lookupStringNode(value);
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) StringNode(value, *this);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
       return this->astGarbageCollector.recordAstNode(node);
@@ -446,7 +691,11 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
-      AbstractNode* node = new(std::nothrow) SxNode(sizeExt, expr);
+      AbstractNode* node = this->lookupAstNode(SX_NODE, {this->lookupDecimalNode(sizeExt), expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) SxNode(sizeExt, expr);
 
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -457,7 +706,11 @@ namespace triton {
 
     AbstractNode* AstContext::variable(triton::engines::symbolic::SymbolicVariable& symVar) {
       AbstractNode* ret  = nullptr;
-      AbstractNode* node = new(std::nothrow) VariableNode(symVar, *this);
+      AbstractNode* node = this->lookupVariableNode(symVar.getName());
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) VariableNode(symVar, *this);
 
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -474,7 +727,11 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
-      AbstractNode* node = new(std::nothrow) ZxNode(sizeExt, expr);
+      AbstractNode* node = this->lookupAstNode(ZX_NODE, {this->lookupDecimalNode(sizeExt), expr});
+      if (node != nullptr)
+        return node;
+
+      node = new(*this) ZxNode(sizeExt, expr);
 
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -493,6 +750,16 @@ namespace triton {
     }
 
 
+    triton::ast::AstArena& AstContext::getAstArena(void) {
+      return this->arena;
+    }
+
+
+    const triton::ast::AstArena& AstContext::getAstArena(void) const {
+      return this->arena;
+    }
+
+
     void AstContext::initVariable(const std::string& name, const triton::uint512& value) {
       auto it = this->valueMapping.find(name);
       if (it == this->valueMapping.end())
@@ -5,6 +5,11 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <utility>
+
 #include <triton/astDictionaries.hpp>
 #include <triton/symbolicExpression.hpp>
 #include <triton/symbolicVariable.hpp>
@@ -14,11 +19,114 @@
 namespace triton {
   namespace ast {
 
-    AstDictionaries::AstDictionaries(bool isBackup) {
-      this->allocatedNodes  = 0;
-      this->backupFlag      = isBackup;
+    /* Names of the dictionaries returned by getAstDictionariesStats() */
+    static const std::pair<triton::uint32, const char*> dictionariesNames[] = {
+      {triton::ast::BVADD_NODE,     "bvadd"},
+      {triton::ast::BVAND_NODE,     "bvand"},
+      {triton::ast::BVASHR_NODE,    "bvashr"},
+      {triton::ast::BVLSHR_NODE,    "bvlshr"},
+      {triton::ast::BVMUL_NODE,     "bvmul"},
+      {triton::ast::BVNAND_NODE,    "bvnand"},
+      {triton::ast::BVNEG_NODE,     "bvneg"},
+      {triton::ast::BVNOR_NODE,     "bvnor"},
+      {triton::ast::BVNOT_NODE,     "bvnot"},
+      {triton::ast::BVOR_NODE,      "bvor"},
+      {triton::ast::BVROL_NODE,     "bvrol"},
+      {triton::ast::BVROR_NODE,     "bvror"},
+      {triton::ast::BVSDIV_NODE,    "bvsdiv"},
+      {triton::ast::BVSGE_NODE,     "bvsge"},
+      {triton::ast::BVSGT_NODE,     "bvsgt"},
+      {triton::ast::BVSHL_NODE,     "bvshl"},
+      {triton::ast::BVSLE_NODE,     "bvsle"},
+      {triton::ast::BVSLT_NODE,     "bvslt"},
+      {triton::ast::BVSMOD_NODE,    "bvsmod"},
+      {triton::ast::BVSREM_NODE,    "bvsrem"},
+      {triton::ast::BVSUB_NODE,     "bvsub"},
+      {triton::ast::BVUDIV_NODE,    "bvudiv"},
+      {triton::ast::BVUGE_NODE,     "bvuge"},
+      {triton::ast::BVUGT_NODE,     "bvugt"},
+      {triton::ast::BVULE_NODE,     "bvule"},
+      {triton::ast::BVULT_NODE,     "bvult"},
+      {triton::ast::BVUREM_NODE,    "bvurem"},
+      {triton::ast::BVXNOR_NODE,    "bvxnor"},
+      {triton::ast::BVXOR_NODE,     "bvxor"},
+      {triton::ast::BV_NODE,        "bv"},
+      {triton::ast::CONCAT_NODE,    "concat"},
+      {triton::ast::DECIMAL_NODE,   "decimal"},
+      {triton::ast::DISTINCT_NODE,  "distinct"},
+      {triton::ast::EQUAL_NODE,     "equal"},
+      {triton::ast::EXTRACT_NODE,   "extract"},
+      {triton::ast::ITE_NODE,       "ite"},
+      {triton::ast::LAND_NODE,      "land"},
+      {triton::ast::LET_NODE,       "let"},
+      {triton::ast::LNOT_NODE,      "lnot"},
+      {triton::ast::LOR_NODE,       "lor"},
+      {triton::ast::REFERENCE_NODE, "reference"},
+      {triton::ast::STRING_NODE,    "string"},
+      {triton::ast::SX_NODE,        "sx"},
+      {triton::ast::VARIABLE_NODE,  "variable"},
+      {triton::ast::ZX_NODE,        "zx"},
+    };
+
+
+    /* Mixes a value into a hash (boost::hash_combine) */
+    static inline void hashCombine(triton::usize& seed, triton::usize value) {
+      seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+
+    /* Returns the hash of a node identified by its children */
+    template <typename T>
+    static inline triton::usize hashChildren(triton::uint32 kind, const T& children) {
+      triton::usize hash = kind;
+      for (triton::ast::AbstractNode* child : children)
+        hashCombine(hash, reinterpret_cast<triton::usize>(child));
+      return hash;
+    }
+
+
+    /* Returns the hash of a decimal node */
+    static inline triton::usize hashDecimal(triton::uint512 value) {
+      triton::usize hash = triton::ast::DECIMAL_NODE;
+      while (value) {
+        hashCombine(hash, static_cast<triton::usize>(value.convert_to<triton::uint64>()));
+        value >>= 64;
+      }
+      return hash;
+    }
+
+
+    /* Returns the hash of a node identified by a name */
+    static inline triton::usize hashString(triton::uint32 kind, const std::string& value) {
+      triton::usize hash = kind;
+      hashCombine(hash, std::hash<std::string>()(value));
+      return hash;
+    }
 
-      this->linkDictionaries();
+
+    /* Returns the hash of a node identified by an id */
+    static inline triton::usize hashId(triton::uint32 kind, triton::usize id) {
+      triton::usize hash = kind;
+      hashCombine(hash, id);
+      return hash;
+    }
+
+
+    /* Returns true if `node` has exactly these children */
+    template <typename T>
+    static inline bool hasChildren(triton::ast::AbstractNode* node, const T& children) {
+      const triton::ast::AstChildren& nodeChildren = node->getChildren();
+      return nodeChildren.size() == children.size() && std::equal(children.begin(), children.end(), nodeChildren.begin());
+    }
+
+
+    AstDictionaries::AstDictionaries() {
+      this->allocatedNodes  = 0;
+      this->tableCount      = 0;
+      this->lookups         = 0;
+      this->probes          = 0;
+      this->maxProbeLength  = 0;
+      this->hits            = 0;
     }
 
 
@@ -28,10 +136,6 @@ namespace triton {
 
 
     AstDictionaries::~AstDictionaries() {
-      if (this->backupFlag == false) {
-        for (auto it = this->allocatedDictionaries.begin(); it != this->allocatedDictionaries.end(); it++)
-          delete *it;
-      }
     }
 
 
@@ -42,231 +146,250 @@ namespace triton {
 
 
     void AstDictionaries::copy(const AstDictionaries& other) {
-      /* Global information */
-      this->allocatedNodes              = other.allocatedNodes;
-      this->allocatedDictionaries       = other.allocatedDictionaries;
-      this->backupFlag                  = true;
-
-      /* Dictionnaries */
-      this->bvaddDictionary             = other.bvaddDictionary;
-      this->bvandDictionary             = other.bvandDictionary;
-      this->bvashrDictionary            = other.bvashrDictionary;
-      this->bvlshrDictionary            = other.bvlshrDictionary;
-      this->bvmulDictionary             = other.bvmulDictionary;
-      this->bvnandDictionary            = other.bvnandDictionary;
-      this->bvnegDictionary             = other.bvnegDictionary;
-      this->bvnorDictionary             = other.bvnorDictionary;
-      this->bvnotDictionary             = other.bvnotDictionary;
-      this->bvorDictionary              = other.bvorDictionary;
-      this->bvrolDictionary             = other.bvrolDictionary;
-      this->bvrorDictionary             = other.bvrorDictionary;
-      this->bvsdivDictionary            = other.bvsdivDictionary;
-      this->bvsgeDictionary             = other.bvsgeDictionary;
-      this->bvsgtDictionary             = other.bvsgtDictionary;
-      this->bvshlDictionary             = other.bvshlDictionary;
-      this->bvsleDictionary             = other.bvsleDictionary;
-      this->bvsltDictionary             = other.bvsltDictionary;
-      this->bvsmodDictionary            = other.bvsmodDictionary;
-      this->bvsremDictionary            = other.bvsremDictionary;
-      this->bvsubDictionary             = other.bvsubDictionary;
-      this->bvudivDictionary            = other.bvudivDictionary;
-      this->bvugeDictionary             = other.bvugeDictionary;
-      this->bvugtDictionary             = other.bvugtDictionary;
-      this->bvuleDictionary             = other.bvuleDictionary;
-      this->bvultDictionary             = other.bvultDictionary;
-      this->bvuremDictionary            = other.bvuremDictionary;
-      this->bvxnorDictionary            = other.bvxnorDictionary;
-      this->bvxorDictionary             = other.bvxorDictionary;
-      this->bvDictionary                = other.bvDictionary;
-      this->concatDictionary            = other.concatDictionary;
-      this->decimalDictionary           = other.decimalDictionary;
-      this->distinctDictionary          = other.distinctDictionary;
-      this->equalDictionary             = other.equalDictionary;
-      this->extractDictionary           = other.extractDictionary;
-      this->iteDictionary               = other.iteDictionary;
-      this->landDictionary              = other.landDictionary;
-      this->letDictionary               = other.letDictionary;
-      this->lnotDictionary              = other.lnotDictionary;
-      this->lorDictionary               = other.lorDictionary;
-      this->referenceDictionary         = other.referenceDictionary;
-      this->stringDictionary            = other.stringDictionary;
-      this->sxDictionary                = other.sxDictionary;
-      this->variableDictionary          = other.variableDictionary;
-      this->zxDictionary                = other.zxDictionary;
-
-      this->linkDictionaries();
+      this->allocatedNodes  = other.allocatedNodes;
+      this->table           = other.table;
+      this->tableCount      = other.tableCount;
+      this->kindCount       = other.kindCount;
+      this->lookups         = other.lookups;
+      this->probes          = other.probes;
+      this->maxProbeLength  = other.maxProbeLength;
+      this->hits            = other.hits;
+    }
+
+
+    triton::usize AstDictionaries::hashNode(triton::ast::AbstractNode* node) const {
+      switch (node->getKind()) {
+        case triton::ast::DECIMAL_NODE:
+          return hashDecimal(reinterpret_cast<triton::ast::DecimalNode*>(node)->getValue());
+
+        case triton::ast::REFERENCE_NODE:
+          return hashId(triton::ast::REFERENCE_NODE, reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression().getId());
+
+        case triton::ast::STRING_NODE:
+          return hashString(triton::ast::STRING_NODE, reinterpret_cast<triton::ast::StringNode*>(node)->getValue());
+
+        case triton::ast::VARIABLE_NODE:
+          return hashString(triton::ast::VARIABLE_NODE, reinterpret_cast<triton::ast::VariableNode*>(node)->getVar().getName());
+
+        default:
+          return hashChildren(node->getKind(), node->getChildren());
+      }
     }
 
 
-    void AstDictionaries::linkDictionaries(void) {
-      this->dictionaries[triton::ast::BVADD_NODE]              = &this->bvaddDictionary;
-      this->dictionaries[triton::ast::BVAND_NODE]              = &this->bvandDictionary;
-      this->dictionaries[triton::ast::BVASHR_NODE]             = &this->bvashrDictionary;
-      this->dictionaries[triton::ast::BVLSHR_NODE]             = &this->bvlshrDictionary;
-      this->dictionaries[triton::ast::BVMUL_NODE]              = &this->bvmulDictionary;
-      this->dictionaries[triton::ast::BVNAND_NODE]             = &this->bvnandDictionary;
-      this->dictionaries[triton::ast::BVNEG_NODE]              = &this->bvnegDictionary;
-      this->dictionaries[triton::ast::BVNOR_NODE]              = &this->bvnorDictionary;
-      this->dictionaries[triton::ast::BVNOT_NODE]              = &this->bvnotDictionary;
-      this->dictionaries[triton::ast::BVOR_NODE]               = &this->bvorDictionary;
-      this->dictionaries[triton::ast::BVROL_NODE]              = &this->bvrolDictionary;
-      this->dictionaries[triton::ast::BVROR_NODE]              = &this->bvrorDictionary;
-      this->dictionaries[triton::ast::BVSDIV_NODE]             = &this->bvsdivDictionary;
-      this->dictionaries[triton::ast::BVSGE_NODE]              = &this->bvsgeDictionary;
-      this->dictionaries[triton::ast::BVSGT_NODE]              = &this->bvsgtDictionary;
-      this->dictionaries[triton::ast::BVSHL_NODE]              = &this->bvshlDictionary;
-      this->dictionaries[triton::ast::BVSLE_NODE]              = &this->bvsleDictionary;
-      this->dictionaries[triton::ast::BVSLT_NODE]              = &this->bvsltDictionary;
-      this->dictionaries[triton::ast::BVSMOD_NODE]             = &this->bvsmodDictionary;
-      this->dictionaries[triton::ast::BVSREM_NODE]             = &this->bvsremDictionary;
-      this->dictionaries[triton::ast::BVSUB_NODE]              = &this->bvsubDictionary;
-      this->dictionaries[triton::ast::BVUDIV_NODE]             = &this->bvudivDictionary;
-      this->dictionaries[triton::ast::BVUGE_NODE]              = &this->bvugeDictionary;
-      this->dictionaries[triton::ast::BVUGT_NODE]              = &this->bvugtDictionary;
-      this->dictionaries[triton::ast::BVULE_NODE]              = &this->bvuleDictionary;
-      this->dictionaries[triton::ast::BVULT_NODE]              = &this->bvultDictionary;
-      this->dictionaries[triton::ast::BVUREM_NODE]             = &this->bvuremDictionary;
-      this->dictionaries[triton::ast::BVXNOR_NODE]             = &this->bvxnorDictionary;
-      this->dictionaries[triton::ast::BVXOR_NODE]              = &this->bvxorDictionary;
-      this->dictionaries[triton::ast::BV_NODE]                 = &this->bvDictionary;
-      this->dictionaries[triton::ast::CONCAT_NODE]             = &this->concatDictionary;
-      this->dictionaries[triton::ast::DECIMAL_NODE]            = &this->decimalDictionary;
-      this->dictionaries[triton::ast::DISTINCT_NODE]           = &this->distinctDictionary;
-      this->dictionaries[triton::ast::EQUAL_NODE]              = &this->equalDictionary;
-      this->dictionaries[triton::ast::EXTRACT_NODE]            = &this->extractDictionary;
-      this->dictionaries[triton::ast::ITE_NODE]                = &this->iteDictionary;
-      this->dictionaries[triton::ast::LAND_NODE]               = &this->landDictionary;
-      this->dictionaries[triton::ast::LET_NODE]                = &this->letDictionary;
-      this->dictionaries[triton::ast::LNOT_NODE]               = &this->lnotDictionary;
-      this->dictionaries[triton::ast::LOR_NODE]                = &this->lorDictionary;
-      this->dictionaries[triton::ast::REFERENCE_NODE]          = &this->referenceDictionary;
-      this->dictionaries[triton::ast::STRING_NODE]             = &this->stringDictionary;
-      this->dictionaries[triton::ast::SX_NODE]                 = &this->sxDictionary;
-      this->dictionaries[triton::ast::VARIABLE_NODE]           = &this->variableDictionary;
-      this->dictionaries[triton::ast::ZX_NODE]                 = &this->zxDictionary;
+    bool AstDictionaries::isSameNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const {
+      if (node1->getKind() != node2->getKind())
+        return false;
+
+      switch (node1->getKind()) {
+        case triton::ast::DECIMAL_NODE:
+          return reinterpret_cast<triton::ast::DecimalNode*>(node1)->getValue() == reinterpret_cast<triton::ast::DecimalNode*>(node2)->getValue();
+
+        case triton::ast::REFERENCE_NODE:
+          return reinterpret_cast<triton::ast::ReferenceNode*>(node1)->getSymbolicExpression().getId() == reinterpret_cast<triton::ast::ReferenceNode*>(node2)->getSymbolicExpression().getId();
+
+        case triton::ast::STRING_NODE:
+          return reinterpret_cast<triton::ast::StringNode*>(node1)->getValue() == reinterpret_cast<triton::ast::StringNode*>(node2)->getValue();
+
+        case triton::ast::VARIABLE_NODE:
+          return reinterpret_cast<triton::ast::VariableNode*>(node1)->getVar().getName() == reinterpret_cast<triton::ast::VariableNode*>(node2)->getVar().getName();
+
+        default:
+          return node1->getChildren() == node2->getChildren();
+      }
     }
 
 
-    triton::ast::AbstractNode* AstDictionaries::browseAstDictionaries(triton::ast::AbstractNode* node) {
-      this->allocatedNodes++;
-      triton::uint32 kind = node->getKind();
-
-      switch (kind) {
-
-        case triton::ast::DECIMAL_NODE: {
-          auto value       = static_cast<triton::ast::DecimalNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<triton::uint512, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
-        }
+    template <typename Match>
+    triton::usize AstDictionaries::findSlot(triton::usize hash, const Match& match) {
+      triton::usize mask   = this->table.size() - 1;
+      triton::usize index  = hash & mask;
+      triton::usize length = 1;
 
-        case triton::ast::REFERENCE_NODE: {
-          auto value       = static_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression().getId();
-          auto dictionary  = static_cast<std::map<triton::usize, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
+      /* The table is never full, so an empty slot is always reached */
+      while (this->table[index].node != nullptr) {
+        const Slot& slot = this->table[index];
+        if (slot.hash == hash && match(slot.node))
           break;
-        }
+        index = (index + 1) & mask;
+        length++;
+      }
 
-        case triton::ast::STRING_NODE: {
-          auto value       = static_cast<triton::ast::StringNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<std::string, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
-        }
+      this->lookups++;
+      this->probes += length;
+      if (length > this->maxProbeLength)
+        this->maxProbeLength = length;
 
-        case triton::ast::VARIABLE_NODE: {
-          auto value       = static_cast<triton::ast::VariableNode*>(node)->getVar().getName();
-          auto dictionary  = static_cast<std::map<std::string, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
-        }
+      return index;
+    }
 
-        default: {
-          auto value       = node->getChildren();
-          auto dictionary  = static_cast<std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
+
+    template <typename Match>
+    triton::ast::AbstractNode* AstDictionaries::lookup(triton::usize hash, const Match& match) {
+      if (this->table.empty())
+        return nullptr;
+
+      triton::ast::AbstractNode* node = this->table[this->findSlot(hash, match)].node;
+      if (node != nullptr)
+        this->hits++;
+
+      return node;
+    }
+
+
+    void AstDictionaries::grow(void) {
+      std::vector<Slot> old;
+      triton::usize size = this->table.empty() ? AST_DICTIONARIES_INITIAL_SIZE : (this->table.size() << 1);
+
+      old.swap(this->table);
+      this->table.resize(size);
+
+      /* Nodes are unique, just find the first empty slot of each one */
+      for (const Slot& slot : old) {
+        if (slot.node == nullptr)
+          continue;
+        triton::usize index = slot.hash & (size - 1);
+        while (this->table[index].node != nullptr)
+          index = (index + 1) & (size - 1);
+        this->table[index] = slot;
+      }
+    }
+
+
+    void AstDictionaries::clearAstDictionaries(void) {
+      this->table.clear();
+      this->kindCount.clear();
+      this->tableCount = 0;
+    }
+
+
+    void AstDictionaries::removeAstNode(triton::ast::AbstractNode* node) {
+      if (this->table.empty())
+        return;
+
+      triton::usize mask  = this->table.size() - 1;
+      triton::usize index = this->hashNode(node) & mask;
+
+      while (this->table[index].node != nullptr && this->table[index].node != node)
+        index = (index + 1) & mask;
+
+      if (this->table[index].node == nullptr)
+        return;
+
+      this->tableCount--;
+      this->kindCount[node->getKind()]--;
+
+      /*
+       * Backward shift deletion: the following slots of the cluster are moved
+       * into the hole unless the hole is before their home slot, so that the
+       * probe sequences stay unbroken without tombstones.
+       */
+      triton::usize hole = index;
+      for (triton::usize next = (hole + 1) & mask; this->table[next].node != nullptr; next = (next + 1) & mask) {
+        triton::usize home = this->table[next].hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+          this->table[hole] = this->table[next];
+          hole = next;
         }
+      }
+
+      this->table[hole] = Slot();
+    }
+
 
+    triton::ast::AbstractNode* AstDictionaries::browseAstDictionaries(triton::ast::AbstractNode* node) {
+      this->allocatedNodes++;
+
+      /* Keep the load factor under 70% */
+      if ((this->tableCount + 1) * 10 > this->table.size() * 7)
+        this->grow();
+
+      triton::usize hash  = this->hashNode(node);
+      triton::usize index = this->findSlot(hash, [&](triton::ast::AbstractNode* n) { return this->isSameNode(n, node); });
+      Slot& slot          = this->table[index];
+
+      if (slot.node != nullptr) {
+        this->hits++;
+        return slot.node;
       }
 
-      this->allocatedDictionaries.insert(node);
+      slot.hash = hash;
+      slot.node = node;
+      this->tableCount++;
+      this->kindCount[node->getKind()]++;
+
       return nullptr;
     }
 
 
+    template TRITON_EXPORT triton::ast::AbstractNode* AstDictionaries::lookupAstNode(triton::uint32 kind, const std::vector<triton::ast::AbstractNode*>& children);
+    template TRITON_EXPORT triton::ast::AbstractNode* AstDictionaries::lookupAstNode(triton::uint32 kind, const std::list<triton::ast::AbstractNode*>& children);
+    template <typename T>
+    triton::ast::AbstractNode* AstDictionaries::lookupAstNode(triton::uint32 kind, const T& children) {
+      /* A child which does not exist yet cannot be part of an existing node */
+      for (triton::ast::AbstractNode* child : children) {
+        if (child == nullptr)
+          return nullptr;
+      }
+
+      return this->lookup(hashChildren(kind, children), [&](triton::ast::AbstractNode* n) {
+        return n->getKind() == kind && hasChildren(n, children);
+      });
+    }
+
+
+    triton::ast::AbstractNode* AstDictionaries::lookupAstNode(triton::uint32 kind, std::initializer_list<triton::ast::AbstractNode*> children) {
+      return this->lookupAstNode<std::initializer_list<triton::ast::AbstractNode*>>(kind, children);
+    }
+
+
+    triton::ast::AbstractNode* AstDictionaries::lookupDecimalNode(const triton::uint512& value) {
+      return this->lookup(hashDecimal(value), [&](triton::ast::AbstractNode* n) {
+        return n->getKind() == triton::ast::DECIMAL_NODE && reinterpret_cast<triton::ast::DecimalNode*>(n)->getValue() == value;
+      });
+    }
+
+
+    triton::ast::AbstractNode* AstDictionaries::lookupReferenceNode(triton::usize id) {
+      return this->lookup(hashId(triton::ast::REFERENCE_NODE, id), [&](triton::ast::AbstractNode* n) {
+        return n->getKind() == triton::ast::REFERENCE_NODE && reinterpret_cast<triton::ast::ReferenceNode*>(n)->getSymbolicExpression().getId() == id;
+      });
+    }
+
+
+    triton::ast::AbstractNode* AstDictionaries::lookupStringNode(const std::string& value) {
+      return this->lookup(hashString(triton::ast::STRING_NODE, value), [&](triton::ast::AbstractNode* n) {
+        return n->getKind() == triton::ast::STRING_NODE && reinterpret_cast<triton::ast::StringNode*>(n)->getValue() == value;
+      });
+    }
+
+
+    triton::ast::AbstractNode* AstDictionaries::lookupVariableNode(const std::string& name) {
+      return this->lookup(hashString(triton::ast::VARIABLE_NODE, name), [&](triton::ast::AbstractNode* n) {
+        return n->getKind() == triton::ast::VARIABLE_NODE && reinterpret_cast<triton::ast::VariableNode*>(n)->getVar().getName() == name;
+      });
+    }
+
+
     std::map<std::string, triton::usize> AstDictionaries::getAstDictionariesStats(void) const {
       std::map<std::string, triton::usize> stats;
-      stats["bvadd"]                  = this->bvaddDictionary.size();
-      stats["bvand"]                  = this->bvandDictionary.size();
-      stats["bvashr"]                 = this->bvashrDictionary.size();
-      stats["bvlshr"]                 = this->bvlshrDictionary.size();
-      stats["bvmul"]                  = this->bvmulDictionary.size();
-      stats["bvnand"]                 = this->bvnandDictionary.size();
-      stats["bvneg"]                  = this->bvnegDictionary.size();
-      stats["bvnor"]                  = this->bvnorDictionary.size();
-      stats["bvnot"]                  = this->bvnotDictionary.size();
-      stats["bvor"]                   = this->bvorDictionary.size();
-      stats["bvrol"]                  = this->bvrolDictionary.size();
-      stats["bvror"]                  = this->bvrorDictionary.size();
-      stats["bvsdiv"]                 = this->bvsdivDictionary.size();
-      stats["bvsge"]                  = this->bvsgeDictionary.size();
-      stats["bvsgt"]                  = this->bvsgtDictionary.size();
-      stats["bvshl"]                  = this->bvshlDictionary.size();
-      stats["bvsle"]                  = this->bvsleDictionary.size();
-      stats["bvslt"]                  = this->bvsltDictionary.size();
-      stats["bvsmod"]                 = this->bvsmodDictionary.size();
-      stats["bvsrem"]                 = this->bvsremDictionary.size();
-      stats["bvsub"]                  = this->bvsubDictionary.size();
-      stats["bvudiv"]                 = this->bvudivDictionary.size();
-      stats["bvuge"]                  = this->bvugeDictionary.size();
-      stats["bvugt"]                  = this->bvugtDictionary.size();
-      stats["bvule"]                  = this->bvuleDictionary.size();
-      stats["bvult"]                  = this->bvultDictionary.size();
-      stats["bvurem"]                 = this->bvuremDictionary.size();
-      stats["bvxnor"]                 = this->bvxnorDictionary.size();
-      stats["bvxor"]                  = this->bvxorDictionary.size();
-      stats["bv"]                     = this->bvDictionary.size();
-      stats["concat"]                 = this->concatDictionary.size();
-      stats["decimal"]                = this->decimalDictionary.size();
-      stats["distinct"]               = this->distinctDictionary.size();
-      stats["equal"]                  = this->equalDictionary.size();
-      stats["extract"]                = this->extractDictionary.size();
-      stats["ite"]                    = this->iteDictionary.size();
-      stats["land"]                   = this->landDictionary.size();
-      stats["let"]                    = this->letDictionary.size();
-      stats["lnot"]                   = this->lnotDictionary.size();
-      stats["lor"]                    = this->lorDictionary.size();
-      stats["reference"]              = this->referenceDictionary.size();
-      stats["string"]                 = this->stringDictionary.size();
-      stats["sx"]                     = this->sxDictionary.size();
-      stats["variable"]               = this->variableDictionary.size();
-      stats["zx"]                     = this->zxDictionary.size();
-      stats["allocatedDictionaries"]  = this->allocatedDictionaries.size();
+
+      for (const auto& item : dictionariesNames) {
+        auto it = this->kindCount.find(item.first);
+        stats[item.second] = (it != this->kindCount.end()) ? it->second : 0;
+      }
+
+      stats["allocatedDictionaries"]  = this->tableCount;
       stats["allocatedNodes"]         = this->allocatedNodes;
+      stats["tableSize"]              = this->table.size();
+      stats["loadFactor"]             = this->table.empty() ? 0 : ((this->tableCount * 100) / this->table.size());
+      stats["lookups"]                = this->lookups;
+      stats["hits"]                   = this->hits;
+      stats["probes"]                 = this->probes;
+      stats["maxProbeLength"]         = this->maxProbeLength;
+
       return stats;
     }
 
   }; /* ast namespace */
 }; /*triton namespace */
-
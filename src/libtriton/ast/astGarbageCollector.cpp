@@ -5,8 +5,13 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 #include <triton/astGarbageCollector.hpp>
 #include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
 #include <triton/symbolicVariable.hpp>
 
 
@@ -14,23 +19,26 @@
 namespace triton {
   namespace ast {
 
-    AstGarbageCollector::AstGarbageCollector(const triton::modes::Modes& modes, bool isBackup)
-      : triton::ast::AstDictionaries(isBackup),
-        modes(modes) {
+    AstGarbageCollector::AstGarbageCollector(const triton::modes::Modes& modes, triton::ast::AstArena& arena, bool isBackup)
+      : modes(modes),
+        arena(arena) {
 
-      this->backupFlag = isBackup;
+      this->backupFlag  = isBackup;
+      this->sequence    = 0;
     }
 
 
     AstGarbageCollector::AstGarbageCollector(const AstGarbageCollector& other)
-      : triton::ast::AstDictionaries(other),
-        modes(other.modes) {
+      : triton::ast::AstDictionaries(),
+        modes(other.modes),
+        arena(other.arena) {
+      this->backupFlag  = true;
+      this->sequence    = 0;
       this->copy(other);
     }
 
 
     AstGarbageCollector& AstGarbageCollector::operator=(const AstGarbageCollector& other) {
-      triton::ast::AstDictionaries::operator=(other);
       // We assume modes didn't change
       this->copy(other);
       return *this;
@@ -38,14 +46,85 @@ namespace triton {
 
 
     void AstGarbageCollector::copy(const AstGarbageCollector& other) {
-      /* Remove unused nodes before the assignation */
-      for (auto it = this->allocatedNodes.begin(); it != this->allocatedNodes.end(); it++) {
-        if (other.allocatedNodes.find(*it) == other.allocatedNodes.end())
-          delete *it;
+      /* Taking a backup remembers where the arena is */
+      if (this->backupFlag)
+        this->sequence = this->arena.getSequence();
+
+      /* Restoring a backup deletes the nodes allocated since the backup has been taken */
+      else if (other.backupFlag && &this->arena == &other.arena)
+        this->rollback(other.sequence);
+
+      else {
+        triton::ast::AstDictionaries::operator=(other);
+        this->variableNodes = other.variableNodes;
+      }
+    }
+
+
+    void AstGarbageCollector::forgetAstNode(triton::ast::AbstractNode* node) {
+      switch (node->getKind()) {
+        case triton::ast::REFERENCE_NODE: {
+          triton::ast::ReferenceNode* ref = reinterpret_cast<triton::ast::ReferenceNode*>(node);
+          /* A detached reference has already left the dictionaries */
+          if (ref->isDetached())
+            return;
+          ref->getSymbolicExpression().getAst()->removeParent(node);
+          break;
+        }
+
+        case triton::ast::VARIABLE_NODE: {
+          /* The variable may already be gone, see setAllocatedAstNodes() */
+          if (this->variableNodes.empty())
+            break;
+          auto it = this->variableNodes.find(reinterpret_cast<triton::ast::VariableNode*>(node)->getVar().getName());
+          if (it != this->variableNodes.end()) {
+            it->second.erase(std::remove(it->second.begin(), it->second.end(), node), it->second.end());
+            if (it->second.empty())
+              this->variableNodes.erase(it);
+          }
+          break;
+        }
+
+        default:
+          break;
+      }
+
+      this->removeAstNode(node);
+    }
+
+
+    void AstGarbageCollector::dropAstNodes(const std::vector<triton::ast::AbstractNode*>& nodes, bool freeChildren) {
+      std::unordered_set<triton::ast::AbstractNode*> dropped(nodes.begin(), nodes.end());
+      std::vector<triton::ast::AbstractNode*> unreferenced;
+
+      /* The children which are dropped as well are deleted by this loop, do not touch them */
+      for (triton::ast::AbstractNode* node : nodes) {
+        this->forgetAstNode(node);
+        for (triton::ast::AbstractNode* child : node->getChildren()) {
+          if (dropped.find(child) != dropped.end())
+            continue;
+          child->removeParent(node);
+          if (child->refs && --child->refs == 0)
+            unreferenced.push_back(child);
+        }
+      }
+
+      for (triton::ast::AbstractNode* node : nodes)
+        delete node;
+
+      /* The dropped nodes were the last reference to these children */
+      if (freeChildren) {
+        for (triton::ast::AbstractNode* child : unreferenced)
+          this->freeAstNode(child);
       }
-      this->allocatedNodes  = other.allocatedNodes;
-      this->backupFlag      = true;
-      this->variableNodes   = other.variableNodes;
+    }
+
+
+    void AstGarbageCollector::rollback(triton::usize sequence) {
+      std::vector<triton::ast::AbstractNode*> nodes = this->arena.getLiveNodes(sequence);
+
+      std::reverse(nodes.begin(), nodes.end());
+      this->dropAstNodes(nodes, true);
     }
 
 
@@ -56,44 +135,80 @@ namespace triton {
 
 
     void AstGarbageCollector::freeAllAstNodes(void) {
-      for (auto it = this->allocatedNodes.begin(); it != this->allocatedNodes.end(); it++)
-        delete *it;
-
+      /* The dictionaries point into the arena */
+      this->clearAstDictionaries();
       this->variableNodes.clear();
-      this->allocatedNodes.clear();
+      this->arena.clear();
     }
 
 
     void AstGarbageCollector::freeAstNodes(std::set<triton::ast::AbstractNode*>& nodes) {
-      std::set<triton::ast::AbstractNode*>::iterator it;
+      std::vector<triton::ast::AbstractNode*> roots;
+
+      /*
+       * Only the nodes which are not referenced are freed. They have no parent, so none
+       * of them is freed as the child of another one, and freeing them gives back their
+       * references on their children.
+       */
+      for (triton::ast::AbstractNode* node : nodes) {
+        if (node->getRefCount() == 0)
+          roots.push_back(node);
+      }
 
-      /* Do not delete AST nodes if the AST_DICTIONARIES optimization is enabled */
-      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES))
-        return;
+      for (triton::ast::AbstractNode* node : roots)
+        this->freeAstNode(node);
 
-      for (it = nodes.begin(); it != nodes.end(); it++) {
-        /* Remove the node from the global set */
-        this->allocatedNodes.erase(*it);
+      nodes.clear();
+    }
+
+
+    void AstGarbageCollector::freeAstNode(triton::ast::AbstractNode* node) {
+      std::vector<triton::ast::AbstractNode*> worklist(1, node);
+
+      /* No recursion, a long chain of nodes may be freed at once */
+      while (!worklist.empty()) {
+        triton::ast::AbstractNode* current = worklist.back();
+        worklist.pop_back();
+
+        this->forgetAstNode(current);
 
-        /* Remove the node from the global variables map */
-        if ((*it)->getKind() == triton::ast::VARIABLE_NODE)
-          this->variableNodes.erase(reinterpret_cast<triton::ast::VariableNode*>(*it)->getVar().getName());
+        for (triton::ast::AbstractNode* child : current->getChildren()) {
+          child->removeParent(current);
+          if (child->refs && --child->refs == 0)
+            worklist.push_back(child);
+        }
 
-        /* Delete the node */
-        delete *it;
+        delete current;
       }
+    }
 
-      nodes.clear();
+
+    void AstGarbageCollector::detachReferenceNodes(const triton::engines::symbolic::SymbolicExpression& expr) {
+      std::vector<triton::ast::ReferenceNode*> refs;
+      triton::ast::AbstractNode* ast = expr.getAst();
+
+      for (triton::ast::AbstractNode* parent : ast->getParents()) {
+        if (parent->getKind() != triton::ast::REFERENCE_NODE)
+          continue;
+        triton::ast::ReferenceNode* ref = reinterpret_cast<triton::ast::ReferenceNode*>(parent);
+        if (!ref->isDetached() && &ref->getSymbolicExpression() == &expr)
+          refs.push_back(ref);
+      }
+
+      /* The dictionaries identify references by the id of their expression */
+      for (triton::ast::ReferenceNode* ref : refs) {
+        this->removeAstNode(ref);
+        ast->removeParent(ref);
+        ref->detach();
+      }
     }
 
 
     void AstGarbageCollector::extractUniqueAstNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, triton::ast::AbstractNode* root) const {
-      if (root == nullptr)
-        return;
+      std::vector<triton::ast::AbstractNode*> nodes;
 
-      uniqueNodes.insert(root);
-      for (auto it = root->getChildren().cbegin(); it != root->getChildren().cend(); it++)
-        this->extractUniqueAstNodes(uniqueNodes, *it);
+      triton::ast::nodesExtraction(root, nodes);
+      uniqueNodes.insert(nodes.begin(), nodes.end());
     }
 
 
@@ -101,12 +216,10 @@ namespace triton {
       /* Check if the AST_DICTIONARIES is enabled. */
       if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES)) {
         triton::ast::AbstractNode* ret = this->browseAstDictionaries(node);
-        if (ret != nullptr)
+        if (ret != nullptr) {
+          this->dropAstNodes({node}, true);
           return ret;
-      }
-      else {
-        /* Record the node */
-        this->allocatedNodes.insert(node);
+        }
       }
       return node;
     }
@@ -117,8 +230,14 @@ namespace triton {
     }
 
 
-    const std::set<triton::ast::AbstractNode*>& AstGarbageCollector::getAllocatedAstNodes(void) const {
-      return this->allocatedNodes;
+    std::set<triton::ast::AbstractNode*> AstGarbageCollector::getAllocatedAstNodes(void) const {
+      std::vector<triton::ast::AbstractNode*> nodes = this->arena.getLiveNodes();
+      return std::set<triton::ast::AbstractNode*>(nodes.begin(), nodes.end());
+    }
+
+
+    std::map<std::string, triton::usize> AstGarbageCollector::getAstArenaStats(void) const {
+      return this->arena.getStats();
     }
 
 
@@ -136,12 +255,24 @@ namespace triton {
 
 
     void AstGarbageCollector::setAllocatedAstNodes(const std::set<triton::ast::AbstractNode*>& nodes) {
-      /* Remove unused nodes before the assignation */
-      for (auto it = this->allocatedNodes.begin(); it != this->allocatedNodes.end(); it++) {
+      /* Nodes owned by the dictionaries must stay alive */
+      if (this->modes.isModeEnabled(triton::modes::AST_DICTIONARIES))
+        return;
+
+      /*
+       * The variables of the dropped nodes may already be deleted, the
+       * variables map is assigned afterwards by setAstVariableNodes().
+       */
+      this->variableNodes.clear();
+
+      /* Remove unused nodes before the assignation, newest first. The nodes kept are not freed even if they are not referenced anymore. */
+      std::vector<triton::ast::AbstractNode*> live = this->arena.getLiveNodes();
+      std::vector<triton::ast::AbstractNode*> unused;
+      for (auto it = live.rbegin(); it != live.rend(); it++) {
         if (nodes.find(*it) == nodes.end())
-          delete *it;
+          unused.push_back(*it);
       }
-      this->allocatedNodes = nodes;
+      this->dropAstNodes(unused, false);
     }
 
 
@@ -7,6 +7,10 @@
 
 #include <new>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <triton/astRepresentation.hpp>
 #include <triton/exceptions.hpp>
@@ -19,7 +23,8 @@ namespace triton {
 
       AstRepresentation::AstRepresentation() {
         /* Set the default representation */
-        this->mode = triton::ast::representations::SMT_REPRESENTATION;
+        this->mode    = triton::ast::representations::SMT_REPRESENTATION;
+        this->pending = nullptr;
 
         /* Init representations interface */
         this->representations[triton::ast::representations::SMT_REPRESENTATION] = std::unique_ptr<triton::ast::representations::AstSmtRepresentation>(new(std::nothrow) triton::ast::representations::AstSmtRepresentation());
@@ -58,7 +63,66 @@ namespace triton {
 
 
       std::ostream& AstRepresentation::print(std::ostream& stream, AbstractNode* node) {
-        return this->representations[this->mode]->print(stream, node);
+        /* A child of the node being displayed, remember where it goes */
+        if (this->pending) {
+          this->pending->push_back(std::make_pair(static_cast<triton::usize>(static_cast<std::streamoff>(stream.tellp())), node));
+          return stream;
+        }
+
+        /* The text of a node is cut into segments, each one followed by a child (null for the last one) */
+        struct Frame {
+          std::vector<std::pair<std::string, AbstractNode*>> items;
+          triton::usize index;
+        };
+        std::vector<Frame> worklist;
+
+        /* Displays a node alone, without its children */
+        auto display = [&](AbstractNode* n) {
+          std::vector<std::pair<triton::usize, AbstractNode*>> slots;
+          std::ostringstream text;
+          triton::usize pos = 0;
+          Frame frame;
+
+          text.flags(stream.flags());
+          this->pending = &slots;
+          try {
+            this->representations[this->mode]->print(text, n);
+          }
+          catch (...) {
+            this->pending = nullptr;
+            throw;
+          }
+          this->pending = nullptr;
+
+          std::string str = text.str();
+          for (const auto& slot : slots) {
+            frame.items.push_back(std::make_pair(str.substr(pos, slot.first - pos), slot.second));
+            pos = slot.first;
+          }
+          frame.items.push_back(std::make_pair(str.substr(pos), nullptr));
+          frame.index = 0;
+
+          worklist.push_back(std::move(frame));
+        };
+
+        display(node);
+        while (!worklist.empty()) {
+          Frame& frame = worklist.back();
+
+          if (frame.index == frame.items.size()) {
+            worklist.pop_back();
+            continue;
+          }
+
+          AbstractNode* child = frame.items[frame.index].second;
+          stream << frame.items[frame.index].first;
+          frame.index++;
+
+          if (child)
+            display(child);
+        }
+
+        return stream;
       }
 
     };
@@ -287,7 +287,7 @@ namespace triton {
 
       /* concat representation */
       std::ostream& AstSmtRepresentation::print(std::ostream& stream, triton::ast::ConcatNode* node) {
-        std::vector<triton::ast::AbstractNode*> children = node->getChildren();
+        const triton::ast::AstChildren& children = node->getChildren();
         triton::usize size = children.size();
 
         if (size < 2)
@@ -5,6 +5,11 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <triton/cpuSize.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/tritonToZ3Ast.hpp>
@@ -14,13 +19,43 @@
 namespace triton {
   namespace ast {
 
-    TritonToZ3Ast::TritonToZ3Ast(triton::engines::symbolic::SymbolicEngine* symbolicEngine, bool eval)
+    TritonToZ3Ast::TritonToZ3Ast(triton::engines::symbolic::SymbolicEngine* symbolicEngine, bool eval, bool cache)
       : context() {
       if (symbolicEngine == nullptr)
         throw triton::exceptions::AstTranslations("TritonToZ3Ast::TritonToZ3Ast(): The symbolicEngine API cannot be null.");
 
       this->symbolicEngine = symbolicEngine;
       this->isEval = eval;
+      this->isCached = cache;
+    }
+
+
+    TritonToZ3Ast::~TritonToZ3Ast() {
+      this->clearCache();
+    }
+
+
+    void TritonToZ3Ast::clearCache(void) {
+      std::vector<triton::ast::AbstractNode*> nodes;
+
+      nodes.reserve(this->cache.size());
+      for (const auto& item : this->cache)
+        nodes.push_back(item.first);
+
+      /* Drop the z3 expressions first, a released node may free some other cached nodes */
+      this->cache.clear();
+      for (triton::ast::AbstractNode* node : nodes)
+        node->release();
+    }
+
+
+    triton::usize TritonToZ3Ast::getCacheSize(void) const {
+      return this->cache.size();
+    }
+
+
+    z3::context& TritonToZ3Ast::getContext(void) {
+      return this->context;
     }
 
 
@@ -46,118 +81,263 @@ namespace triton {
     }
 
 
+    void TritonToZ3Ast::getOperands(triton::ast::AbstractNode* node, std::vector<triton::ast::AbstractNode*>& operands) const {
+      const triton::ast::AstChildren& children = node->getChildren();
+
+      operands.clear();
+      switch (node->getKind()) {
+        /* A reference is translated as the AST of its expression */
+        case REFERENCE_NODE:
+          operands.push_back(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression().getAst());
+          break;
+
+        /* A symbol is translated as the expression bound to it */
+        case STRING_NODE: {
+          auto it = this->symbols.find(reinterpret_cast<triton::ast::StringNode*>(node)->getValue());
+          if (it == this->symbols.end())
+            throw triton::exceptions::AstTranslations("TritonToZ3Ast::convert(): [STRING_NODE] Symbols not found.");
+          operands.push_back(it->second);
+          break;
+        }
+
+        /* The bound expression is translated where its symbol occurs */
+        case LET_NODE:
+          operands.push_back(children[2]);
+          break;
+
+        default:
+          operands.assign(children.begin(), children.end());
+          break;
+      }
+    }
+
+
     z3::expr TritonToZ3Ast::convert(triton::ast::AbstractNode* node) {
+      std::unordered_map<triton::ast::AbstractNode*, z3::expr> local;
+      std::unordered_set<triton::ast::AbstractNode*> references;
+      std::vector<std::unordered_map<triton::ast::AbstractNode*, z3::expr>> lets;
+      std::vector<triton::ast::AbstractNode*> operands;
+      std::vector<z3::expr> ops;
+
+      /* A node to translate, its operands are resolved at the first visit */
+      struct Frame {
+        triton::ast::AbstractNode* node;
+        bool visited;
+        std::vector<triton::ast::AbstractNode*> operands;
+        triton::ast::AbstractNode* shadowed;
+      };
+      std::vector<Frame> worklist;
+
       if (node == nullptr)
         throw triton::exceptions::AstTranslations("TritonToZ3Ast::convert(): node cannot be null.");
 
+      /*
+       * Each node is translated once. The translations made under a let depend on the
+       * bound symbols, they are kept in a map per nested let which is dropped with it.
+       * The translations which go through a reference depend on the current AST of its
+       * expression, they are only kept for this conversion. The cache is cleared before
+       * a conversion once it is full.
+       */
+      if (this->isCached && this->cache.size() >= MAX_TRANSLATION_CACHE_SIZE)
+        this->clearCache();
+
+      auto lookup = [&](triton::ast::AbstractNode* n) -> const z3::expr* {
+        if (!lets.empty()) {
+          auto it = lets.back().find(n);
+          if (it != lets.back().end())
+            return &it->second;
+        }
+        auto it = this->cache.find(n);
+        if (it != this->cache.end())
+          return &it->second;
+        it = local.find(n);
+        return (it != local.end()) ? &it->second : nullptr;
+      };
+
+      auto push = [&](triton::ast::AbstractNode* n) {
+        worklist.emplace_back();
+        worklist.back().node     = n;
+        worklist.back().visited  = false;
+        worklist.back().shadowed = nullptr;
+      };
+
+      /* No recursion, the depth of an AST is only bounded by the trace */
+      push(node);
+      while (!worklist.empty()) {
+        triton::ast::AbstractNode* current = worklist.back().node;
+
+        /* First visit, the operands are translated before the node */
+        if (worklist.back().visited == false) {
+          if (lookup(current)) {
+            worklist.pop_back();
+            continue;
+          }
+
+          worklist.back().visited = true;
+          if (current->getKind() == LET_NODE) {
+            std::string symbol = reinterpret_cast<triton::ast::StringNode*>(current->getChildren()[0])->getValue();
+            auto it = this->symbols.find(symbol);
+            /* A nested let may shadow the symbol, its previous binding is restored with the let */
+            if (it != this->symbols.end())
+              worklist.back().shadowed = it->second;
+            this->symbols[symbol] = current->getChildren()[1];
+            lets.emplace_back();
+          }
+
+          /* The symbols are resolved now, they may be bound to another expression at the second visit */
+          this->getOperands(current, worklist.back().operands);
+          operands = worklist.back().operands;
+          for (auto it = operands.rbegin(); it != operands.rend(); it++) {
+            if (!lookup(*it))
+              push(*it);
+          }
+          continue;
+        }
+
+        /* Second visit, all the operands are translated */
+        bool reference = (current->getKind() == REFERENCE_NODE);
+        ops.clear();
+        for (triton::ast::AbstractNode* operand : worklist.back().operands) {
+          ops.push_back(*lookup(operand));
+          reference |= (references.find(operand) != references.end());
+        }
+        if (reference)
+          references.insert(current);
+
+        z3::expr expr = this->translate(current, ops);
+        if (current->getKind() == LET_NODE) {
+          std::string symbol = reinterpret_cast<triton::ast::StringNode*>(current->getChildren()[0])->getValue();
+          if (worklist.back().shadowed != nullptr)
+            this->symbols[symbol] = worklist.back().shadowed;
+          else
+            this->symbols.erase(symbol);
+          lets.pop_back();
+        }
+        worklist.pop_back();
+
+        if (!lets.empty())
+          lets.back().emplace(current, expr);
+        else if (reference || !this->isCached)
+          local.emplace(current, expr);
+        else {
+          this->cache.emplace(current, expr);
+          current->retain();
+        }
+      }
+
+      return *lookup(node);
+    }
+
+
+    z3::expr TritonToZ3Ast::translate(triton::ast::AbstractNode* node, const std::vector<z3::expr>& ops) {
       switch (node->getKind()) {
         case BVADD_NODE:
-          return to_expr(this->context, Z3_mk_bvadd(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvadd(this->context, ops[0], ops[1]));
 
         case BVAND_NODE:
-          return to_expr(this->context, Z3_mk_bvand(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvand(this->context, ops[0], ops[1]));
 
         case BVASHR_NODE:
-          return to_expr(this->context, Z3_mk_bvashr(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvashr(this->context, ops[0], ops[1]));
 
         case BVLSHR_NODE:
-          return to_expr(this->context, Z3_mk_bvlshr(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvlshr(this->context, ops[0], ops[1]));
 
         case BVMUL_NODE:
-          return to_expr(this->context, Z3_mk_bvmul(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvmul(this->context, ops[0], ops[1]));
 
         case BVNAND_NODE:
-          return to_expr(this->context, Z3_mk_bvnand(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvnand(this->context, ops[0], ops[1]));
 
         case BVNEG_NODE:
-          return to_expr(this->context, Z3_mk_bvneg(this->context, this->convert(node->getChildren()[0])));
+          return to_expr(this->context, Z3_mk_bvneg(this->context, ops[0]));
 
         case BVNOR_NODE:
-          return to_expr(this->context, Z3_mk_bvnor(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvnor(this->context, ops[0], ops[1]));
 
         case BVNOT_NODE:
-          return to_expr(this->context, Z3_mk_bvnot(this->context, this->convert(node->getChildren()[0])));
+          return to_expr(this->context, Z3_mk_bvnot(this->context, ops[0]));
 
         case BVOR_NODE:
-          return to_expr(this->context, Z3_mk_bvor(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvor(this->context, ops[0], ops[1]));
 
         case BVROL_NODE: {
           triton::uint32 op1 = reinterpret_cast<triton::ast::DecimalNode*>(node->getChildren()[0])->getValue().convert_to<triton::uint32>();
-          return to_expr(this->context, Z3_mk_rotate_left(this->context, op1, this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_rotate_left(this->context, op1, ops[1]));
         }
 
         case BVROR_NODE: {
           triton::uint32 op1 = reinterpret_cast<triton::ast::DecimalNode*>(node->getChildren()[0])->getValue().convert_to<triton::uint32>();
-          return to_expr(this->context, Z3_mk_rotate_right(this->context, op1, this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_rotate_right(this->context, op1, ops[1]));
         }
 
         case BVSDIV_NODE:
-          return to_expr(this->context, Z3_mk_bvsdiv(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsdiv(this->context, ops[0], ops[1]));
 
         case BVSGE_NODE:
-          return to_expr(this->context, Z3_mk_bvsge(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsge(this->context, ops[0], ops[1]));
 
         case BVSGT_NODE:
-          return to_expr(this->context, Z3_mk_bvsgt(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsgt(this->context, ops[0], ops[1]));
 
         case BVSHL_NODE:
-          return to_expr(this->context, Z3_mk_bvshl(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvshl(this->context, ops[0], ops[1]));
 
         case BVSLE_NODE:
-          return to_expr(this->context, Z3_mk_bvsle(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsle(this->context, ops[0], ops[1]));
 
         case BVSLT_NODE:
-          return to_expr(this->context, Z3_mk_bvslt(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvslt(this->context, ops[0], ops[1]));
 
         case BVSMOD_NODE:
-          return to_expr(this->context, Z3_mk_bvsmod(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsmod(this->context, ops[0], ops[1]));
 
         case BVSREM_NODE:
-          return to_expr(this->context, Z3_mk_bvsrem(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsrem(this->context, ops[0], ops[1]));
 
         case BVSUB_NODE:
-          return to_expr(this->context, Z3_mk_bvsub(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvsub(this->context, ops[0], ops[1]));
 
         case BVUDIV_NODE:
-          return to_expr(this->context, Z3_mk_bvudiv(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvudiv(this->context, ops[0], ops[1]));
 
         case BVUGE_NODE:
-          return to_expr(this->context, Z3_mk_bvuge(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvuge(this->context, ops[0], ops[1]));
 
         case BVUGT_NODE:
-          return to_expr(this->context, Z3_mk_bvugt(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvugt(this->context, ops[0], ops[1]));
 
         case BVULE_NODE:
-          return to_expr(this->context, Z3_mk_bvule(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvule(this->context, ops[0], ops[1]));
 
         case BVULT_NODE:
-          return to_expr(this->context, Z3_mk_bvult(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvult(this->context, ops[0], ops[1]));
 
         case BVUREM_NODE:
-          return to_expr(this->context, Z3_mk_bvurem(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvurem(this->context, ops[0], ops[1]));
 
         case BVXNOR_NODE:
-          return to_expr(this->context, Z3_mk_bvxnor(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvxnor(this->context, ops[0], ops[1]));
 
         case BVXOR_NODE:
-          return to_expr(this->context, Z3_mk_bvxor(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_bvxor(this->context, ops[0], ops[1]));
 
         case BV_NODE: {
-          z3::expr value        = this->convert(node->getChildren()[0]);
-          z3::expr size         = this->convert(node->getChildren()[1]);
+          z3::expr value        = ops[0];
+          z3::expr size         = ops[1];
           triton::uint32 bvsize = static_cast<triton::uint32>(this->getUintValue(size));
           return this->context.bv_val(this->getStringValue(value).c_str(), bvsize);
         }
 
         case CONCAT_NODE: {
-          const std::vector<triton::ast::AbstractNode*>& children = node->getChildren();
+          const triton::ast::AstChildren& children = node->getChildren();
 
-          z3::expr currentValue = this->convert(node->getChildren()[0]);
+          z3::expr currentValue = ops[0];
           z3::expr nextValue(this->context);
 
           // Child[0] is the LSB
           for (triton::uint32 idx = 1; idx < children.size(); idx++) {
-            nextValue = this->convert(children[idx]);
+            nextValue = ops[idx];
             currentValue = to_expr(this->context, Z3_mk_concat(this->context, currentValue, nextValue));
           }
 
@@ -170,20 +350,20 @@ namespace triton {
         }
 
         case DISTINCT_NODE: {
-          z3::expr op1 = this->convert(node->getChildren()[0]);
-          z3::expr op2 = this->convert(node->getChildren()[1]);
+          z3::expr op1 = ops[0];
+          z3::expr op2 = ops[1];
           Z3_ast ops[] = {op1, op2};
 
           return to_expr(this->context, Z3_mk_distinct(this->context, 2, ops));
         }
 
         case EQUAL_NODE:
-          return to_expr(this->context, Z3_mk_eq(this->context, this->convert(node->getChildren()[0]), this->convert(node->getChildren()[1])));
+          return to_expr(this->context, Z3_mk_eq(this->context, ops[0], ops[1]));
 
         case EXTRACT_NODE: {
-          z3::expr high     = this->convert(node->getChildren()[0]);
-          z3::expr low      = this->convert(node->getChildren()[1]);
-          z3::expr value    = this->convert(node->getChildren()[2]);
+          z3::expr high     = ops[0];
+          z3::expr low      = ops[1];
+          z3::expr value    = ops[2];
           triton::uint32 hv = static_cast<triton::uint32>(this->getUintValue(high));
           triton::uint32 lv = static_cast<triton::uint32>(this->getUintValue(low));
 
@@ -191,24 +371,24 @@ namespace triton {
         }
 
         case ITE_NODE: {
-          z3::expr op1 = this->convert(node->getChildren()[0]); // condition
-          z3::expr op2 = this->convert(node->getChildren()[1]); // if true
-          z3::expr op3 = this->convert(node->getChildren()[2]); // if false
+          z3::expr op1 = ops[0]; // condition
+          z3::expr op2 = ops[1]; // if true
+          z3::expr op3 = ops[2]; // if false
 
           return to_expr(this->context, Z3_mk_ite(this->context, op1, op2, op3));
         }
 
         case LAND_NODE: {
-          const std::vector<triton::ast::AbstractNode*>& children = node->getChildren();
+          const triton::ast::AstChildren& children = node->getChildren();
 
-          z3::expr currentValue = this->convert(node->getChildren()[0]);
+          z3::expr currentValue = ops[0];
           if (!currentValue.get_sort().is_bool()) {
             throw triton::exceptions::AstTranslations("TritonToZ3Ast::LandNode(): Land can be apply only on bool value.");
           }
           z3::expr nextValue(this->context);
 
           for (triton::uint32 idx = 1; idx < children.size(); idx++) {
-            nextValue = this->convert(children[idx]);
+            nextValue = ops[idx];
             if (!nextValue.get_sort().is_bool()) {
               throw triton::exceptions::AstTranslations("TritonToZ3Ast::LandNode(): Land can be apply only on bool value.");
             }
@@ -220,15 +400,12 @@ namespace triton {
         }
 
 
-        case LET_NODE: {
-          std::string symbol    = reinterpret_cast<triton::ast::StringNode*>(node->getChildren()[0])->getValue();
-          this->symbols[symbol] = node->getChildren()[1];
-
-          return this->convert(node->getChildren()[2]);
-        }
+        /* The symbol is bound when the node is visited, see convert() */
+        case LET_NODE:
+          return ops[0];
 
         case LNOT_NODE: {
-          z3::expr value = this->convert(node->getChildren()[0]);
+          z3::expr value = ops[0];
           if (!value.get_sort().is_bool()) {
             throw triton::exceptions::AstTranslations("TritonToZ3Ast::LnotNode(): Lnot can be apply only on bool value.");
           }
@@ -236,16 +413,16 @@ namespace triton {
         }
 
         case LOR_NODE: {
-          const std::vector<triton::ast::AbstractNode*>& children = node->getChildren();
+          const triton::ast::AstChildren& children = node->getChildren();
 
-          z3::expr currentValue = this->convert(node->getChildren()[0]);
+          z3::expr currentValue = ops[0];
           if (!currentValue.get_sort().is_bool()) {
             throw triton::exceptions::AstTranslations("TritonToZ3Ast::LnotNode(): Lnot can be apply only on bool value.");
           }
           z3::expr nextValue(this->context);
 
           for (triton::uint32 idx = 1; idx < children.size(); idx++) {
-            nextValue = this->convert(children[idx]);
+            nextValue = ops[idx];
             if (!nextValue.get_sort().is_bool()) {
               throw triton::exceptions::AstTranslations("TritonToZ3Ast::LnotNode(): Lnot can be apply only on bool value.");
             }
@@ -257,20 +434,12 @@ namespace triton {
         }
 
         case REFERENCE_NODE:
-          return this->convert(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression().getAst());
-
-        case STRING_NODE: {
-          std::string value = reinterpret_cast<triton::ast::StringNode*>(node)->getValue();
-
-          if (this->symbols.find(value) == this->symbols.end())
-            throw triton::exceptions::AstTranslations("TritonToZ3Ast::convert(): [STRING_NODE] Symbols not found.");
-
-          return this->convert(this->symbols[value]);
-        }
+        case STRING_NODE:
+          return ops[0];
 
         case SX_NODE: {
-          z3::expr ext        = this->convert(node->getChildren()[0]);
-          z3::expr value      = this->convert(node->getChildren()[1]);
+          z3::expr ext        = ops[0];
+          z3::expr value      = ops[1];
           triton::uint32 extv = static_cast<triton::uint32>(this->getUintValue(ext));
 
           return to_expr(this->context, Z3_mk_sign_ext(this->context, extv, value));
@@ -295,8 +464,8 @@ namespace triton {
         }
 
         case ZX_NODE: {
-          z3::expr ext        = this->convert(node->getChildren()[0]);
-          z3::expr value      = this->convert(node->getChildren()[1]);
+          z3::expr ext        = ops[0];
+          z3::expr value      = ops[1];
           triton::uint32 extv = static_cast<triton::uint32>(this->getUintValue(ext));
 
           return to_expr(this->context, Z3_mk_zero_ext(this->context, extv, value));
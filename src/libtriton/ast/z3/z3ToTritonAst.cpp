@@ -6,6 +6,9 @@
 */
 
 #include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <triton/exceptions.hpp>
 #include <triton/z3ToTritonAst.hpp>
@@ -25,14 +28,60 @@ namespace triton {
 
 
     AbstractNode* Z3ToTritonAst::convert(const z3::expr& expr) {
-      AbstractNode* node = nullptr;
+      std::unordered_map<triton::uint32, AbstractNode*> memo;
+      std::vector<std::pair<z3::expr, bool>> worklist;
+      std::vector<AbstractNode*> args;
+
+      /* Each node of the DAG is translated once, no recursion */
+      worklist.emplace_back(expr, false);
+      while (!worklist.empty()) {
+        z3::expr current = worklist.back().first;
+        triton::uint32 id = Z3_get_ast_id(current.ctx(), current);
+
+        /* First visit, the arguments are translated before the node */
+        if (worklist.back().second == false) {
+          if (memo.find(id) != memo.end()) {
+            worklist.pop_back();
+            continue;
+          }
+
+          /* Currently, only support application node */
+          if (current.is_quantifier())
+            throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Quantifier not supported yet.");
 
-      /* Currently, only support application node */
-      if (expr.is_quantifier())
-        throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Quantifier not supported yet.");
+          if (!current.is_app())
+            throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): At this moment only application are supported.");
 
-      if (!expr.is_app())
-        throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): At this moment only application are supported.");
+          worklist.back().second = true;
+          if (current.decl().decl_kind() != Z3_OP_UNINTERPRETED) {
+            for (triton::uint32 i = current.num_args(); i > 0; i--) {
+              z3::expr arg = current.arg(i - 1);
+              if (memo.find(Z3_get_ast_id(arg.ctx(), arg)) == memo.end())
+                worklist.emplace_back(arg, false);
+            }
+          }
+          continue;
+        }
+
+        /* Second visit, all the arguments are translated */
+        worklist.pop_back();
+        args.clear();
+        if (current.decl().decl_kind() != Z3_OP_UNINTERPRETED) {
+          for (triton::uint32 i = 0; i < current.num_args(); i++) {
+            z3::expr arg = current.arg(i);
+            args.push_back(memo[Z3_get_ast_id(arg.ctx(), arg)]);
+          }
+        }
+
+        memo[id] = this->translate(current, args);
+      }
+
+      return memo[Z3_get_ast_id(expr.ctx(), expr)];
+    }
+
+
+    AbstractNode* Z3ToTritonAst::translate(const z3::expr& expr, const std::vector<AbstractNode*>& args) {
+      AbstractNode* node = nullptr;
 
       /* Get the function declaration */
       z3::func_decl function = expr.decl();
@@ -43,23 +92,23 @@ namespace triton {
         case Z3_OP_EQ: {
           if (expr.num_args() != 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_EQ must contain two arguments.");
-          node = this->astCtxt.equal(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.equal(args[0], args[1]);
           break;
         }
 
         case Z3_OP_DISTINCT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_DISTINCT must contain at least two arguments.");
-          node = this->astCtxt.distinct(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.distinct(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.distinct(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.distinct(node, args[i]);
           break;
         }
 
         case Z3_OP_ITE: {
           if (expr.num_args() != 3)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ITE must contain three arguments.");
-          node = this->astCtxt.ite(this->convert(expr.arg(0)), this->convert(expr.arg(1)), this->convert(expr.arg(2)));
+          node = this->astCtxt.ite(args[0], args[1], args[2]);
           break;
         }
 
@@ -67,12 +116,8 @@ namespace triton {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_AND must contain at least two arguments.");
 
-          std::list<AbstractNode*> args;
-          for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
-          }
-
-          node = this->astCtxt.land(args);
+          std::list<AbstractNode*> nodes(args.begin(), args.end());
+          node = this->astCtxt.land(nodes);
           break;
         }
 
@@ -80,12 +125,8 @@ namespace triton {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_OR must contain at least two arguments.");
 
-          std::list<AbstractNode*> args;
-          for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
-          }
-
-          node = this->astCtxt.lor(args);
+          std::list<AbstractNode*> nodes(args.begin(), args.end());
+          node = this->astCtxt.lor(nodes);
           break;
         }
 
@@ -93,7 +134,7 @@ namespace triton {
         case Z3_OP_NOT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_NOT must contain one argument.");
-          node = this->astCtxt.lnot(this->convert(expr.arg(0)));
+          node = this->astCtxt.lnot(args[0]);
           break;
         }
 
@@ -107,34 +148,34 @@ namespace triton {
         case Z3_OP_BNEG: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNEG must contain one argument.");
-          node = this->astCtxt.bvneg(this->convert(expr.arg(0)));
+          node = this->astCtxt.bvneg(args[0]);
           break;
         }
 
         case Z3_OP_BADD: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BADD must contain at least two arguments.");
-          node = this->astCtxt.bvadd(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvadd(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvadd(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvadd(node, args[i]);
           break;
         }
 
         case Z3_OP_BSUB: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSUB must contain at least two arguments.");
-          node = this->astCtxt.bvsub(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsub(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsub(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsub(node, args[i]);
           break;
         }
 
         case Z3_OP_BMUL: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BMUL must contain at least two arguments.");
-          node = this->astCtxt.bvmul(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvmul(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvmul(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvmul(node, args[i]);
           break;
         }
 
@@ -142,9 +183,9 @@ namespace triton {
         case Z3_OP_BSDIV: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSDIV must contain at least two arguments.");
-          node = this->astCtxt.bvsdiv(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsdiv(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsdiv(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsdiv(node, args[i]);
           break;
         }
 
@@ -152,9 +193,9 @@ namespace triton {
         case Z3_OP_BUDIV: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BUDIV must contain at least two arguments.");
-          node = this->astCtxt.bvudiv(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvudiv(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvudiv(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvudiv(node, args[i]);
           break;
         }
 
@@ -162,9 +203,9 @@ namespace triton {
         case Z3_OP_BSREM: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSREM must contain at least two arguments.");
-          node = this->astCtxt.bvsrem(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsrem(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsrem(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsrem(node, args[i]);
           break;
         }
 
@@ -172,9 +213,9 @@ namespace triton {
         case Z3_OP_BUREM: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BUREM must contain at least two arguments.");
-          node = this->astCtxt.bvurem(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvurem(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvurem(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvurem(node, args[i]);
           break;
         }
 
@@ -182,142 +223,142 @@ namespace triton {
         case Z3_OP_BSMOD: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSMOD must contain at least two arguments.");
-          node = this->astCtxt.bvsmod(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsmod(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsmod(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsmod(node, args[i]);
           break;
         }
 
         case Z3_OP_ULEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ULEQ must contain at least two arguments.");
-          node = this->astCtxt.bvule(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvule(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvule(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvule(node, args[i]);
           break;
         }
 
         case Z3_OP_SLEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SLEQ must contain at least two arguments.");
-          node = this->astCtxt.bvsle(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsle(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsle(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsle(node, args[i]);
           break;
         }
 
         case Z3_OP_UGEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_UGEQ must contain at least two arguments.");
-          node = this->astCtxt.bvuge(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvuge(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvuge(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvuge(node, args[i]);
           break;
         }
 
         case Z3_OP_SGEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SGEQ must contain at least two arguments.");
-          node = this->astCtxt.bvsge(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsge(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsge(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsge(node, args[i]);
           break;
         }
 
         case Z3_OP_ULT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ULT must contain at least two arguments.");
-          node = this->astCtxt.bvult(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvult(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvult(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvult(node, args[i]);
           break;
         }
 
         case Z3_OP_SLT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SLT must contain at least two arguments.");
-          node = this->astCtxt.bvslt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvslt(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvslt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvslt(node, args[i]);
           break;
         }
 
         case Z3_OP_UGT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_UGT must contain at least two arguments.");
-          node = this->astCtxt.bvugt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvugt(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvugt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvugt(node, args[i]);
           break;
         }
 
         case Z3_OP_SGT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SGT must contain at least two arguments.");
-          node = this->astCtxt.bvsgt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsgt(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsgt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsgt(node, args[i]);
           break;
         }
 
         case Z3_OP_BAND: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BAND must contain at least two arguments.");
-          node = this->astCtxt.bvand(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvand(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvand(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvand(node, args[i]);
           break;
         }
 
         case Z3_OP_BOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BOR must contain at least two arguments.");
-          node = this->astCtxt.bvor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvor(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvor(node, args[i]);
           break;
         }
 
         case Z3_OP_BNOT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNOT must contain one argument.");
-          node = this->astCtxt.bvnot(this->convert(expr.arg(0)));
+          node = this->astCtxt.bvnot(args[0]);
           break;
         }
 
         case Z3_OP_BXOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BXOR must contain at least two arguments.");
-          node = this->astCtxt.bvxor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvxor(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvxor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvxor(node, args[i]);
           break;
         }
 
         case Z3_OP_BNAND: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNAND must contain at least two arguments.");
-          node = this->astCtxt.bvnand(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvnand(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvnand(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvnand(node, args[i]);
           break;
         }
 
         case Z3_OP_BNOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNOR must contain at least two arguments.");
-          node = this->astCtxt.bvnor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvnor(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvnor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvnor(node, args[i]);
           break;
         }
 
         case Z3_OP_BXNOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BXNOR must contain at least two arguments.");
-          node = this->astCtxt.bvxnor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvxnor(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvxnor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvxnor(node, args[i]);
           break;
         }
 
@@ -325,74 +366,70 @@ namespace triton {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_CONCAT must contain at least two arguments.");
 
-          std::list<AbstractNode*> args;
-          for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
-          }
-
-          node = this->astCtxt.concat(args);
+          std::list<AbstractNode*> nodes(args.begin(), args.end());
+          node = this->astCtxt.concat(nodes);
           break;
         }
 
         case Z3_OP_SIGN_EXT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SIGN_EXT must contain one argument.");
-          node = this->astCtxt.sx(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.sx(expr.hi(), args[0]);
           break;
         }
 
         case Z3_OP_ZERO_EXT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ZERO_EXT must contain one argument.");
-          node = this->astCtxt.zx(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.zx(expr.hi(), args[0]);
           break;
         }
 
         case Z3_OP_EXTRACT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_EXTRACT must contain one argument.");
-          node = this->astCtxt.extract(expr.hi(), expr.lo(), this->convert(expr.arg(0)));
+          node = this->astCtxt.extract(expr.hi(), expr.lo(), args[0]);
           break;
         }
 
         case Z3_OP_BSHL: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSHL must contain at least two arguments.");
-          node = this->astCtxt.bvshl(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvshl(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvshl(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvshl(node, args[i]);
           break;
         }
 
         case Z3_OP_BLSHR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BLSHR must contain at least two arguments.");
-          node = this->astCtxt.bvlshr(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvlshr(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvlshr(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvlshr(node, args[i]);
           break;
         }
 
         case Z3_OP_BASHR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BASHR must contain at least two arguments.");
-          node = this->astCtxt.bvashr(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvashr(args[0], args[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvashr(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvashr(node, args[i]);
           break;
         }
 
         case Z3_OP_ROTATE_LEFT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ROTATE_LEFT must contain one argument.");
-          node = this->astCtxt.bvrol(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.bvrol(expr.hi(), args[0]);
           break;
         }
 
         case Z3_OP_ROTATE_RIGHT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ROTATE_RIGHT must contain one argument.");
-          node = this->astCtxt.bvror(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.bvror(expr.hi(), args[0]);
           break;
         }
 
@@ -36,6 +36,15 @@ Enabled, Triton will keep a map of aligned memory to reduce the symbolic memory
 - **MODE.AST_DICTIONARIES**<br>
 Enabled, Triton will record all AST nodes into several dictionaries and try to return node already allocated instead of allocate twice the same node.
 
+- **MODE.DISASSEMBLY_CACHE**<br>
+Enabled, Triton will keep a cache of the decoded instructions (keyed by address and opcode bytes) to avoid disassembling twice the same instruction.
+The number of hits and misses are returned by `getDisassemblyCacheStats()`.
+
+- **MODE.LAZY_FLAGS**<br>
+Enabled, Triton will build the expressions of the arithmetic flags (af, cf, of, pf, sf, zf) only when they are read
+(by an instruction, a path constraint or a query of the flag). The flags overwritten before being read never get
+an expression. These expressions are not attached to the instruction which produced the flags.
+
 - **MODE.ONLY_ON_SYMBOLIZED**<br>
 Enabled, Triton will perform symbolic execution only on symbolized expressions.
 
@@ -45,6 +54,13 @@ Enabled, Triton will perform symbolic execution only on tainted instructions.
 - **MODE.PC_TRACKING_SYMBOLIC**<br>
 Enabled, Triton will track path constraints only if they are symbolized. This mode is enabled by default.
 
+- **MODE.TAINT_SUMMARIES**<br>
+Enabled and when the symbolic engine is disabled, Triton will spread the taint of the instructions from a summary of
+their opcode (assignment, union, flags) applied to the decoded operands, without building their semantics. The
+concrete state is not updated by these instructions, it must be provided by the caller (e.g. a tracer). Their
+loads, stores and read and written registers are still recorded, with no AST. The instructions without summary are
+processed by the semantics.
+
 */
 
 
@@ -56,9 +72,12 @@ namespace triton {
       void initModeNamespace(PyObject* modeDict) {
         PyDict_SetItemString(modeDict, "ALIGNED_MEMORY",         PyLong_FromUint32(triton::modes::ALIGNED_MEMORY));
         PyDict_SetItemString(modeDict, "AST_DICTIONARIES",       PyLong_FromUint32(triton::modes::AST_DICTIONARIES));
+        PyDict_SetItemString(modeDict, "DISASSEMBLY_CACHE",      PyLong_FromUint32(triton::modes::DISASSEMBLY_CACHE));
+        PyDict_SetItemString(modeDict, "LAZY_FLAGS",             PyLong_FromUint32(triton::modes::LAZY_FLAGS));
         PyDict_SetItemString(modeDict, "ONLY_ON_SYMBOLIZED",     PyLong_FromUint32(triton::modes::ONLY_ON_SYMBOLIZED));
         PyDict_SetItemString(modeDict, "ONLY_ON_TAINTED",        PyLong_FromUint32(triton::modes::ONLY_ON_TAINTED));
         PyDict_SetItemString(modeDict, "PC_TRACKING_SYMBOLIC",   PyLong_FromUint32(triton::modes::PC_TRACKING_SYMBOLIC));
+        PyDict_SetItemString(modeDict, "TAINT_SUMMARIES",        PyLong_FromUint32(triton::modes::TAINT_SUMMARIES));
       }
 
     }; /* python namespace */
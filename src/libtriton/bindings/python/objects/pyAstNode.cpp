@@ -133,6 +133,10 @@ namespace triton {
       //! AstNode destructor.
       void AstNode_dealloc(PyObject* self) {
         std::cout << std::flush;
+        /* The node is already gone if its context has been destroyed or has freed all its nodes */
+        if (!((AstNode_Object*)self)->lifetime->expired())
+          PyAstNode_AsAstNode(self)->release();
+        delete ((AstNode_Object*)self)->lifetime;
         Py_DECREF(self);
       }
 
@@ -224,7 +228,7 @@ namespace triton {
       static PyObject* AstNode_getParents(PyObject* self, PyObject* noarg) {
         try {
           PyObject* ret = nullptr;
-          std::set<triton::ast::AbstractNode*>& parents = PyAstNode_AsAstNode(self)->getParents();
+          std::set<triton::ast::AbstractNode*> parents = PyAstNode_AsAstNode(self)->getParents();
           ret = xPyList_New(parents.size());
           triton::uint32 index = 0;
           for (std::set<triton::ast::AbstractNode*>::iterator it = parents.begin(); it != parents.end(); it++)
@@ -680,8 +684,12 @@ namespace triton {
 
         PyType_Ready(&AstNode_Type);
         object = PyObject_NEW(AstNode_Object, &AstNode_Type);
-        if (object != NULL)
-          object->node = node;
+        if (object != NULL) {
+          /* The node is kept alive as long as the object, see AstNode_dealloc() */
+          node->retain();
+          object->node     = node;
+          object->lifetime = new std::weak_ptr<bool>(node->getContext().getAstArena().getLifetime());
+        }
 
         return (PyObject*)object;
       }
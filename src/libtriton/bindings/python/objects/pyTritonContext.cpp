@@ -50,6 +50,10 @@ The libTriton offers Python bindings on its C++ API which allow you to build ana
 - <b>void addCallback(function cb, \ref py_CALLBACK_page kind)</b><br>
 Adds a callback at specific internal points. Your callback will be called each time the point is reached.
 
+- <b>void addSolverConstraint(\ref py_AstNode_page node)</b><br>
+Adds a symbolic constraint to the incremental solver session. The constraint is kept until its scope is popped (see pushSolver()).
+The translation of the nodes to z3 is cached by the session, so adding the path constraints one by one only translates the new nodes.
+
 - <b>void assignSymbolicExpressionToMemory(\ref py_SymbolicExpression_page symExpr, \ref py_MemoryAccess_page mem)</b><br>
 Assigns a \ref py_SymbolicExpression_page to a \ref py_MemoryAccess_page area. **Be careful**, use this function only if you know what you are doing.
 The symbolic expression (`symExpr`) must be aligned to the memory access.
@@ -75,6 +79,12 @@ Builds a symbolic register from a \ref py_Register_page with the SSA form.
 - <b>void clearPathConstraints(void)</b><br>
 Clears the logical conjunction vector of path constraints.
 
+- <b>void clearSolverCache(void)</b><br>
+Removes the queries of the solver cache and resets its statistics. The cache file is left as it is. See \ref solver_interface_cache.
+
+- <b>void clearUnrolledAsts(void)</b><br>
+Forgets the unrolled ASTs kept by unrollAst() and releases their nodes. The ASTs which depend on an expression replaced with \ref py_SymbolicExpression_page.setAst() are unrolled again without it.
+
 - <b>void concretizeAllMemory(void)</b><br>
 Concretizes all symbolic memory references.
 
@@ -135,6 +145,9 @@ Returns the current architecture used.
 - <b>\ref py_AstContext_page getAstContext(void)</b><br>
 Returns the AST context to create and modify nodes.
 
+- <b>dict getAstArenaStats(void)</b><br>
+Returns a dictionary which contains the allocation counters and the memory usage of the AST nodes arena.
+
 - <b>dict getAstDictionariesStats(void)</b><br>
 Returns a dictionary which contains all information about number of nodes allocated via AST dictionaries.
 
@@ -159,8 +172,15 @@ Returns the concrete value of a register.
 - <b>integer getConcreteSymbolicVariableValue(\ref py_SymbolicVariable_page symVar)</b><br>
 Returns the concrete value of a symbolic variable.
 
+- <b>dict getDisassemblyCacheStats(void)</b><br>
+Returns a dictionary which contains the hits, misses, evictions, invalidations, entries and capacity of the disassembly cache. See \ref py_MODE_page.
+
+- <b>[integer, ...] getMemoryTaintLabels(\ref py_MemoryAccess_page mem)</b><br>
+Returns the taint labels of a memory (the union of the labels of its bytes). See \ref engine_Taint_labels.
+
 - <b>dict getModel(\ref py_AstNode_page node)</b><br>
 Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} from a symbolic constraint.
+The query may be answered by the solver cache, see setSolverCacheSize().
 
 - <b>[dict, ...] getModels(\ref py_AstNode_page node, integer limit)</b><br>
 Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
@@ -186,6 +206,26 @@ Returns the max size (in bit) of the CPU register (GPR).
 - <b>integer getRegisterSize(void)</b><br>
 Returns the max size (in byte) of the CPU register (GPR).
 
+- <b>[integer, ...] getRegisterTaintLabels(\ref py_Register_page reg)</b><br>
+Returns the taint labels of a register (the union of the labels of its bytes). See \ref engine_Taint_labels.
+
+- <b>string getSolverCacheFile(void)</b><br>
+Returns the file of the solver cache, empty if the cache is not persistent.
+
+- <b>integer getSolverCacheSize(void)</b><br>
+Returns the maximum number of queries kept by the solver cache of getModel().
+
+- <b>dict getSolverCacheStats(void)</b><br>
+Returns the statistics of the solver cache: the number of `entries`, the `maxSize`, the number of `queries` looked up, of `hits`,
+of `modelHits` (queries answered by the model of another query), of `misses` (queries sent to the solver) and of `evictions`.
+
+- <b>dict getSolverModel(void)</b><br>
+Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} from the constraints of the incremental
+solver session. The dictionary is empty if they are unsatisfiable.
+
+- <b>integer getSolverScopes(void)</b><br>
+Returns the number of scopes opened in the incremental solver session.
+
 - <b>\ref py_SymbolicExpression_page getSymbolicExpressionFromId(intger symExprId)</b><br>
 Returns the symbolic expression corresponding to an id.
 
@@ -196,7 +236,7 @@ Returns all symbolic expressions as a dictionary of {integer SymExprId : \ref py
 Returns the map of symbolic memory as {integer address : \ref py_SymbolicExpression_page expr}.
 
 - <b>integer getSymbolicMemoryId(intger addr)</b><br>
-Returns the symbolic expression id corresponding to a memory address.
+Returns the symbolic expression id corresponding to a memory address. A byte which is part of a wider range gets its own expression the first time it is queried, the memory state is not modified.
 
 - <b>integer getSymbolicMemoryValue(intger addr)</b><br>
 Returns the symbolic memory value.
@@ -267,6 +307,9 @@ Returns true if the register is tainted.
 - <b>bool isRegisterValid(\ref py_Register_page reg)</b><br>
 Returns true if the register is valid.
 
+- <b>bool isSolverSat(void)</b><br>
+Returns true if the constraints of the incremental solver session are satisfiable.
+
 - <b>bool isSymbolicEngineEnabled(void)</b><br>
 Returns true if the symbolic execution engine is enabled.
 
@@ -282,9 +325,23 @@ Returns a new symbolic expression. Note that if there are simplification passes
 - <b>\ref py_SymbolicVariable_page newSymbolicVariable(intger varSize, string comment)</b><br>
 Returns a new symbolic variable.
 
+- <b>void popSolver(integer count=1)</b><br>
+Closes the `count` last scopes of the incremental solver session and drops their constraints.
+
+- <b>integer processBlock([record, ...] block, function callback)</b><br>
+Processes the records of a trace in one call and returns the number of supported instructions. A record is a tuple
+`(integer address, bytes opcode [, [(\ref py_Register_page reg, integer value), ...] registers [, [(integer baseAddr, bytes values), ...] memory [, bool callback]]])`.
+The concrete values of a record are set before processing its instruction. The `callback` is optional, it is called as
+`callback(\ref py_TritonContext_page ctx, \ref py_Instruction_page inst)` after each record whose last item is true.
+The block may also be a buffer (bytes or bytearray) of packed records without concrete values, each one being
+`struct.pack('<QB', address, len(opcode) | (0x80 if callback else 0)) + opcode`.
+
 - <b>bool processing(\ref py_Instruction_page inst)</b><br>
 Processes an instruction and updates engines according to the instruction semantics. Returns true if the instruction is supported. You must define an architecture before.
 
+- <b>void pushSolver(void)</b><br>
+Opens a new scope in the incremental solver session. E.g: push the negation of a branch, ask a model and pop it.
+
 - <b>void removeAllCallbacks(void)</b><br>
 Removes all recorded callbacks.
 
@@ -294,6 +351,9 @@ Removes a recorded callback.
 - <b>void reset(void)</b><br>
 Resets everything.
 
+- <b>void resetSolver(void)</b><br>
+Drops the incremental solver session: its constraints, its scopes and its translation cache.
+
 - <b>void setArchitecture(\ref py_ARCH_page arch)</b><br>
 Initializes an architecture. This function must be called before any call to the rest of the API.
 
@@ -323,6 +383,15 @@ the symbolic state (if it exists). You should probably use the concretize functi
 - <b>void setConcreteSymbolicVariableValue(\ref py_SymbolicVariable_page symVar, integer value)</b><br>
 Sets the concrete value of a symbolic variable.
 
+- <b>void setSolverCacheFile(string path)</b><br>
+Loads the queries of a file into the solver cache and appends the new ones to it, so that they are known by the next runs. The size of
+the cache must be set first. An empty path stops the persistence. Once the file holds twice the size of the cache, it is rewritten with the
+queries kept by the cache.
+
+- <b>void setSolverCacheSize(integer size)</b><br>
+Sets the maximum number of queries kept by the solver cache of getModel(). The cache is disabled by default (size 0). With the cache,
+the models hold every variable of the constraint, the ones left free by the solver take their concrete value.
+
 - <b>bool setTaintMemory(\ref py_MemoryAccess_page mem, bool flag)</b><br>
 Sets the targeted memory as tainted or not. Returns true if the memory is still tainted.
 
@@ -364,9 +433,15 @@ Taints an address. Returns true if the address is tainted.
 - <b>bool taintMemory(\ref py_MemoryAccess_page mem)</b><br>
 Taints a memory. Returns true if the memory is tainted.
 
+- <b>bool taintMemoryWithLabel(\ref py_MemoryAccess_page mem, integer label)</b><br>
+Taints a memory and adds `label` to the labels of its bytes. Returns true if the memory is tainted.
+
 - <b>bool taintRegister(\ref py_Register_page reg)</b><br>
 Taints a register. Returns true if the register is tainted.
 
+- <b>bool taintRegisterWithLabel(\ref py_Register_page reg, integer label)</b><br>
+Taints a register and adds `label` to the labels of its bytes. Returns true if the register is tainted.
+
 - <b>bool taintUnionMemoryImmediate(\ref py_MemoryAccess_page memDst)</b><br>
 Taints `memDst` with an union - `memDst` does not changes. Returns true if `memDst` is tainted.
 
@@ -393,7 +468,7 @@ tainted. Returns true if `regDst` is tainted.
 Removes the range `[baseAddr:size]` from the internal memory representation.
 
 - <b>\ref py_AstNode_page unrollAst(\ref py_AstNode_page node)</b><br>
-Unrolls the SSA form of a given AST.
+Unrolls the SSA form of a given AST. The given AST is not modified and the unrolled ASTs of the expressions are kept for the next calls.
 
 - <b>\ref py_AstNode_page unrollAstFromId(integer symExprId)</b><br>
 Unrolls the SSA form of a given symbolic expression id.
@@ -583,6 +658,22 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_addSolverConstraint(PyObject* self, PyObject* node) {
+        if (!PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "addSolverConstraint(): Expects a AstNode as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->addSolverConstraint(PyAstNode_AsAstNode(node));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_assignSymbolicExpressionToMemory(PyObject* self, PyObject* args) {
         PyObject* se  = nullptr;
         PyObject* mem = nullptr;
@@ -706,6 +797,32 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_clearSolverCache(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->clearSolverCache();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_clearUnrolledAsts(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->clearUnrolledAsts();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_concretizeAllMemory(PyObject* self, PyObject* noarg) {
         try {
           PyTritonContext_AsTritonContext(self)->concretizeAllMemory();
@@ -1138,6 +1255,24 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getAstArenaStats(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+
+        try {
+          std::map<std::string, triton::usize> stats = PyTritonContext_AsTritonContext(self)->getAstArenaStats();
+
+          ret = xPyDict_New();
+          for (auto it = stats.begin(); it != stats.end(); it++)
+            PyDict_SetItem(ret, PyString_FromString(it->first.c_str()), PyLong_FromUsize(it->second));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
       static PyObject* TritonContext_getAstDictionariesStats(PyObject* self, PyObject* noarg) {
         PyObject* ret = nullptr;
 
@@ -1249,6 +1384,48 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getDisassemblyCacheStats(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+
+        try {
+          std::map<std::string, triton::usize> stats = PyTritonContext_AsTritonContext(self)->getDisassemblyCacheStats();
+
+          ret = xPyDict_New();
+          for (auto it = stats.begin(); it != stats.end(); it++)
+            PyDict_SetItem(ret, PyString_FromString(it->first.c_str()), PyLong_FromUsize(it->second));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* TritonContext_getMemoryTaintLabels(PyObject* self, PyObject* mem) {
+        PyObject* ret = nullptr;
+        triton::usize index = 0;
+
+        if (!PyMemoryAccess_Check(mem))
+          return PyErr_Format(PyExc_TypeError, "getMemoryTaintLabels(): Expects a MemoryAccess as argument.");
+
+        try {
+          std::set<triton::uint32> labels = PyTritonContext_AsTritonContext(self)->getMemoryTaintLabels(*PyMemoryAccess_AsMemoryAccess(mem));
+
+          ret = xPyList_New(labels.size());
+          for (auto label : labels) {
+            PyList_SetItem(ret, index, PyLong_FromUint32(label));
+            index++;
+          }
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
       static PyObject* TritonContext_getModel(PyObject* self, PyObject* node) {
         PyObject* ret = nullptr;
 
@@ -1394,6 +1571,96 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getRegisterTaintLabels(PyObject* self, PyObject* reg) {
+        PyObject* ret = nullptr;
+        triton::usize index = 0;
+
+        if (!PyRegister_Check(reg))
+          return PyErr_Format(PyExc_TypeError, "getRegisterTaintLabels(): Expects a Register as argument.");
+
+        try {
+          std::set<triton::uint32> labels = PyTritonContext_AsTritonContext(self)->getRegisterTaintLabels(*PyRegister_AsRegister(reg));
+
+          ret = xPyList_New(labels.size());
+          for (auto label : labels) {
+            PyList_SetItem(ret, index, PyLong_FromUint32(label));
+            index++;
+          }
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* TritonContext_getSolverCacheFile(PyObject* self, PyObject* noarg) {
+        try {
+          return PyString_FromString(PyTritonContext_AsTritonContext(self)->getSolverCacheFile().c_str());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverCacheSize(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getSolverCacheSize());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverCacheStats(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+
+        try {
+          std::map<std::string, triton::usize> stats = PyTritonContext_AsTritonContext(self)->getSolverCacheStats();
+
+          ret = xPyDict_New();
+          for (auto it = stats.begin(); it != stats.end(); it++)
+            PyDict_SetItem(ret, PyString_FromString(it->first.c_str()), PyLong_FromUsize(it->second));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* TritonContext_getSolverModel(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+
+        try {
+          ret = xPyDict_New();
+          auto model = PyTritonContext_AsTritonContext(self)->getSolverModel();
+          for (auto it = model.begin(); it != model.end(); it++) {
+            PyDict_SetItem(ret, PyLong_FromUint32(it->first), PySolverModel(it->second));
+          }
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* TritonContext_getSolverScopes(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PyTritonContext_AsTritonContext(self)->getSolverScopes());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_getSymbolicExpressionFromId(PyObject* self, PyObject* symExprId) {
         if (!PyLong_Check(symExprId) && !PyInt_Check(symExprId))
           return PyErr_Format(PyExc_TypeError, "getSymbolicExpressionFromId(): Expects an integer as argument.");
@@ -1790,6 +2057,18 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_isSolverSat(PyObject* self, PyObject* noarg) {
+        try {
+          if (PyTritonContext_AsTritonContext(self)->isSolverSat() == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_isSymbolicEngineEnabled(PyObject* self, PyObject* noarg) {
         try {
           if (PyTritonContext_AsTritonContext(self)->isSymbolicEngineEnabled() == true)
@@ -1896,6 +2175,177 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_popSolver(PyObject* self, PyObject* args) {
+        PyObject* count = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|O", &count);
+
+        if (count != nullptr && !PyLong_Check(count) && !PyInt_Check(count))
+          return PyErr_Format(PyExc_TypeError, "popSolver(): Expects an integer as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->popSolver(count != nullptr ? PyLong_AsUint32(count) : 1);
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_processBlock(PyObject* self, PyObject* args) {
+        std::vector<triton::arch::TraceRecord> records;
+        PyObject* block    = nullptr;
+        PyObject* function = nullptr;
+        triton::usize count = 0;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &block, &function);
+
+        if (block == nullptr || (!PyList_Check(block) && !PyTuple_Check(block) && !PyBytes_Check(block) && !PyByteArray_Check(block)))
+          return PyErr_Format(PyExc_TypeError, "processBlock(): Expects a list of records or a buffer as first argument.");
+
+        if (function != nullptr && function != Py_None && !PyCallable_Check(function))
+          return PyErr_Format(PyExc_TypeError, "processBlock(): Expects a function as second argument.");
+
+        /*
+         * Packed records: the address (8 bytes, little endian), the size of the opcode (1 byte, its
+         * high bit requests the callback) and the opcode. They carry no concrete values.
+         */
+        if (PyBytes_Check(block) || PyByteArray_Check(block)) {
+          const triton::uint8* data = reinterpret_cast<triton::uint8*>(PyBytes_Check(block) ? PyBytes_AsString(block) : PyByteArray_AsString(block));
+          Py_ssize_t size           = PyBytes_Check(block) ? PyBytes_Size(block) : PyByteArray_Size(block);
+          Py_ssize_t offset         = 0;
+
+          while (offset < size) {
+            triton::uint64 address = 0;
+            triton::uint32 opSize  = 0;
+            bool callback          = false;
+
+            if (size - offset < 9)
+              return PyErr_Format(PyExc_TypeError, "processBlock(): Truncated record in the buffer.");
+
+            for (triton::uint32 i = 0; i < 8; i++)
+              address |= (static_cast<triton::uint64>(data[offset + i]) << (i * 8));
+
+            opSize   = (data[offset + 8] & 0x7f);
+            callback = ((data[offset + 8] & 0x80) != 0);
+            offset  += 9;
+
+            if (size - offset < opSize)
+              return PyErr_Format(PyExc_TypeError, "processBlock(): Truncated record in the buffer.");
+
+            try {
+              records.push_back(triton::arch::TraceRecord(address, data + offset, opSize));
+            }
+            catch (const triton::exceptions::Exception& e) {
+              return PyErr_Format(PyExc_TypeError, "%s", e.what());
+            }
+
+            records.back().callback = callback;
+            offset += opSize;
+          }
+        }
+
+        /* Convert the records before processing them */
+        Py_ssize_t size = (PyList_Check(block) || PyTuple_Check(block)) ? PySequence_Size(block) : 0;
+        records.reserve(records.size() + size);
+
+        for (Py_ssize_t i = 0; i < size; i++) {
+          PyObject* record = PySequence_Fast_GET_ITEM(block, i);
+
+          if (!PyTuple_Check(record) || PyTuple_Size(record) < 2 || PyTuple_Size(record) > 5)
+            return PyErr_Format(PyExc_TypeError, "processBlock(): Each record must be a tuple of 2 to 5 items.");
+
+          PyObject* address = PyTuple_GetItem(record, 0);
+          PyObject* opcode  = PyTuple_GetItem(record, 1);
+
+          if ((!PyLong_Check(address) && !PyInt_Check(address)) || !PyBytes_Check(opcode))
+            return PyErr_Format(PyExc_TypeError, "processBlock(): A record starts with an address and bytes.");
+
+          try {
+            records.push_back(triton::arch::TraceRecord(
+              PyLong_AsUint64(address),
+              reinterpret_cast<triton::uint8*>(PyBytes_AsString(opcode)),
+              static_cast<triton::uint32>(PyBytes_Size(opcode))
+            ));
+          }
+          catch (const triton::exceptions::Exception& e) {
+            return PyErr_Format(PyExc_TypeError, "%s", e.what());
+          }
+          triton::arch::TraceRecord& tr = records.back();
+
+          /* Registers */
+          if (PyTuple_Size(record) > 2 && PyTuple_GetItem(record, 2) != Py_None) {
+            PyObject* registers = PyTuple_GetItem(record, 2);
+            if (!PyList_Check(registers))
+              return PyErr_Format(PyExc_TypeError, "processBlock(): The registers of a record must be a list.");
+
+            for (Py_ssize_t j = 0; j < PyList_Size(registers); j++) {
+              PyObject* item = PyList_GetItem(registers, j);
+              if (!PyTuple_Check(item) || PyTuple_Size(item) != 2 || !PyRegister_Check(PyTuple_GetItem(item, 0)) ||
+                  (!PyLong_Check(PyTuple_GetItem(item, 1)) && !PyInt_Check(PyTuple_GetItem(item, 1))))
+                return PyErr_Format(PyExc_TypeError, "processBlock(): Each register of a record must be a tuple (Register, integer).");
+              tr.registers.push_back(std::make_pair(*PyRegister_AsRegister(PyTuple_GetItem(item, 0)), PyLong_AsUint512(PyTuple_GetItem(item, 1))));
+            }
+          }
+
+          /* Memory */
+          if (PyTuple_Size(record) > 3 && PyTuple_GetItem(record, 3) != Py_None) {
+            PyObject* memory = PyTuple_GetItem(record, 3);
+            if (!PyList_Check(memory))
+              return PyErr_Format(PyExc_TypeError, "processBlock(): The memory of a record must be a list.");
+
+            for (Py_ssize_t j = 0; j < PyList_Size(memory); j++) {
+              PyObject* item = PyList_GetItem(memory, j);
+              if (!PyTuple_Check(item) || PyTuple_Size(item) != 2 || !PyBytes_Check(PyTuple_GetItem(item, 1)) ||
+                  (!PyLong_Check(PyTuple_GetItem(item, 0)) && !PyInt_Check(PyTuple_GetItem(item, 0))))
+                return PyErr_Format(PyExc_TypeError, "processBlock(): Each memory area of a record must be a tuple (integer, bytes).");
+              triton::uint8* area = reinterpret_cast<triton::uint8*>(PyBytes_AsString(PyTuple_GetItem(item, 1)));
+              triton::usize  len  = static_cast<triton::usize>(PyBytes_Size(PyTuple_GetItem(item, 1)));
+              tr.memory.push_back(std::make_pair(PyLong_AsUint64(PyTuple_GetItem(item, 0)), std::vector<triton::uint8>(area, area + len)));
+            }
+          }
+
+          /* Callback */
+          if (PyTuple_Size(record) > 4)
+            tr.callback = (PyObject_IsTrue(PyTuple_GetItem(record, 4)) == 1);
+        }
+
+        try {
+          if (function == nullptr || function == Py_None) {
+            count = PyTritonContext_AsTritonContext(self)->processBlock(records);
+          }
+          else {
+            count = PyTritonContext_AsTritonContext(self)->processBlock(records, [self, function](triton::arch::TraceRecord& record) {
+              /********* Lambda *********/
+              PyObject* inst = triton::bindings::python::PyInstruction(record.instruction);
+              PyObject* ret  = PyObject_CallFunctionObjArgs(function, self, inst, nullptr);
+
+              Py_DECREF(inst);
+
+              /* Check the call */
+              if (ret == nullptr) {
+                PyErr_Print();
+                throw triton::exceptions::Callbacks("TritonContext::processBlock(): Fail to call the python callback.");
+              }
+
+              Py_DECREF(ret);
+              /********* End of lambda *********/
+            });
+          }
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return PyLong_FromUsize(count);
+      }
+
+
       static PyObject* TritonContext_processing(PyObject* self, PyObject* inst) {
         if (!PyInstruction_Check(inst))
           return PyErr_Format(PyExc_TypeError, "processing(): Expects an Instruction as argument.");
@@ -1911,6 +2361,19 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_pushSolver(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->pushSolver();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_removeAllCallbacks(PyObject* self, PyObject* noarg) {
         try {
           PyTritonContext_AsTritonContext(self)->removeAllCallbacks();
@@ -1982,6 +2445,19 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_resetSolver(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->resetSolver();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setArchitecture(PyObject* self, PyObject* arg) {
         if (!PyLong_Check(arg) && !PyInt_Check(arg))
           return PyErr_Format(PyExc_TypeError, "setArchitecture(): Expects an ARCH as argument.");
@@ -2184,6 +2660,38 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_setSolverCacheFile(PyObject* self, PyObject* path) {
+        if (!PyString_Check(path))
+          return PyErr_Format(PyExc_TypeError, "setSolverCacheFile(): Expects a string as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverCacheFile(PyString_AsString(path));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_setSolverCacheSize(PyObject* self, PyObject* size) {
+        if (!PyLong_Check(size) && !PyInt_Check(size))
+          return PyErr_Format(PyExc_TypeError, "setSolverCacheSize(): Expects an integer as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverCacheSize(PyLong_AsUsize(size));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setTaintMemory(PyObject* self, PyObject* args) {
         PyObject* mem  = nullptr;
         PyObject* flag = nullptr;
@@ -2426,6 +2934,30 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_taintMemoryWithLabel(PyObject* self, PyObject* args) {
+        PyObject* mem   = nullptr;
+        PyObject* label = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &mem, &label);
+
+        if (mem == nullptr || !PyMemoryAccess_Check(mem))
+          return PyErr_Format(PyExc_TypeError, "taintMemoryWithLabel(): Expects a MemoryAccess as first argument.");
+
+        if (label == nullptr || (!PyLong_Check(label) && !PyInt_Check(label)))
+          return PyErr_Format(PyExc_TypeError, "taintMemoryWithLabel(): Expects an integer as second argument.");
+
+        try {
+          if (PyTritonContext_AsTritonContext(self)->taintMemoryWithLabel(*PyMemoryAccess_AsMemoryAccess(mem), PyLong_AsUint32(label)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_taintRegister(PyObject* self, PyObject* reg) {
         if (!PyRegister_Check(reg))
           return PyErr_Format(PyExc_TypeError, "taintRegister(): Expects a Register as argument.");
@@ -2441,6 +2973,30 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_taintRegisterWithLabel(PyObject* self, PyObject* args) {
+        PyObject* reg   = nullptr;
+        PyObject* label = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &reg, &label);
+
+        if (reg == nullptr || !PyRegister_Check(reg))
+          return PyErr_Format(PyExc_TypeError, "taintRegisterWithLabel(): Expects a Register as first argument.");
+
+        if (label == nullptr || (!PyLong_Check(label) && !PyInt_Check(label)))
+          return PyErr_Format(PyExc_TypeError, "taintRegisterWithLabel(): Expects an integer as second argument.");
+
+        try {
+          if (PyTritonContext_AsTritonContext(self)->taintRegisterWithLabel(*PyRegister_AsRegister(reg), PyLong_AsUint32(label)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_taintUnionMemoryImmediate(PyObject* self, PyObject* mem) {
         if (!PyMemoryAccess_Check(mem))
           return PyErr_Format(PyExc_TypeError, "taintUnionMemoryImmediate(): Expects a MemoryAccess as argument.");
@@ -2701,6 +3257,7 @@ namespace triton {
       //! TritonContext methods.
       PyMethodDef TritonContext_callbacks[] = {
         {"addCallback",                         (PyCFunction)TritonContext_addCallback,                            METH_VARARGS,       ""},
+        {"addSolverConstraint",                 (PyCFunction)TritonContext_addSolverConstraint,                    METH_O,             ""},
         {"assignSymbolicExpressionToMemory",    (PyCFunction)TritonContext_assignSymbolicExpressionToMemory,       METH_VARARGS,       ""},
         {"assignSymbolicExpressionToRegister",  (PyCFunction)TritonContext_assignSymbolicExpressionToRegister,     METH_VARARGS,       ""},
         {"buildSemantics",                      (PyCFunction)TritonContext_buildSemantics,                         METH_O,             ""},
@@ -2708,6 +3265,8 @@ namespace triton {
         {"buildSymbolicMemory",                 (PyCFunction)TritonContext_buildSymbolicMemory,                    METH_O,             ""},
         {"buildSymbolicRegister",               (PyCFunction)TritonContext_buildSymbolicRegister,                  METH_O,             ""},
         {"clearPathConstraints",                (PyCFunction)TritonContext_clearPathConstraints,                   METH_NOARGS,        ""},
+        {"clearSolverCache",                    (PyCFunction)TritonContext_clearSolverCache,                       METH_NOARGS,        ""},
+        {"clearUnrolledAsts",                   (PyCFunction)TritonContext_clearUnrolledAsts,                      METH_NOARGS,        ""},
         {"concretizeAllMemory",                 (PyCFunction)TritonContext_concretizeAllMemory,                    METH_NOARGS,        ""},
         {"concretizeAllRegister",               (PyCFunction)TritonContext_concretizeAllRegister,                  METH_NOARGS,        ""},
         {"concretizeMemory",                    (PyCFunction)TritonContext_concretizeMemory,                       METH_O,             ""},
@@ -2727,6 +3286,7 @@ namespace triton {
         {"getAllRegisters",                     (PyCFunction)TritonContext_getAllRegisters,                        METH_NOARGS,        ""},
         {"getArchitecture",                     (PyCFunction)TritonContext_getArchitecture,                        METH_NOARGS,        ""},
         {"getAstContext",                       (PyCFunction)TritonContext_getAstContext,                          METH_NOARGS,        ""},
+        {"getAstArenaStats",                    (PyCFunction)TritonContext_getAstArenaStats,                       METH_NOARGS,        ""},
         {"getAstDictionariesStats",             (PyCFunction)TritonContext_getAstDictionariesStats,                METH_NOARGS,        ""},
         {"getAstFromId",                        (PyCFunction)TritonContext_getAstFromId,                           METH_O,             ""},
         {"getAstRepresentationMode",            (PyCFunction)TritonContext_getAstRepresentationMode,               METH_NOARGS,        ""},
@@ -2734,6 +3294,8 @@ namespace triton {
         {"getConcreteMemoryValue",              (PyCFunction)TritonContext_getConcreteMemoryValue,                 METH_O,             ""},
         {"getConcreteRegisterValue",            (PyCFunction)TritonContext_getConcreteRegisterValue,               METH_O,             ""},
         {"getConcreteSymbolicVariableValue",    (PyCFunction)TritonContext_getConcreteSymbolicVariableValue,       METH_O,             ""},
+        {"getDisassemblyCacheStats",            (PyCFunction)TritonContext_getDisassemblyCacheStats,               METH_NOARGS,        ""},
+        {"getMemoryTaintLabels",                (PyCFunction)TritonContext_getMemoryTaintLabels,                   METH_O,             ""},
         {"getModel",                            (PyCFunction)TritonContext_getModel,                               METH_O,             ""},
         {"getModels",                           (PyCFunction)TritonContext_getModels,                              METH_VARARGS,       ""},
         {"getParentRegister",                   (PyCFunction)TritonContext_getParentRegister,                      METH_O,             ""},
@@ -2743,6 +3305,12 @@ namespace triton {
         {"getRegister",                         (PyCFunction)TritonContext_getRegister,                            METH_O,             ""},
         {"getRegisterBitSize",                  (PyCFunction)TritonContext_getRegisterBitSize,                     METH_NOARGS,        ""},
         {"getRegisterSize",                     (PyCFunction)TritonContext_getRegisterSize,                        METH_NOARGS,        ""},
+        {"getRegisterTaintLabels",              (PyCFunction)TritonContext_getRegisterTaintLabels,                 METH_O,             ""},
+        {"getSolverCacheFile",                  (PyCFunction)TritonContext_getSolverCacheFile,                     METH_NOARGS,        ""},
+        {"getSolverCacheSize",                  (PyCFunction)TritonContext_getSolverCacheSize,                     METH_NOARGS,        ""},
+        {"getSolverCacheStats",                 (PyCFunction)TritonContext_getSolverCacheStats,                    METH_NOARGS,        ""},
+        {"getSolverModel",                      (PyCFunction)TritonContext_getSolverModel,                         METH_NOARGS,        ""},
+        {"getSolverScopes",                     (PyCFunction)TritonContext_getSolverScopes,                        METH_NOARGS,        ""},
         {"getSymbolicExpressionFromId",         (PyCFunction)TritonContext_getSymbolicExpressionFromId,            METH_O,             ""},
         {"getSymbolicExpressions",              (PyCFunction)TritonContext_getSymbolicExpressions,                 METH_NOARGS,        ""},
         {"getSymbolicMemory",                   (PyCFunction)TritonContext_getSymbolicMemory,                      METH_NOARGS,        ""},
@@ -2767,21 +3335,28 @@ namespace triton {
         {"isRegisterSymbolized",                (PyCFunction)TritonContext_isRegisterSymbolized,                   METH_O,             ""},
         {"isRegisterTainted",                   (PyCFunction)TritonContext_isRegisterTainted,                      METH_O,             ""},
         {"isRegisterValid",                     (PyCFunction)TritonContext_isRegisterValid,                        METH_O,             ""},
+        {"isSolverSat",                         (PyCFunction)TritonContext_isSolverSat,                            METH_NOARGS,        ""},
         {"isSymbolicEngineEnabled",             (PyCFunction)TritonContext_isSymbolicEngineEnabled,                METH_NOARGS,        ""},
         {"isSymbolicExpressionIdExists",        (PyCFunction)TritonContext_isSymbolicExpressionIdExists,           METH_O,             ""},
         {"isTaintEngineEnabled",                (PyCFunction)TritonContext_isTaintEngineEnabled,                   METH_NOARGS,        ""},
         {"newSymbolicExpression",               (PyCFunction)TritonContext_newSymbolicExpression,                  METH_VARARGS,       ""},
         {"newSymbolicVariable",                 (PyCFunction)TritonContext_newSymbolicVariable,                    METH_VARARGS,       ""},
+        {"popSolver",                           (PyCFunction)TritonContext_popSolver,                              METH_VARARGS,       ""},
+        {"processBlock",                        (PyCFunction)TritonContext_processBlock,                           METH_VARARGS,       ""},
         {"processing",                          (PyCFunction)TritonContext_processing,                             METH_O,             ""},
+        {"pushSolver",                          (PyCFunction)TritonContext_pushSolver,                             METH_NOARGS,        ""},
         {"removeAllCallbacks",                  (PyCFunction)TritonContext_removeAllCallbacks,                     METH_NOARGS,        ""},
         {"removeCallback",                      (PyCFunction)TritonContext_removeCallback,                         METH_VARARGS,       ""},
         {"reset",                               (PyCFunction)TritonContext_reset,                                  METH_NOARGS,        ""},
+        {"resetSolver",                         (PyCFunction)TritonContext_resetSolver,                            METH_NOARGS,        ""},
         {"setArchitecture",                     (PyCFunction)TritonContext_setArchitecture,                        METH_O,             ""},
         {"setAstRepresentationMode",            (PyCFunction)TritonContext_setAstRepresentationMode,               METH_O,             ""},
         {"setConcreteMemoryAreaValue",          (PyCFunction)TritonContext_setConcreteMemoryAreaValue,             METH_VARARGS,       ""},
         {"setConcreteMemoryValue",              (PyCFunction)TritonContext_setConcreteMemoryValue,                 METH_VARARGS,       ""},
         {"setConcreteRegisterValue",            (PyCFunction)TritonContext_setConcreteRegisterValue,               METH_VARARGS,       ""},
         {"setConcreteSymbolicVariableValue",    (PyCFunction)TritonContext_setConcreteSymbolicVariableValue,       METH_VARARGS,       ""},
+        {"setSolverCacheFile",                  (PyCFunction)TritonContext_setSolverCacheFile,                     METH_O,             ""},
+        {"setSolverCacheSize",                  (PyCFunction)TritonContext_setSolverCacheSize,                     METH_O,             ""},
         {"setTaintMemory",                      (PyCFunction)TritonContext_setTaintMemory,                         METH_VARARGS,       ""},
         {"setTaintRegister",                    (PyCFunction)TritonContext_setTaintRegister,                       METH_VARARGS,       ""},
         {"simplify",                            (PyCFunction)TritonContext_simplify,                               METH_VARARGS,       ""},
@@ -2793,7 +3368,9 @@ namespace triton {
         {"taintAssignmentRegisterMemory",       (PyCFunction)TritonContext_taintAssignmentRegisterMemory,          METH_VARARGS,       ""},
         {"taintAssignmentRegisterRegister",     (PyCFunction)TritonContext_taintAssignmentRegisterRegister,        METH_VARARGS,       ""},
         {"taintMemory",                         (PyCFunction)TritonContext_taintMemory,                            METH_O,             ""},
+        {"taintMemoryWithLabel",                (PyCFunction)TritonContext_taintMemoryWithLabel,                   METH_VARARGS,       ""},
         {"taintRegister",                       (PyCFunction)TritonContext_taintRegister,                          METH_O,             ""},
+        {"taintRegisterWithLabel",              (PyCFunction)TritonContext_taintRegisterWithLabel,                 METH_VARARGS,       ""},
         {"taintUnionMemoryImmediate",           (PyCFunction)TritonContext_taintUnionMemoryImmediate,              METH_O,             ""},
         {"taintUnionMemoryMemory",              (PyCFunction)TritonContext_taintUnionMemoryMemory,                 METH_VARARGS,       ""},
         {"taintUnionMemoryRegister",            (PyCFunction)TritonContext_taintUnionMemoryRegister,               METH_VARARGS,       ""},
@@ -0,0 +1,371 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <triton/exceptions.hpp>
+#include <triton/solverCache.hpp>
+#include <triton/symbolicEnums.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/symbolicVariable.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      /* Returns true if both ASTs have the same structure. A shared pair of nodes is compared once. */
+      static bool isSameAst(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) {
+        std::set<std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*>> compared;
+        std::vector<std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*>> worklist;
+
+        worklist.push_back(std::make_pair(node1, node2));
+        while (!worklist.empty()) {
+          std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*> pair = worklist.back();
+          triton::ast::AbstractNode* a = pair.first;
+          triton::ast::AbstractNode* b = pair.second;
+
+          worklist.pop_back();
+          if (a == b || compared.insert(pair).second == false)
+            continue;
+
+          if (a->getKind() != b->getKind() || a->getBitvectorSize() != b->getBitvectorSize() || a->getChildren().size() != b->getChildren().size())
+            return false;
+
+          /* The leaves hold their value, the other nodes only differ by their children */
+          switch (a->getKind()) {
+            case triton::ast::DECIMAL_NODE:
+              if (reinterpret_cast<triton::ast::DecimalNode*>(a)->getValue() != reinterpret_cast<triton::ast::DecimalNode*>(b)->getValue())
+                return false;
+              break;
+
+            case triton::ast::STRING_NODE:
+              if (reinterpret_cast<triton::ast::StringNode*>(a)->getValue() != reinterpret_cast<triton::ast::StringNode*>(b)->getValue())
+                return false;
+              break;
+
+            case triton::ast::VARIABLE_NODE:
+              if (reinterpret_cast<triton::ast::VariableNode*>(a)->getVar().getId() != reinterpret_cast<triton::ast::VariableNode*>(b)->getVar().getId())
+                return false;
+              break;
+
+            case triton::ast::REFERENCE_NODE:
+              if (reinterpret_cast<triton::ast::ReferenceNode*>(a)->getSymbolicExpression().getId() != reinterpret_cast<triton::ast::ReferenceNode*>(b)->getSymbolicExpression().getId())
+                return false;
+              break;
+
+            default:
+              break;
+          }
+
+          for (triton::usize i = 0; i < a->getChildren().size(); i++)
+            worklist.push_back(std::make_pair(a->getChildren()[i], b->getChildren()[i]));
+        }
+
+        return true;
+      }
+
+
+      SolverCache::SolverCache() {
+        this->lines   = 0;
+        this->maxSize = 0;
+        this->clear();
+      }
+
+
+      SolverCache::SolverCache(const SolverCache& other) {
+        this->copy(other);
+      }
+
+
+      SolverCache::~SolverCache() {
+        this->clear();
+      }
+
+
+      SolverCache& SolverCache::operator=(const SolverCache& other) {
+        if (this != &other) {
+          this->clear();
+          this->copy(other);
+        }
+        return *this;
+      }
+
+
+      /* The index points into the list of entries, it is rebuilt on the copied list. Both caches hold a reference to the constraints. */
+      void SolverCache::copy(const SolverCache& other) {
+        this->entries   = other.entries;
+        this->evictions = other.evictions;
+        this->hits      = other.hits;
+        this->lines     = other.lines;
+        this->maxSize   = other.maxSize;
+        this->misses    = other.misses;
+        this->modelHits = other.modelHits;
+        this->path      = other.path;
+        this->queries   = other.queries;
+
+        this->index.clear();
+        for (auto it = this->entries.begin(); it != this->entries.end(); it++) {
+          this->index[it->hash] = it;
+          if (it->node != nullptr)
+            it->node->retain();
+        }
+      }
+
+
+      bool SolverCache::isEnabled(void) const {
+        return (this->maxSize != 0);
+      }
+
+
+      triton::usize SolverCache::getMaxSize(void) const {
+        return this->maxSize;
+      }
+
+
+      void SolverCache::setMaxSize(triton::usize size) {
+        this->maxSize = size;
+
+        while (this->entries.size() > this->maxSize) {
+          this->evict();
+          this->evictions++;
+        }
+      }
+
+
+      void SolverCache::evict(void) {
+        triton::ast::AbstractNode* node = this->entries.back().node;
+
+        this->index.erase(this->entries.back().hash);
+        this->entries.pop_back();
+        if (node != nullptr)
+          node->release();
+      }
+
+
+      void SolverCache::record(const triton::uint512& hash, triton::ast::AbstractNode* node, const std::map<triton::uint32, SolverModel>& model) {
+        auto it = this->index.find(hash);
+
+        if (node != nullptr)
+          node->retain();
+
+        /* Another constraint with the same hash is replaced */
+        if (it != this->index.end()) {
+          triton::ast::AbstractNode* old = it->second->node;
+          it->second->node  = node;
+          it->second->model = model;
+          this->entries.splice(this->entries.begin(), this->entries, it->second);
+          if (old != nullptr)
+            old->release();
+          return;
+        }
+
+        Entry entry;
+        entry.hash  = hash;
+        entry.node  = node;
+        entry.model = model;
+        this->entries.push_front(entry);
+        this->index[hash] = this->entries.begin();
+
+        /* Evict the least recently used entries */
+        this->setMaxSize(this->maxSize);
+      }
+
+
+      void SolverCache::append(std::ostream& stream, const Entry& entry) const {
+        stream << "0x" << std::hex << entry.hash << std::dec << "\t";
+        for (const auto& item : entry.model)
+          stream << " " << item.second.getName() << "=" << item.second.getValue();
+        stream << std::endl;
+      }
+
+
+      bool SolverCache::lookup(const triton::uint512& hash, triton::ast::AbstractNode* node, const ModelCheck& check, std::map<triton::uint32, SolverModel>& model) {
+        if (!this->isEnabled())
+          return false;
+
+        this->queries++;
+
+        /*
+         * The answer of the same constraint is trusted, without checking it. The constraint of an
+         * entry loaded from a file is unknown, its model is checked.
+         */
+        auto it = this->index.find(hash);
+        if (it != this->index.end()) {
+          Entry& entry = *it->second;
+          bool same = (entry.node != nullptr && isSameAst(entry.node, node));
+          std::map<triton::uint32, SolverModel> result = entry.model;
+
+          if (same || (entry.node == nullptr && check(entry.model, result))) {
+            /* The checked entry of a file is now known by its constraint */
+            if (entry.node == nullptr)
+              this->record(hash, node, result);
+            else
+              this->entries.splice(this->entries.begin(), this->entries, it->second);
+            this->hits++;
+            model = result;
+            return true;
+          }
+        }
+
+        /* The recent models often fit a constraint which only differs by its last branch */
+        triton::uint32 candidates = 0;
+        for (auto entry = this->entries.begin(); entry != this->entries.end() && candidates < SOLVER_CACHE_CANDIDATES; entry++) {
+          if (entry->hash == hash || entry->model.empty())
+            continue;
+
+          std::map<triton::uint32, SolverModel> result;
+          candidates++;
+
+          if (check(entry->model, result)) {
+            this->modelHits++;
+            this->insert(hash, node, result);
+            model = result;
+            return true;
+          }
+        }
+
+        this->misses++;
+        return false;
+      }
+
+
+      void SolverCache::insert(const triton::uint512& hash, triton::ast::AbstractNode* node, const std::map<triton::uint32, SolverModel>& model) {
+        if (!this->isEnabled())
+          return;
+
+        this->record(hash, node, model);
+
+        if (this->path.empty())
+          return;
+
+        /* The evicted entries are dropped from the file once they fill half of it */
+        if (this->lines >= 2 * this->maxSize) {
+          this->save(this->path);
+          return;
+        }
+
+        std::ofstream file(this->path, std::ios::app);
+        if (!file)
+          throw triton::exceptions::SolverEngine("SolverCache::insert(): Cannot write the cache file.");
+        this->append(file, this->entries.front());
+        this->lines++;
+      }
+
+
+      void SolverCache::save(const std::string& path) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+          throw triton::exceptions::SolverEngine("SolverCache::save(): Cannot write the cache file.");
+
+        /* The oldest entries first, like the lines appended */
+        for (auto it = this->entries.rbegin(); it != this->entries.rend(); it++)
+          this->append(file, *it);
+        this->lines = this->entries.size();
+      }
+
+
+      const std::string& SolverCache::getFile(void) const {
+        return this->path;
+      }
+
+
+      void SolverCache::setFile(const std::string& path) {
+        this->path.clear();
+
+        if (path.empty())
+          return;
+
+        if (!this->isEnabled())
+          throw triton::exceptions::SolverEngine("SolverCache::setFile(): The cache is disabled, its size must be set first.");
+
+        /* Each line is an entry: the hash of the constraint and the name=value pairs of its model, separated by a tab */
+        std::ifstream input(path);
+        std::string line;
+
+        while (std::getline(input, line)) {
+          std::map<triton::uint32, SolverModel> model;
+
+          if (line.empty())
+            continue;
+
+          try {
+            std::string::size_type sep = line.find('\t');
+
+            if (sep == std::string::npos)
+              throw std::invalid_argument(line);
+
+            triton::uint512 hash = triton::uint512(line.substr(0, sep));
+
+            std::istringstream stream(line.substr(sep + 1));
+            std::string item;
+
+            while (stream >> item) {
+              std::string::size_type eq = item.find('=');
+              if (eq == std::string::npos || item.compare(0, TRITON_SYMVAR_NAME_SIZE, TRITON_SYMVAR_NAME) != 0)
+                throw std::invalid_argument(item);
+
+              SolverModel m = SolverModel(item.substr(0, eq), triton::uint512(item.substr(eq + 1)));
+              model[m.getId()] = m;
+            }
+
+            /*
+             * The last lines are the most recent entries, their constraints are unknown. An unsatisfiable
+             * answer cannot be confirmed without its constraint, it is not loaded.
+             */
+            if (!model.empty())
+              this->record(hash, nullptr, model);
+          }
+          catch (const std::runtime_error&) {
+            throw triton::exceptions::SolverEngine("SolverCache::setFile(): Invalid entry in the cache file.");
+          }
+          catch (const std::logic_error&) {
+            throw triton::exceptions::SolverEngine("SolverCache::setFile(): Invalid entry in the cache file.");
+          }
+        }
+        input.close();
+
+        /* The file is rewritten with the entries kept, so that it does not grow without bound */
+        this->save(path);
+        this->path = path;
+      }
+
+
+      void SolverCache::clear(void) {
+        while (!this->entries.empty())
+          this->evict();
+        this->evictions = 0;
+        this->hits      = 0;
+        this->misses    = 0;
+        this->modelHits = 0;
+        this->queries   = 0;
+      }
+
+
+      std::map<std::string, triton::usize> SolverCache::getStats(void) const {
+        std::map<std::string, triton::usize> stats;
+
+        stats["entries"]    = this->entries.size();
+        stats["maxSize"]    = this->maxSize;
+        stats["queries"]    = this->queries;
+        stats["hits"]       = this->hits;
+        stats["modelHits"]  = this->modelHits;
+        stats["misses"]     = this->misses;
+        stats["evictions"]  = this->evictions;
+
+        return stats;
+      }
+
+    };
+  };
+};
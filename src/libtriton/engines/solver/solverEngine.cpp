@@ -7,10 +7,13 @@
 
 #include <z3++.h>                        // for expr, model, solver, expr_ve...
 #include <z3_api.h>                      // for Z3_ast, _Z3_ast
-#include <iosfwd>                        // for ostringstream
+#include <sstream>                       // for ostringstream
+#include <memory>                        // for unique_ptr
+#include <new>                           // for nothrow
 #include <string>                        // for string
-#include <triton/astContext.hpp>         // for AstContext
+#include <vector>                        // for vector
 #include <triton/exceptions.hpp>         // for SolverEngine
+#include <triton/solverCache.hpp>        // for SolverCache
 #include <triton/solverEngine.hpp>       // for SolverEngine
 #include <triton/solverModel.hpp>        // for SolverModel
 #include <triton/tritonToZ3Ast.hpp>      // for TritonToZ3Ast
@@ -90,6 +93,55 @@ for (auto it = model.begin(); it != model.end(); it++) {
 }
 ~~~~~~~~~~~~~
 
+\section solver_interface_session Incremental session
+<hr>
+
+Each call to triton::API::getModel() translates the whole constraint into a fresh z3 context. When the constraints share a long prefix
+(e.g. a concolic execution which negates each branch of a trace), the solver engine also offers an incremental session. The session
+owns a long-lived z3 context and solver, the constraints are added one by one with triton::API::addSolverConstraint() and are scoped
+with triton::API::pushSolver() and triton::API::popSolver(). The translation of each node is cached by the session, so only the new
+nodes of a constraint are translated. The cached nodes are retained until triton::API::resetSolver().
+
+~~~~~~~~~~~~~{cpp}
+for (const auto& pc : api.getPathConstraints()) {
+  for (const auto& branch : pc.getBranchConstraints()) {
+    if (std::get<0>(branch) == false) {
+      api.pushSolver();
+      api.addSolverConstraint(std::get<3>(branch));
+      auto model = api.getSolverModel();
+      api.popSolver();
+    }
+  }
+  api.addSolverConstraint(pc.getTakenPathConstraintAst());
+}
+~~~~~~~~~~~~~
+
+\section solver_interface_cache Query cache
+<hr>
+
+A concolic loop often sends the same constraints to triton::API::getModel(), iteration after iteration. When its size is set with
+triton::API::setSolverCacheSize(), the solver engine keeps the answers of the last queries, keyed by the structural hash of the
+unrolled constraint (the expression ids do not matter). Before calling the solver, a query is answered by:
+
+- its own entry, if it has been recorded for a constraint of the same structure (two constraints may share a hash). Its
+answer is returned as it is, the constraint is not even translated for the solver.
+- the model of one of the most recent entries (triton::engines::solver::SOLVER_CACHE_CANDIDATES), if it satisfies the constraint.
+
+A model is checked by evaluating the constraint with its values, the variables which are not in the model keep their concrete
+value. A model returned with the cache enabled holds every variable of the constraint, the ones which the solver leaves free
+take their concrete value, so that a hit and a miss return the same variables. The least recently used entries are evicted
+once the cache is full, and triton::API::getSolverCacheStats() returns the number of hits and misses. Only the sat and unsat
+answers of the solver are kept, an unknown one (e.g. a timeout) is not. With triton::API::setSolverCacheFile(), the entries
+are loaded from a file and the new ones are appended to it, so that the next runs on the same binary start with them. Once
+the file holds twice the size of the cache, it is rewritten with the entries kept. The file only holds the hashes and the
+models: a loaded model is checked against the constraint, and the unsatisfiable answers are not loaded.
+
+~~~~~~~~~~~~~{cpp}
+api.setSolverCacheSize(10000);
+api.setSolverCacheFile("queries.cache");
+auto model = api.getModel(constraint);
+~~~~~~~~~~~~~
+
 */
 
 
@@ -110,20 +162,76 @@ namespace triton {
       }
 
 
+      /* Converts a z3 model to a Triton one. If `blocks` is defined, it receives the constraints which exclude this model. */
+      static inline std::map<triton::uint32, SolverModel> toSolverModel(z3::context& ctx, z3::model& m, z3::expr_vector* blocks) {
+        std::map<triton::uint32, SolverModel> smodel;
+
+        for (triton::uint32 i = 0; i < m.size(); i++) {
+
+          /* Get the z3 variable */
+          z3::func_decl z3Variable = m[i];
+
+          /* Get the name as std::string from a z3 variable */
+          std::string varName = z3Variable.name().str();
+
+          /* Get z3 expr */
+          z3::expr exp = m.get_const_interp(z3Variable);
+
+          /* Get the size of a z3 expr */
+          triton::uint32 bvSize = exp.get_sort().bv_size();
+
+          /* Get the value of a z3 expr */
+          std::string svalue = Z3_get_numeral_string(ctx, exp);
+
+          /* Convert a string value to a integer value */
+          triton::uint512 value = triton::uint512(svalue);
+
+          /* Create a triton model */
+          SolverModel trionModel = SolverModel(varName, value);
+
+          /* Map the result */
+          smodel[trionModel.getId()] = trionModel;
+
+          /* Uniq result */
+          if (blocks && exp.get_sort().is_bv())
+            blocks->push_back(ctx.bv_const(varName.c_str(), bvSize) != ctx.bv_val(svalue.c_str(), bvSize));
+        }
+
+        return smodel;
+      }
+
+
       SolverEngine::SolverEngine(triton::engines::symbolic::SymbolicEngine* symbolicEngine) {
         if (symbolicEngine == nullptr)
           throw triton::exceptions::SolverEngine("SolverEngine::SolverEngine(): The symbolicEngine API cannot be null.");
         this->symbolicEngine = symbolicEngine;
+        this->sessionAst     = nullptr;
+        this->sessionSolver  = nullptr;
+        this->sessionScopes  = 0;
       }
 
 
+      /* The incremental session is not shared, a copy starts with an empty one. The query cache is copied. */
       SolverEngine::SolverEngine(const SolverEngine& other) {
+        this->cache          = other.cache;
         this->symbolicEngine = other.symbolicEngine;
+        this->sessionAst     = nullptr;
+        this->sessionSolver  = nullptr;
+        this->sessionScopes  = 0;
+      }
+
+
+      SolverEngine::~SolverEngine() {
+        this->resetSolver();
       }
 
 
       SolverEngine& SolverEngine::operator=(const SolverEngine& other) {
-        this->symbolicEngine = other.symbolicEngine;
+        if (this != &other) {
+          this->resetSolver();
+          this->cache          = other.cache;
+          this->symbolicEngine = other.symbolicEngine;
+        }
         return *this;
       }
 
@@ -152,39 +260,8 @@ namespace triton {
           z3::model m = solver.get_model();
 
           /* Traversing the model */
-          std::map<triton::uint32, SolverModel> smodel;
           z3::expr_vector args(ctx);
-          for (triton::uint32 i = 0; i < m.size(); i++) {
-
-            /* Get the z3 variable */
-            z3::func_decl z3Variable = m[i];
-
-            /* Get the name as std::string from a z3 variable */
-            std::string varName = z3Variable.name().str();
-
-            /* Get z3 expr */
-            z3::expr exp = m.get_const_interp(z3Variable);
-
-            /* Get the size of a z3 expr */
-            triton::uint32 bvSize = exp.get_sort().bv_size();
-
-            /* Get the value of a z3 expr */
-            std::string svalue = Z3_get_numeral_string(ctx, exp);
-
-            /* Convert a string value to a integer value */
-            triton::uint512 value = triton::uint512(svalue);
-
-            /* Create a triton model */
-            SolverModel trionModel = SolverModel(varName, value);
-
-            /* Map the result */
-            smodel[trionModel.getId()] = trionModel;
-
-            /* Uniq result */
-            if (exp.get_sort().is_bv())
-              args.push_back(ctx.bv_const(varName.c_str(), bvSize) != ctx.bv_val(svalue.c_str(), bvSize));
-
-          }
+          std::map<triton::uint32, SolverModel> smodel = toSolverModel(ctx, m, &args);
 
           /* Escape last models */
           solver.add(triton::engines::solver::mk_or(args));
@@ -205,6 +282,9 @@ namespace triton {
         std::map<triton::uint32, SolverModel> ret;
         std::list<std::map<triton::uint32, SolverModel>> allModels;
 
+        if (this->cache.isEnabled())
+          return this->getCachedModel(node);
+
         allModels = this->getModels(node, 1);
         if (allModels.size() > 0)
           ret = allModels.front();
@@ -212,6 +292,228 @@ namespace triton {
         return ret;
       }
 
+
+      std::map<triton::uint32, SolverModel> SolverEngine::getCachedModel(triton::ast::AbstractNode* node) const {
+        std::map<triton::uint32, SolverModel> ret;
+        std::vector<triton::ast::AbstractNode*> nodes;
+
+        if (node == nullptr)
+          throw triton::exceptions::SolverEngine("SolverEngine::getCachedModel(): node cannot be null.");
+
+        if (node->isLogical() == false)
+          throw triton::exceptions::SolverEngine("SolverEngine::getCachedModel(): Must be a logical node.");
+
+        /* The constraint is keyed by its unrolled form, which does not depend on the expression ids. The hash may collide, a hit is confirmed on this form. */
+        triton::ast::AbstractNode* unrolled = this->symbolicEngine->unrollAst(node);
+        triton::uint512 hash = unrolled->hash(1);
+
+        /*
+         * The constraint is translated and its variables are collected only if a model has to be
+         * checked or the solver has to be called, an entry of the same constraint answers without them.
+         */
+        std::unique_ptr<triton::ast::TritonToZ3Ast> z3Ast;
+        std::unique_ptr<z3::expr> expr;
+        std::vector<triton::engines::symbolic::SymbolicVariable*> variables;
+
+        auto translate = [&](void) -> z3::expr& {
+          if (expr == nullptr) {
+            z3Ast.reset(new(std::nothrow) triton::ast::TritonToZ3Ast(this->symbolicEngine, false));
+            if (z3Ast == nullptr)
+              throw triton::exceptions::SolverEngine("SolverEngine::getCachedModel(): No enough memory.");
+
+            expr.reset(new(std::nothrow) z3::expr(z3Ast->convert(unrolled)));
+            if (expr == nullptr)
+              throw triton::exceptions::SolverEngine("SolverEngine::getCachedModel(): No enough memory.");
+
+            triton::ast::nodesExtraction(unrolled, nodes);
+            for (triton::ast::AbstractNode* current : nodes) {
+              if (current->getKind() == triton::ast::VARIABLE_NODE)
+                variables.push_back(&reinterpret_cast<triton::ast::VariableNode*>(current)->getVar());
+            }
+          }
+          return *expr;
+        };
+
+        /*
+         * A model holds every variable of the constraint, whether it comes from the solver or from
+         * the cache. The variables which are not in a model keep their concrete value, like in the
+         * concrete evaluation of the AST.
+         */
+        auto complete = [&](const std::map<triton::uint32, SolverModel>& partial, std::map<triton::uint32, SolverModel>& model) {
+          translate();
+          model.clear();
+          for (triton::engines::symbolic::SymbolicVariable* var : variables) {
+            auto it = partial.find(static_cast<triton::uint32>(var->getId()));
+            triton::uint512 value = (it != partial.end()) ? it->second.getValue() : this->symbolicEngine->getConcreteSymbolicVariableValue(*var);
+
+            value &= (triton::uint512(1) << var->getSize()) - 1;
+
+            SolverModel m = SolverModel(var->getName(), value);
+            model[m.getId()] = m;
+          }
+        };
+
+        /* A candidate model is evaluated on the constraint without calling the solver */
+        auto check = [&](const std::map<triton::uint32, SolverModel>& candidate, std::map<triton::uint32, SolverModel>& model) -> bool {
+          z3::expr& constraint = translate();
+          z3::context& ctx     = constraint.ctx();
+          z3::expr_vector src(ctx);
+          z3::expr_vector dst(ctx);
+
+          complete(candidate, model);
+          for (triton::engines::symbolic::SymbolicVariable* var : variables) {
+            std::ostringstream str;
+
+            str << model[static_cast<triton::uint32>(var->getId())].getValue();
+            src.push_back(ctx.bv_const(var->getName().c_str(), var->getSize()));
+            dst.push_back(ctx.bv_val(str.str().c_str(), var->getSize()));
+          }
+
+          z3::expr evaluated = constraint.substitute(src, dst).simplify();
+          return (Z3_get_bool_value(ctx, evaluated) == Z3_L_TRUE);
+        };
+
+        if (this->cache.lookup(hash, unrolled, check, ret))
+          return ret;
+
+        z3::expr& constraint = translate();
+        z3::context& ctx     = constraint.ctx();
+        z3::solver solver(ctx);
+        solver.add(constraint);
+
+        /* An unknown result (e.g. a timeout) is not a proof of unsatisfiability, it is not cached */
+        switch (solver.check()) {
+          case z3::sat: {
+            z3::model m = solver.get_model();
+            complete(toSolverModel(ctx, m, nullptr), ret);
+            this->cache.insert(hash, unrolled, ret);
+            break;
+          }
+          case z3::unsat:
+            this->cache.insert(hash, unrolled, ret);
+            break;
+          default:
+            break;
+        }
+
+        return ret;
+      }
+
+
+      void SolverEngine::setSolverCacheSize(triton::usize size) {
+        this->cache.setMaxSize(size);
+      }
+
+
+      triton::usize SolverEngine::getSolverCacheSize(void) const {
+        return this->cache.getMaxSize();
+      }
+
+
+      void SolverEngine::setSolverCacheFile(const std::string& path) {
+        this->cache.setFile(path);
+      }
+
+
+      const std::string& SolverEngine::getSolverCacheFile(void) const {
+        return this->cache.getFile();
+      }
+
+
+      void SolverEngine::clearSolverCache(void) {
+        this->cache.clear();
+      }
+
+
+      std::map<std::string, triton::usize> SolverEngine::getSolverCacheStats(void) const {
+        return this->cache.getStats();
+      }
+
+
+      void SolverEngine::initSession(void) {
+        if (this->sessionSolver)
+          return;
+
+        this->sessionAst = new(std::nothrow) triton::ast::TritonToZ3Ast(this->symbolicEngine, false, true);
+        if (this->sessionAst == nullptr)
+          throw triton::exceptions::SolverEngine("SolverEngine::initSession(): No enough memory.");
+
+        this->sessionSolver = new(std::nothrow) z3::solver(this->sessionAst->getContext());
+        if (this->sessionSolver == nullptr) {
+          delete this->sessionAst;
+          this->sessionAst = nullptr;
+          throw triton::exceptions::SolverEngine("SolverEngine::initSession(): No enough memory.");
+        }
+      }
+
+
+      void SolverEngine::addSolverConstraint(triton::ast::AbstractNode* node) {
+        if (node == nullptr)
+          throw triton::exceptions::SolverEngine("SolverEngine::addSolverConstraint(): node cannot be null.");
+
+        if (node->isLogical() == false)
+          throw triton::exceptions::SolverEngine("SolverEngine::addSolverConstraint(): Must be a logical node.");
+
+        this->initSession();
+
+        /* Only the nodes never seen by the session are translated */
+        this->sessionSolver->add(this->sessionAst->convert(node));
+      }
+
+
+      void SolverEngine::pushSolver(void) {
+        this->initSession();
+        this->sessionSolver->push();
+        this->sessionScopes++;
+      }
+
+
+      void SolverEngine::popSolver(triton::uint32 count) {
+        if (count > this->sessionScopes)
+          throw triton::exceptions::SolverEngine("SolverEngine::popSolver(): Not enough scopes to pop.");
+
+        if (count == 0)
+          return;
+
+        /* The translation cache outlives the scopes, the expressions still belong to the same context */
+        this->sessionSolver->pop(count);
+        this->sessionScopes -= count;
+      }
+
+
+      triton::uint32 SolverEngine::getSolverScopes(void) const {
+        return this->sessionScopes;
+      }
+
+
+      bool SolverEngine::isSolverSat(void) {
+        this->initSession();
+        return (this->sessionSolver->check() == z3::sat);
+      }
+
+
+      std::map<triton::uint32, SolverModel> SolverEngine::getSolverModel(void) {
+        std::map<triton::uint32, SolverModel> ret;
+
+        this->initSession();
+        if (this->sessionSolver->check() == z3::sat) {
+          z3::model m = this->sessionSolver->get_model();
+          ret = toSolverModel(this->sessionAst->getContext(), m, nullptr);
+        }
+
+        return ret;
+      }
+
+
+      void SolverEngine::resetSolver(void) {
+        /* The solver must go away before the context it belongs to */
+        delete this->sessionSolver;
+        delete this->sessionAst;
+        this->sessionSolver = nullptr;
+        this->sessionAst    = nullptr;
+        this->sessionScopes = 0;
+      }
+
     };
   };
 };
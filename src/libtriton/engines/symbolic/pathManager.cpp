@@ -5,6 +5,9 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <tuple>
+#include <vector>
+
 #include <triton/exceptions.hpp>
 #include <triton/pathManager.hpp>
 #include <triton/symbolicEnums.hpp>
@@ -16,6 +19,19 @@ namespace triton {
   namespace engines {
     namespace symbolic {
 
+      /* The path manager holds a reference to the nodes of its constraints */
+      static inline void retainPathConstraint(const triton::engines::symbolic::PathConstraint& pco) {
+        for (const auto& branch : pco.getBranchConstraints())
+          std::get<3>(branch)->retain();
+      }
+
+
+      static inline void releasePathConstraint(const triton::engines::symbolic::PathConstraint& pco) {
+        for (const auto& branch : pco.getBranchConstraints())
+          std::get<3>(branch)->release();
+      }
+
+
       PathManager::PathManager(const triton::modes::Modes& modes, triton::ast::AstContext& astCtxt)
         : modes(modes),
           astCtxt(astCtxt) {
@@ -29,7 +45,16 @@ namespace triton {
       }
 
 
+      PathManager::~PathManager() {
+        this->clearPathConstraints();
+      }
+
+
       void PathManager::copy(const PathManager& other) {
+        for (const auto& pco : other.pathConstraints)
+          retainPathConstraint(pco);
+
+        this->clearPathConstraints();
         this->pathConstraints = other.pathConstraints;
       }
 
@@ -112,20 +137,36 @@ namespace triton {
           pco.addBranchConstraint(bb1 == dstAddr, srcAddr, bb1, bb1pc);
           pco.addBranchConstraint(bb2 == dstAddr, srcAddr, bb2, bb2pc);
 
+          retainPathConstraint(pco);
           this->pathConstraints.push_back(pco);
         }
 
         /* Direct branch */
         else {
           pco.addBranchConstraint(true, srcAddr, dstAddr, this->astCtxt.equal(pc, this->astCtxt.bv(dstAddr, size)));
+          retainPathConstraint(pco);
           this->pathConstraints.push_back(pco);
         }
 
       }
 
 
+      void PathManager::popPathConstraint(void) {
+        if (this->pathConstraints.empty())
+          return;
+
+        triton::engines::symbolic::PathConstraint pco = this->pathConstraints.back();
+        this->pathConstraints.pop_back();
+        releasePathConstraint(pco);
+      }
+
+
       void PathManager::clearPathConstraints(void) {
-        this->pathConstraints.clear();
+        std::vector<triton::engines::symbolic::PathConstraint> pcs;
+
+        pcs.swap(this->pathConstraints);
+        for (const auto& pco : pcs)
+          releasePathConstraint(pco);
       }
 
 
@@ -7,6 +7,8 @@
 
 #include <cstring>
 #include <new>
+#include <unordered_map>
+#include <vector>
 
 #include <triton/exceptions.hpp>
 #include <triton/coreUtils.hpp>
@@ -71,6 +73,14 @@ namespace triton {
   namespace engines {
     namespace symbolic {
 
+      /* Returns the bit vector of the bytes [low, high) of a concrete memory value */
+      static inline triton::ast::AbstractNode* buildConcreteBytes(triton::ast::AstContext& astCtxt, const triton::uint512& value, triton::uint64 low, triton::uint64 high) {
+        triton::uint32 size  = static_cast<triton::uint32>((high - low) * BYTE_SIZE_BIT);
+        triton::uint512 mask = (triton::uint512(1) << size) - 1;
+        return astCtxt.bv((value >> static_cast<triton::uint32>(low * BYTE_SIZE_BIT)) & mask, size);
+      }
+
+
       SymbolicEngine::SymbolicEngine(triton::arch::Architecture* architecture,
                                      const triton::modes::Modes& modes,
                                      triton::ast::AstContext& astCtxt,
@@ -94,9 +104,11 @@ namespace triton {
 
         this->callbacks       = callbacks;
         this->backupFlag      = isBackup;
+        this->concreteFlag    = false;
         this->enableFlag      = true;
         this->uniqueSymExprId = 0;
         this->uniqueSymVarId  = 0;
+        this->unrolledVersion = 0;
       }
 
 
@@ -114,13 +126,17 @@ namespace triton {
         this->alignedMemoryReference      = other.alignedMemoryReference;
         this->architecture                = other.architecture;
         this->backupFlag                  = true;
+        this->byteReferences              = other.byteReferences;
         this->callbacks                   = other.callbacks;
+        this->concreteFlag                = other.concreteFlag;
         this->enableFlag                  = other.enableFlag;
+        this->lazyFlags                   = other.lazyFlags;
         this->memoryReference             = other.memoryReference;
         this->symbolicExpressions         = other.symbolicExpressions;
         this->symbolicVariables           = other.symbolicVariables;
         this->uniqueSymExprId             = other.uniqueSymExprId;
         this->uniqueSymVarId              = other.uniqueSymVarId;
+        this->unrolledVersion             = other.unrolledVersion;
       }
 
 
@@ -129,6 +145,13 @@ namespace triton {
           triton::engines::symbolic::PathManager(other),
           astCtxt(other.astCtxt),
           modes(other.modes) {
+        /* Both engines hold a reference to the aligned nodes */
+        for (const auto& item : other.alignedMemoryReference)
+          item.second->retain();
+        for (const auto& item : other.lazyFlags) {
+          for (auto* node : item.second.nodes)
+            node->retain();
+        }
         this->copy(other);
       }
 
@@ -137,17 +160,30 @@ namespace triton {
         triton::engines::symbolic::SymbolicSimplification::operator=(other);
         triton::engines::symbolic::PathManager::operator=(other);
 
+        /*
+         * Release our aligned nodes before deleting the unused variables,
+         * a variable node needs its variable to be forgotten.
+         */
+        for (const auto& item : other.alignedMemoryReference)
+          item.second->retain();
+        for (const auto& item : other.lazyFlags) {
+          for (auto* node : item.second.nodes)
+            node->retain();
+        }
+        this->clearAlignedMemory();
+        this->clearLazyFlags();
+        this->clearUnrolledAsts();
+
         /* Delete unused expressions */
-        std::map<triton::usize, SymbolicExpression*>::iterator it1;
-        for (it1 = this->symbolicExpressions.begin(); it1 != this->symbolicExpressions.end(); it1++) {
-          if (other.symbolicExpressions.find(it1->first) == other.symbolicExpressions.end())
-            delete this->symbolicExpressions[it1->first];
+        for (const auto& se: this->symbolicExpressions) {
+          if (other.symbolicExpressions.get(se.first) == nullptr)
+            delete se.second;
         }
 
         /* Delete unused variables */
-        for (auto& sv: this->symbolicVariables) {
-          if (other.symbolicVariables.find(sv.first) == other.symbolicVariables.end())
-            delete this->symbolicVariables[sv.first];
+        for (const auto& sv: this->symbolicVariables) {
+          if (other.symbolicVariables.get(sv.first) == nullptr)
+            delete sv.second;
         }
 
         delete[] this->symbolicReg;
@@ -167,13 +203,20 @@ namespace triton {
          * result in a double-free bug if the original symbolic engine
          * is deleted too (cf: #385).
          */
+        /* Release the nodes before their variables go away */
+        this->clearAlignedMemory();
+        this->clearConcreteExpressions();
+        this->clearLazyFlags();
+        this->clearPathConstraints();
+        this->clearUnrolledAsts();
+
         if (this->backupFlag == false) {
           /* Delete all symbolic expressions */
-          for (auto& se: this->symbolicExpressions)
+          for (const auto& se: this->symbolicExpressions)
             delete se.second;
 
           /* Delete all symbolic variables */
-          for (auto sv: this->symbolicVariables)
+          for (const auto& sv: this->symbolicVariables)
             delete sv.second;
         }
 
@@ -193,12 +236,14 @@ namespace triton {
         if (!this->architecture->isRegisterValid(parentId))
           return;
 
+        this->removeLazyFlag(parentId);
         this->symbolicReg[parentId] = triton::engines::symbolic::UNSET;
       }
 
 
       /* Same as concretizeRegister but with all registers */
       void SymbolicEngine::concretizeAllRegister(void) {
+        this->clearLazyFlags();
         for (triton::uint32 i = 0; i < this->numberOfRegisters; i++)
           this->symbolicReg[i] = triton::engines::symbolic::UNSET;
       }
@@ -213,8 +258,12 @@ namespace triton {
         triton::uint64 addr = mem.getAddress();
         triton::uint32 size = mem.getSize();
 
-        for (triton::uint32 index = 0; index < size; index++)
-          this->concretizeMemory(addr+index);
+        this->memoryReference.erase(addr, size);
+
+        if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY)) {
+          for (triton::uint32 index = 0; index < size; index++)
+            this->removeAlignedMemory(addr+index, BYTE_SIZE);
+        }
       }
 
 
@@ -224,7 +273,8 @@ namespace triton {
        * before symbolic processing.
        */
       void SymbolicEngine::concretizeMemory(triton::uint64 addr) {
-        this->memoryReference.erase(addr);
+        this->memoryReference.erase(addr, BYTE_SIZE);
+
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY))
           this->removeAlignedMemory(addr, BYTE_SIZE);
       }
@@ -232,8 +282,9 @@ namespace triton {
 
       /* Same as concretizeMemory but with all address memory */
       void SymbolicEngine::concretizeAllMemory(void) {
+        this->byteReferences.clear();
         this->memoryReference.clear();
-        this->alignedMemoryReference.clear();
+        this->clearAlignedMemory();
       }
 
 
@@ -255,60 +306,150 @@ namespace triton {
 
       /* Adds an aligned memory */
       void SymbolicEngine::addAlignedMemory(triton::uint64 address, triton::uint32 size, triton::ast::AbstractNode* node) {
+        bool record = !(this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED) && node->isSymbolized() == false);
+
+        /* Retained first, the previous entry may be the same node */
+        if (record)
+          node->retain();
+
         this->removeAlignedMemory(address, size);
-        if (!(this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED) && node->isSymbolized() == false))
+
+        if (record)
           this->alignedMemoryReference[std::make_pair(address, size)] = node;
       }
 
 
+      /* Removes an aligned entry and releases its node */
+      void SymbolicEngine::eraseAlignedMemory(triton::uint64 address, triton::uint32 size) {
+        auto it = this->alignedMemoryReference.find(std::make_pair(address, size));
+
+        if (it != this->alignedMemoryReference.end()) {
+          triton::ast::AbstractNode* node = it->second;
+          this->alignedMemoryReference.erase(it);
+          node->release();
+        }
+      }
+
+
+      /* Removes all aligned entries and releases their nodes */
+      void SymbolicEngine::clearAlignedMemory(void) {
+        std::map<std::pair<triton::uint64, triton::uint32>, triton::ast::AbstractNode*> entries;
+
+        entries.swap(this->alignedMemoryReference);
+        for (const auto& item : entries)
+          item.second->release();
+      }
+
+
+      /* Removes a pending flag and releases its nodes */
+      void SymbolicEngine::removeLazyFlag(triton::arch::registers_e id) {
+        auto it = this->lazyFlags.find(id);
+
+        if (it == this->lazyFlags.end())
+          return;
+
+        std::vector<triton::ast::AbstractNode*> nodes;
+        nodes.swap(it->second.nodes);
+        this->lazyFlags.erase(it);
+
+        for (auto* node : nodes)
+          node->release();
+      }
+
+
+      /* Removes all pending flags and releases their nodes */
+      void SymbolicEngine::clearLazyFlags(void) {
+        std::map<triton::arch::registers_e, LazyFlag> flags;
+
+        flags.swap(this->lazyFlags);
+        for (const auto& item : flags) {
+          for (auto* node : item.second.nodes)
+            node->release();
+        }
+      }
+
+
       /* Removes an aligned memory */
       void SymbolicEngine::removeAlignedMemory(triton::uint64 address, triton::uint32 size) {
         /* Remove overloaded positive ranges */
         for (triton::uint32 index = 0; index < size; index++) {
-          this->alignedMemoryReference.erase(std::make_pair(address+index, BYTE_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, WORD_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, DWORD_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, QWORD_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, DQWORD_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, QQWORD_SIZE));
-          this->alignedMemoryReference.erase(std::make_pair(address+index, DQQWORD_SIZE));
+          this->eraseAlignedMemory(address+index, BYTE_SIZE);
+          this->eraseAlignedMemory(address+index, WORD_SIZE);
+          this->eraseAlignedMemory(address+index, DWORD_SIZE);
+          this->eraseAlignedMemory(address+index, QWORD_SIZE);
+          this->eraseAlignedMemory(address+index, DQWORD_SIZE);
+          this->eraseAlignedMemory(address+index, QQWORD_SIZE);
+          this->eraseAlignedMemory(address+index, DQQWORD_SIZE);
         }
 
         /* Remove overloaded negative ranges */
         for (triton::uint32 index = 1; index < DQQWORD_SIZE; index++) {
           if (index < WORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, WORD_SIZE));
+            this->eraseAlignedMemory(address-index, WORD_SIZE);
           if (index < DWORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, DWORD_SIZE));
+            this->eraseAlignedMemory(address-index, DWORD_SIZE);
           if (index < QWORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, QWORD_SIZE));
+            this->eraseAlignedMemory(address-index, QWORD_SIZE);
           if (index < DQWORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, DQWORD_SIZE));
+            this->eraseAlignedMemory(address-index, DQWORD_SIZE);
           if (index < QQWORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, QQWORD_SIZE));
+            this->eraseAlignedMemory(address-index, QQWORD_SIZE);
           if (index < DQQWORD_SIZE)
-            this->alignedMemoryReference.erase(std::make_pair(address-index, DQQWORD_SIZE));
+            this->eraseAlignedMemory(address-index, DQQWORD_SIZE);
         }
       }
 
 
+      /* Returns the ranges of symbolic memory which intersect a memory access */
+      std::vector<SymbolicMemory::Range> SymbolicEngine::getSymbolicMemoryRanges(const triton::arch::MemoryAccess& mem) const {
+        return this->memoryReference.getRanges(mem.getAddress(), mem.getSize());
+      }
+
+
       /* Returns the reference memory if it's referenced otherwise returns UNSET */
-      triton::usize SymbolicEngine::getSymbolicMemoryId(triton::uint64 addr) const {
-        std::map<triton::uint64, triton::usize>::const_iterator it;
+      triton::usize SymbolicEngine::getSymbolicMemoryId(triton::uint64 addr) {
+        SymbolicMemory::Range range;
 
-        if ((it = this->memoryReference.find(addr)) != this->memoryReference.end())
-          return it->second;
+        if (!this->memoryReference.find(addr, range))
+          return triton::engines::symbolic::UNSET;
 
-        return triton::engines::symbolic::UNSET;
+        /* The expression is already the expression of this byte */
+        SymbolicExpression* expr = this->getSymbolicExpressionFromId(range.id);
+        if (range.offset == 0 && expr->getAst()->getBitvectorSize() == BYTE_SIZE_BIT)
+          return range.id;
+
+        /* The byte has already been queried and neither it nor its range has changed since */
+        auto it = this->byteReferences.find(addr);
+        if (it != this->byteReferences.end()) {
+          const ByteReference& ref = it->second;
+          if (ref.id == range.id && ref.offset == range.offset && ref.ast == expr->getAst() && this->symbolicExpressions.get(ref.byteId) != nullptr)
+            return ref.byteId;
+        }
+
+        /*
+         * Otherwise, the byte gets its own expression. It extracts the byte from the AST
+         * of the wider expression (not from a reference), so it does not depend on the
+         * wider expression still being alive. The range is left as it is.
+         */
+        triton::uint32 low = static_cast<triton::uint32>(range.offset * BYTE_SIZE_BIT);
+        triton::ast::AbstractNode* node = this->astCtxt.extract(low + BYTE_SIZE_BIT - 1, low, expr->getAst());
+        SymbolicExpression* se = this->newSymbolicExpression(node, triton::engines::symbolic::MEM, "Byte reference");
+        se->setOriginMemory(triton::arch::MemoryAccess(addr, BYTE_SIZE));
+        se->isTainted = expr->isTainted;
+
+        ByteReference& ref = this->byteReferences[addr];
+        ref.id     = range.id;
+        ref.offset = range.offset;
+        ref.ast    = expr->getAst();
+        ref.byteId = se->getId();
+
+        return se->getId();
       }
 
 
       /* Returns the symbolic variable otherwise returns nullptr */
       SymbolicVariable* SymbolicEngine::getSymbolicVariableFromId(triton::usize symVarId) const {
-        auto it = this->symbolicVariables.find(symVarId);
-        if (it == this->symbolicVariables.end())
-          return nullptr;
-        return it->second;
+        return this->symbolicVariables.get(symVarId);
       }
 
 
@@ -328,7 +469,7 @@ namespace triton {
 
 
       /* Returns all symbolic variables */
-      const std::map<triton::usize, SymbolicVariable*>& SymbolicEngine::getSymbolicVariables(void) const {
+      const SymbolicTable<SymbolicVariable>& SymbolicEngine::getSymbolicVariables(void) const {
         return this->symbolicVariables;
       }
 
@@ -399,33 +540,63 @@ namespace triton {
         SymbolicExpression* expr = new(std::nothrow) SymbolicExpression(node, id, kind, comment);
         if (expr == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::newSymbolicExpression(): not enough memory");
-        this->symbolicExpressions[id] = expr;
+        this->symbolicExpressions.set(id, expr);
+        return expr;
+      }
+
+
+      /* Returns true if the expression of the node is dropped by the concrete path (all of them when the engine is disabled) */
+      bool SymbolicEngine::isConcreteNode(triton::ast::AbstractNode* node) const {
+        return (this->concreteFlag && (!this->enableFlag || !node->isSymbolized()));
+      }
+
+
+      /* Creates an expression which is neither recorded nor assigned, it is deleted at the end of the instruction */
+      SymbolicExpression* SymbolicEngine::newConcreteExpression(triton::ast::AbstractNode* node, triton::engines::symbolic::symkind_e kind, const std::string& comment) {
+        SymbolicExpression* expr = new(std::nothrow) SymbolicExpression(node, this->getUniqueSymExprId(), kind, comment);
+        if (expr == nullptr)
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::newConcreteExpression(): not enough memory");
+        this->concreteExpressions.push_back(expr);
         return expr;
       }
 
 
+      void SymbolicEngine::enableConcretePath(bool flag) {
+        this->concreteFlag = flag;
+      }
+
+
+      /* Deletes the expressions dropped by the concrete path */
+      void SymbolicEngine::clearConcreteExpressions(void) {
+        for (auto* expr : this->concreteExpressions)
+          delete expr;
+        this->concreteExpressions.clear();
+      }
+
+
       /* Removes the symbolic expression corresponding to the id */
       void SymbolicEngine::removeSymbolicExpression(triton::usize symExprId) {
-        std::map<triton::uint64, triton::usize>::iterator it;
+        SymbolicExpression* expr = this->symbolicExpressions.get(symExprId);
+
+        if (expr != nullptr) {
+          this->eraseUnrolledAst(symExprId);
 
-        if (this->symbolicExpressions.find(symExprId) != this->symbolicExpressions.end()) {
           /* Delete and remove the pointer */
-          delete this->symbolicExpressions[symExprId];
+          delete expr;
           this->symbolicExpressions.erase(symExprId);
 
-          /* Concretize the register if it exists */
+          /* Concretize the registers which refer to it */
           for (triton::uint32 i = 0; i < this->numberOfRegisters; i++) {
-            if (this->symbolicReg[i] == symExprId) {
+            if (this->symbolicReg[i] == symExprId)
               this->symbolicReg[i] = triton::engines::symbolic::UNSET;
-              return;
-            }
           }
 
-          /* Concretize the memory if it exists */
-          for (it = this->memoryReference.begin(); it != memoryReference.end(); it++) {
-            if (it->second == symExprId) {
-              this->concretizeMemory(it->first);
-              return;
+          /* Concretize the memory ranges which refer to it */
+          for (const auto& range : this->memoryReference.getExpressionRanges(symExprId)) {
+            this->memoryReference.erase(range.address, range.size);
+            if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY)) {
+              for (triton::uint64 index = 0; index < range.size; index++)
+                this->removeAlignedMemory(range.address + index, BYTE_SIZE);
             }
           }
         }
@@ -435,64 +606,244 @@ namespace triton {
 
       /* Gets the symbolic expression pointer from a symbolic id */
       SymbolicExpression* SymbolicEngine::getSymbolicExpressionFromId(triton::usize symExprId) const {
-        auto it = this->symbolicExpressions.find(symExprId);
-        if (it == this->symbolicExpressions.end())
+        SymbolicExpression* expr = this->symbolicExpressions.get(symExprId);
+        if (expr == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::getSymbolicExpressionFromId(): symbolic expression id not found");
-        return it->second;
+        return expr;
       }
 
 
       /* Returns all symbolic expressions */
-      const std::map<triton::usize, SymbolicExpression*>& SymbolicEngine::getSymbolicExpressions(void) const {
+      const SymbolicTable<SymbolicExpression>& SymbolicEngine::getSymbolicExpressions(void) const {
         return this->symbolicExpressions;
       }
 
 
       /* Returns the full symbolic expression backtracked. */
       triton::ast::AbstractNode* SymbolicEngine::unrollAst(triton::ast::AbstractNode* node) {
-        std::vector<triton::ast::AbstractNode*>& children = node->getChildren();
+        std::unordered_map<triton::ast::AbstractNode*, triton::ast::AbstractNode*> unrolledNodes;
+        std::unordered_map<triton::usize, triton::ast::AbstractNode*> unrolledExprs;
+        std::vector<std::pair<SymbolicExpression*, bool>> worklist;
+        std::vector<SymbolicExpression*> pending;
+        std::vector<triton::ast::AbstractNode*> nodes;
+        std::vector<std::pair<triton::usize, triton::usize>> references;
+
+        /* The kept ASTs are bounded, and the ones which depend on a replaced AST are dropped */
+        if (this->unrolledAsts.size() >= MAX_UNROLLED_ASTS)
+          this->clearUnrolledAsts();
+        this->checkUnrolledAsts();
+
+        /* Returns true if the unrolled AST of the expression is kept and up to date */
+        auto isUnrolled = [&](const SymbolicExpression& expr) -> bool {
+          auto it = this->unrolledAsts.find(expr.getId());
+          return (it != this->unrolledAsts.end() && it->second.version == expr.getVersion());
+        };
+
+        /* Pushes the expressions referenced by an AST which are not unrolled yet */
+        auto pushReferences = [&](triton::ast::AbstractNode* root) {
+          triton::ast::nodesExtraction(root, nodes, true, false);
+          for (triton::ast::AbstractNode* current : nodes) {
+            if (current->getKind() == triton::ast::REFERENCE_NODE) {
+              SymbolicExpression& expr = reinterpret_cast<triton::ast::ReferenceNode*>(current)->getSymbolicExpression();
+              if (!isUnrolled(expr) && unrolledExprs.find(expr.getId()) == unrolledExprs.end())
+                worklist.push_back(std::make_pair(&expr, false));
+            }
+          }
+        };
+
+        /* Rebuilds the nodes of an AST above its references, the other nodes are kept as they are. Fills `references`. */
+        auto unroll = [&](triton::ast::AbstractNode* root) -> triton::ast::AbstractNode* {
+          references.clear();
+          triton::ast::nodesExtraction(root, nodes, true, false);
+          for (triton::ast::AbstractNode* current : nodes) {
+            if (current->getKind() == triton::ast::REFERENCE_NODE) {
+              const SymbolicExpression& expr = reinterpret_cast<triton::ast::ReferenceNode*>(current)->getSymbolicExpression();
+              references.push_back(std::make_pair(expr.getId(), expr.getVersion()));
+              if (unrolledNodes.find(current) == unrolledNodes.end()) {
+                auto it = unrolledExprs.find(expr.getId());
+                unrolledNodes[current] = (it != unrolledExprs.end()) ? it->second : this->unrolledAsts[expr.getId()].ast;
+              }
+              continue;
+            }
+
+            if (unrolledNodes.find(current) != unrolledNodes.end())
+              continue;
+
+            std::vector<triton::ast::AbstractNode*> children;
+            bool changed = false;
+
+            for (triton::ast::AbstractNode* child : current->getChildren()) {
+              children.push_back(unrolledNodes[child]);
+              changed |= (children.back() != child);
+            }
+
+            unrolledNodes[current] = changed ? triton::ast::newInstance(current, children) : current;
+          }
+          return unrolledNodes[root];
+        };
+
+        /*
+         * Orders the expressions to unroll, the referenced ones first. An expression may be pushed
+         * several times, it is placed by the copy which is expanded first. The placeholder entries
+         * of unrolledExprs mark the expressions already expanded.
+         */
+        pushReferences(node);
+        while (!worklist.empty()) {
+          SymbolicExpression* expr = worklist.back().first;
+
+          if (worklist.back().second) {
+            worklist.pop_back();
+            pending.push_back(expr);
+            continue;
+          }
+
+          if (unrolledExprs.find(expr->getId()) != unrolledExprs.end()) {
+            worklist.pop_back();
+            continue;
+          }
+
+          worklist.back().second = true;
+          unrolledExprs[expr->getId()] = nullptr;
+          pushReferences(expr->getAst());
+        }
 
-        if (node->getKind() == triton::ast::REFERENCE_NODE) {
-          SymbolicExpression& expr = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression();
-          triton::ast::AbstractNode* ref = expr.getAst();
-          return this->unrollAst(ref);
+        /* The out of date ASTs are released before any node is built, none of them is used */
+        for (SymbolicExpression* expr : pending)
+          this->eraseUnrolledAst(expr->getId());
+
+        for (SymbolicExpression* expr : pending) {
+          triton::ast::AbstractNode* unrolled = unroll(expr->getAst());
+          unrolledExprs[expr->getId()] = unrolled;
+
+          /* Only the recorded expressions are kept, the others go away with their instruction */
+          if (this->symbolicExpressions.get(expr->getId()) == expr) {
+            UnrolledAst& entry = this->unrolledAsts[expr->getId()];
+            unrolled->retain();
+            entry.ast        = unrolled;
+            entry.version    = expr->getVersion();
+            entry.references = references;
+          }
         }
 
-        for (triton::uint32 index = 0; index < children.size(); index++)
-          children[index] = this->unrollAst(children[index]);
+        return unroll(node);
+      }
+
 
-        return node;
+      /* Removes the unrolled AST of an expression and releases its nodes */
+      void SymbolicEngine::eraseUnrolledAst(triton::usize symExprId) {
+        auto it = this->unrolledAsts.find(symExprId);
+
+        if (it != this->unrolledAsts.end()) {
+          triton::ast::AbstractNode* unrolled = it->second.ast;
+          this->unrolledAsts.erase(it);
+          unrolled->release();
+        }
       }
 
 
-      /* [private method] Slices all expressions from a given node */
-      void SymbolicEngine::sliceExpressions(triton::ast::AbstractNode* node, std::map<triton::usize, SymbolicExpression*>& exprs) {
-        std::vector<triton::ast::AbstractNode*>& children = node->getChildren();
+      /* Removes the unrolled ASTs which depend on a replaced AST */
+      void SymbolicEngine::checkUnrolledAsts(void) {
+        /* 1: being checked, 2: up to date, 3: out of date */
+        std::unordered_map<triton::usize, triton::uint32> states;
+        std::vector<triton::usize> worklist;
+        std::vector<triton::usize> pending;
+
+        if (this->unrolledVersion == SymbolicExpression::getLastVersion())
+          return;
 
-        if (node->getKind() == triton::ast::REFERENCE_NODE) {
-          SymbolicExpression& expr = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression();
-          triton::usize id = expr.getId();
-          if (exprs.find(id) == exprs.end()) {
-            exprs[id] = &expr;
-            this->sliceExpressions(expr.getAst(), exprs);
+        /*
+         * An unrolled AST is up to date if its expression and the expressions it references
+         * keep the versions they had when it was built, and if their unrolled ASTs are up to
+         * date too. The references of an expression without unrolled AST are unknown, the
+         * ASTs which reference it are unrolled again.
+         */
+        for (const auto& item : this->unrolledAsts) {
+          worklist.push_back(item.first);
+          while (!worklist.empty()) {
+            triton::usize id = worklist.back();
+            auto state = states.find(id);
+
+            if (state != states.end() && state->second != 1) {
+              worklist.pop_back();
+              continue;
+            }
+
+            auto entry = this->unrolledAsts.find(id);
+            const SymbolicExpression* expr = this->symbolicExpressions.get(id);
+            if (entry == this->unrolledAsts.end() || expr == nullptr || expr->getVersion() != entry->second.version) {
+              states[id] = 3;
+              worklist.pop_back();
+              continue;
+            }
+
+            bool valid = true;
+            pending.clear();
+            states[id] = 1;
+            for (const auto& reference : entry->second.references) {
+              const SymbolicExpression* ref = this->symbolicExpressions.get(reference.first);
+              if (ref == nullptr || ref->getVersion() != reference.second || this->unrolledAsts.find(reference.first) == this->unrolledAsts.end()) {
+                valid = false;
+                break;
+              }
+
+              /* Not checked yet, checked or being checked (a cycle built by setAst()) */
+              auto refState = states.find(reference.first);
+              if (refState == states.end())
+                pending.push_back(reference.first);
+              else if (refState->second != 2) {
+                valid = false;
+                break;
+              }
+            }
+
+            /* The referenced expressions are checked first */
+            if (valid && !pending.empty()) {
+              worklist.insert(worklist.end(), pending.begin(), pending.end());
+              continue;
+            }
+
+            states[id] = valid ? 2 : 3;
+            worklist.pop_back();
           }
         }
 
-        for (triton::uint32 index = 0; index < children.size(); index++) {
-          this->sliceExpressions(children[index], exprs);
+        for (const auto& item : states) {
+          if (item.second == 3)
+            this->eraseUnrolledAst(item.first);
         }
+
+        this->unrolledVersion = SymbolicExpression::getLastVersion();
+      }
+
+
+      /* Removes all unrolled ASTs and releases their nodes */
+      void SymbolicEngine::clearUnrolledAsts(void) {
+        std::unordered_map<triton::usize, UnrolledAst> entries;
+
+        entries.swap(this->unrolledAsts);
+        for (const auto& item : entries)
+          item.second.ast->release();
       }
 
 
       /* Slices all expressions from a given one */
       std::map<triton::usize, SymbolicExpression*> SymbolicEngine::sliceExpressions(SymbolicExpression* expr) {
         std::map<triton::usize, SymbolicExpression*> exprs;
+        std::vector<triton::ast::AbstractNode*> nodes;
 
         if (expr == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::sliceExpressions(): expr cannot be null.");
 
         exprs[expr->getId()] = expr;
-        this->sliceExpressions(expr->getAst(), exprs);
+
+        /* Each reference is visited once, whatever the number of its occurrences */
+        triton::ast::nodesExtraction(expr->getAst(), nodes, false, true);
+        for (triton::ast::AbstractNode* node : nodes) {
+          if (node->getKind() == triton::ast::REFERENCE_NODE) {
+            SymbolicExpression& ref = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression();
+            exprs[ref.getId()] = &ref;
+          }
+        }
 
         return exprs;
       }
@@ -500,12 +851,11 @@ namespace triton {
 
       /* Returns a list which contains all tainted expressions */
       std::list<SymbolicExpression*> SymbolicEngine::getTaintedSymbolicExpressions(void) const {
-        std::map<triton::usize, SymbolicExpression*>::const_iterator it;
         std::list<SymbolicExpression*> taintedExprs;
 
-        for (it = this->symbolicExpressions.begin(); it != this->symbolicExpressions.end(); it++) {
-          if (it->second->isTainted == true)
-            taintedExprs.push_back(it->second);
+        for (const auto& se : this->symbolicExpressions) {
+          if (se.second->isTainted == true)
+            taintedExprs.push_back(se.second);
         }
 
         return taintedExprs;
@@ -527,12 +877,22 @@ namespace triton {
 
 
       /* Returns the map of symbolic memory defined */
-      std::map<triton::uint64, SymbolicExpression*> SymbolicEngine::getSymbolicMemory(void) const {
+      std::map<triton::uint64, SymbolicExpression*> SymbolicEngine::getSymbolicMemory(void) {
         std::map<triton::uint64, SymbolicExpression*> ret;
-        std::map<triton::uint64, triton::usize>::const_iterator it;
 
-        for (it = this->memoryReference.begin(); it != this->memoryReference.end(); it++)
-          ret[it->first] = this->getSymbolicExpressionFromId(it->second);
+        for (const auto& item : this->memoryReference.getRanges()) {
+          const SymbolicMemory::Range& range = item.second;
+          for (triton::uint64 index = 0; index < range.size; index++)
+            ret[range.address + index] = this->getSymbolicExpressionFromId(this->getSymbolicMemoryId(range.address + index));
+        }
+
+        /* The views of the bytes which are no longer referenced are dropped */
+        for (auto it = this->byteReferences.begin(); it != this->byteReferences.end();) {
+          if (ret.find(it->first) == ret.end())
+            it = this->byteReferences.erase(it);
+          else
+            it++;
+        }
 
         return ret;
       }
@@ -558,21 +918,22 @@ namespace triton {
 
         expression->setAst(tmp);
 
+        /* The unrolled ASTs which go through this expression are out of date */
+        this->clearUnrolledAsts();
+
         return symVar;
       }
 
 
       /* The memory size is used to define the symbolic variable's size. */
       SymbolicVariable* SymbolicEngine::convertMemoryToSymbolicVariable(const triton::arch::MemoryAccess& mem, const std::string& symVarComment) {
-        triton::ast::AbstractNode* tmp  = nullptr;
         SymbolicExpression* se          = nullptr;
         SymbolicVariable* symVar        = nullptr;
-        triton::usize memSymId          = triton::engines::symbolic::UNSET;
         triton::uint64 memAddr          = mem.getAddress();
         triton::uint32 symVarSize       = mem.getSize();
         triton::uint512 cv              = this->architecture->getConcreteMemoryValue(mem);
 
-        memSymId = this->getSymbolicMemoryId(memAddr);
+        std::vector<SymbolicMemory::Range> ranges = this->memoryReference.getRanges(memAddr, symVarSize);
 
         /* First we create a symbolic variable */
         symVar = this->newSymbolicVariable(triton::engines::symbolic::MEM, memAddr, symVarSize * BYTE_SIZE_BIT, symVarComment);
@@ -587,27 +948,22 @@ namespace triton {
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY))
           this->addAlignedMemory(memAddr, symVarSize, symVarNode);
 
-        /*  Split expression in bytes */
-        for (triton::sint32 index = symVarSize-1; index >= 0; index--) {
+        /* If the memory is already defined by exactly one expression, this expression becomes the variable */
+        if (ranges.size() == 1 && ranges[0].size == symVarSize && ranges[0].offset == 0 &&
+            this->getSymbolicExpressionFromId(ranges[0].id)->getAst()->getBitvectorSize() == symVarSize * BYTE_SIZE_BIT) {
+          se = this->getSymbolicExpressionFromId(ranges[0].id);
+          se->setAst(symVarNode);
+          this->clearUnrolledAsts();
+        }
 
-          /* Isolate the good part of the symbolic variable */
-          tmp = this->astCtxt.extract(((BYTE_SIZE_BIT * (index+1)) - 1), ((BYTE_SIZE_BIT * (index+1)) - BYTE_SIZE_BIT), symVarNode);
+        /* Otherwise, a new expression defines the whole memory */
+        else
+          se = this->newSymbolicExpression(symVarNode, triton::engines::symbolic::MEM);
 
-          /* Check if the memory address is already defined */
-          memSymId = this->getSymbolicMemoryId(memAddr+index);
-          if (memSymId == triton::engines::symbolic::UNSET) {
-            se = this->newSymbolicExpression(tmp, triton::engines::symbolic::MEM, "Byte reference");
-            se->setOriginMemory(triton::arch::MemoryAccess(memAddr+index, BYTE_SIZE));
-          }
-          else {
-            se = this->getSymbolicExpressionFromId(memSymId);
-            se->setAst(tmp);
-            se->setOriginMemory(triton::arch::MemoryAccess(memAddr+index, BYTE_SIZE));
-          }
+        se->setOriginMemory(triton::arch::MemoryAccess(memAddr, symVarSize));
 
-          /* Add the new memory reference */
-          this->addMemoryReference(memAddr+index, se->getId());
-        }
+        /* Add the new memory reference */
+        this->addMemoryReference(memAddr, symVarSize, se->getId());
 
         return symVar;
       }
@@ -624,6 +980,10 @@ namespace triton {
         if (!this->architecture->isRegisterValid(parent.getId()))
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::convertRegisterToSymbolicVariable(): Invalid register id");
 
+        /* A pending flag is overwritten by the variable but its concrete value must be known */
+        this->buildLazyFlag(reg);
+        cv = this->architecture->getConcreteRegisterValue(reg);
+
         regSymId = this->getSymbolicRegisterId(reg);
         if (regSymId == triton::engines::symbolic::UNSET) {
           /* Create the symbolic variable */
@@ -649,6 +1009,7 @@ namespace triton {
           this->setConcreteSymbolicVariableValue(*symVar, cv);
           /* Set the AST node */
           expression->setAst(tmp);
+          this->clearUnrolledAsts();
         }
 
         return symVar;
@@ -663,7 +1024,7 @@ namespace triton {
         if (symVar == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::newSymbolicVariable(): Cannot allocate a new symbolic variable");
 
-        this->symbolicVariables[uniqueId] = symVar;
+        this->symbolicVariables.set(uniqueId, symVar);
         return symVar;
       }
 
@@ -707,18 +1068,29 @@ namespace triton {
       }
 
 
+      /* [private method] Returns the AST of a range of memory */
+      triton::ast::AbstractNode* SymbolicEngine::buildSymbolicMemoryRange(const SymbolicMemory::Range& range) {
+        SymbolicExpression* expr        = this->getSymbolicExpressionFromId(range.id);
+        triton::ast::AbstractNode* node = this->astCtxt.reference(*expr);
+        triton::uint32 low              = static_cast<triton::uint32>(range.offset * BYTE_SIZE_BIT);
+        triton::uint32 high             = static_cast<triton::uint32>((range.offset + range.size) * BYTE_SIZE_BIT) - 1;
+
+        /* The range holds the whole expression */
+        if (low == 0 && high == node->getBitvectorSize() - 1)
+          return node;
+
+        return this->astCtxt.extract(high, low, node);
+      }
+
+
       /* Returns a symbolic memory */
       triton::ast::AbstractNode* SymbolicEngine::buildSymbolicMemory(const triton::arch::MemoryAccess& mem) {
         std::list<triton::ast::AbstractNode*> opVec;
 
-        triton::ast::AbstractNode* tmp            = nullptr;
-        triton::uint64 address                    = mem.getAddress();
-        triton::uint32 size                       = mem.getSize();
-        triton::usize symMem                      = triton::engines::symbolic::UNSET;
-        triton::uint8 concreteValue[DQQWORD_SIZE] = {0};
-        triton::uint512 value                     = this->architecture->getConcreteMemoryValue(mem);
-
-        triton::utils::fromUintToBuffer(value, concreteValue);
+        triton::uint64 address  = mem.getAddress();
+        triton::uint32 size     = mem.getSize();
+        triton::uint64 end      = size;
+        triton::uint512 value   = this->architecture->getConcreteMemoryValue(mem);
 
         /*
          * Symbolic optimization
@@ -727,38 +1099,28 @@ namespace triton {
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY) && this->isAlignedMemory(address, size))
           return this->getAlignedMemory(address, size);
 
-        /* Iterate on every memory cells to use their symbolic or concrete values */
-        while (size) {
-          symMem = this->getSymbolicMemoryId(address + size - 1);
-          /* Check if the memory cell is already symbolic */
-          if (symMem != triton::engines::symbolic::UNSET) {
-            tmp = this->astCtxt.reference(*this->getSymbolicExpressionFromId(symMem));
-            opVec.push_back(this->astCtxt.extract((BYTE_SIZE_BIT - 1), 0, tmp));
-          }
-          /* Otherwise, use the concerte value */
-          else {
-            tmp = this->astCtxt.bv(concreteValue[size - 1], BYTE_SIZE_BIT);
-            opVec.push_back(this->astCtxt.extract((BYTE_SIZE_BIT - 1), 0, tmp));
-          }
-          size--;
+        /*
+         * Iterate on the symbolic ranges from the last byte. The bytes between
+         * two ranges use their concrete values. The offsets are relative to the
+         * address, so that an access may wrap around the address space.
+         */
+        std::vector<SymbolicMemory::Range> ranges = this->memoryReference.getRanges(address, size);
+        for (auto it = ranges.rbegin(); it != ranges.rend(); it++) {
+          triton::uint64 low = it->address - address;
+          if (low + it->size < end)
+            opVec.push_back(buildConcreteBytes(this->astCtxt, value, low + it->size, end));
+          opVec.push_back(this->buildSymbolicMemoryRange(*it));
+          end = low;
         }
 
-        /* Concatenate all memory cell to create a bit vector with the appropriate memory access */
-        switch (opVec.size()) {
-          case DQQWORD_SIZE:
-          case QQWORD_SIZE:
-          case DQWORD_SIZE:
-          case QWORD_SIZE:
-          case DWORD_SIZE:
-          case WORD_SIZE:
-            tmp = this->astCtxt.concat(opVec);
-            break;
-          case BYTE_SIZE:
-            tmp = opVec.front();
-            break;
-        }
+        if (end > 0)
+          opVec.push_back(buildConcreteBytes(this->astCtxt, value, 0, end));
+
+        /* Concatenate all parts to create a bit vector with the appropriate memory access */
+        if (opVec.size() == 1)
+          return opVec.front();
 
-        return tmp;
+        return this->astCtxt.concat(opVec);
       }
 
 
@@ -782,11 +1144,17 @@ namespace triton {
       /* Returns a symbolic register */
       triton::ast::AbstractNode* SymbolicEngine::buildSymbolicRegister(const triton::arch::Register& reg) {
         triton::ast::AbstractNode* op = nullptr;
-        triton::usize symReg          = this->getSymbolicRegisterId(reg);
+        triton::usize symReg          = triton::engines::symbolic::UNSET;
         triton::uint32 bvSize         = reg.getBitSize();
         triton::uint32 high           = reg.getHigh();
         triton::uint32 low            = reg.getLow();
 
+        /* A pending flag is built when it is read */
+        if (!this->lazyFlags.empty())
+          this->buildLazyFlag(reg);
+
+        symReg = this->getSymbolicRegisterId(reg);
+
         /* Check if the register is already symbolic */
         if (symReg != triton::engines::symbolic::UNSET)
           op = this->astCtxt.extract(high, low, this->astCtxt.reference(*this->getSymbolicExpressionFromId(symReg)));
@@ -822,51 +1190,36 @@ namespace triton {
 
       /* Returns the new symbolic memory expression */
       SymbolicExpression* SymbolicEngine::createSymbolicMemoryExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const triton::arch::MemoryAccess& mem, const std::string& comment) {
-        triton::ast::AbstractNode* tmp = nullptr;
-        std::list<triton::ast::AbstractNode*> ret;
-
-        SymbolicExpression* se   = nullptr;
         triton::uint64 address   = mem.getAddress();
         triton::uint32 writeSize = mem.getSize();
 
+        /* Concrete path: the bytes are concretized and only their concrete value is updated */
+        if (this->isConcreteNode(node)) {
+          SymbolicExpression* se = this->newConcreteExpression(node, triton::engines::symbolic::MEM, comment);
+          se->setOriginMemory(triton::arch::MemoryAccess(address, writeSize));
+          if (this->enableFlag)
+            this->concretizeMemory(mem);
+          this->architecture->setConcreteMemoryValue(mem, node->evaluate());
+          inst.setStoreAccess(mem, node);
+          inst.addSymbolicExpression(se);
+          return se;
+        }
+
         /* Record the aligned memory for a symbolic optimization */
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY))
           this->addAlignedMemory(address, writeSize, node);
 
         /*
-         * As the x86's memory can be accessed without alignment, each byte of the
-         * memory must be assigned to an unique reference.
+         * As the x86's memory can be accessed without alignment, the written bytes
+         * are assigned to the expression as a whole. A later access to a part of
+         * them extracts its bytes from the expression.
          */
-        while (writeSize) {
-          /* Extract each byte of the memory */
-          tmp = this->astCtxt.extract(((writeSize * BYTE_SIZE_BIT) - 1), ((writeSize * BYTE_SIZE_BIT) - BYTE_SIZE_BIT), node);
-          se = this->newSymbolicExpression(tmp, triton::engines::symbolic::MEM, "Byte reference - " + comment);
-          se->setOriginMemory(triton::arch::MemoryAccess(((address + writeSize) - 1), BYTE_SIZE));
-          ret.push_back(tmp);
-          inst.addSymbolicExpression(se);
-          /* Assign memory with little endian */
-          this->addMemoryReference((address + writeSize) - 1, se->getId());
-          /* continue */
-          writeSize--;
-        }
-
-        /* If there is only one reference, we return the symbolic expression */
-        if (ret.size() == 1) {
-          /* Synchronize the concrete state */
-          this->architecture->setConcreteMemoryValue(mem, tmp->evaluate());
-          /* Define the memory store */
-          inst.setStoreAccess(mem, node);
-          return se;
-        }
-
-        /* Otherwise, we return the concatenation of all symbolic expressions */
-        tmp = this->astCtxt.concat(ret);
+        SymbolicExpression* se = this->newSymbolicExpression(node, triton::engines::symbolic::MEM, comment);
+        se->setOriginMemory(triton::arch::MemoryAccess(address, writeSize));
+        this->addMemoryReference(address, writeSize, se->getId());
 
         /* Synchronize the concrete state */
-        this->architecture->setConcreteMemoryValue(mem, tmp->evaluate());
-
-        se  = this->newSymbolicExpression(tmp, triton::engines::symbolic::MEM, "Temporary concatenation reference - " + comment);
-        se->setOriginMemory(triton::arch::MemoryAccess(address, mem.getSize()));
+        this->architecture->setConcreteMemoryValue(mem, se->getAst()->evaluate());
 
         /* Define the memory store */
         inst.setStoreAccess(mem, node);
@@ -885,6 +1238,30 @@ namespace triton {
         if (this->architecture->isFlag(reg))
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::createSymbolicRegisterExpression(): The register cannot be a flag.");
 
+        /*
+         * Concrete path: the register is concretized and only its concrete value is updated.
+         * A part of a register is concrete only if the rest of the register is concrete too.
+         */
+        if (this->isConcreteNode(node) && (!this->enableFlag || (regSize != BYTE_SIZE && regSize != WORD_SIZE) || this->symbolicReg[parentReg.getId()] == triton::engines::symbolic::UNSET)) {
+          if (regSize == BYTE_SIZE || regSize == WORD_SIZE) {
+            this->architecture->setConcreteRegisterValue(reg, node->evaluate());
+            finalExpr = this->astCtxt.bv(this->architecture->getConcreteRegisterValue(parentReg), parentReg.getBitSize());
+          }
+          else {
+            finalExpr = this->astCtxt.zx(parentReg.getBitSize() - node->getBitvectorSize(), node);
+            this->architecture->setConcreteRegisterValue(parentReg, finalExpr->evaluate());
+          }
+
+          triton::engines::symbolic::SymbolicExpression* se = this->newConcreteExpression(finalExpr, triton::engines::symbolic::REG, comment);
+          se->setOriginRegister(parentReg);
+          if (this->enableFlag)
+            this->symbolicReg[parentReg.getId()] = triton::engines::symbolic::UNSET;
+          inst.addSymbolicExpression(se);
+          inst.setWrittenRegister(reg, node);
+
+          return se;
+        }
+
         if (regSize == BYTE_SIZE || regSize == WORD_SIZE)
           origReg = this->buildSymbolicRegister(parentReg);
 
@@ -927,6 +1304,18 @@ namespace triton {
         if (!this->architecture->isFlag(flag))
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::createSymbolicFlagExpression(): The register must be a flag.");
 
+        /* Concrete path: the flag is concretized and only its concrete value is updated */
+        if (this->isConcreteNode(node)) {
+          triton::engines::symbolic::SymbolicExpression* se = this->newConcreteExpression(node, triton::engines::symbolic::REG, comment);
+          se->setOriginRegister(flag);
+          if (this->enableFlag)
+            this->concretizeRegister(flag);
+          this->architecture->setConcreteRegisterValue(flag, node->evaluate());
+          inst.addSymbolicExpression(se);
+          inst.setWrittenRegister(flag, node);
+          return se;
+        }
+
         triton::engines::symbolic::SymbolicExpression *se = this->newSymbolicExpression(node, triton::engines::symbolic::REG, comment);
         this->assignSymbolicExpressionToRegister(se, flag);
         inst.addSymbolicExpression(se);
@@ -936,8 +1325,101 @@ namespace triton {
       }
 
 
+      /*
+       * Returns the new symbolic flag expression built from the parent expression.
+       * In the LAZY_FLAGS mode, most flags are overwritten before being read, so
+       * the builder is recorded and only called when the flag is read (see
+       * buildLazyFlag). The parent's AST is used instead of a reference to the
+       * parent, this way the flag does not depend on the lifetime of the parent.
+       */
+      SymbolicExpression* SymbolicEngine::createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, SymbolicExpression* parent, const triton::arch::Register& flag, const std::vector<triton::ast::AbstractNode*>& nodes, const LazyFlagBuilder& build, bool isTainted, const std::string& comment) {
+        if (!this->architecture->isFlag(flag))
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::createSymbolicLazyFlagExpression(): The register must be a flag.");
+
+        /*
+         * When the symbolic engine is disabled, its state is restored after the
+         * instruction but the concrete value of the flag must be synchronized.
+         */
+        if (!this->modes.isModeEnabled(triton::modes::LAZY_FLAGS) || !this->isEnabled()) {
+          SymbolicExpression* se = this->createSymbolicFlagExpression(inst, build(this->astCtxt.reference(*parent)), flag, comment);
+          se->isTainted = isTainted;
+          return se;
+        }
+
+        triton::ast::AbstractNode* ast = parent->getAst();
+        triton::arch::registers_e id   = flag.getParent();
+
+        this->removeLazyFlag(id);
+
+        LazyFlag& lazy = this->lazyFlags[id];
+        lazy.nodes = nodes;
+        lazy.nodes.push_back(ast);
+        for (auto* node : lazy.nodes)
+          node->retain();
+
+        lazy.build     = [build, ast] { return build(ast); };
+        lazy.comment   = comment;
+        lazy.isTainted = isTainted;
+
+        this->symbolicReg[id] = triton::engines::symbolic::UNSET;
+
+        return nullptr;
+      }
+
+
+      /* Builds the expression of a pending flag */
+      void SymbolicEngine::buildLazyFlag(const triton::arch::Register& flag) {
+        auto it = this->lazyFlags.find(flag.getParent());
+
+        if (it == this->lazyFlags.end())
+          return;
+
+        LazyFlag lazy = it->second;
+        this->lazyFlags.erase(it);
+
+        const triton::arch::Register& reg = this->architecture->getRegister(flag.getParent());
+        triton::ast::AbstractNode* node   = lazy.build();
+
+        /* Same filters as the IR builder applies to the eager expressions */
+        if ((this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED) && !node->isSymbolized()) ||
+            (this->modes.isModeEnabled(triton::modes::ONLY_ON_TAINTED) && !lazy.isTainted)) {
+          this->architecture->setConcreteRegisterValue(reg, node->evaluate());
+          /* Free the nodes built for nothing */
+          node->retain();
+          node->release();
+        }
+        else {
+          SymbolicExpression* se = this->newSymbolicExpression(node, triton::engines::symbolic::REG, lazy.comment);
+          se->isTainted = lazy.isTainted;
+          this->assignSymbolicExpressionToRegister(se, reg);
+        }
+
+        for (auto* n : lazy.nodes)
+          n->release();
+      }
+
+
+      /* Builds the expressions of all pending flags */
+      void SymbolicEngine::buildLazyFlags(void) {
+        while (!this->lazyFlags.empty())
+          this->buildLazyFlag(this->architecture->getRegister(this->lazyFlags.begin()->first));
+      }
+
+
+      /* Returns true if the expression of the flag is pending */
+      bool SymbolicEngine::isLazyFlag(const triton::arch::Register& flag) const {
+        return this->lazyFlags.find(flag.getParent()) != this->lazyFlags.end();
+      }
+
+
       /* Returns the new symbolic volatile expression */
       SymbolicExpression* SymbolicEngine::createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment) {
+        if (this->isConcreteNode(node)) {
+          triton::engines::symbolic::SymbolicExpression* se = this->newConcreteExpression(node, triton::engines::symbolic::UNDEF, comment);
+          inst.addSymbolicExpression(se);
+          return se;
+        }
+
         triton::engines::symbolic::SymbolicExpression* se = this->newSymbolicExpression(node, triton::engines::symbolic::UNDEF, comment);
         inst.addSymbolicExpression(se);
         return se;
@@ -946,7 +1428,13 @@ namespace triton {
 
       /* Adds and assign a new memory reference */
       void SymbolicEngine::addMemoryReference(triton::uint64 mem, triton::usize id) {
-        this->memoryReference[mem] = id;
+        this->memoryReference.assign(mem, BYTE_SIZE, id);
+      }
+
+
+      /* Adds and assign a new memory reference over several bytes */
+      void SymbolicEngine::addMemoryReference(triton::uint64 mem, triton::uint64 size, triton::usize id, triton::uint64 offset) {
+        this->memoryReference.assign(mem, size, id, offset);
       }
 
 
@@ -964,6 +1452,10 @@ namespace triton {
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::assignSymbolicExpressionToRegister(): The size of the symbolic expression is not equal to the target register.");
         }
 
+        /* The expression overwrites a pending flag */
+        if (!this->lazyFlags.empty())
+          this->removeLazyFlag(static_cast<triton::arch::registers_e>(id));
+
         se->setKind(triton::engines::symbolic::REG);
         se->setOriginRegister(reg);
         this->symbolicReg[id] = se->getId();
@@ -987,19 +1479,10 @@ namespace triton {
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY))
           this->addAlignedMemory(address, writeSize, node);
 
-        /*
-         * As the x86's memory can be accessed without alignment, each byte of the
-         * memory must be assigned to an unique reference.
-         */
-        while (writeSize) {
-          /* Extract each byte of the memory */
-          triton::ast::AbstractNode* tmp = this->astCtxt.extract(((writeSize * BYTE_SIZE_BIT) - 1), ((writeSize * BYTE_SIZE_BIT) - BYTE_SIZE_BIT), node);
-          SymbolicExpression* byteRef = this->newSymbolicExpression(tmp, triton::engines::symbolic::MEM, "Byte reference");
-          byteRef->setOriginMemory(triton::arch::MemoryAccess(((address + writeSize) - 1), BYTE_SIZE));
-          /* Assign memory with little endian */
-          this->addMemoryReference((address + writeSize) - 1, byteRef->getId());
-          writeSize--;
-        }
+        /* The expression defines the memory as a whole */
+        se->setKind(triton::engines::symbolic::MEM);
+        se->setOriginMemory(mem);
+        this->addMemoryReference(address, writeSize, se->getId());
       }
 
 
@@ -1011,7 +1494,7 @@ namespace triton {
 
       /* Returns true if the symbolic expression ID exists */
       bool SymbolicEngine::isSymbolicExpressionIdExists(triton::usize symExprId) const {
-        if (this->symbolicExpressions.find(symExprId) != this->symbolicExpressions.end())
+        if (this->symbolicExpressions.get(symExprId) != nullptr)
           return true;
         return false;
       }
@@ -1028,13 +1511,8 @@ namespace triton {
 
       /* Returns true if memory cell expressions contain symbolic variables. */
       bool SymbolicEngine::isMemorySymbolized(triton::uint64 addr, triton::uint32 size) const {
-        for (triton::uint32 i = 0; i < size; i++) {
-          triton::usize symId = this->getSymbolicMemoryId(addr+i);
-
-          if (symId == triton::engines::symbolic::UNSET)
-            continue;
-
-          triton::engines::symbolic::SymbolicExpression* symExp = this->getSymbolicExpressionFromId(symId);
+        for (const auto& range : this->memoryReference.getRanges(addr, size)) {
+          triton::engines::symbolic::SymbolicExpression* symExp = this->getSymbolicExpressionFromId(range.id);
           if (symExp->isSymbolized())
             return true;
         }
@@ -1057,6 +1535,13 @@ namespace triton {
 
       /* Enables or disables the symbolic engine */
       void SymbolicEngine::enable(bool flag) {
+        /*
+         * The nodes built while the engine is disabled are deleted after each instruction,
+         * so the pending flags are built before (and there is no pending flag until the
+         * engine is enabled again).
+         */
+        if (!flag)
+          this->buildLazyFlags();
         this->enableFlag = flag;
       }
 
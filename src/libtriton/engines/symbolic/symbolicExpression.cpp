@@ -6,6 +6,7 @@
 */
 
 #include <iosfwd>                         // for ostream
+#include <set>                            // for set
 #include <string>                         // for string
 #include <triton/astRepresentation.hpp>   // for AstRepresentation, astRepre...
 #include <triton/astContext.hpp>          // for AstContext
@@ -20,6 +21,9 @@ namespace triton {
   namespace engines {
     namespace symbolic {
 
+      triton::usize SymbolicExpression::lastVersion = 0;
+
+
       SymbolicExpression::SymbolicExpression(triton::ast::AbstractNode* node, triton::usize id, symkind_e kind, const std::string& comment)
         : originMemory(),
           originRegister() {
@@ -28,6 +32,10 @@ namespace triton {
         this->id            = id;
         this->isTainted     = false;
         this->kind          = kind;
+        this->version       = 0;
+
+        if (this->ast != nullptr)
+          this->ast->retain();
       }
 
 
@@ -39,10 +47,27 @@ namespace triton {
         this->kind           = other.kind;
         this->originMemory   = other.originMemory;
         this->originRegister = other.originRegister;
+        this->version        = other.version;
+
+        if (this->ast != nullptr)
+          this->ast->retain();
+      }
+
+
+      SymbolicExpression::~SymbolicExpression() {
+        if (this->ast != nullptr) {
+          this->ast->getContext().getAstGarbageCollector().detachReferenceNodes(*this);
+          this->ast->release();
+        }
       }
 
 
       SymbolicExpression& SymbolicExpression::operator=(const SymbolicExpression& other) {
+        if (other.ast != nullptr)
+          other.ast->retain();
+        if (this->ast != nullptr)
+          this->ast->release();
+
         this->ast            = other.ast;
         this->comment        = other.comment;
         this->id             = other.id;
@@ -50,6 +75,7 @@ namespace triton {
         this->kind           = other.kind;
         this->originMemory   = other.originMemory;
         this->originRegister = other.originRegister;
+        this->version        = other.version;
         return *this;
       }
 
@@ -78,6 +104,16 @@ namespace triton {
       }
 
 
+      triton::usize SymbolicExpression::getVersion(void) const {
+        return this->version;
+      }
+
+
+      triton::usize SymbolicExpression::getLastVersion(void) {
+        return SymbolicExpression::lastVersion;
+      }
+
+
       std::string SymbolicExpression::getFormattedId(void) const {
         if (this->ast == nullptr)
           throw triton::exceptions::SymbolicExpression("SymbolicExpression::getAst(): No AST defined.");
@@ -125,9 +161,33 @@ namespace triton {
 
 
       void SymbolicExpression::setAst(triton::ast::AbstractNode* node) {
-        node->setParent(this->ast->getParents());
+        triton::ast::AbstractNode* old = this->ast;
+
+        if (node == nullptr)
+          throw triton::exceptions::SymbolicExpression("SymbolicExpression::setAst(): The AST cannot be null.");
+
+        node->retain();
+
+        /* The reference nodes of this expression now depend on the new tree */
+        if (old != nullptr) {
+          std::set<triton::ast::AbstractNode*> parents = old->getParents();
+          for (triton::ast::AbstractNode* parent : parents) {
+            if (parent->getKind() == triton::ast::REFERENCE_NODE && !reinterpret_cast<triton::ast::ReferenceNode*>(parent)->isDetached() &&
+                &reinterpret_cast<triton::ast::ReferenceNode*>(parent)->getSymbolicExpression() == this) {
+              old->removeParent(parent);
+              node->setParent(parent);
+            }
+          }
+        }
+
         this->ast = node;
         this->ast->init();
+
+        /* The unrolled ASTs built from the old tree are out of date */
+        this->version = ++SymbolicExpression::lastVersion;
+
+        if (old != nullptr)
+          old->release();
       }
 
 
@@ -0,0 +1,214 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+
+#include <triton/symbolicMemory.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace symbolic {
+
+      /* Returns the address of the last byte of an access, it does not overflow unless the access wraps around the address space */
+      static inline triton::uint64 lastByte(triton::uint64 address, triton::uint64 size) {
+        return address + (size - 1);
+      }
+
+
+      /* Returns true if an access wraps around the address space */
+      static inline bool wraps(triton::uint64 address, triton::uint64 size) {
+        return (lastByte(address, size) < address);
+      }
+
+
+      SymbolicMemory::SymbolicMemory() {
+        this->bytes = 0;
+      }
+
+
+      void SymbolicMemory::insert(const Range& range) {
+        this->ranges[range.address] = range;
+        this->addresses.emplace(range.id, range.address);
+        this->bytes += range.size;
+      }
+
+
+      std::map<triton::uint64, SymbolicMemory::Range>::iterator SymbolicMemory::remove(std::map<triton::uint64, Range>::iterator it) {
+        auto index = this->addresses.equal_range(it->second.id);
+
+        for (auto i = index.first; i != index.second; i++) {
+          if (i->second == it->first) {
+            this->addresses.erase(i);
+            break;
+          }
+        }
+
+        this->bytes -= it->second.size;
+        return this->ranges.erase(it);
+      }
+
+
+      void SymbolicMemory::split(triton::uint64 address) {
+        auto it = this->ranges.upper_bound(address);
+
+        if (it == this->ranges.begin())
+          return;
+
+        Range& range = (--it)->second;
+        if (range.address == address || lastByte(range.address, range.size) < address)
+          return;
+
+        /* Cut the range in two, the second part keeps referencing the upper bytes of the expression */
+        triton::uint64 delta = address - range.address;
+        Range upper(address, range.size - delta, range.id, range.offset + delta);
+
+        range.size = delta;
+        this->bytes -= upper.size;
+        this->insert(upper);
+      }
+
+
+      void SymbolicMemory::assign(triton::uint64 address, triton::uint64 size, triton::usize id, triton::uint64 offset) {
+        if (size == 0)
+          return;
+
+        /* The bytes past the end of the address space are at address 0 */
+        if (wraps(address, size)) {
+          triton::uint64 upper = ~address + 1;
+          this->assign(address, upper, id, offset);
+          this->assign(0, size - upper, id, offset + upper);
+          return;
+        }
+
+        /* Fast path: the exact same range is overwritten */
+        auto it = this->ranges.find(address);
+        if (it != this->ranges.end() && it->second.size == size) {
+          if (it->second.id != id) {
+            this->remove(it);
+            this->insert(Range(address, size, id, offset));
+          }
+          else
+            it->second.offset = offset;
+          return;
+        }
+
+        this->erase(address, size);
+        this->insert(Range(address, size, id, offset));
+      }
+
+
+      void SymbolicMemory::erase(triton::uint64 address, triton::uint64 size) {
+        if (size == 0 || this->ranges.empty())
+          return;
+
+        if (wraps(address, size)) {
+          triton::uint64 upper = ~address + 1;
+          this->erase(address, upper);
+          this->erase(0, size - upper);
+          return;
+        }
+
+        triton::uint64 last = lastByte(address, size);
+
+        this->split(address);
+        if (last != static_cast<triton::uint64>(-1))
+          this->split(last + 1);
+
+        auto it = this->ranges.lower_bound(address);
+        while (it != this->ranges.end() && it->first <= last)
+          it = this->remove(it);
+      }
+
+
+      void SymbolicMemory::clear(void) {
+        this->ranges.clear();
+        this->addresses.clear();
+        this->bytes = 0;
+      }
+
+
+      bool SymbolicMemory::find(triton::uint64 address, Range& range) const {
+        auto it = this->ranges.upper_bound(address);
+
+        if (it == this->ranges.begin())
+          return false;
+
+        const Range& r = (--it)->second;
+        if (lastByte(r.address, r.size) < address)
+          return false;
+
+        range = Range(address, 1, r.id, r.offset + (address - r.address));
+        return true;
+      }
+
+
+      std::vector<SymbolicMemory::Range> SymbolicMemory::getRanges(triton::uint64 address, triton::uint64 size) const {
+        std::vector<Range> ret;
+
+        if (size == 0 || this->ranges.empty())
+          return ret;
+
+        /* The ranges from address 0 come after the ones up to the end of the address space */
+        if (wraps(address, size)) {
+          triton::uint64 upper = ~address + 1;
+          ret = this->getRanges(address, upper);
+          std::vector<Range> lower = this->getRanges(0, size - upper);
+          ret.insert(ret.end(), lower.begin(), lower.end());
+          return ret;
+        }
+
+        triton::uint64 last = lastByte(address, size);
+
+        auto it = this->ranges.upper_bound(address);
+        if (it != this->ranges.begin())
+          it--;
+
+        for (; it != this->ranges.end() && it->first <= last; it++) {
+          const Range& r = it->second;
+          if (lastByte(r.address, r.size) < address)
+            continue;
+
+          /* Clip the range to [address, last] */
+          triton::uint64 lo = std::max(r.address, address);
+          triton::uint64 hi = std::min(lastByte(r.address, r.size), last);
+          ret.push_back(Range(lo, hi - lo + 1, r.id, r.offset + (lo - r.address)));
+        }
+
+        return ret;
+      }
+
+
+      std::vector<SymbolicMemory::Range> SymbolicMemory::getExpressionRanges(triton::usize id) const {
+        std::vector<Range> ret;
+
+        auto index = this->addresses.equal_range(id);
+        for (auto it = index.first; it != index.second; it++)
+          ret.push_back(this->ranges.at(it->second));
+
+        return ret;
+      }
+
+
+      const std::map<triton::uint64, SymbolicMemory::Range>& SymbolicMemory::getRanges(void) const {
+        return this->ranges;
+      }
+
+
+      triton::usize SymbolicMemory::size(void) const {
+        return this->bytes;
+      }
+
+
+      bool SymbolicMemory::empty(void) const {
+        return this->ranges.empty();
+      }
+
+    }; /* symbolic namespace */
+  }; /* engines namespace */
+}; /*triton namespace */
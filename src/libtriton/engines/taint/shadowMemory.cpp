@@ -0,0 +1,204 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <new>
+
+#include <triton/exceptions.hpp>
+#include <triton/shadowMemory.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace taint {
+
+      /* Returns a mask of `size` bits */
+      static inline triton::uint64 bitMask(triton::uint32 size) {
+        if (size >= 64)
+          return ~static_cast<triton::uint64>(0);
+        return (static_cast<triton::uint64>(1) << size) - 1;
+      }
+
+
+      ShadowMemory::Page::Page() {
+        std::memset(this->bits, 0x00, sizeof(this->bits));
+        this->count = 0;
+      }
+
+
+      ShadowMemory::ShadowMemory() {
+      }
+
+
+      ShadowMemory::ShadowMemory(const ShadowMemory& other) {
+        this->copy(other);
+      }
+
+
+      ShadowMemory::~ShadowMemory() {
+        this->clear();
+      }
+
+
+      ShadowMemory& ShadowMemory::operator=(const ShadowMemory& other) {
+        if (this != &other)
+          this->copy(other);
+        return *this;
+      }
+
+
+      void ShadowMemory::copy(const ShadowMemory& other) {
+        this->clear();
+
+        for (auto it = other.pages.begin(); it != other.pages.end(); it++) {
+          Page* page = new(std::nothrow) Page(*it->second);
+          if (page == nullptr)
+            throw triton::exceptions::TaintEngine("ShadowMemory::copy(): Not enough memory.");
+          this->pages[it->first] = page;
+        }
+      }
+
+
+      triton::uint64 ShadowMemory::getWordBits(triton::uint64 addr, triton::uint32 size) const {
+        auto it = this->pages.find(addr >> SHADOW_PAGE_SHIFT);
+
+        if (it == this->pages.end())
+          return 0;
+
+        triton::usize offset = addr & (SHADOW_PAGE_SIZE - 1);
+        return (it->second->bits[offset / 64] >> (offset % 64)) & bitMask(size);
+      }
+
+
+      void ShadowMemory::setWordBits(triton::uint64 addr, triton::uint32 size, triton::uint64 bits) {
+        triton::uint64 pageId = addr >> SHADOW_PAGE_SHIFT;
+        triton::usize offset  = addr & (SHADOW_PAGE_SIZE - 1);
+        triton::uint64 mask   = bitMask(size) << (offset % 64);
+        auto it               = this->pages.find(pageId);
+        Page* page            = nullptr;
+
+        bits = (bits << (offset % 64)) & mask;
+
+        if (it != this->pages.end())
+          page = it->second;
+
+        /* Nothing to untaint in a page which does not exist */
+        else if (bits == 0)
+          return;
+
+        else {
+          page = new(std::nothrow) Page();
+          if (page == nullptr)
+            throw triton::exceptions::TaintEngine("ShadowMemory::setWordBits(): Not enough memory.");
+          this->pages[pageId] = page;
+        }
+
+        triton::uint64& word = page->bits[offset / 64];
+        triton::uint64 value = (word & ~mask) | bits;
+
+        page->count += std::bitset<64>(value).count();
+        page->count -= std::bitset<64>(word).count();
+        word = value;
+
+        /* Release the page when nothing is tainted anymore */
+        if (page->count == 0) {
+          this->pages.erase(pageId);
+          delete page;
+        }
+      }
+
+
+      triton::uint64 ShadowMemory::getBits(triton::uint64 addr, triton::uint32 size) const {
+        triton::uint64 ret = 0;
+
+        for (triton::uint32 done = 0; done < size;) {
+          triton::uint32 bit = (addr + done) % 64;
+          triton::uint32 n   = std::min(64 - bit, size - done);
+          ret |= this->getWordBits(addr + done, n) << done;
+          done += n;
+        }
+
+        return ret;
+      }
+
+
+      void ShadowMemory::setBits(triton::uint64 addr, triton::uint32 size, triton::uint64 bits) {
+        for (triton::uint32 done = 0; done < size;) {
+          triton::uint32 bit = (addr + done) % 64;
+          triton::uint32 n   = std::min(64 - bit, size - done);
+          this->setWordBits(addr + done, n, bits >> done);
+          done += n;
+        }
+      }
+
+
+      bool ShadowMemory::isTainted(triton::uint64 addr, triton::usize size) const {
+        if (this->pages.empty())
+          return false;
+
+        while (size) {
+          triton::uint32 n = static_cast<triton::uint32>(std::min<triton::usize>(64, size));
+          if (this->getBits(addr, n))
+            return true;
+          addr += n;
+          size -= n;
+        }
+
+        return false;
+      }
+
+
+      void ShadowMemory::taint(triton::uint64 addr, triton::usize size) {
+        while (size) {
+          triton::uint32 n = static_cast<triton::uint32>(std::min<triton::usize>(64, size));
+          this->setBits(addr, n, bitMask(n));
+          addr += n;
+          size -= n;
+        }
+      }
+
+
+      void ShadowMemory::untaint(triton::uint64 addr, triton::usize size) {
+        while (size && !this->pages.empty()) {
+          triton::uint32 n = static_cast<triton::uint32>(std::min<triton::usize>(64, size));
+          this->setBits(addr, n, 0);
+          addr += n;
+          size -= n;
+        }
+      }
+
+
+      std::set<triton::uint64> ShadowMemory::getTaintedAddresses(void) const {
+        std::set<triton::uint64> ret;
+
+        for (auto it = this->pages.begin(); it != this->pages.end(); it++) {
+          triton::uint64 base = it->first << SHADOW_PAGE_SHIFT;
+          for (triton::usize w = 0; w < SHADOW_PAGE_SIZE / 64; w++) {
+            triton::uint64 word = it->second->bits[w];
+            for (triton::uint32 b = 0; word; b++, word >>= 1) {
+              if (word & 1)
+                ret.insert(base + (w * 64) + b);
+            }
+          }
+        }
+
+        return ret;
+      }
+
+
+      void ShadowMemory::clear(void) {
+        for (auto it = this->pages.begin(); it != this->pages.end(); it++)
+          delete it->second;
+        this->pages.clear();
+      }
+
+    }; /* taint namespace */
+  }; /* engines namespace */
+}; /* triton namespace */
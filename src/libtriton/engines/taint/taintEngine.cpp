@@ -5,6 +5,9 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+
+#include <triton/cpuSize.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/taintEngine.hpp>
 
@@ -75,16 +78,19 @@ simplicity and performance. Let's look at the following ASM code.
 
 ~~~~~~~~~~~~~{.asm}
 mov ax, 0x1122                ; RAX is untainted
-mov al, byte ptr [user_input] ; RAX is tainted
+mov al, byte ptr [user_input] ; AL is tainted
 cmp ah, 0x99                  ; can we control this comparison?
 ~~~~~~~~~~~~~
 
-Under our current over-approximation, the taint engine will raise a false
-positive (that says the `ah` is tainted while it actually is not) for this
-particular example, while only the seven bits of `RAX` (`RAX[7..0]`) is tainted
-while the other bits (`RAX[63..8]`) are not.
+The taint of the registers is tracked per byte of their parent register, so
+`ah` is not tainted in this example: only the byte of `RAX` (`RAX[7..0]`) written
+by `al` is. A write only touches the bytes of the written register (a 32-bit or
+wider write also clears the upper bytes of its parent, as the CPU zero-extends
+it) but an operation still spreads the taint of one source byte to all the bytes
+of its destination. The bits of a byte are not tracked, which may raise false
+positives.
 
-This imprecision may raise excessively extraneous false positive on a big
+The remaining imprecision may raise excessively extraneous false positive on a big
 problem and make the tool totally useless in solving real problems. Let's
 consider a scenario when an attacker is developing an exploit of an executable.
 In this scenario, what the attacker wants to know is if a register at certain
@@ -104,6 +110,43 @@ over-approximated tainting to know if we can ask a model to the SMT solver - by
 asking a model, we can query the solver and check if the symbolic variables are
 controllable by the user input.
 
+
+\section engine_Taint_summaries Taint Summaries
+<hr>
+
+The taint is usually spread by the instruction semantics, which also build the
+symbolic expressions and update the concrete state. When the symbolic engine is
+disabled and the `TAINT_SUMMARIES` mode is enabled, the taint engine spreads the
+taint from a summary of the opcode instead (see `triton::engines::taint::TaintSummary`):
+the destination is assigned or merged with the taint of the other operands, and
+the written flags take the taint of the result. The semantics are not built, so
+the concrete state must be provided by the caller (e.g. a tracer). The opcodes
+without summary are still processed by the semantics.
+
+
+\section engine_Taint_labels Taint Labels
+<hr>
+
+A taint source may be given a label (`taintMemoryWithLabel()` and `taintRegisterWithLabel()`),
+so that one execution tells which sources reach a target instead of one execution per source.
+Each tainted byte of the memory and of the registers holds the id of a label set. The sets
+are interned in a table (see `triton::engines::taint::TaintLabels`) which also memoizes their
+unions, so spreading the labels only costs a lookup per byte. An assignment copies the labels
+of its source, a union merges the labels of its operands, and the other written operands
+(e.g. the flags) take the labels of all the tainted operands read by the instruction. The
+labels are only tracked once a label has been introduced and the bytes tainted without label
+have an empty set.
+
+~~~~~~~~~~~~~{.py}
+>>> ctx.taintMemoryWithLabel(MemoryAccess(0x1000, CPUSIZE.QWORD), 1)
+True
+>>> ctx.taintMemoryWithLabel(MemoryAccess(0x2000, CPUSIZE.QWORD), 2)
+True
+>>> # mov rax, [0x1000] ; cmp rax, [0x2000] ; jz ...
+>>> ctx.getRegisterTaintLabels(ctx.registers.rip)
+[1L, 2L]
+~~~~~~~~~~~~~
+
 */
 
 
@@ -112,10 +155,26 @@ namespace triton {
   namespace engines {
     namespace taint {
 
+      /* Returns the bytes of the parent register covered by a register (one bit per byte) */
+      static inline triton::uint64 getRegisterMask(const triton::arch::Register& reg) {
+        triton::uint32 low  = reg.getAbstractLow() / BYTE_SIZE_BIT;
+        triton::uint32 size = (reg.getAbstractHigh() / BYTE_SIZE_BIT) - low + 1;
+
+        if (size >= TAINT_REGISTER_BYTES)
+          return static_cast<triton::uint64>(-1);
+
+        return ((static_cast<triton::uint64>(1) << size) - 1) << low;
+      }
+
+
       TaintEngine::TaintEngine(triton::engines::symbolic::SymbolicEngine* symbolicEngine, const triton::arch::CpuInterface& cpu)
         : symbolicEngine(symbolicEngine),
           cpu(cpu),
-          enableFlag(true) {
+          enableFlag(true),
+          taintedRegisters(triton::arch::ID_REG_LAST_ITEM, 0),
+          labelFlag(false),
+          collectFlag(false),
+          readLabels(EMPTY_LABEL_SET) {
 
         if (this->symbolicEngine == nullptr)
           throw triton::exceptions::TaintEngine("TaintEngine::TaintEngine(): The symbolicEngine TaintEngine cannot be null.");
@@ -127,6 +186,12 @@ namespace triton {
         this->symbolicEngine   = other.symbolicEngine;
         this->taintedMemory    = other.taintedMemory;
         this->taintedRegisters = other.taintedRegisters;
+        this->labels           = other.labels;
+        this->labelFlag        = other.labelFlag;
+        this->collectFlag      = false;
+        this->readLabels       = EMPTY_LABEL_SET;
+        this->memoryLabels     = other.memoryLabels;
+        this->registerLabels   = other.registerLabels;
       }
 
 
@@ -153,8 +218,8 @@ namespace triton {
 
 
       /* Returns the tainted addresses */
-      const std::set<triton::uint64>& TaintEngine::getTaintedMemory(void) const {
-        return this->taintedMemory;
+      std::set<triton::uint64> TaintEngine::getTaintedMemory(void) const {
+        return this->taintedMemory.getTaintedAddresses();
       }
 
 
@@ -162,8 +227,10 @@ namespace triton {
       std::set<const triton::arch::Register*> TaintEngine::getTaintedRegisters(void) const {
         std::set<const triton::arch::Register*> res;
 
-        for (auto id : this->taintedRegisters)
-          res.insert(&this->cpu.getRegister(id));
+        for (triton::uint32 id = 0; id < this->taintedRegisters.size(); id++) {
+          if (this->taintedRegisters[id])
+            res.insert(&this->cpu.getRegister(static_cast<triton::arch::registers_e>(id)));
+        }
 
         return res;
       }
@@ -171,12 +238,10 @@ namespace triton {
 
       /* Returns true of false if the memory address is currently tainted */
       bool TaintEngine::isMemoryTainted(const triton::arch::MemoryAccess& mem) const {
-        triton::uint64 addr = mem.getAddress();
-        triton::uint32 size = mem.getSize();
-
-        for (triton::uint32 index = 0; index < size; index++) {
-          if (this->taintedMemory.find(addr+index) != this->taintedMemory.end())
-            return TAINTED;
+        if (this->taintedMemory.isTainted(mem.getAddress(), mem.getSize())) {
+          if (this->collectFlag)
+            this->getMemoryLabels(mem.getAddress(), mem.getSize());
+          return TAINTED;
         }
 
         return !TAINTED;
@@ -185,9 +250,10 @@ namespace triton {
 
       /* Returns true of false if the address is currently tainted */
       bool TaintEngine::isMemoryTainted(triton::uint64 addr, triton::uint32 size) const {
-        for (triton::uint32 index = 0; index < size; index++) {
-          if (this->taintedMemory.find(addr+index) != this->taintedMemory.end())
-            return TAINTED;
+        if (this->taintedMemory.isTainted(addr, size)) {
+          if (this->collectFlag)
+            this->getMemoryLabels(addr, size);
+          return TAINTED;
         }
 
         return !TAINTED;
@@ -196,8 +262,11 @@ namespace triton {
 
       /* Returns true of false if the register is currently tainted */
       bool TaintEngine::isRegisterTainted(const triton::arch::Register& reg) const {
-        if (this->taintedRegisters.find(reg.getParent()) != this->taintedRegisters.end())
+        if (this->taintedRegisters[reg.getParent()] & getRegisterMask(reg)) {
+          if (this->collectFlag)
+            this->getRegisterLabels(reg);
           return TAINTED;
+        }
 
         return !TAINTED;
       }
@@ -219,7 +288,11 @@ namespace triton {
       bool TaintEngine::taintRegister(const triton::arch::Register& reg) {
         if (!this->isEnabled())
           return this->isRegisterTainted(reg);
-        this->taintedRegisters.insert(reg.getParent());
+        this->taintedRegisters[reg.getParent()] |= getRegisterMask(reg);
+
+        /* An instruction gives the labels it has read, a plain call keeps the labels of the bytes */
+        if (this->collectFlag)
+          this->setRegisterLabels(reg, this->getCollectedLabels(), false);
 
         return TAINTED;
       }
@@ -229,12 +302,40 @@ namespace triton {
       bool TaintEngine::untaintRegister(const triton::arch::Register& reg) {
         if (!this->isEnabled())
           return this->isRegisterTainted(reg);
-        this->taintedRegisters.erase(reg.getParent());
+        this->taintedRegisters[reg.getParent()] &= ~getRegisterMask(reg);
+        this->setRegisterLabels(reg, EMPTY_LABEL_SET, false);
 
         return !TAINTED;
       }
 
 
+      /* Writes the taint of a register, the bytes above a 32-bit or wider register are zeroed by the write */
+      void TaintEngine::writeRegister(const triton::arch::Register& reg, bool flag, triton::uint32 label) {
+        triton::uint64 mask    = getRegisterMask(reg);
+        triton::uint64 written = (reg.getSize() >= DWORD_SIZE) ? getRegisterMask(this->cpu.getParentRegister(reg)) : mask;
+        triton::uint64& bytes  = this->taintedRegisters[reg.getParent()];
+
+        bytes = (bytes & ~written) | (flag ? mask : 0);
+
+        if (this->labelFlag) {
+          if (written != mask)
+            this->setRegisterLabels(this->cpu.getParentRegister(reg), EMPTY_LABEL_SET, false);
+          this->setRegisterLabels(reg, (flag ? label : EMPTY_LABEL_SET), false);
+        }
+      }
+
+
+      /* Writes the taint of a memory area */
+      void TaintEngine::writeMemory(triton::uint64 addr, triton::uint32 size, bool flag, triton::uint32 label) {
+        if (flag == TAINTED)
+          this->taintedMemory.taint(addr, size);
+        else
+          this->taintedMemory.untaint(addr, size);
+
+        this->setMemoryLabels(addr, size, (flag ? label : EMPTY_LABEL_SET), false);
+      }
+
+
       /* Sets the flag (taint or untaint) to an abstract operand (Register or Memory). */
       bool TaintEngine::setTaint(const triton::arch::OperandWrapper& op, bool flag) {
         switch (op.getType()) {
@@ -285,8 +386,11 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(mem);
 
-        for (triton::uint32 index = 0; index < size; index++)
-          this->taintedMemory.insert(addr+index);
+        /* An instruction gives the labels it has read, a plain call keeps the labels of the bytes */
+        if (this->collectFlag)
+          this->writeMemory(addr, size, TAINTED, this->getCollectedLabels());
+        else
+          this->taintedMemory.taint(addr, size);
 
         return TAINTED;
       }
@@ -296,7 +400,10 @@ namespace triton {
       bool TaintEngine::taintMemory(triton::uint64 addr) {
         if (!this->isEnabled())
           return this->isMemoryTainted(addr);
-        this->taintedMemory.insert(addr);
+        if (this->collectFlag)
+          this->writeMemory(addr, 1, TAINTED, this->getCollectedLabels());
+        else
+          this->taintedMemory.taint(addr, 1);
         return TAINTED;
       }
 
@@ -309,8 +416,7 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(mem);
 
-        for (triton::uint32 index = 0; index < size; index++)
-          this->taintedMemory.erase(addr+index);
+        this->writeMemory(addr, size, !TAINTED, EMPTY_LABEL_SET);
 
         return !TAINTED;
       }
@@ -320,7 +426,7 @@ namespace triton {
       bool TaintEngine::untaintMemory(triton::uint64 addr) {
         if (!this->isEnabled())
           return this->isMemoryTainted(addr);
-        this->taintedMemory.erase(addr);
+        this->writeMemory(addr, 1, !TAINTED, EMPTY_LABEL_SET);
         return !TAINTED;
       }
 
@@ -379,21 +485,26 @@ namespace triton {
       }
 
 
+      void TaintEngine::taintMemoryExpressions(const triton::arch::MemoryAccess& mem, bool flag) {
+        for (const auto& range : this->symbolicEngine->getSymbolicMemoryRanges(mem))
+          this->symbolicEngine->getSymbolicExpressionFromId(range.id)->isTainted = flag;
+      }
+
+
+      void TaintEngine::taintMemoryExpressions(const triton::arch::MemoryAccess& mem) {
+        /* The taint of the destination is already spread, an expression is tainted if one of its bytes is */
+        for (const auto& range : this->symbolicEngine->getSymbolicMemoryRanges(mem))
+          this->symbolicEngine->getSymbolicExpressionFromId(range.id)->isTainted = this->isMemoryTainted(range.address, static_cast<triton::uint32>(range.size));
+      }
+
+
       bool TaintEngine::taintUnionMemoryImmediate(const triton::arch::MemoryAccess& memDst) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->unionMemoryImmediate(memDst);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = flag;
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst, flag);
 
         return flag;
       }
@@ -401,20 +512,11 @@ namespace triton {
 
       bool TaintEngine::taintUnionMemoryMemory(const triton::arch::MemoryAccess& memDst, const triton::arch::MemoryAccess& memSrc) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint64 memAddrSrc = memSrc.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->unionMemoryMemory(memDst, memSrc);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = this->isMemoryTainted(memAddrDst + i) | this->isMemoryTainted(memAddrSrc + i);
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst);
 
         return flag;
       }
@@ -422,19 +524,11 @@ namespace triton {
 
       bool TaintEngine::taintUnionMemoryRegister(const triton::arch::MemoryAccess& memDst, const triton::arch::Register& regSrc) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->unionMemoryRegister(memDst, regSrc);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = flag;
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst, flag);
 
         return flag;
       }
@@ -457,19 +551,11 @@ namespace triton {
 
       bool TaintEngine::taintAssignmentMemoryImmediate(const triton::arch::MemoryAccess& memDst) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->assignmentMemoryImmediate(memDst);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = flag;
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst, flag);
 
         return flag;
       }
@@ -477,20 +563,11 @@ namespace triton {
 
       bool TaintEngine::taintAssignmentMemoryMemory(const triton::arch::MemoryAccess& memDst, const triton::arch::MemoryAccess& memSrc) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint64 memAddrSrc = memSrc.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->assignmentMemoryMemory(memDst, memSrc);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = this->isMemoryTainted(memAddrSrc + i);
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst);
 
         return flag;
       }
@@ -498,19 +575,11 @@ namespace triton {
 
       bool TaintEngine::taintAssignmentMemoryRegister(const triton::arch::MemoryAccess& memDst, const triton::arch::Register& regSrc) {
         bool flag = triton::engines::taint::UNTAINTED;
-        triton::uint64 memAddrDst = memDst.getAddress();
-        triton::uint32 writeSize  = memDst.getSize();
 
         flag = this->assignmentMemoryRegister(memDst, regSrc);
 
-        /* Taint each byte of reference expression */
-        for (triton::uint32 i = 0; i != writeSize; i++) {
-          triton::usize byteId = this->symbolicEngine->getSymbolicMemoryId(memAddrDst + i);
-          if (byteId == triton::engines::symbolic::UNSET)
-            continue;
-          triton::engines::symbolic::SymbolicExpression* byte = this->symbolicEngine->getSymbolicExpressionFromId(byteId);
-          byte->isTainted = flag;
-        }
+        /* Taint the reference expressions */
+        this->taintMemoryExpressions(memDst, flag);
 
         return flag;
       }
@@ -537,11 +606,11 @@ namespace triton {
           return this->isRegisterTainted(regDst);
 
         if (this->isRegisterTainted(regSrc)) {
-          this->taintRegister(regDst);
+          this->writeRegister(regDst, TAINTED, this->getRegisterLabels(regSrc));
           return TAINTED;
         }
 
-        this->untaintRegister(regDst);
+        this->writeRegister(regDst, !TAINTED, EMPTY_LABEL_SET);
         return !TAINTED;
       }
 
@@ -550,7 +619,7 @@ namespace triton {
       bool TaintEngine::assignmentRegisterImmediate(const triton::arch::Register& regDst) {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
-        this->untaintRegister(regDst);
+        this->writeRegister(regDst, !TAINTED, EMPTY_LABEL_SET);
         return !TAINTED;
       }
 
@@ -561,11 +630,11 @@ namespace triton {
           return this->isRegisterTainted(regDst);
 
         if (this->isMemoryTainted(memSrc)) {
-          this->taintRegister(regDst);
+          this->writeRegister(regDst, TAINTED, this->getMemoryLabels(memSrc.getAddress(), memSrc.getSize()));
           return TAINTED;
         }
 
-        this->untaintRegister(regDst);
+        this->writeRegister(regDst, !TAINTED, EMPTY_LABEL_SET);
         return !TAINTED;
       }
 
@@ -580,15 +649,17 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(memDst);
 
-        for (triton::uint32 offset = 0; offset < readSize; offset++) {
-          if (this->isMemoryTainted(addrSrc+offset)) {
-            this->taintMemory(addrDst+offset);
+        /* Copy the taint of the source, 64 bytes at a time */
+        for (triton::uint32 offset = 0; offset < readSize; offset += 64) {
+          triton::uint32 size = std::min<triton::uint32>(64, readSize - offset);
+          triton::uint64 bits = this->taintedMemory.getBits(addrSrc+offset, size);
+          this->taintedMemory.setBits(addrDst+offset, size, bits);
+          if (bits)
             isTainted = TAINTED;
-          }
-          else
-            this->untaintMemory(addrDst+offset);
         }
 
+        this->copyMemoryLabels(addrDst, addrSrc, readSize, false);
+
         return isTainted;
       }
 
@@ -609,7 +680,7 @@ namespace triton {
 
         /* Check source */
         if (this->isRegisterTainted(regSrc)) {
-          this->taintMemory(memDst);
+          this->writeMemory(memDst.getAddress(), memDst.getSize(), TAINTED, this->getRegisterLabels(regSrc));
           return TAINTED;
         }
 
@@ -621,23 +692,26 @@ namespace triton {
 
       /* reg U imm */
       bool TaintEngine::unionRegisterImmediate(const triton::arch::Register& regDst) {
+        bool flag = this->isRegisterTainted(regDst);
+
         if (!this->isEnabled())
-          return this->isRegisterTainted(regDst);
-        return this->isRegisterTainted(regDst);
+          return flag;
+
+        /* The taint of one byte spreads to the whole destination */
+        this->writeRegister(regDst, flag, this->getRegisterLabels(regDst));
+        return flag;
       }
 
 
       /* reg U reg */
       bool TaintEngine::unionRegisterRegister(const triton::arch::Register& regDst, const triton::arch::Register& regSrc) {
+        bool flag = this->isRegisterTainted(regDst) | this->isRegisterTainted(regSrc);
+
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isRegisterTainted(regSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        return this->isRegisterTainted(regDst);
+        this->writeRegister(regDst, flag, this->labels.getUnion(this->getRegisterLabels(regDst), this->getRegisterLabels(regSrc)));
+        return flag;
       }
 
 
@@ -651,14 +725,18 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(memDst);
 
-        /* Check source */
-        for (triton::uint32 offset = 0; offset < writeSize; offset++) {
-          if (this->isMemoryTainted(addrSrc+offset)) {
-            this->taintMemory(addrDst+offset);
+        /* Check source, 64 bytes at a time */
+        for (triton::uint32 offset = 0; offset < writeSize; offset += 64) {
+          triton::uint32 size = std::min<triton::uint32>(64, writeSize - offset);
+          triton::uint64 bits = this->taintedMemory.getBits(addrSrc+offset, size);
+          if (bits) {
+            this->taintedMemory.setBits(addrDst+offset, size, bits | this->taintedMemory.getBits(addrDst+offset, size));
             tainted = TAINTED;
           }
         }
 
+        this->copyMemoryLabels(addrDst, addrSrc, writeSize, true);
+
         /* Check destination */
         if (this->isMemoryTainted(memDst)) {
           return TAINTED;
@@ -670,15 +748,13 @@ namespace triton {
 
       /* reg U mem */
       bool TaintEngine::unionRegisterMemory(const triton::arch::Register& regDst, const triton::arch::MemoryAccess& memSrc) {
+        bool flag = this->isRegisterTainted(regDst) | this->isMemoryTainted(memSrc);
+
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isMemoryTainted(memSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        return this->isRegisterTainted(regDst);
+        this->writeRegister(regDst, flag, this->labels.getUnion(this->getRegisterLabels(regDst), this->getMemoryLabels(memSrc.getAddress(), memSrc.getSize())));
+        return flag;
       }
 
 
@@ -701,7 +777,8 @@ namespace triton {
           return this->isMemoryTainted(memDst);
 
         if (this->isRegisterTainted(regSrc)) {
-          this->taintMemory(memDst);
+          this->taintedMemory.taint(memDst.getAddress(), memDst.getSize());
+          this->setMemoryLabels(memDst.getAddress(), memDst.getSize(), this->getRegisterLabels(regSrc), true);
           return TAINTED;
         }
 
@@ -711,6 +788,428 @@ namespace triton {
         return !TAINTED;
       }
 
+
+      void TaintEngine::initMemoryAddress(triton::arch::MemoryAccess& mem) const {
+        const triton::arch::Register& base  = mem.getConstBaseRegister();
+        const triton::arch::Register& index = mem.getConstIndexRegister();
+        const triton::arch::Register& seg   = mem.getConstSegmentRegister();
+
+        /* Same computation as the LEA AST of the symbolic engine, without the AST */
+        if (mem.getAddress() || mem.getBitSize() < BYTE_SIZE_BIT)
+          return;
+
+        triton::uint32 bitSize = (this->cpu.isRegisterValid(index.getId()) ? index.getBitSize() :
+                                   (this->cpu.isRegisterValid(base.getId()) ? base.getBitSize() :
+                                     (mem.getConstDisplacement().getBitSize() ? mem.getConstDisplacement().getBitSize() :
+                                       this->cpu.registerBitSize()
+                                     )
+                                   )
+                                 );
+
+        triton::uint64 mask = (bitSize >= QWORD_SIZE_BIT) ? static_cast<triton::uint64>(-1) : ((static_cast<triton::uint64>(1) << bitSize) - 1);
+        triton::uint64 addr = 0;
+
+        if (mem.getPcRelative())
+          addr = mem.getPcRelative();
+        else if (this->cpu.isRegisterValid(base.getId()))
+          addr = this->cpu.getConcreteRegisterValue(base).convert_to<triton::uint64>();
+
+        if (this->cpu.isRegisterValid(index.getId()))
+          addr += this->cpu.getConcreteRegisterValue(index).convert_to<triton::uint64>() * mem.getConstScale().getValue();
+
+        addr = (addr + mem.getConstDisplacement().getValue()) & mask;
+
+        /* Use segments as base address instead of selector into the GDT. */
+        if (this->cpu.isRegisterValid(seg.getId())) {
+          triton::uint64 segmentValue = this->cpu.getConcreteRegisterValue(seg).convert_to<triton::uint64>();
+          if (segmentValue) {
+            /* Sign extend the address to the size of the segment */
+            if (bitSize < QWORD_SIZE_BIT && (addr >> (bitSize - 1)) & 1)
+              addr |= ~mask;
+            addr += segmentValue;
+            if (seg.getBitSize() < QWORD_SIZE_BIT)
+              addr &= (static_cast<triton::uint64>(1) << seg.getBitSize()) - 1;
+          }
+        }
+
+        mem.setAddress(addr);
+      }
+
+
+      bool TaintEngine::isFlagTainted(const std::vector<triton::arch::registers_e>& flags) const {
+        bool tainted = !TAINTED;
+
+        for (auto flag : flags) {
+          /* All the tainted flags are read, their labels are collected */
+          if (this->taintedRegisters[flag])
+            tainted |= this->isRegisterTainted(this->cpu.getRegister(flag));
+        }
+
+        return tainted;
+      }
+
+
+      void TaintEngine::setOperandTaint(const triton::arch::OperandWrapper& op, bool flag) {
+        switch (op.getType()) {
+          case triton::arch::OP_REG:
+            this->writeRegister(op.getConstRegister(), flag, this->getCollectedLabels());
+            break;
+
+          case triton::arch::OP_MEM:
+            this->setTaintMemory(op.getConstMemory(), flag);
+            /* Taint the reference expressions */
+            this->taintMemoryExpressions(op.getConstMemory(), flag);
+            break;
+
+          default:
+            break;
+        }
+      }
+
+
+      void TaintEngine::initLabels(void) {
+        if (this->labelFlag)
+          return;
+
+        /* The bytes tainted before have no label */
+        this->labelFlag = true;
+        this->registerLabels.assign(triton::arch::ID_REG_LAST_ITEM * TAINT_REGISTER_BYTES, EMPTY_LABEL_SET);
+      }
+
+
+      void TaintEngine::collectLabels(bool flag) {
+        this->collectFlag = flag;
+        this->readLabels  = EMPTY_LABEL_SET;
+      }
+
+
+      triton::uint32 TaintEngine::getCollectedLabels(void) const {
+        if (!this->collectFlag)
+          return EMPTY_LABEL_SET;
+        return this->readLabels;
+      }
+
+
+      triton::uint32 TaintEngine::getRegisterLabels(const triton::arch::Register& reg) const {
+        triton::uint32 label = EMPTY_LABEL_SET;
+
+        if (!this->labelFlag)
+          return EMPTY_LABEL_SET;
+
+        const triton::uint32* ids = &this->registerLabels[reg.getParent() * TAINT_REGISTER_BYTES];
+        triton::uint64 bytes      = this->taintedRegisters[reg.getParent()] & getRegisterMask(reg);
+
+        for (triton::uint32 i = 0; bytes; i++, bytes >>= 1) {
+          if (bytes & 1)
+            label = this->labels.getUnion(label, ids[i]);
+        }
+
+        if (this->collectFlag)
+          this->readLabels = this->labels.getUnion(this->readLabels, label);
+
+        return label;
+      }
+
+
+      triton::uint32 TaintEngine::getMemoryLabels(triton::uint64 addr, triton::uint32 size) const {
+        triton::uint32 label = EMPTY_LABEL_SET;
+
+        if (!this->labelFlag)
+          return EMPTY_LABEL_SET;
+
+        for (triton::uint32 i = 0; i < size; i++) {
+          auto it = this->memoryLabels.find((addr + i) >> SHADOW_PAGE_SHIFT);
+          if (it != this->memoryLabels.end())
+            label = this->labels.getUnion(label, it->second[(addr + i) & (SHADOW_PAGE_SIZE - 1)]);
+        }
+
+        if (this->collectFlag)
+          this->readLabels = this->labels.getUnion(this->readLabels, label);
+
+        return label;
+      }
+
+
+      void TaintEngine::setRegisterLabels(const triton::arch::Register& reg, triton::uint32 label, bool merge) {
+        if (!this->labelFlag)
+          return;
+
+        triton::uint32* ids  = &this->registerLabels[reg.getParent() * TAINT_REGISTER_BYTES];
+        triton::uint64 bytes = getRegisterMask(reg);
+
+        for (triton::uint32 i = 0; bytes; i++, bytes >>= 1) {
+          if (bytes & 1)
+            ids[i] = merge ? this->labels.getUnion(ids[i], label) : label;
+        }
+      }
+
+
+      void TaintEngine::setMemoryLabels(triton::uint64 addr, triton::uint32 size, triton::uint32 label, bool merge) {
+        if (!this->labelFlag)
+          return;
+
+        for (triton::uint32 i = 0; i < size; i++) {
+          triton::uint64 page = (addr + i) >> SHADOW_PAGE_SHIFT;
+          auto it = this->memoryLabels.find(page);
+
+          if (it == this->memoryLabels.end()) {
+            /* The bytes of a missing page have no label */
+            if (label == EMPTY_LABEL_SET)
+              continue;
+            it = this->memoryLabels.emplace(page, std::vector<triton::uint32>(SHADOW_PAGE_SIZE, EMPTY_LABEL_SET)).first;
+          }
+
+          triton::uint32& id = it->second[(addr + i) & (SHADOW_PAGE_SIZE - 1)];
+          id = merge ? this->labels.getUnion(id, label) : label;
+        }
+      }
+
+
+      void TaintEngine::copyMemoryLabels(triton::uint64 dst, triton::uint64 src, triton::uint32 size, bool merge) {
+        if (!this->labelFlag)
+          return;
+
+        std::vector<triton::uint32> ids(size, EMPTY_LABEL_SET);
+
+        /* Read the whole source first, it may overlap the destination */
+        for (triton::uint32 i = 0; i < size; i++)
+          ids[i] = this->getMemoryLabels(src + i, 1);
+
+        for (triton::uint32 i = 0; i < size; i++)
+          this->setMemoryLabels(dst + i, 1, ids[i], merge);
+      }
+
+
+      bool TaintEngine::taintMemoryWithLabel(const triton::arch::MemoryAccess& mem, triton::uint32 label) {
+        if (!this->isEnabled())
+          return this->isMemoryTainted(mem);
+
+        this->initLabels();
+        this->taintedMemory.taint(mem.getAddress(), mem.getSize());
+        this->setMemoryLabels(mem.getAddress(), mem.getSize(), this->labels.getSingleton(label), true);
+
+        return TAINTED;
+      }
+
+
+      bool TaintEngine::taintRegisterWithLabel(const triton::arch::Register& reg, triton::uint32 label) {
+        if (!this->isEnabled())
+          return this->isRegisterTainted(reg);
+
+        this->initLabels();
+        this->taintedRegisters[reg.getParent()] |= getRegisterMask(reg);
+        this->setRegisterLabels(reg, this->labels.getSingleton(label), true);
+
+        return TAINTED;
+      }
+
+
+      std::set<triton::uint32> TaintEngine::getMemoryTaintLabels(const triton::arch::MemoryAccess& mem) const {
+        const std::vector<triton::uint32>& labels = this->labels.getLabels(this->getMemoryLabels(mem.getAddress(), mem.getSize()));
+        return std::set<triton::uint32>(labels.begin(), labels.end());
+      }
+
+
+      std::set<triton::uint32> TaintEngine::getRegisterTaintLabels(const triton::arch::Register& reg) const {
+        const std::vector<triton::uint32>& labels = this->labels.getLabels(this->getRegisterLabels(reg));
+        return std::set<triton::uint32>(labels.begin(), labels.end());
+      }
+
+
+      bool TaintEngine::spreadTaint(const triton::engines::taint::TaintSummary& summary, triton::arch::Instruction& inst) {
+        const triton::arch::Register& pc    = this->cpu.getParentRegister(triton::arch::ID_REG_IP);
+        const triton::arch::Register& stack = this->cpu.getParentRegister(triton::arch::ID_REG_SP);
+        auto& operands = inst.operands;
+        bool tainted   = !TAINTED;
+        bool branch    = false;
+
+        if (!this->isEnabled())
+          return !TAINTED;
+
+        if (!summary.isValid(operands.size()))
+          throw triton::exceptions::TaintEngine("TaintEngine::spreadTaint(): Invalid summary for this instruction.");
+
+        /* Resolve the memory operands */
+        for (auto& operand : operands) {
+          if (operand.getType() == triton::arch::OP_MEM)
+            this->initMemoryAddress(operand.getMemory());
+        }
+
+        /*
+         * The accesses are recorded like the semantics do, so that the callers (e.g. a tracer which
+         * provides the concrete state) still know them. No AST is built, their nodes are null.
+         */
+        auto readRegister = [&](const triton::arch::Register& reg) {
+          if (this->cpu.isRegisterValid(reg.getId()))
+            inst.setReadRegister(reg, nullptr);
+        };
+
+        auto readAddress = [&](const triton::arch::MemoryAccess& mem) {
+          readRegister(mem.getConstBaseRegister());
+          readRegister(mem.getConstIndexRegister());
+          readRegister(mem.getConstSegmentRegister());
+        };
+
+        auto read = [&](const triton::arch::OperandWrapper& operand) {
+          switch (operand.getType()) {
+            case triton::arch::OP_IMM: inst.setReadImmediate(operand.getConstImmediate(), nullptr); break;
+            case triton::arch::OP_MEM: inst.setLoadAccess(operand.getConstMemory(), nullptr); readAddress(operand.getConstMemory()); break;
+            case triton::arch::OP_REG: readRegister(operand.getConstRegister()); break;
+            default: break;
+          }
+        };
+
+        auto write = [&](const triton::arch::OperandWrapper& operand) {
+          switch (operand.getType()) {
+            case triton::arch::OP_MEM: inst.setStoreAccess(operand.getConstMemory(), nullptr); readAddress(operand.getConstMemory()); break;
+            case triton::arch::OP_REG: inst.setWrittenRegister(operand.getConstRegister(), nullptr); break;
+            default: break;
+          }
+        };
+
+        /* The stack pointer is moved by push, pop, call and ret */
+        auto moveStack = [&](void) {
+          readRegister(stack);
+          inst.setWrittenRegister(stack, nullptr);
+        };
+
+        /* The read flags flow into the destination */
+        bool flags = this->isFlagTainted(summary.readFlags);
+        for (auto flag : summary.readFlags)
+          readRegister(this->cpu.getRegister(flag));
+
+        switch (summary.effect) {
+          case SUMMARY_NONE:
+            for (const auto& operand : operands) {
+              tainted |= this->isTainted(operand);
+              read(operand);
+            }
+            break;
+
+          case SUMMARY_ASSIGN:
+          case SUMMARY_UNION: {
+            triton::usize size = operands.size();
+            for (triton::usize i = (summary.effect == SUMMARY_UNION) ? 0 : 1; i < size; i++)
+              read(operands[i]);
+            write(operands[0]);
+            /* The result does not depend on the operands */
+            if (summary.zeroIdiom && size >= 2 &&
+                operands[size-1].getType() == triton::arch::OP_REG && operands[size-2].getType() == triton::arch::OP_REG &&
+                operands[size-1].getConstRegister().getId() == operands[size-2].getConstRegister().getId()) {
+              tainted = !TAINTED;
+            }
+            else {
+              tainted = flags | (summary.effect == SUMMARY_UNION && this->isTainted(operands[0]));
+              for (triton::usize i = 1; i < size; i++)
+                tainted |= this->isTainted(operands[i]);
+            }
+            this->setOperandTaint(operands[0], tainted);
+            break;
+          }
+
+          case SUMMARY_CLEAR:
+            this->setOperandTaint(operands[0], !TAINTED);
+            write(operands[0]);
+            break;
+
+          case SUMMARY_XCHG: {
+            bool dstT = this->isTainted(operands[0]);
+            bool srcT = this->isTainted(operands[1]);
+            this->setOperandTaint(operands[0], srcT);
+            this->setOperandTaint(operands[1], dstT);
+            tainted = (dstT | srcT);
+            read(operands[0]);
+            read(operands[1]);
+            write(operands[0]);
+            write(operands[1]);
+            break;
+          }
+
+          case SUMMARY_LEA: {
+            const triton::arch::MemoryAccess& src = operands[1].getConstMemory();
+            tainted = this->isRegisterTainted(src.getConstBaseRegister()) | this->isRegisterTainted(src.getConstIndexRegister());
+            this->setOperandTaint(operands[0], tainted);
+            readAddress(src);
+            write(operands[0]);
+            break;
+          }
+
+          case SUMMARY_PUSH: {
+            /* If it's an immediate source, the memory access is always based on the arch size */
+            triton::uint32 size = (operands[0].getType() == triton::arch::OP_IMM) ? stack.getSize() : operands[0].getSize();
+            triton::uint64 sp   = this->cpu.getConcreteRegisterValue(stack).convert_to<triton::uint64>();
+            triton::arch::OperandWrapper slot(triton::arch::MemoryAccess(sp - size, size));
+            tainted = this->isTainted(operands[0]);
+            this->setOperandTaint(slot, tainted);
+            read(operands[0]);
+            write(slot);
+            moveStack();
+            break;
+          }
+
+          case SUMMARY_POP: {
+            triton::uint64 sp = this->cpu.getConcreteRegisterValue(stack).convert_to<triton::uint64>();
+            tainted = this->isMemoryTainted(sp, operands[0].getSize());
+            this->setOperandTaint(operands[0], tainted);
+            read(triton::arch::OperandWrapper(triton::arch::MemoryAccess(sp, operands[0].getSize())));
+            write(operands[0]);
+            moveStack();
+            break;
+          }
+
+          case SUMMARY_CALL: {
+            triton::uint64 sp = this->cpu.getConcreteRegisterValue(stack).convert_to<triton::uint64>();
+            triton::arch::OperandWrapper slot(triton::arch::MemoryAccess(sp - stack.getSize(), stack.getSize()));
+            this->setOperandTaint(slot, !TAINTED);
+            tainted = this->isTainted(operands[0]);
+            this->setTaintRegister(pc, tainted);
+            read(operands[0]);
+            write(slot);
+            moveStack();
+            branch = true;
+            break;
+          }
+
+          case SUMMARY_BRANCH:
+            tainted = (flags | this->isTainted(operands[0]));
+            this->setTaintRegister(pc, tainted);
+            read(operands[0]);
+            branch = true;
+            break;
+
+          case SUMMARY_RET: {
+            triton::uint64 sp = this->cpu.getConcreteRegisterValue(stack).convert_to<triton::uint64>();
+            tainted = this->isMemoryTainted(sp, stack.getSize());
+            this->setTaintRegister(pc, tainted);
+            read(triton::arch::OperandWrapper(triton::arch::MemoryAccess(sp, stack.getSize())));
+            moveStack();
+            branch = true;
+            break;
+          }
+
+          default:
+            throw triton::exceptions::TaintEngine("TaintEngine::spreadTaint(): Invalid summary.");
+        }
+
+        /* The written flags take the taint of the result */
+        for (auto flag : summary.writtenFlags) {
+          this->setTaintRegister(this->cpu.getRegister(flag), tainted);
+          inst.setWrittenRegister(this->cpu.getRegister(flag), nullptr);
+        }
+
+        for (auto flag : summary.clearedFlags) {
+          this->setTaintRegister(this->cpu.getRegister(flag), !TAINTED);
+          inst.setWrittenRegister(this->cpu.getRegister(flag), nullptr);
+        }
+
+        /* The next instruction does not depend on the operands */
+        if (!branch)
+          this->setTaintRegister(pc, !TAINTED);
+        inst.setWrittenRegister(pc, nullptr);
+
+        return tainted;
+      }
+
     }; /* taint namespace */
   }; /* engines namespace */
 }; /* triton namespace */
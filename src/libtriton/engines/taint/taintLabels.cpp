@@ -0,0 +1,111 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <iterator>
+
+#include <triton/exceptions.hpp>
+#include <triton/taintLabels.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace taint {
+
+      triton::usize TaintLabels::SetHash::operator()(const std::vector<triton::uint32>& labels) const {
+        triton::usize hash = labels.size();
+
+        for (auto label : labels)
+          hash ^= label + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+        return hash;
+      }
+
+
+      TaintLabels::TaintLabels() {
+        this->clear();
+      }
+
+
+      void TaintLabels::clear(void) {
+        this->sets.clear();
+        this->ids.clear();
+        this->unions.clear();
+
+        /* The id 0 is the empty set */
+        this->sets.push_back(std::vector<triton::uint32>());
+        this->ids[this->sets.back()] = EMPTY_LABEL_SET;
+      }
+
+
+      triton::uint32 TaintLabels::intern(const std::vector<triton::uint32>& labels) {
+        auto it = this->ids.find(labels);
+
+        if (it != this->ids.end())
+          return it->second;
+
+        if (this->sets.size() > 0xffffffff)
+          throw triton::exceptions::TaintEngine("TaintLabels::intern(): Too many label sets.");
+
+        triton::uint32 id = static_cast<triton::uint32>(this->sets.size());
+        this->sets.push_back(labels);
+        this->ids[labels] = id;
+
+        return id;
+      }
+
+
+      triton::uint32 TaintLabels::getSingleton(triton::uint32 label) {
+        return this->intern(std::vector<triton::uint32>(1, label));
+      }
+
+
+      triton::uint32 TaintLabels::getUnion(triton::uint32 id1, triton::uint32 id2) {
+        if (id1 == id2 || id2 == EMPTY_LABEL_SET)
+          return id1;
+
+        if (id1 == EMPTY_LABEL_SET)
+          return id2;
+
+        if (id1 > id2)
+          std::swap(id1, id2);
+
+        triton::uint64 key = (static_cast<triton::uint64>(id1) << 32) | id2;
+        auto it = this->unions.find(key);
+
+        if (it != this->unions.end())
+          return it->second;
+
+        const std::vector<triton::uint32>& set1 = this->getLabels(id1);
+        const std::vector<triton::uint32>& set2 = this->getLabels(id2);
+        std::vector<triton::uint32> labels;
+
+        labels.reserve(set1.size() + set2.size());
+        std::set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), std::back_inserter(labels));
+
+        triton::uint32 id = this->intern(labels);
+        this->unions[key] = id;
+
+        return id;
+      }
+
+
+      const std::vector<triton::uint32>& TaintLabels::getLabels(triton::uint32 id) const {
+        if (id >= this->sets.size())
+          throw triton::exceptions::TaintEngine("TaintLabels::getLabels(): Invalid label set.");
+        return this->sets[id];
+      }
+
+
+      triton::usize TaintLabels::size(void) const {
+        return this->sets.size();
+      }
+
+    }; /* taint namespace */
+  }; /* engines namespace */
+}; /* triton namespace */
@@ -8,11 +8,14 @@
 #ifndef TRITON_API_H
 #define TRITON_API_H
 
+#include <functional>
+
 #include <triton/architecture.hpp>
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
 #include <triton/astRepresentation.hpp>
 #include <triton/callbacks.hpp>
+#include <triton/disassemblyCache.hpp>
 #include <triton/dllexport.hpp>
 #include <triton/immediate.hpp>
 #include <triton/instruction.hpp>
@@ -25,6 +28,7 @@
 #include <triton/solverEngine.hpp>
 #include <triton/symbolicEngine.hpp>
 #include <triton/taintEngine.hpp>
+#include <triton/traceRecord.hpp>
 #include <triton/tritonTypes.hpp>
 #include <triton/z3Interface.hpp>
 
@@ -68,6 +72,9 @@ namespace triton {
         //! The Z3 interface between Triton and Z3.
         triton::ast::Z3Interface* z3Interface = nullptr;
 
+        //! The cache of decoded instructions used by the DISASSEMBLY_CACHE mode.
+        triton::arch::DisassemblyCache* disassCache = nullptr;
+
 
       public:
         //! Constructor of the API.
@@ -200,6 +207,9 @@ namespace triton {
         //! [**architecture api**] - Disassembles the instruction and setup operands. You must define an architecture before. \sa processing().
         TRITON_EXPORT void disassembly(triton::arch::Instruction& inst) const;
 
+        //! [**architecture api**] - Returns the hits, misses, evictions, invalidations, entries and capacity of the disassembly cache. \sa triton::modes::DISASSEMBLY_CACHE.
+        TRITON_EXPORT std::map<std::string, triton::usize> getDisassemblyCacheStats(void) const;
+
 
 
         /* Processing API ================================================================================ */
@@ -207,6 +217,14 @@ namespace triton {
         //! [**proccesing api**] - Processes an instruction and updates engines according to the instruction semantics. Returns true if the instruction is supported.
         TRITON_EXPORT bool processing(triton::arch::Instruction& inst);
 
+        /*!
+         * \brief [**proccesing api**] - Processes the records of a trace in order. The concrete values of a record are set before processing
+         * its instruction, and the `callback` is called after the records which request it. The semantics of an instruction are cleared once
+         * it has been processed (see triton::arch::Instruction::clear()), the callback is the place to look at them. Returns the number of
+         * supported instructions. \sa processing().
+         */
+        TRITON_EXPORT triton::usize processBlock(std::vector<triton::arch::TraceRecord>& block, const std::function<void(triton::arch::TraceRecord&)>& callback=nullptr);
+
         //! [**proccesing api**] - Initializes everything.
         TRITON_EXPORT void initEngines(void);
 
@@ -236,7 +254,7 @@ namespace triton {
         //! [**AST garbage collector api**] - Go through every allocated nodes and free them.
         TRITON_EXPORT void freeAllAstNodes(void);
 
-        //! [**AST garbage collector api**] - Frees a set of nodes and removes them from the global container.
+        //! [**AST garbage collector api**] - Frees the nodes of a set which are not referenced, and the children they were the last reference to.
         TRITON_EXPORT void freeAstNodes(std::set<triton::ast::AbstractNode*>& nodes);
 
         //! [**AST garbage collector api**] - Extracts all unique nodes from a partial AST into the uniqueNodes set.
@@ -249,7 +267,10 @@ namespace triton {
         TRITON_EXPORT void recordVariableAstNode(const std::string& name, triton::ast::AbstractNode* node);
 
         //! [**AST garbage collector api**] - Returns all allocated nodes.
-        TRITON_EXPORT const std::set<triton::ast::AbstractNode*>& getAllocatedAstNodes(void) const;
+        TRITON_EXPORT std::set<triton::ast::AbstractNode*> getAllocatedAstNodes(void) const;
+
+        //! [**AST garbage collector api**] - Returns all stats about the memory arena of the nodes.
+        TRITON_EXPORT std::map<std::string, triton::usize> getAstArenaStats(void) const;
 
         //! [**AST garbage collector api**] - Returns all stats about AST Dictionaries.
         TRITON_EXPORT std::map<std::string, triton::usize> getAstDictionariesStats(void) const;
@@ -336,10 +357,16 @@ namespace triton {
         //! [**symbolic api**] - Returns the map of symbolic registers defined.
         TRITON_EXPORT std::map<triton::arch::registers_e, triton::engines::symbolic::SymbolicExpression*> getSymbolicRegisters(void) const;
 
-        //! [**symbolic api**] - Returns the map (<Addr : SymExpr>) of symbolic memory defined.
+        //! [**symbolic api**] - Returns the map (<Addr : SymExpr>) of symbolic memory defined. The bytes of wider ranges get their own expressions, see getSymbolicMemoryId().
         TRITON_EXPORT std::map<triton::uint64, triton::engines::symbolic::SymbolicExpression*> getSymbolicMemory(void) const;
 
-        //! [**symbolic api**] - Returns the symbolic expression id corresponding to the memory address.
+        /*!
+         * \brief [**symbolic api**] - Returns the symbolic expression id corresponding to the memory address.
+         *
+         * \details
+         * The memory state is not modified, but a byte which is part of a wider range gets its own
+         * expression: it is added to the table of expressions the first time its id is queried.
+         */
         TRITON_EXPORT triton::usize getSymbolicMemoryId(triton::uint64 addr) const;
 
         //! [**symbolic api**] - Returns the symbolic expression id corresponding to the register.
@@ -444,6 +471,9 @@ namespace triton {
         //! [**symbolic api**] - Clears the logical conjunction vector of path constraints.
         TRITON_EXPORT void clearPathConstraints(void);
 
+        //! [**symbolic api**] - Forgets the unrolled ASTs kept by unrollAst().
+        TRITON_EXPORT void clearUnrolledAsts(void);
+
         //! [**symbolic api**] - Enables or disables the symbolic execution engine.
         TRITON_EXPORT void enableSymbolicEngine(bool flag);
 
@@ -493,10 +523,10 @@ namespace triton {
         TRITON_EXPORT std::list<triton::engines::symbolic::SymbolicExpression*> getTaintedSymbolicExpressions(void) const;
 
         //! [**symbolic api**] - Returns all symbolic expressions as a map of <SymExprId : SymExpr>
-        TRITON_EXPORT const std::map<triton::usize, triton::engines::symbolic::SymbolicExpression*>& getSymbolicExpressions(void) const;
+        TRITON_EXPORT const triton::engines::symbolic::SymbolicTable<triton::engines::symbolic::SymbolicExpression>& getSymbolicExpressions(void) const;
 
         //! [**symbolic api**] - Returns all symbolic variables as a map of <SymVarId : SymVar>
-        TRITON_EXPORT const std::map<triton::usize, triton::engines::symbolic::SymbolicVariable*>& getSymbolicVariables(void) const;
+        TRITON_EXPORT const triton::engines::symbolic::SymbolicTable<triton::engines::symbolic::SymbolicVariable>& getSymbolicVariables(void) const;
 
         //! [**symbolic api**] - Gets the concrete value of a symbolic variable.
         TRITON_EXPORT const triton::uint512& getConcreteSymbolicVariableValue(const triton::engines::symbolic::SymbolicVariable& symVar) const;
@@ -529,6 +559,51 @@ namespace triton {
          */
         TRITON_EXPORT std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> getModels(triton::ast::AbstractNode* node, triton::uint32 limit) const;
 
+        //! [**solver api**] - Adds a symbolic constraint to the incremental solver session.
+        TRITON_EXPORT void addSolverConstraint(triton::ast::AbstractNode* node);
+
+        //! [**solver api**] - Opens a new scope in the incremental solver session.
+        TRITON_EXPORT void pushSolver(void);
+
+        //! [**solver api**] - Closes the `count` last scopes of the incremental solver session.
+        TRITON_EXPORT void popSolver(triton::uint32 count=1);
+
+        //! [**solver api**] - Returns the number of scopes opened in the incremental solver session.
+        TRITON_EXPORT triton::uint32 getSolverScopes(void) const;
+
+        //! [**solver api**] - Returns true if the constraints of the incremental solver session are satisfiable.
+        TRITON_EXPORT bool isSolverSat(void);
+
+        /*!
+         * \brief [**solver api**] - Computes and returns a model from the constraints of the incremental solver session.
+         *
+         * \details
+         * **item1**: symbolic variable id<br>
+         * **item2**: model
+         */
+        TRITON_EXPORT std::map<triton::uint32, triton::engines::solver::SolverModel> getSolverModel(void);
+
+        //! [**solver api**] - Drops the incremental solver session (constraints, scopes and translation cache).
+        TRITON_EXPORT void resetSolver(void);
+
+        //! [**solver api**] - Sets the maximum number of queries kept by the cache of getModel(). 0 disables the cache.
+        TRITON_EXPORT void setSolverCacheSize(triton::usize size);
+
+        //! [**solver api**] - Returns the maximum number of queries kept by the cache of getModel().
+        TRITON_EXPORT triton::usize getSolverCacheSize(void) const;
+
+        //! [**solver api**] - Loads the queries of a file into the solver cache and appends the new ones to it. An empty path stops the persistence.
+        TRITON_EXPORT void setSolverCacheFile(const std::string& path);
+
+        //! [**solver api**] - Returns the file of the solver cache, empty if the cache is not persistent.
+        TRITON_EXPORT const std::string& getSolverCacheFile(void) const;
+
+        //! [**solver api**] - Removes the queries of the solver cache and resets its statistics.
+        TRITON_EXPORT void clearSolverCache(void);
+
+        //! [**solver api**] - Returns the statistics of the solver cache.
+        TRITON_EXPORT std::map<std::string, triton::usize> getSolverCacheStats(void) const;
+
 
 
         /* Z3 interface API ============================================================================== */
@@ -553,7 +628,7 @@ namespace triton {
         TRITON_EXPORT triton::engines::taint::TaintEngine* getTaintEngine(void);
 
         //! [**taint api**] - Returns the tainted addresses.
-        TRITON_EXPORT const std::set<triton::uint64>& getTaintedMemory(void) const;
+        TRITON_EXPORT std::set<triton::uint64> getTaintedMemory(void) const;
 
         //! [**taint api**] - Returns the tainted registers.
         TRITON_EXPORT std::set<const triton::arch::Register*> getTaintedRegisters(void) const;
@@ -594,6 +669,18 @@ namespace triton {
         //! [**taint api**] - Taints a register. Returns TAINTED if the register has been tainted correctly. Otherwise it returns the last defined state.
         TRITON_EXPORT bool taintRegister(const triton::arch::Register& reg);
 
+        //! [**taint api**] - Taints a memory with a label. The label is added to the labels of each byte.
+        TRITON_EXPORT bool taintMemoryWithLabel(const triton::arch::MemoryAccess& mem, triton::uint32 label);
+
+        //! [**taint api**] - Taints a register with a label. The label is added to the labels of each byte.
+        TRITON_EXPORT bool taintRegisterWithLabel(const triton::arch::Register& reg, triton::uint32 label);
+
+        //! [**taint api**] - Returns the labels of a memory (the union of the labels of its bytes).
+        TRITON_EXPORT std::set<triton::uint32> getMemoryTaintLabels(const triton::arch::MemoryAccess& mem) const;
+
+        //! [**taint api**] - Returns the labels of a register (the union of the labels of its bytes).
+        TRITON_EXPORT std::set<triton::uint32> getRegisterTaintLabels(const triton::arch::Register& reg) const;
+
         //! [**taint api**] - Untaints an address. Returns !TAINTED if the address has been untainted correctly. Otherwise it returns the last defined state.
         TRITON_EXPORT bool untaintMemory(triton::uint64 addr);
 
@@ -8,12 +8,14 @@
 #ifndef TRITON_AST_H
 #define TRITON_AST_H
 
+#include <cstddef>
 #include <list>
 #include <map>
 #include <ostream>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <triton/astEnums.hpp>
@@ -44,25 +46,163 @@ namespace triton {
    *  @{
    */
 
+    class AbstractNode;
     class AstContext;
+    class AstGarbageCollector;
+
+    //! The number of children stored inside a node, more are allocated on the heap.
+    const triton::uint32 AST_INLINE_CHILDREN = 3;
+
+    /*! \class AstValue
+     *  \brief A value of up to 512 bits held by a node.
+     *
+     *  \details
+     *  Most of the nodes hold values which fit in 64 bits, they are stored inline. A wider value is
+     *  allocated on the heap.
+     */
+    class AstValue {
+      private:
+        //! The value if it fits in 64 bits.
+        triton::uint64 value;
+
+        //! The value if it does not fit in 64 bits, nullptr otherwise.
+        triton::uint512* wide;
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstValue();
+
+        //! Constructor by copy.
+        TRITON_EXPORT AstValue(const AstValue& other);
+
+        //! Destructor.
+        TRITON_EXPORT ~AstValue();
+
+        //! Copies an AstValue.
+        TRITON_EXPORT AstValue& operator=(const AstValue& other);
+
+        //! Sets the value.
+        TRITON_EXPORT AstValue& operator=(const triton::uint512& value);
+
+        //! Sets the value.
+        TRITON_EXPORT AstValue& operator=(triton::uint64 value);
+
+        //! Returns true if the value does not fit in 64 bits.
+        TRITON_EXPORT bool isWide(void) const;
+
+        //! Returns the value if it fits in 64 bits.
+        TRITON_EXPORT triton::uint64 getLow(void) const;
+
+        //! Returns the value.
+        TRITON_EXPORT triton::uint512 get(void) const;
+    };
+
+    /*! \class AstChildren
+     *  \brief The children of a node.
+     *
+     *  \details
+     *  A vector of nodes which keeps up to `AST_INLINE_CHILDREN` children inline, so that the
+     *  nodes with a small arity (nearly all of them) do not need any allocation for their children.
+     */
+    class AstChildren {
+      private:
+        //! The inline children, or the heap array once there are more children than inline slots.
+        union {
+          AbstractNode* inlined[AST_INLINE_CHILDREN];
+          AbstractNode** heap;
+        } items;
+
+        //! The number of children.
+        triton::uint32 count;
+
+        //! The number of slots.
+        triton::uint32 capacity;
+
+        //! Returns the slots.
+        AbstractNode** data(void);
+
+        //! Returns the slots.
+        AbstractNode* const* data(void) const;
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstChildren();
+
+        //! Constructor by copy.
+        TRITON_EXPORT AstChildren(const AstChildren& other);
+
+        //! Destructor.
+        TRITON_EXPORT ~AstChildren();
+
+        //! Copies an AstChildren.
+        TRITON_EXPORT AstChildren& operator=(const AstChildren& other);
+
+        //! Returns true if both contain the same children in the same order.
+        TRITON_EXPORT bool operator==(const AstChildren& other) const;
+
+        //! Returns the child at an index.
+        TRITON_EXPORT AbstractNode*& operator[](triton::usize index);
+
+        //! Returns the child at an index.
+        TRITON_EXPORT AbstractNode* const& operator[](triton::usize index) const;
+
+        //! Returns the number of children.
+        TRITON_EXPORT triton::usize size(void) const;
+
+        //! Returns true if there is no child.
+        TRITON_EXPORT bool empty(void) const;
+
+        //! Adds a child at the end.
+        TRITON_EXPORT void push_back(AbstractNode* child);
+
+        //! Removes all children.
+        TRITON_EXPORT void clear(void);
+
+        //! Returns an iterator on the first child.
+        TRITON_EXPORT AbstractNode** begin(void);
+
+        //! Returns an iterator past the last child.
+        TRITON_EXPORT AbstractNode** end(void);
+
+        //! Returns an iterator on the first child.
+        TRITON_EXPORT AbstractNode* const* begin(void) const;
+
+        //! Returns an iterator past the last child.
+        TRITON_EXPORT AbstractNode* const* end(void) const;
+
+        //! Returns an iterator on the first child.
+        TRITON_EXPORT AbstractNode* const* cbegin(void) const;
+
+        //! Returns an iterator past the last child.
+        TRITON_EXPORT AbstractNode* const* cend(void) const;
+    };
 
     //! Abstract node
     class AbstractNode {
       protected:
-        //! The kind of the node.
-        enum kind_e kind;
-
         //! The children of the node.
-        std::vector<AbstractNode*> children;
+        AstChildren children;
 
-        //! The parents of the node. Empty if there is still no parent.
-        std::set<AbstractNode*> parents;
+        //! The first parent of the node, nullptr if there is no parent.
+        AbstractNode* parent;
 
-        //! The size of the node.
-        triton::uint32 size;
+        //! The other parents of the node, only allocated when the node has several parents.
+        std::unordered_set<AbstractNode*>* parents;
 
         //! The value of the tree from this root node.
-        triton::uint512 eval;
+        AstValue eval;
+
+        //! Contect use to create this node
+        AstContext& ctxt;
+
+        //! The number of references (parent nodes, symbolic expressions, ...) to the node.
+        triton::uint32 refs;
+
+        //! The kind of the node.
+        enum kind_e kind;
+
+        //! The size of the node.
+        triton::uint32 size;
 
         //! True if the tree contains a symbolic variable.
         bool symbolized;
@@ -70,22 +210,53 @@ namespace triton {
         //! True if it's a logical node.
         bool logical;
 
-        //! Contect use to create this node
-        AstContext& ctxt;
+        //! The garbage collector drops the references of the nodes it frees.
+        friend class AstGarbageCollector;
+
+        //! Inits the parents of the node.
+        void initParents(void);
 
       public:
         //! Constructor.
         TRITON_EXPORT AbstractNode(enum kind_e kind, AstContext& ctxt);
 
-        //! Constructor by copy.
+        //! Constructor by copy. The copy shares the children of the original node and is not referenced yet.
+        TRITON_EXPORT AbstractNode(const AbstractNode& other);
+
+        //! Constructor by copy. The children are copied too.
         TRITON_EXPORT AbstractNode(const AbstractNode& other, AstContext& ctxt);
 
         //! Destructor.
         TRITON_EXPORT virtual ~AbstractNode();
 
+        //! Allocates a node into the arena of a context. Returns nullptr if there is not enough memory.
+        TRITON_EXPORT void* operator new(std::size_t size, AstContext& ctxt) noexcept;
+
+        //! Releases the memory of a node whose constructor has thrown.
+        TRITON_EXPORT void operator delete(void* ptr, AstContext& ctxt) noexcept;
+
+        //! Releases the memory of a node.
+        TRITON_EXPORT void operator delete(void* ptr) noexcept;
+
         //! Access to its context
         TRITON_EXPORT AstContext& getContext(void) const;
 
+        //! Adds a reference to the node.
+        TRITON_EXPORT void retain(void);
+
+        /*!
+         * \brief Removes a reference to the node.
+         *
+         * \details
+         * When the last reference goes away, the node is freed as well as the children which are no
+         * longer referenced. A node which has never been referenced (e.g. a node which has just been
+         * built) is never freed by this way, it belongs to the one who built it until it is retained.
+         */
+        TRITON_EXPORT void release(void);
+
+        //! Returns the number of references to the node.
+        TRITON_EXPORT triton::usize getRefCount(void) const;
+
         //! Returns the kind of the node.
         TRITON_EXPORT enum kind_e getKind(void) const;
 
@@ -113,8 +284,11 @@ namespace triton {
         //! Evaluates the tree.
         TRITON_EXPORT virtual triton::uint512 evaluate(void) const;
 
+        //! Evaluates a tree whose size is at most 64 bits, without any uint512 arithmetic.
+        TRITON_EXPORT triton::uint64 evaluate64(void) const;
+
         //! Returns the children of the node.
-        TRITON_EXPORT std::vector<AbstractNode*>& getChildren(void);
+        TRITON_EXPORT AstChildren& getChildren(void);
 
         /*!
          * \brief Returns the parents of node or an empty set if there is still no parent defined.
@@ -122,7 +296,7 @@ namespace triton {
          * Note that if there is the `AST_DICTIONARIES` optimization enabled, this feature will
          * probably not represent the real tree of your expression.
          */
-        TRITON_EXPORT std::set<AbstractNode*>& getParents(void);
+        TRITON_EXPORT std::set<AbstractNode*> getParents(void) const;
 
         //! Removes a parent node.
         TRITON_EXPORT void removeParent(AbstractNode* p);
@@ -145,8 +319,11 @@ namespace triton {
         //! Init stuffs like size and eval.
         TRITON_EXPORT virtual void init(void) = 0;
 
-        //! Returns the has of the tree. The hash is computed recursively on the whole tree.
-        TRITON_EXPORT virtual triton::uint512 hash(triton::uint32 deep) const = 0;
+        //! Returns the hash of the tree. Each node of the DAG is hashed once.
+        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+
+        //! Returns the hash of the node from the hashes of its children.
+        TRITON_EXPORT virtual triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const = 0;
     };
 
 
@@ -155,7 +332,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvaddNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -164,7 +341,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvandNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -173,7 +350,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvashrNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -182,7 +359,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvlshrNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -191,7 +368,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvmulNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -200,7 +377,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvnandNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -209,7 +386,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvnegNode(AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -218,7 +395,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvnorNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -227,7 +404,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvnotNode(AbstractNode* expr1);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -236,7 +413,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvorNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -246,7 +423,7 @@ namespace triton {
         TRITON_EXPORT BvrolNode(triton::uint32 rot, AbstractNode* expr);
         TRITON_EXPORT BvrolNode(AbstractNode* rot, AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -256,7 +433,7 @@ namespace triton {
         TRITON_EXPORT BvrorNode(triton::uint32 rot, AbstractNode* expr);
         TRITON_EXPORT BvrorNode(AbstractNode* rot, AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -265,7 +442,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsdivNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -274,7 +451,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsgeNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -283,7 +460,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsgtNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -292,7 +469,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvshlNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -301,7 +478,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsleNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -310,7 +487,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsltNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -319,7 +496,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsmodNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -328,7 +505,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsremNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -337,7 +514,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvsubNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -346,7 +523,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvudivNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -355,7 +532,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvugeNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -364,7 +541,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvugtNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -373,7 +550,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvuleNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -382,7 +559,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvultNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -391,7 +568,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvuremNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -400,7 +577,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvxnorNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -409,7 +586,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvxorNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -418,7 +595,7 @@ namespace triton {
       public:
         TRITON_EXPORT BvNode(triton::uint512 value, triton::uint32 size, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -428,19 +605,19 @@ namespace triton {
         TRITON_EXPORT ConcatNode(AbstractNode* expr1, AbstractNode* expr2);
         template <typename T> ConcatNode(const T& exprs, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
     //! Decimal node
     class DecimalNode : public AbstractNode {
       protected:
-        triton::uint512 value;
+        AstValue value;
 
       public:
         TRITON_EXPORT DecimalNode(triton::uint512 value, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
         TRITON_EXPORT triton::uint512 getValue(void);
     };
 
@@ -450,7 +627,7 @@ namespace triton {
       public:
         TRITON_EXPORT DistinctNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -459,7 +636,7 @@ namespace triton {
       public:
         TRITON_EXPORT EqualNode(AbstractNode* expr1, AbstractNode* expr2);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -468,7 +645,7 @@ namespace triton {
       public:
         TRITON_EXPORT ExtractNode(triton::uint32 high, triton::uint32 low, AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -477,7 +654,7 @@ namespace triton {
       public:
         TRITON_EXPORT IteNode(AbstractNode* ifExpr, AbstractNode* thenExpr, AbstractNode* elseExpr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -487,7 +664,7 @@ namespace triton {
         TRITON_EXPORT LandNode(AbstractNode* expr1, AbstractNode* expr2);
         template <typename T> LandNode(const T& exprs, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -496,7 +673,7 @@ namespace triton {
       public:
         TRITON_EXPORT LetNode(std::string alias, AbstractNode* expr2, AbstractNode* expr3);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -505,7 +682,7 @@ namespace triton {
       public:
         TRITON_EXPORT LnotNode(AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -515,20 +692,28 @@ namespace triton {
         TRITON_EXPORT LorNode(AbstractNode* expr1, AbstractNode* expr2);
         template <typename T> LorNode(const T& exprs, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
     //! Reference node
     class ReferenceNode : public AbstractNode {
       protected:
-        triton::engines::symbolic::SymbolicExpression& expr;
+        //! The referenced expression, nullptr once the expression has been removed.
+        triton::engines::symbolic::SymbolicExpression* expr;
 
       public:
         TRITON_EXPORT ReferenceNode(triton::engines::symbolic::SymbolicExpression& expr);
+        TRITON_EXPORT ReferenceNode(const ReferenceNode& other);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
         TRITON_EXPORT triton::engines::symbolic::SymbolicExpression& getSymbolicExpression(void) const;
+
+        //! Returns true if the referenced expression has been removed.
+        TRITON_EXPORT bool isDetached(void) const;
+
+        //! Detaches the node from its expression, which is about to be removed.
+        TRITON_EXPORT void detach(void);
     };
 
 
@@ -540,7 +725,7 @@ namespace triton {
       public:
         TRITON_EXPORT StringNode(std::string value, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
         TRITON_EXPORT std::string getValue(void);
     };
 
@@ -550,7 +735,7 @@ namespace triton {
       public:
         TRITON_EXPORT SxNode(triton::uint32 sizeExt, AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -562,7 +747,7 @@ namespace triton {
       public:
         TRITON_EXPORT VariableNode(triton::engines::symbolic::SymbolicVariable& symVar, AstContext& ctxt);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
         TRITON_EXPORT triton::engines::symbolic::SymbolicVariable& getVar(void);
     };
 
@@ -573,7 +758,7 @@ namespace triton {
         //! Create a zero extend of expr to sizeExt bits
         TRITON_EXPORT ZxNode(triton::uint32 sizeExt, AbstractNode* expr);
         TRITON_EXPORT void init(void);
-        TRITON_EXPORT triton::uint512 hash(triton::uint32 deep) const;
+        TRITON_EXPORT triton::uint512 computeHash(const std::vector<triton::uint512>& hashes) const;
     };
 
 
@@ -583,6 +768,19 @@ namespace triton {
     //! AST C++ API - Duplicates the AST
     TRITON_EXPORT AbstractNode* newInstance(AbstractNode* node);
 
+    //! AST C++ API - Duplicates a node with other children. The children must fit the kind of the node.
+    TRITON_EXPORT AbstractNode* newInstance(AbstractNode* node, const std::vector<AbstractNode*>& children);
+
+    /*!
+     * \brief Fills `nodes` with the nodes of the DAG rooted at `root`, each node once.
+     *
+     * \details
+     * In post-order, the children come before their parents. In pre-order, the parents come
+     * before their children. If `unroll` is true, the ASTs of the symbolic expressions behind
+     * the reference nodes are visited too. The DAG is walked without recursion.
+     */
+    TRITON_EXPORT void nodesExtraction(AbstractNode* root, std::vector<AbstractNode*>& nodes, bool postOrder=true, bool unroll=false);
+
     //! Custom pow function for hash routine.
     triton::uint512 pow(triton::uint512 hash, triton::uint32 n);
 
@@ -0,0 +1,166 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ASTARENA_H
+#define TRITON_ASTARENA_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    class AbstractNode;
+
+    //! The size (in bytes) of an arena slab.
+    const triton::usize AST_ARENA_SLAB_SIZE = 64 * 1024;
+
+    //! The alignment (in bytes) of the blocks returned by an arena.
+    const triton::usize AST_ARENA_ALIGNMENT = 16;
+
+    /*! \class AstArena
+     *  \brief The memory arena of the AST nodes of a context.
+     *
+     *  \details
+     *  Nodes are carved out of 64 KiB slabs with a bump pointer. Freed blocks go into a free list per
+     *  size class (multiple of 16 bytes) and are reused before bumping. Every block starts with a small
+     *  header which links the live nodes in allocation order, so the nodes allocated since a given point
+     *  can be released without any external container, and the whole arena is released by destroying
+     *  the live nodes and dropping its slabs.
+     */
+    class AstArena {
+      private:
+        //! The header of a block.
+        class Header {
+          public:
+            //! The arena which owns the block.
+            AstArena* arena;
+
+            //! The previous live block.
+            Header* prev;
+
+            //! The next live block, or the next free block of the same size class.
+            Header* next;
+
+            //! The allocation number of the block.
+            triton::usize sequence;
+
+            //! The size class of the block.
+            triton::usize sizeClass;
+        };
+
+        //! The slabs.
+        std::vector<triton::uint8*> slabs;
+
+        //! The free lists indexed by size class.
+        std::vector<Header*> freeLists;
+
+        //! The first free byte of the current slab.
+        triton::uint8* cursor;
+
+        //! The end of the current slab.
+        triton::uint8* end;
+
+        //! The oldest live block.
+        Header* head;
+
+        //! The newest live block.
+        Header* tail;
+
+        //! The number of the next allocation.
+        triton::usize sequence;
+
+        //! Total of allocations.
+        triton::usize allocations;
+
+        //! Total of deallocations.
+        triton::usize deallocations;
+
+        //! Number of live nodes.
+        triton::usize liveNodes;
+
+        //! Number of bytes used by live nodes (headers included).
+        triton::usize liveBytes;
+
+        //! Replaced each time the live nodes are destroyed, see getLifetime().
+        std::shared_ptr<bool> lifetime;
+
+        //! Returns the size (in bytes) of the header of a block.
+        static triton::usize getHeaderSize(void);
+
+        //! Unlinks a block from the live list and puts it into its free list.
+        void deallocate(Header* header);
+
+        //! An arena cannot be copied, its nodes refer to it.
+        AstArena(const AstArena& other);
+
+        //! An arena cannot be copied, its nodes refer to it.
+        AstArena& operator=(const AstArena& other);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstArena();
+
+        //! Destructor.
+        TRITON_EXPORT ~AstArena();
+
+        //! Allocates a block of `size` bytes. Returns nullptr if there is not enough memory.
+        TRITON_EXPORT void* allocate(triton::usize size);
+
+        //! Releases a block returned by allocate(). The memory goes back to the arena which owns it.
+        TRITON_EXPORT static void release(void* ptr);
+
+        //! Returns the allocation number of a block returned by allocate().
+        TRITON_EXPORT static triton::usize getAllocationNumber(const void* ptr);
+
+        //! Returns the number of the next allocation.
+        TRITON_EXPORT triton::usize getSequence(void) const;
+
+        //! Calls the destructor of all live nodes and releases all slabs.
+        TRITON_EXPORT void clear(void);
+
+        /*!
+         * \brief Returns a handle which expires when the live nodes are destroyed by clear() or by the destructor.
+         *
+         * \details
+         * The owners of a reference which may outlive the nodes (e.g. an instruction or a Python object)
+         * keep it to know whether they can still release their nodes.
+         */
+        TRITON_EXPORT std::weak_ptr<bool> getLifetime(void) const;
+
+        //! Returns the live nodes allocated since the allocation number `sequence`, oldest first.
+        TRITON_EXPORT std::vector<triton::ast::AbstractNode*> getLiveNodes(triton::usize sequence=0) const;
+
+        //! Returns stats about the arena.
+        TRITON_EXPORT std::map<std::string, triton::usize> getStats(void) const;
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_ASTARENA_H */
@@ -9,10 +9,13 @@
 #define TRITON_AST_CONTEXT_H
 
 #include <triton/ast.hpp>
+#include <triton/astArena.hpp>
 #include <triton/astGarbageCollector.hpp>
 #include <triton/astRepresentation.hpp>   // for AstRepresentation, astRepre...
 #include <triton/dllexport.hpp>
+#include <triton/modes.hpp>
 
+#include <initializer_list>
 #include <vector>
 
 
@@ -42,6 +45,9 @@ namespace triton {
     /*! \brief AST Context - Used as AST builder. */
     class AstContext {
       private:
+        //! The memory arena of the nodes. Declared first so that it outlives the garbage collector.
+        triton::ast::AstArena arena;
+
         //! The AST garbage collector interface.
         triton::ast::AstGarbageCollector astGarbageCollector;
 
@@ -51,6 +57,28 @@ namespace triton {
         //! Map a concrete value for a variable name.
         std::map<std::string, triton::uint512> valueMapping;
 
+        //! Modes API
+        const triton::modes::Modes& modes;
+
+        //! Returns the existing node of kind `kind` with these children if AST_DICTIONARIES is enabled, nullptr otherwise.
+        AbstractNode* lookupAstNode(triton::uint32 kind, std::initializer_list<AbstractNode*> children);
+
+        //! Returns the existing node of kind `kind` with these children if AST_DICTIONARIES is enabled, nullptr otherwise.
+        template <typename T>
+        AbstractNode* lookupAstNode(triton::uint32 kind, const T& children);
+
+        //! Returns the existing decimal node of this value if AST_DICTIONARIES is enabled, nullptr otherwise.
+        AbstractNode* lookupDecimalNode(const triton::uint512& value);
+
+        //! Returns the existing reference node of this symbolic expression id if AST_DICTIONARIES is enabled, nullptr otherwise.
+        AbstractNode* lookupReferenceNode(triton::usize id);
+
+        //! Returns the existing string node of this value if AST_DICTIONARIES is enabled, nullptr otherwise.
+        AbstractNode* lookupStringNode(const std::string& value);
+
+        //! Returns the existing variable node of this name if AST_DICTIONARIES is enabled, nullptr otherwise.
+        AbstractNode* lookupVariableNode(const std::string& name);
+
       public:
         //! Constructor
         TRITON_EXPORT AstContext(const triton::modes::Modes& modes);
@@ -226,6 +254,12 @@ namespace triton {
         //! Access to the underliying garbage collector
         TRITON_EXPORT const triton::ast::AstGarbageCollector& getAstGarbageCollector(void) const;
 
+        //! Access to the memory arena of the nodes
+        TRITON_EXPORT triton::ast::AstArena& getAstArena(void);
+
+        //! Access to the memory arena of the nodes
+        TRITON_EXPORT const triton::ast::AstArena& getAstArena(void) const;
+
         //! Initialize a variable in the context
         TRITON_EXPORT void initVariable(const std::string& name, const triton::uint512& value);
 
@@ -8,7 +8,10 @@
 #ifndef TRITON_ASTDICTIONARIES_H
 #define TRITON_ASTDICTIONARIES_H
 
-#include <set>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <triton/ast.hpp>
@@ -32,167 +35,85 @@ namespace triton {
    *  @{
    */
 
+    //! The initial number of slots of the AST dictionaries table.
+    const triton::usize AST_DICTIONARIES_INITIAL_SIZE = 1024;
+
     //! \class AstDictionaries
-    /*! \brief The AST dictionaries class */
+    /*! \brief The AST dictionaries class
+     *
+     * \details
+     * All nodes are hash-consed into a single open-addressing table (linear probing, power-of-two
+     * size). A node is identified by its kind, its immediate payload (value of a decimal, name of a
+     * string or a variable, id of a reference) and the pointers of its children. As children are
+     * themselves unique, comparing their pointers is enough to compare two sub-trees. The table does
+     * not own the nodes, they live in the arena of their context.
+     */
     class AstDictionaries {
       private:
-        //! Defines if this instance is used as a backup.
-        bool backupFlag;
-
-        //! Copies an AstDictionaries.
-        void copy(const AstDictionaries& other);
-
-        //! Links all sub dictionaries to the root one.
-        void linkDictionaries(void);
-
-      protected:
-        //! Total of allocated nodes.
-        triton::usize allocatedNodes;
-
-        //! Total of allocated dictionaries.
-        std::set<triton::ast::AbstractNode*> allocatedDictionaries;
-
-        //! Bvadd Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvaddDictionary;
-
-        //! Bvand Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvandDictionary;
-
-        //! Bvashr Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvashrDictionary;
-
-        //! Bvlshr Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvlshrDictionary;
-
-        //! Bvmul Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvmulDictionary;
-
-        //! Bvnand Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnandDictionary;
-
-        //! Bvneg Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnegDictionary;
-
-        //! Bvnor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnorDictionary;
-
-        //! Bvnot Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnotDictionary;
-
-        //! Bvor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvorDictionary;
-
-        //! Bvrol Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvrolDictionary;
-
-        //! Bvror Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvrorDictionary;
-
-        //! Bvsdiv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsdivDictionary;
-
-        //! Bvsge Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsgeDictionary;
-
-        //! Bvsgt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsgtDictionary;
-
-        //! Bvshl Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvshlDictionary;
+        //! A slot of the table.
+        class Slot {
+          public:
+            //! The structural hash of the node.
+            triton::usize hash;
 
-        //! Bvsle Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsleDictionary;
+            //! The node, nullptr if the slot is empty.
+            triton::ast::AbstractNode* node;
 
-        //! Bvslt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsltDictionary;
+            //! Constructor.
+            Slot() : hash(0), node(nullptr) {}
+        };
 
-        //! Bvsmod Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsmodDictionary;
+        //! The hash-consing table.
+        std::vector<Slot> table;
 
-        //! Bvsrem Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsremDictionary;
+        //! Number of nodes in the table.
+        triton::usize tableCount;
 
-        //! Bvsub Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsubDictionary;
+        //! Number of nodes in the table per kind.
+        std::unordered_map<triton::uint32, triton::usize> kindCount;
 
-        //! Bvudiv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvudivDictionary;
+        //! Number of lookups into the table.
+        triton::usize lookups;
 
-        //! Bvuge Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvugeDictionary;
+        //! Total of slots visited by lookups.
+        triton::usize probes;
 
-        //! Bvugt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvugtDictionary;
+        //! The longest probe sequence seen.
+        triton::usize maxProbeLength;
 
-        //! Bvule Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvuleDictionary;
-
-        //! Bvult Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvultDictionary;
-
-        //! Bvurem Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvuremDictionary;
-
-        //! Bvxnor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvxnorDictionary;
-
-        //! Bvxor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvxorDictionary;
-
-        //! Bv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvDictionary;
-
-        //! Concat Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> concatDictionary;
-
-        //! Decimal Dictionary
-        std::map<triton::uint512, triton::ast::AbstractNode*> decimalDictionary;
-
-        //! Distinct Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> distinctDictionary;
-
-        //! Equal Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> equalDictionary;
-
-        //! Extract Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> extractDictionary;
-
-        //! Ite Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> iteDictionary;
-
-        //! Land Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> landDictionary;
-
-        //! Let Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> letDictionary;
+        //! Copies an AstDictionaries.
+        void copy(const AstDictionaries& other);
 
-        //! Lnot Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> lnotDictionary;
+        //! Number of lookups which found an existing node.
+        triton::usize hits;
 
-        //! Lor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> lorDictionary;
+        //! Returns the structural hash of a node.
+        triton::usize hashNode(triton::ast::AbstractNode* node) const;
 
-        //! Reference Dictionary
-        std::map<triton::usize, triton::ast::AbstractNode*> referenceDictionary;
+        //! Returns true if two nodes have the same kind, payload and children.
+        bool isSameNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const;
 
-        //! String Dictionary
-        std::map<std::string, triton::ast::AbstractNode*> stringDictionary;
+        //! Returns the slot of the node matching `match`, or the empty slot where it must be inserted.
+        template <typename Match>
+        triton::usize findSlot(triton::usize hash, const Match& match);
 
-        //! Sx Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> sxDictionary;
+        //! Returns the node with this hash matching `match`, nullptr otherwise.
+        template <typename Match>
+        triton::ast::AbstractNode* lookup(triton::usize hash, const Match& match);
 
-        //! Variable Dictionary
-        std::map<std::string, triton::ast::AbstractNode*> variableDictionary;
+        //! Doubles the size of the table.
+        void grow(void);
 
-        //! Zx Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> zxDictionary;
+      protected:
+        //! Total of allocated nodes.
+        triton::usize allocatedNodes;
 
-        //! Dictionaries
-        std::map<triton::uint32, void*> dictionaries;
+        //! Removes all nodes from the dictionaries. The nodes themselves are owned by the arena.
+        void clearAstDictionaries(void);
 
     public:
         //! Constructor.
-        TRITON_EXPORT AstDictionaries(bool isBackup=false);
+        TRITON_EXPORT AstDictionaries();
 
         //! Constructor.
         TRITON_EXPORT AstDictionaries(const AstDictionaries& other);
@@ -203,9 +124,31 @@ namespace triton {
         //! Copies an AstDictionaries.
         TRITON_EXPORT AstDictionaries& operator=(const AstDictionaries& other);
 
-        //! Browses into dictionaries.
+        //! Browses into dictionaries. Returns the existing node equal to `node`, or nullptr if `node` has been inserted.
         TRITON_EXPORT triton::ast::AbstractNode* browseAstDictionaries(triton::ast::AbstractNode* node);
 
+        //! Removes a node from the dictionaries (e.g. because it is about to be freed or changed).
+        TRITON_EXPORT void removeAstNode(triton::ast::AbstractNode* node);
+
+        //! Returns the existing node of kind `kind` with these children, nullptr otherwise.
+        template <typename T>
+        triton::ast::AbstractNode* lookupAstNode(triton::uint32 kind, const T& children);
+
+        //! Returns the existing node of kind `kind` with these children, nullptr otherwise.
+        TRITON_EXPORT triton::ast::AbstractNode* lookupAstNode(triton::uint32 kind, std::initializer_list<triton::ast::AbstractNode*> children);
+
+        //! Returns the existing decimal node of this value, nullptr otherwise.
+        TRITON_EXPORT triton::ast::AbstractNode* lookupDecimalNode(const triton::uint512& value);
+
+        //! Returns the existing reference node of this symbolic expression id, nullptr otherwise.
+        TRITON_EXPORT triton::ast::AbstractNode* lookupReferenceNode(triton::usize id);
+
+        //! Returns the existing string node of this value, nullptr otherwise.
+        TRITON_EXPORT triton::ast::AbstractNode* lookupStringNode(const std::string& value);
+
+        //! Returns the existing variable node of this symbolic variable name, nullptr otherwise.
+        TRITON_EXPORT triton::ast::AbstractNode* lookupVariableNode(const std::string& name);
+
         //! Returns stats about dictionaries.
         TRITON_EXPORT std::map<std::string, triton::usize> getAstDictionariesStats(void) const;
     };
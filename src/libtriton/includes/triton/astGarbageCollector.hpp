@@ -12,6 +12,7 @@
 #include <string>
 
 #include <triton/ast.hpp>
+#include <triton/astArena.hpp>
 #include <triton/astDictionaries.hpp>
 #include <triton/dllexport.hpp>
 #include <triton/modes.hpp>
@@ -41,22 +42,40 @@ namespace triton {
         //! Modes API
         const triton::modes::Modes& modes;
 
+        //! The memory arena of the nodes.
+        triton::ast::AstArena& arena;
+
         //! Defines if this instance is used as a backup.
         bool backupFlag;
 
+        //! The allocation number of the arena when this backup has been taken.
+        triton::usize sequence;
+
         //! Copies an AstGarbageCollectors..
         void copy(const AstGarbageCollector& other);
 
-      protected:
-        //! This container contains all allocated nodes.
-        std::set<triton::ast::AbstractNode*> allocatedNodes;
+        //! Removes a node which is about to be deleted from the dictionaries, the variables map and its expression.
+        void forgetAstNode(triton::ast::AbstractNode* node);
+
+        /*!
+         * \brief Deletes nodes whatever their references, newest first, and gives back the references they hold on the other nodes.
+         *
+         * \details
+         * The children which are not referenced anymore are freed if `freeChildren` is true, otherwise they are
+         * left to the one who asked for the drop.
+         */
+        void dropAstNodes(const std::vector<triton::ast::AbstractNode*>& nodes, bool freeChildren);
+
+        //! Deletes all nodes allocated since the allocation number `sequence`, newest first.
+        void rollback(triton::usize sequence);
 
+      protected:
         //! This map maintains a link between symbolic variables and their nodes.
         std::map<std::string, std::vector<triton::ast::AbstractNode*>> variableNodes;
 
       public:
         //! Constructor.
-        TRITON_EXPORT AstGarbageCollector(const triton::modes::Modes& modes, bool isBackup=false);
+        TRITON_EXPORT AstGarbageCollector(const triton::modes::Modes& modes, triton::ast::AstArena& arena, bool isBackup=false);
 
         //! Constructor by copy.
         TRITON_EXPORT AstGarbageCollector(const AstGarbageCollector& other);
@@ -70,9 +89,15 @@ namespace triton {
         //! Go through every allocated nodes and free them.
         TRITON_EXPORT void freeAllAstNodes(void);
 
-        //! Frees a set of nodes and removes them from the global container.
+        //! Frees the nodes of a set which are not referenced, and the children they were the last reference to.
         TRITON_EXPORT void freeAstNodes(std::set<triton::ast::AbstractNode*>& nodes);
 
+        //! Frees a node which is no longer referenced, and the children it was the last reference to.
+        TRITON_EXPORT void freeAstNode(triton::ast::AbstractNode* node);
+
+        //! Detaches the reference nodes which point to a symbolic expression about to be deleted.
+        TRITON_EXPORT void detachReferenceNodes(const triton::engines::symbolic::SymbolicExpression& expr);
+
         //! Extracts all unique nodes from a partial AST into the uniqueNodes set.
         TRITON_EXPORT void extractUniqueAstNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, triton::ast::AbstractNode* root) const;
 
@@ -83,14 +108,17 @@ namespace triton {
         TRITON_EXPORT void recordVariableAstNode(const std::string& name, triton::ast::AbstractNode* node);
 
         //! Returns all allocated nodes.
-        TRITON_EXPORT const std::set<triton::ast::AbstractNode*>& getAllocatedAstNodes(void) const;
+        TRITON_EXPORT std::set<triton::ast::AbstractNode*> getAllocatedAstNodes(void) const;
+
+        //! Returns stats about the memory arena of the nodes.
+        TRITON_EXPORT std::map<std::string, triton::usize> getAstArenaStats(void) const;
 
         //! Returns all variable nodes recorded.
         TRITON_EXPORT const std::map<std::string, std::vector<triton::ast::AbstractNode*>>& getAstVariableNodes(void) const;
 
         //! Returns the node of a recorded variable.
         TRITON_EXPORT std::vector<triton::ast::AbstractNode*> getAstVariableNode(const std::string& name) const;
-
+        //! Sets all allocated nodes. The variable nodes must be assigned afterwards with setAstVariableNodes().
         //! Sets all allocated nodes.
         TRITON_EXPORT void setAllocatedAstNodes(const std::set<triton::ast::AbstractNode*>& nodes);
 
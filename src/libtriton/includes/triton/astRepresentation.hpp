@@ -10,6 +10,8 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <triton/astPythonRepresentation.hpp>
 #include <triton/astRepresentationInterface.hpp>
@@ -58,6 +60,9 @@ namespace triton {
           //! AstRepresentation interface.
           std::unique_ptr<triton::ast::representations::AstRepresentationInterface> representations[triton::ast::representations::LAST_REPRESENTATION];
 
+          //! While a node is displayed, receives its children and their positions in the text instead of displaying them (see print()).
+          std::vector<std::pair<triton::usize, AbstractNode*>>* pending;
+
         public:
           //! Constructor.
           TRITON_EXPORT AstRepresentation();
@@ -74,7 +79,14 @@ namespace triton {
           //! Sets the representation mode.
           TRITON_EXPORT void setMode(triton::uint32 mode);
 
-          //! Displays the node according to the representation mode.
+          /*!
+           * \brief Displays the node according to the representation mode.
+           *
+           * \details
+           * The tree is displayed without recursion: each node is displayed alone while the
+           * positions of its children in its text are recorded, then the children are displayed
+           * at these positions.
+           */
           TRITON_EXPORT std::ostream& print(std::ostream& stream, AbstractNode* node);
       };
 
@@ -0,0 +1,114 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_DISASSEMBLYCACHE_H
+#define TRITON_DISASSEMBLYCACHE_H
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <triton/dllexport.hpp>
+#include <triton/instruction.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    //! The default number of instructions kept by the disassembly cache.
+    const triton::usize DEFAULT_DISASSEMBLY_CACHE_SIZE = 65536;
+
+    //! The maximum size (in bytes) of an instruction. Used to find the entries overlapping a memory write.
+    const triton::uint32 MAX_INSTRUCTION_SIZE = 16;
+
+    /*! \class DisassemblyCache
+     *  \brief The disassembly cache class.
+     *
+     *  \details
+     *  Keeps the result of the disassembly (type, prefix, size, disassembly string and operands)
+     *  for a given address. An entry is only reused if the opcode bytes of the instruction still
+     *  match the cached ones, so a stale entry can never be returned. The cache is bounded and
+     *  the least recently used entries are evicted first.
+     */
+    class DisassemblyCache {
+      private:
+        //! The maximum number of entries.
+        triton::usize capacity;
+
+        //! Number of hits.
+        triton::usize hits;
+
+        //! Number of misses.
+        triton::usize misses;
+
+        //! Number of evicted entries.
+        triton::usize evictions;
+
+        //! Number of entries removed by a memory write.
+        triton::usize invalidations;
+
+        //! The addresses of the cached entries from the most to the least recently used.
+        std::list<triton::uint64> lru;
+
+        /*! \brief map of address -> decoded instruction
+         *
+         * \details
+         * **item1**: instruction address<br>
+         * **item2**: <decoded instruction, position in the LRU list>
+         */
+        std::map<triton::uint64, std::pair<triton::arch::Instruction, std::list<triton::uint64>::iterator>> entries;
+
+        //! Copies a DisassemblyCache.
+        void copy(const DisassemblyCache& other);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT DisassemblyCache(triton::usize capacity=DEFAULT_DISASSEMBLY_CACHE_SIZE);
+
+        //! Constructor by copy.
+        TRITON_EXPORT DisassemblyCache(const DisassemblyCache& other);
+
+        //! Copies a DisassemblyCache.
+        TRITON_EXPORT DisassemblyCache& operator=(const DisassemblyCache& other);
+
+        //! Fills `inst` from the cache. Returns false if there is no entry for its address and opcode bytes.
+        TRITON_EXPORT bool lookup(triton::arch::Instruction& inst);
+
+        //! Records a freshly disassembled instruction.
+        TRITON_EXPORT void record(const triton::arch::Instruction& inst);
+
+        //! Removes all entries overlapping the memory area [baseAddr, baseAddr+size).
+        TRITON_EXPORT void invalidate(triton::uint64 baseAddr, triton::usize size);
+
+        //! Removes all entries and resets the counters.
+        TRITON_EXPORT void clear(void);
+
+        //! Returns the hits, misses, evictions, invalidations, entries and capacity of the cache.
+        TRITON_EXPORT std::map<std::string, triton::usize> getStats(void) const;
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_DISASSEMBLYCACHE_H */
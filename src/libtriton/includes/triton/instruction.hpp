@@ -10,6 +10,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <utility>
@@ -94,9 +95,18 @@ namespace triton {
         bool tainted;
 
     private:
+        //! The nodes retained by the instruction, see retainNodes().
+        std::vector<triton::ast::AbstractNode*> nodes;
+
+        //! The lifetime of the arena of the retained nodes.
+        std::weak_ptr<bool> nodesLifetime;
+
         //! Copies an Instruction
         void copy(const Instruction& other);
 
+        //! Releases the nodes retained by the instruction.
+        void releaseNodes(void);
+
       public:
         //! A list of operands
         std::vector<triton::arch::OperandWrapper> operands;
@@ -116,6 +126,9 @@ namespace triton {
         //! Copies an Instruction.
         TRITON_EXPORT Instruction& operator=(const Instruction& other);
 
+        //! Destructor.
+        TRITON_EXPORT ~Instruction();
+
         //! Returns the thread id of the instruction.
         TRITON_EXPORT triton::uint32 getThreadId(void) const;
 
@@ -259,6 +272,20 @@ namespace triton {
 
         //! Resets partially instruction information. All except memory and register states.
         TRITON_EXPORT void partialReset(void);
+
+        /*!
+         * \brief Retains the nodes exposed by the instruction.
+         *
+         * \details
+         * The lea, load, read, immediate, store and written nodes must outlive the expressions
+         * which have built them. The references taken by a previous call are given back, so
+         * that processing an instruction again does not pin its former nodes. They are all given
+         * back by clear(), reset(), partialReset() and the destructor.
+         */
+        TRITON_EXPORT void retainNodes(void);
+
+        //! Clears the semantics of the instruction (accesses, lea nodes and expressions) and releases the nodes it retains.
+        TRITON_EXPORT void clear(void);
     };
 
     //! Displays an Instruction.
@@ -53,26 +53,32 @@ namespace triton {
         //! Symbolic engine API
         triton::engines::symbolic::SymbolicEngine* symbolicEngine;
 
-        //! Backup symbolic engine
-        triton::engines::symbolic::SymbolicEngine* backupSymbolicEngine;
+        //! Number of path constraints before the instruction (taint-only path).
+        triton::usize numberOfPathConstraints;
 
         //! Taint engine API
         triton::engines::taint::TaintEngine* taintEngine;
 
         //! Removes all symbolic expressions of an instruction.
-        void removeSymbolicExpressions(triton::arch::Instruction& inst, std::set<triton::ast::AbstractNode*>& uniqueNodes);
+        void removeSymbolicExpressions(triton::arch::Instruction& inst);
 
-        //! Collects nodes from a set.
-        template <typename T> void collectNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, T& items) const;
+        //! Clears the previous semantics of an instruction and sets its address if undefined.
+        void initInstruction(triton::arch::Instruction& inst);
 
-        //! Collects nodes from operands.
-        void collectNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, std::vector<triton::arch::OperandWrapper>& operands, bool gc) const;
+        //! Spreads the taint of an instruction from the summary of its opcode. Returns false if the opcode has no summary.
+        bool buildTaint(triton::arch::Instruction& inst);
 
-        //! Collects unsymbolized nodes from a set.
-        template <typename T> void collectUnsymbolizedNodes(T& items) const;
+        //! Collects and retains nodes from a set.
+        template <typename T> void collectNodes(std::vector<triton::ast::AbstractNode*>& nodes, T& items) const;
 
-        //! Collects unsymbolized nodes from operands.
-        void collectUnsymbolizedNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, std::vector<triton::arch::OperandWrapper>& operands) const;
+        //! Collects and retains nodes from operands.
+        void collectNodes(std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::arch::OperandWrapper>& operands, bool gc) const;
+
+        //! Collects and retains unsymbolized nodes from a set.
+        template <typename T> void collectUnsymbolizedNodes(std::vector<triton::ast::AbstractNode*>& nodes, T& items) const;
+
+        //! Collects and retains unsymbolized nodes from operands.
+        void collectUnsymbolizedNodes(std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::arch::OperandWrapper>& operands) const;
 
       protected:
         //! x86 ISA builder.
@@ -35,9 +35,16 @@ namespace triton {
 
       /* Symbolic */
       ALIGNED_MEMORY,        //!< [symbolic mode] Keep a map of aligned memory.
+      LAZY_FLAGS,            //!< [symbolic mode] Build the expressions of the arithmetic flags only when they are read.
       ONLY_ON_SYMBOLIZED,    //!< [symbolic mode] Perform symbolic execution only on symbolized expressions.
       ONLY_ON_TAINTED,       //!< [symbolic mode] Perform symbolic execution only on tainted instructions.
       PC_TRACKING_SYMBOLIC,  //!< [symbolic mode] Track path constraints only if they are symbolized.
+
+      /* Taint */
+      TAINT_SUMMARIES,       //!< [taint mode] Spread the taint from the opcode summaries when the symbolic engine is disabled.
+
+      /* Architecture */
+      DISASSEMBLY_CACHE,     //!< [arch mode] Keep a cache of the decoded instructions.
     };
 
 
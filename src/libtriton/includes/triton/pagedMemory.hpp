@@ -0,0 +1,134 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_PAGEDMEMORY_H
+#define TRITON_PAGEDMEMORY_H
+
+#include <unordered_map>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    //! The size (in bytes) of a memory page.
+    const triton::usize MEMORY_PAGE_SIZE = 4096;
+
+    //! The number of bits used to get the page offset of an address.
+    const triton::uint32 MEMORY_PAGE_SHIFT = 12;
+
+    /*! \class PagedMemory
+     *  \brief The concrete memory of a CPU.
+     *
+     *  \details
+     *  The memory is split into 4 KiB pages which are allocated on demand. Each page keeps a bitmap
+     *  of its mapped bytes, so reading an unmapped byte returns zero and mapping is tracked at the byte
+     *  level while data is read and written with `memcpy` inside a page.
+     */
+    class PagedMemory {
+      private:
+        //! A memory page.
+        class Page {
+          public:
+            //! The concrete values.
+            triton::uint8 data[MEMORY_PAGE_SIZE];
+
+            //! One bit per byte, set if the byte is mapped.
+            triton::uint64 mapped[MEMORY_PAGE_SIZE / 64];
+
+            //! Number of mapped bytes.
+            triton::usize count;
+
+            //! Constructor.
+            Page();
+
+            //! Maps the bytes [offset, offset+size).
+            void map(triton::usize offset, triton::usize size);
+
+            //! Unmaps the bytes [offset, offset+size).
+            void unmap(triton::usize offset, triton::usize size);
+
+            //! Returns true if all the bytes [offset, offset+size) are mapped.
+            bool isMapped(triton::usize offset, triton::usize size) const;
+        };
+
+        /*! \brief map of page number -> page
+         *
+         * \details
+         * **item1**: address >> MEMORY_PAGE_SHIFT<br>
+         * **item2**: page
+         */
+        std::unordered_map<triton::uint64, Page*> pages;
+
+        //! Copies a PagedMemory.
+        void copy(const PagedMemory& other);
+
+        //! Returns the page of an address or nullptr if the page is not allocated.
+        Page* getPage(triton::uint64 addr) const;
+
+        //! Returns the page of an address. The page is allocated if it does not exist.
+        Page* getOrCreatePage(triton::uint64 addr);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT PagedMemory();
+
+        //! Constructor by copy.
+        TRITON_EXPORT PagedMemory(const PagedMemory& other);
+
+        //! Destructor.
+        TRITON_EXPORT ~PagedMemory();
+
+        //! Copies a PagedMemory.
+        TRITON_EXPORT PagedMemory& operator=(const PagedMemory& other);
+
+        //! Returns the concrete value of a memory cell. Unmapped memory reads as zero.
+        TRITON_EXPORT triton::uint8 read(triton::uint64 addr) const;
+
+        //! Copies `size` bytes from `addr` into `values`. Unmapped memory reads as zero.
+        TRITON_EXPORT void read(triton::uint64 addr, triton::uint8* values, triton::usize size) const;
+
+        //! Sets and maps a memory cell.
+        TRITON_EXPORT void write(triton::uint64 addr, triton::uint8 value);
+
+        //! Copies and maps `size` bytes from `values` to `addr`.
+        TRITON_EXPORT void write(triton::uint64 addr, const triton::uint8* values, triton::usize size);
+
+        //! Returns true if all the bytes of [baseAddr, baseAddr+size) are mapped.
+        TRITON_EXPORT bool isMapped(triton::uint64 baseAddr, triton::usize size=1) const;
+
+        //! Unmaps the bytes of [baseAddr, baseAddr+size). Pages which become empty are released.
+        TRITON_EXPORT void unmap(triton::uint64 baseAddr, triton::usize size=1);
+
+        //! Releases all pages.
+        TRITON_EXPORT void clear(void);
+
+        //! Returns the number of allocated pages.
+        TRITON_EXPORT triton::usize getNumberOfPages(void) const;
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PAGEDMEMORY_H */
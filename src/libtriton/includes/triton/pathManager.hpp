@@ -66,6 +66,9 @@ namespace triton {
           //! Constructor by copy.
           TRITON_EXPORT PathManager(const PathManager& other);
 
+          //! Destructor. Releases the nodes of the path constraints.
+          TRITON_EXPORT ~PathManager();
+
           //! Returns the logical conjunction vector of path constraints.
           TRITON_EXPORT const std::vector<triton::engines::symbolic::PathConstraint>& getPathConstraints(void) const;
 
@@ -78,6 +81,9 @@ namespace triton {
           //! Adds a path constraint.
           TRITON_EXPORT void addPathConstraint(const triton::arch::Instruction& inst, triton::engines::symbolic::SymbolicExpression* expr);
 
+          //! Removes the last path constraint.
+          TRITON_EXPORT void popPathConstraint(void);
+
           //! Clears the logical conjunction vector of path constraints.
           TRITON_EXPORT void clearPathConstraints(void);
 
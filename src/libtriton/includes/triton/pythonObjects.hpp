@@ -99,6 +99,7 @@ namespace triton {
       typedef struct {
         PyObject_HEAD
         triton::ast::AbstractNode* node;
+        std::weak_ptr<bool>* lifetime;
       } AstNode_Object;
 
       //! pyAstNode type.
@@ -0,0 +1,130 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SHADOWMEMORY_H
+#define TRITON_SHADOWMEMORY_H
+
+#include <set>
+#include <unordered_map>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Taint namespace
+    namespace taint {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup taint
+     *  @{
+     */
+
+      //! The number of bytes covered by a shadow page.
+      const triton::usize SHADOW_PAGE_SIZE = 4096;
+
+      //! The number of bits used to get the offset of an address in a shadow page.
+      const triton::uint32 SHADOW_PAGE_SHIFT = 12;
+
+      /*! \class ShadowMemory
+       *  \brief The shadow memory of the taint engine.
+       *
+       *  \details
+       *  One bit per byte of memory, stored in a sparse map of 4 KiB pages. An access of
+       *  1 to 64 bytes is read or written as a single 64-bit mask (one bit per byte, the
+       *  least significant bit being the lowest address).
+       */
+      class ShadowMemory {
+        private:
+          //! A shadow page.
+          class Page {
+            public:
+              //! One bit per byte, set if the byte is tainted.
+              triton::uint64 bits[SHADOW_PAGE_SIZE / 64];
+
+              //! Number of tainted bytes.
+              triton::usize count;
+
+              //! Constructor.
+              Page();
+          };
+
+          /*! \brief map of page number -> shadow page
+           *
+           * \details
+           * **item1**: address >> SHADOW_PAGE_SHIFT<br>
+           * **item2**: shadow page
+           */
+          std::unordered_map<triton::uint64, Page*> pages;
+
+          //! Copies a ShadowMemory.
+          void copy(const ShadowMemory& other);
+
+          //! Sets the `size` bits at `addr` (`size` must not cross a 64-bit word).
+          void setWordBits(triton::uint64 addr, triton::uint32 size, triton::uint64 bits);
+
+          //! Returns the `size` bits at `addr` (`size` must not cross a 64-bit word).
+          triton::uint64 getWordBits(triton::uint64 addr, triton::uint32 size) const;
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT ShadowMemory();
+
+          //! Constructor by copy.
+          TRITON_EXPORT ShadowMemory(const ShadowMemory& other);
+
+          //! Destructor.
+          TRITON_EXPORT ~ShadowMemory();
+
+          //! Copies a ShadowMemory.
+          TRITON_EXPORT ShadowMemory& operator=(const ShadowMemory& other);
+
+          //! Returns the taint mask (one bit per byte) of an access of 1 to 64 bytes.
+          TRITON_EXPORT triton::uint64 getBits(triton::uint64 addr, triton::uint32 size) const;
+
+          //! Sets the taint mask (one bit per byte) of an access of 1 to 64 bytes.
+          TRITON_EXPORT void setBits(triton::uint64 addr, triton::uint32 size, triton::uint64 bits);
+
+          //! Returns true if at least one byte of [addr, addr+size) is tainted.
+          TRITON_EXPORT bool isTainted(triton::uint64 addr, triton::usize size=1) const;
+
+          //! Taints the bytes [addr, addr+size).
+          TRITON_EXPORT void taint(triton::uint64 addr, triton::usize size=1);
+
+          //! Untaints the bytes [addr, addr+size).
+          TRITON_EXPORT void untaint(triton::uint64 addr, triton::usize size=1);
+
+          //! Returns the addresses of all tainted bytes.
+          TRITON_EXPORT std::set<triton::uint64> getTaintedAddresses(void) const;
+
+          //! Untaints the whole memory.
+          TRITON_EXPORT void clear(void);
+      };
+
+    /*! @} End of taint namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SHADOWMEMORY_H */
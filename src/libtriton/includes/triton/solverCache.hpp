@@ -0,0 +1,181 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SOLVERCACHE_H
+#define TRITON_SOLVERCACHE_H
+
+#include <functional>
+#include <list>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! The number of recent models checked against a new constraint before calling the solver.
+      const triton::uint32 SOLVER_CACHE_CANDIDATES = 8;
+
+      /*! \class SolverCache
+       *  \brief The cache of the solver queries.
+       *
+       *  \details
+       *  A query is indexed by the structural hash of its unrolled constraint and holds this constraint,
+       *  which confirms a hit since two constraints may share a hash, and the model found by the solver,
+       *  which is empty if the constraint is unsatisfiable. The entries are evicted in least recently used
+       *  order once the cache is full. When a file is set, each new entry is appended to it, so that the
+       *  queries of a run are known by the next ones. Once it holds twice the maximum number of entries,
+       *  the file is rewritten with the entries kept. The constraints are not saved, the models of the
+       *  entries of a file are checked and their unsatisfiable answers are not trusted.
+       */
+      class SolverCache {
+        public:
+          //! Checks a candidate model against the constraint. If it fits, fills `model` with the model to return.
+          using ModelCheck = std::function<bool(const std::map<triton::uint32, SolverModel>& candidate, std::map<triton::uint32, SolverModel>& model)>;
+
+        private:
+          //! A cached query.
+          struct Entry {
+            //! The hash of the constraint.
+            triton::uint512 hash;
+
+            //! The unrolled constraint (the cache holds a reference to it), null if the entry comes from a file.
+            triton::ast::AbstractNode* node;
+
+            //! The model of the constraint, empty if it is unsatisfiable.
+            std::map<triton::uint32, SolverModel> model;
+          };
+
+          //! The maximum number of entries, 0 disables the cache.
+          triton::usize maxSize;
+
+          //! The entries, the most recently used first.
+          std::list<Entry> entries;
+
+          //! map of constraint hash -> entry
+          std::map<triton::uint512, std::list<Entry>::iterator> index;
+
+          //! The file which receives the new entries, empty if the cache is not persistent.
+          std::string path;
+
+          //! The number of entries written in the file since it has been rewritten.
+          triton::usize lines;
+
+          //! The number of queries looked up.
+          triton::usize queries;
+
+          //! The number of queries answered by their own entry.
+          triton::usize hits;
+
+          //! The number of queries answered by the model of another entry.
+          triton::usize modelHits;
+
+          //! The number of queries sent to the solver.
+          triton::usize misses;
+
+          //! The number of entries evicted.
+          triton::usize evictions;
+
+          //! Copies a SolverCache.
+          void copy(const SolverCache& other);
+
+          //! Adds or replaces the entry of a hash as the most recent one, and evicts the oldest ones.
+          void record(const triton::uint512& hash, triton::ast::AbstractNode* node, const std::map<triton::uint32, SolverModel>& model);
+
+          //! Removes the least recently used entry and releases its constraint.
+          void evict(void);
+
+          //! Appends an entry to the file of the cache.
+          void append(std::ostream& stream, const Entry& entry) const;
+
+          //! Rewrites the file of the cache with the entries kept.
+          void save(const std::string& path);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT SolverCache();
+
+          //! Constructor by copy.
+          TRITON_EXPORT SolverCache(const SolverCache& other);
+
+          //! Destructor. Releases the constraints of the entries.
+          TRITON_EXPORT ~SolverCache();
+
+          //! Copies a SolverCache.
+          TRITON_EXPORT SolverCache& operator=(const SolverCache& other);
+
+          //! Returns true if the cache is enabled (its size is not 0).
+          TRITON_EXPORT bool isEnabled(void) const;
+
+          //! Returns the maximum number of entries.
+          TRITON_EXPORT triton::usize getMaxSize(void) const;
+
+          //! Sets the maximum number of entries, 0 disables the cache. The oldest entries are evicted.
+          TRITON_EXPORT void setMaxSize(triton::usize size);
+
+          /*!
+           * \brief Looks up a query. Returns true and fills `model` if it is answered by the cache.
+           *
+           * \details
+           * The entry of `hash` answers the query if it has been recorded for a constraint with the
+           * same structure as `node`, its answer is returned without calling `check`. The model of an
+           * entry loaded from a file is checked. Otherwise, the models of the most recent entries are
+           * checked. A model which fits becomes the entry of `hash`.
+           */
+          TRITON_EXPORT bool lookup(const triton::uint512& hash, triton::ast::AbstractNode* node, const ModelCheck& check, std::map<triton::uint32, SolverModel>& model);
+
+          //! Records the model found by the solver for the unrolled constraint `node`, empty if the solver has proven it unsatisfiable.
+          TRITON_EXPORT void insert(const triton::uint512& hash, triton::ast::AbstractNode* node, const std::map<triton::uint32, SolverModel>& model);
+
+          //! Returns the file of the cache, empty if the cache is not persistent.
+          TRITON_EXPORT const std::string& getFile(void) const;
+
+          //! Loads the entries of a file (up to the maximum size) and appends the new ones to it. An empty path stops the persistence.
+          TRITON_EXPORT void setFile(const std::string& path);
+
+          //! Removes all entries and resets the statistics. The file is left as it is.
+          TRITON_EXPORT void clear(void);
+
+          //! Returns the statistics of the cache.
+          TRITON_EXPORT std::map<std::string, triton::usize> getStats(void) const;
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SOLVERCACHE_H */
@@ -17,8 +17,10 @@
 
 #include <triton/ast.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/solverCache.hpp>
 #include <triton/solverModel.hpp>
 #include <triton/symbolicEngine.hpp>
+#include <triton/tritonToZ3Ast.hpp>
 #include <triton/tritonTypes.hpp>
 
 
@@ -51,6 +53,24 @@ namespace triton {
           //! Symbolic Engine API
           triton::engines::symbolic::SymbolicEngine* symbolicEngine;
 
+          //! The translator of the incremental session. It owns the z3's context and the translation cache.
+          triton::ast::TritonToZ3Ast* sessionAst;
+
+          //! The z3's solver of the incremental session.
+          z3::solver* sessionSolver;
+
+          //! The number of scopes pushed in the incremental session.
+          triton::uint32 sessionScopes;
+
+          //! Creates the incremental session if it does not exist yet.
+          void initSession(void);
+
+          //! The cache of the queries of getModel().
+          mutable triton::engines::solver::SolverCache cache;
+
+          //! Computes and returns a model from a symbolic constraint through the query cache.
+          std::map<triton::uint32, SolverModel> getCachedModel(triton::ast::AbstractNode* node) const;
+
         public:
           //! Constructor.
           TRITON_EXPORT SolverEngine(triton::engines::symbolic::SymbolicEngine* symbolicEngine);
@@ -58,6 +78,9 @@ namespace triton {
           //! Constructor by copy.
           TRITON_EXPORT SolverEngine(const SolverEngine& other);
 
+          //! Destructor.
+          TRITON_EXPORT ~SolverEngine();
+
           //! Operator.
           TRITON_EXPORT SolverEngine& operator=(const SolverEngine& other);
 
@@ -78,6 +101,51 @@ namespace triton {
            * **item2**: model
            */
           TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(triton::ast::AbstractNode* node, triton::uint32 limit) const;
+
+          //! Adds a symbolic constraint to the incremental session. The constraint is kept until the current scope is popped.
+          TRITON_EXPORT void addSolverConstraint(triton::ast::AbstractNode* node);
+
+          //! Opens a new scope in the incremental session.
+          TRITON_EXPORT void pushSolver(void);
+
+          //! Closes the `count` last scopes of the incremental session and drops their constraints.
+          TRITON_EXPORT void popSolver(triton::uint32 count=1);
+
+          //! Returns the number of scopes opened in the incremental session.
+          TRITON_EXPORT triton::uint32 getSolverScopes(void) const;
+
+          //! Returns true if the constraints of the incremental session are satisfiable.
+          TRITON_EXPORT bool isSolverSat(void);
+
+          //! Computes and returns a model from the constraints of the incremental session. The map is empty if they are unsatisfiable.
+          /*! \brief map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::map<triton::uint32, SolverModel> getSolverModel(void);
+
+          //! Drops the incremental session: its constraints, its scopes and its translation cache.
+          TRITON_EXPORT void resetSolver(void);
+
+          //! Sets the maximum number of queries kept by the cache of getModel(). 0 disables the cache.
+          TRITON_EXPORT void setSolverCacheSize(triton::usize size);
+
+          //! Returns the maximum number of queries kept by the cache of getModel().
+          TRITON_EXPORT triton::usize getSolverCacheSize(void) const;
+
+          //! Loads the queries of a file into the cache and appends the new ones to it. An empty path stops the persistence.
+          TRITON_EXPORT void setSolverCacheFile(const std::string& path);
+
+          //! Returns the file of the query cache, empty if the cache is not persistent.
+          TRITON_EXPORT const std::string& getSolverCacheFile(void) const;
+
+          //! Removes the queries of the cache and resets its statistics.
+          TRITON_EXPORT void clearSolverCache(void);
+
+          //! Returns the statistics of the query cache.
+          TRITON_EXPORT std::map<std::string, triton::usize> getSolverCacheStats(void) const;
       };
 
     /*! @} End of solver namespace */
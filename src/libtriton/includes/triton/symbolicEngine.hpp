@@ -8,9 +8,13 @@
 #ifndef TRITON_SYMBOLICENGINE_H
 #define TRITON_SYMBOLICENGINE_H
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <triton/architecture.hpp>
 #include <triton/ast.hpp>
@@ -22,7 +26,9 @@
 #include <triton/register.hpp>
 #include <triton/symbolicEnums.hpp>
 #include <triton/symbolicExpression.hpp>
+#include <triton/symbolicMemory.hpp>
 #include <triton/symbolicSimplification.hpp>
+#include <triton/symbolicTable.hpp>
 #include <triton/symbolicVariable.hpp>
 #include <triton/tritonTypes.hpp>
 
@@ -51,6 +57,12 @@ namespace triton {
      *  @{
      */
 
+      //! The number of unrolled ASTs the symbolic engine keeps before it forgets them all.
+      const triton::usize MAX_UNROLLED_ASTS = 1000000;
+
+      //! Builds the AST of a flag from the AST (or a reference) of the expression which produces it.
+      using LazyFlagBuilder = std::function<triton::ast::AbstractNode*(triton::ast::AbstractNode* parent)>;
+
       //! \class SymbolicEngine
       /*! \brief The symbolic engine class. */
       class SymbolicEngine
@@ -64,6 +76,9 @@ namespace triton {
           //! Defines if the engine is enable or disable.
           bool enableFlag;
 
+          //! Defines if the expressions which are not symbolized are dropped while they are created (concrete path).
+          bool concreteFlag;
+
           //! Number of registers
           triton::uint32 numberOfRegisters;
 
@@ -73,38 +88,111 @@ namespace triton {
           //! Symbolic variables id.
           triton::usize uniqueSymVarId;
 
-          /*! \brief The map of symbolic variables
+          /*! \brief The table of symbolic variables
            *
            * \details
            * **item1**: variable id<br>
            * **item2**: symbolic variable
            */
-          std::map<triton::usize, SymbolicVariable*> symbolicVariables;
+          triton::engines::symbolic::SymbolicTable<SymbolicVariable> symbolicVariables;
 
-          /*! \brief The map of symbolic expressions
+          /*! \brief The table of symbolic expressions
            *
            * \details
            * **item1**: symbolic reference id<br>
            * **item2**: symbolic expression
            */
-          std::map<triton::usize, SymbolicExpression*> symbolicExpressions;
+          triton::engines::symbolic::SymbolicTable<SymbolicExpression> symbolicExpressions;
+
+          //! The symbolic memory references (ranges of addresses -> symbolic expression).
+          triton::engines::symbolic::SymbolicMemory memoryReference;
+
+          //! The expression of a byte which is part of a wider range, built when its id is queried.
+          class ByteReference {
+            public:
+              //! The id of the expression of the range.
+              triton::usize id;
+
+              //! The offset of the byte into the expression of the range.
+              triton::uint64 offset;
+
+              //! The AST of the expression of the range when the byte has been extracted from it.
+              triton::ast::AbstractNode* ast;
 
-          /*! \brief map of address -> symbolic expression
+              //! The id of the expression of the byte.
+              triton::usize byteId;
+          };
+
+          /*! \brief map of address -> byte expression.
            *
            * \details
-           * **item1**: memory address<br>
-           * **item2**: symbolic reference id
+           * The views of the bytes are kept aside, the ranges of `memoryReference` are not split by a query.
+           * An entry is out of date once its byte is assigned again or its range expression changes.
+           *
+           * **item1**: address<br>
+           * **item2**: byte reference
            */
-          std::map<triton::uint64, triton::usize> memoryReference;
+          std::map<triton::uint64, ByteReference> byteReferences;
 
           /*! \brief map of <address:size> -> symbolic expression.
            *
            * \details
            * **item1**: <addr:size><br>
-           * **item2**: AST node
+           * **item2**: AST node (the map holds a reference to it)
            */
           std::map<std::pair<triton::uint64, triton::uint32>, triton::ast::AbstractNode*> alignedMemoryReference;
 
+          //! A flag whose expression is built when it is read (LAZY_FLAGS mode).
+          class LazyFlag {
+            public:
+              //! Builds the AST of the flag.
+              std::function<triton::ast::AbstractNode*(void)> build;
+
+              //! The nodes used by `build` (the engine holds a reference to them).
+              std::vector<triton::ast::AbstractNode*> nodes;
+
+              //! The comment of the expression.
+              std::string comment;
+
+              //! The taint of the flag when it has been produced.
+              bool isTainted;
+          };
+
+          /*! \brief map of flag -> lazy flag
+           *
+           * \details
+           * **item1**: flag id<br>
+           * **item2**: the pending flag
+           */
+          std::map<triton::arch::registers_e, LazyFlag> lazyFlags;
+
+          //! The expressions dropped by the concrete path of the current instruction (not in the table).
+          std::vector<SymbolicExpression*> concreteExpressions;
+
+          //! The unrolled AST of a recorded expression.
+          class UnrolledAst {
+            public:
+              //! The unrolled AST (the engine holds a reference to it).
+              triton::ast::AbstractNode* ast;
+
+              //! The version of the expression when it was unrolled.
+              triton::usize version;
+
+              //! The <id, version> of the expressions referenced by its AST when it was unrolled.
+              std::vector<std::pair<triton::usize, triton::usize>> references;
+          };
+
+          /*! \brief map of symbolic expression id -> unrolled AST
+           *
+           * \details
+           * **item1**: symbolic expression id<br>
+           * **item2**: unrolled AST
+           */
+          std::unordered_map<triton::usize, UnrolledAst> unrolledAsts;
+
+          //! The last version of the ASTs when the unrolled ASTs were checked. They are checked again once an AST is replaced.
+          triton::usize unrolledVersion;
+
         private:
           //! Architecture API
           triton::arch::Architecture* architecture;
@@ -118,12 +206,36 @@ namespace triton {
           //! Defines if this instance is used as a backup.
           bool backupFlag;
 
-          //! Slices all expressions from a given node.
-          void sliceExpressions(triton::ast::AbstractNode* node, std::map<triton::usize, SymbolicExpression*>& exprs);
-
           //! Copies and initializes a SymbolicEngine.
           void copy(const SymbolicEngine& other);
 
+          //! Removes an aligned entry if it exists and releases its node.
+          void eraseAlignedMemory(triton::uint64 address, triton::uint32 size);
+
+          //! Removes all aligned entries and releases their nodes.
+          void clearAlignedMemory(void);
+
+          //! Removes a pending flag and releases its nodes.
+          void removeLazyFlag(triton::arch::registers_e id);
+
+          //! Removes all pending flags and releases their nodes.
+          void clearLazyFlags(void);
+
+          //! Removes the unrolled AST of an expression if it exists and releases its nodes.
+          void eraseUnrolledAst(triton::usize symExprId);
+
+          //! Removes the unrolled ASTs which depend on a replaced AST, if an AST has been replaced since the last check.
+          void checkUnrolledAsts(void);
+
+          //! Returns the AST of a range of memory (a reference or an extraction of its expression).
+          triton::ast::AbstractNode* buildSymbolicMemoryRange(const SymbolicMemory::Range& range);
+
+          //! Returns true if the expression of the node is dropped by the concrete path.
+          bool isConcreteNode(triton::ast::AbstractNode* node) const;
+
+          //! Creates an expression dropped at the end of the instruction. It is neither recorded nor assigned.
+          SymbolicExpression* newConcreteExpression(triton::ast::AbstractNode* node, symkind_e kind, const std::string& comment);
+
         public:
           //! Symbolic register state.
           triton::usize* symbolicReg;
@@ -180,8 +292,18 @@ namespace triton {
           //! Returns the symbolic variable corresponding to the symbolic variable name.
           TRITON_EXPORT SymbolicVariable* getSymbolicVariableFromName(const std::string& symVarName) const;
 
-          //! Returns the symbolic expression id corresponding to the memory address.
-          TRITON_EXPORT triton::usize getSymbolicMemoryId(triton::uint64 addr) const;
+          /*!
+           * \brief Returns the symbolic expression id corresponding to the memory address.
+           *
+           * \details
+           * If the byte is part of a wider range, it gets its own expression (extracted from the one of the range)
+           * which is added to the table of expressions. The ranges are not modified and the expression of the byte
+           * is kept aside, it is returned again until the byte is assigned.
+           */
+          TRITON_EXPORT triton::usize getSymbolicMemoryId(triton::uint64 addr);
+
+          //! Returns the ranges of symbolic memory which intersect a memory access.
+          TRITON_EXPORT std::vector<SymbolicMemory::Range> getSymbolicMemoryRanges(const triton::arch::MemoryAccess& mem) const;
 
           //! Returns the symbolic expression corresponding to an id.
           TRITON_EXPORT SymbolicExpression* getSymbolicExpressionFromId(triton::usize symExprId) const;
@@ -189,8 +311,8 @@ namespace triton {
           //! Returns the map of symbolic registers defined.
           TRITON_EXPORT std::map<triton::arch::registers_e, SymbolicExpression*> getSymbolicRegisters(void) const;
 
-          //! Returns the map (addr:expr) of all symbolic memory defined.
-          TRITON_EXPORT std::map<triton::uint64, SymbolicExpression*> getSymbolicMemory(void) const;
+          //! Returns the map (addr:expr) of all symbolic memory defined. Every byte gets its own expression, see getSymbolicMemoryId().
+          TRITON_EXPORT std::map<triton::uint64, SymbolicExpression*> getSymbolicMemory(void);
 
           //! Returns the symbolic expression id corresponding to the register.
           TRITON_EXPORT triton::usize getSymbolicRegisterId(const triton::arch::Register& reg) const;
@@ -243,6 +365,33 @@ namespace triton {
           //! Returns the new symbolic flag expression expression and links this expression to the instruction.
           TRITON_EXPORT SymbolicExpression* createSymbolicFlagExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const triton::arch::Register& flag, const std::string& comment="");
 
+          //! Returns the new symbolic flag expression built by `build` from the parent expression. In the LAZY_FLAGS mode, records `build` instead and returns nullptr.
+          TRITON_EXPORT SymbolicExpression* createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, SymbolicExpression* parent, const triton::arch::Register& flag, const std::vector<triton::ast::AbstractNode*>& nodes, const LazyFlagBuilder& build, bool isTainted, const std::string& comment="");
+
+          //! Builds the expression of a pending flag (LAZY_FLAGS mode).
+          TRITON_EXPORT void buildLazyFlag(const triton::arch::Register& flag);
+
+          //! Builds the expressions of all pending flags (LAZY_FLAGS mode).
+          TRITON_EXPORT void buildLazyFlags(void);
+
+          //! Returns true if the expression of the flag is pending (LAZY_FLAGS mode).
+          TRITON_EXPORT bool isLazyFlag(const triton::arch::Register& flag) const;
+
+          /*!
+           * \brief Enables or disables the concrete path.
+           *
+           * \details
+           * Used by the IR builder in the ONLY_ON_SYMBOLIZED mode. While it is enabled, an expression
+           * which is not symbolized only updates the concrete state and concretizes its destination,
+           * instead of being recorded and removed once the instruction is processed. When the engine
+           * is disabled (taint-only), every expression only updates the concrete state and the
+           * symbolic state is left as is.
+           */
+          TRITON_EXPORT void enableConcretePath(bool flag);
+
+          //! Deletes the expressions dropped by the concrete path.
+          TRITON_EXPORT void clearConcreteExpressions(void);
+
           //! Returns the new symbolic volatile expression expression and links this expression to the instruction.
           TRITON_EXPORT SymbolicExpression* createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment="");
 
@@ -258,24 +407,39 @@ namespace triton {
           //! Assigns a symbolic expression to a memory.
           TRITON_EXPORT void assignSymbolicExpressionToMemory(SymbolicExpression *se, const triton::arch::MemoryAccess& mem);
 
-          //! Unrolls the SSA form of a given AST.
+          /*!
+           * \brief Unrolls the SSA form of a given AST.
+           *
+           * \details
+           * The given AST is not modified, new nodes are only built above the reference nodes.
+           * The unrolled ASTs of the recorded expressions are kept, so the next unrolls only
+           * work on the expressions which are not unrolled yet. An expression whose AST is
+           * replaced (see SymbolicExpression::setAst()) is unrolled again, with the expressions
+           * which reference it. At most MAX_UNROLLED_ASTS unrolled ASTs are kept.
+           */
           TRITON_EXPORT triton::ast::AbstractNode* unrollAst(triton::ast::AbstractNode* node);
 
+          //! Forgets the unrolled ASTs of the expressions and releases their nodes.
+          TRITON_EXPORT void clearUnrolledAsts(void);
+
           //! Slices all expressions from a given one.
           TRITON_EXPORT std::map<triton::usize, SymbolicExpression*> sliceExpressions(SymbolicExpression* expr);
 
           //! Returns the list of the tainted symbolic expressions.
           TRITON_EXPORT std::list<SymbolicExpression*> getTaintedSymbolicExpressions(void) const;
 
-          //! Returns all symbolic expressions.
-          TRITON_EXPORT const std::map<triton::usize, SymbolicExpression*>& getSymbolicExpressions(void) const;
+          //! Returns all symbolic expressions (ordered by id).
+          TRITON_EXPORT const SymbolicTable<SymbolicExpression>& getSymbolicExpressions(void) const;
 
-          //! Returns all symbolic variables.
-          TRITON_EXPORT const std::map<triton::usize, SymbolicVariable*>& getSymbolicVariables(void) const;
+          //! Returns all symbolic variables (ordered by id).
+          TRITON_EXPORT const SymbolicTable<SymbolicVariable>& getSymbolicVariables(void) const;
 
-          //! Adds a symbolic memory reference.
+          //! Adds a symbolic memory reference of one byte.
           TRITON_EXPORT void addMemoryReference(triton::uint64 mem, triton::usize id);
 
+          //! Adds a symbolic memory reference of `size` bytes, starting at the byte `offset` of the expression.
+          TRITON_EXPORT void addMemoryReference(triton::uint64 mem, triton::uint64 size, triton::usize id, triton::uint64 offset=0);
+
           //! Concretizes all symbolic memory references.
           TRITON_EXPORT void concretizeAllMemory(void);
 
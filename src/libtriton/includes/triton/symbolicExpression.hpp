@@ -50,7 +50,7 @@ namespace triton {
           //! The kind of the symbolic expression.
           symkind_e kind;
 
-          //! The root node (AST) of the symbolic expression.
+          //! The root node (AST) of the symbolic expression. The expression holds a reference to it.
           triton::ast::AbstractNode* ast;
 
           //! The comment of the symbolic expression.
@@ -65,6 +65,12 @@ namespace triton {
           //! The origin register if `kind` is equal to `triton::engines::symbolic::REG`, `REG_INVALID` otherwise.
           triton::arch::Register originRegister;
 
+          //! The version of the AST, it changes each time the AST is replaced.
+          triton::usize version;
+
+          //! The last version given to an AST, shared by all the expressions.
+          static triton::usize lastVersion;
+
         public:
           //! True if the symbolic expression is tainted.
           bool isTainted;
@@ -75,6 +81,9 @@ namespace triton {
           //! Constructor by copy.
           TRITON_EXPORT SymbolicExpression(const SymbolicExpression& other);
 
+          //! Destructor. Releases the AST, its nodes which are no longer referenced are freed.
+          TRITON_EXPORT ~SymbolicExpression();
+
           //! Operator.
           TRITON_EXPORT SymbolicExpression& operator=(const SymbolicExpression& other);
 
@@ -102,6 +111,12 @@ namespace triton {
           //! Returns the comment of the symbolic expression.
           TRITON_EXPORT const std::string& getComment(void) const;
 
+          //! Returns the version of the AST. It is 0 until setAst() replaces the AST, each replacement gives a new version.
+          TRITON_EXPORT triton::usize getVersion(void) const;
+
+          //! Returns the last version given by setAst() to any expression.
+          TRITON_EXPORT static triton::usize getLastVersion(void);
+
           //! Returns the id as string of the symbolic expression according the mode of the AST representation.
           TRITON_EXPORT std::string getFormattedId(void) const;
 
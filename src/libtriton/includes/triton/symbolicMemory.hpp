@@ -0,0 +1,143 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SYMBOLICMEMORY_H
+#define TRITON_SYMBOLICMEMORY_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      //! \class SymbolicMemory
+      /*! \brief The symbolic memory references.
+       *
+       * \details
+       * An interval map from ranges of addresses to the symbolic expressions holding their bytes.
+       * A store of N bytes is one range referencing its whole expression instead of N byte
+       * expressions. The ranges never overlap: assigning a range clips or splits the ranges it
+       * covers. Each range also records the offset (in bytes, little endian) of its first byte
+       * into the expression, so that a split range still knows which bits of the expression it holds.
+       */
+      class SymbolicMemory {
+        public:
+          //! A range of bytes referencing a symbolic expression.
+          class Range {
+            public:
+              //! The address of the first byte.
+              triton::uint64 address;
+
+              //! The number of bytes.
+              triton::uint64 size;
+
+              //! The symbolic expression id.
+              triton::usize id;
+
+              //! The offset of the first byte into the expression.
+              triton::uint64 offset;
+
+              //! Constructor.
+              Range(triton::uint64 address=0, triton::uint64 size=0, triton::usize id=0, triton::uint64 offset=0)
+                : address(address), size(size), id(id), offset(offset) {}
+          };
+
+        private:
+          /*! \brief The ranges.
+           *
+           * \details
+           * **item1**: address of the first byte<br>
+           * **item2**: range
+           */
+          std::map<triton::uint64, Range> ranges;
+
+          /*! \brief reverse index of `ranges`: symbolic expression -> ranges.
+           *
+           * \details
+           * **item1**: symbolic reference id<br>
+           * **item2**: address of the first byte of the range
+           */
+          std::unordered_multimap<triton::usize, triton::uint64> addresses;
+
+          //! Number of referenced bytes.
+          triton::usize bytes;
+
+          //! Inserts a range which does not overlap any other one.
+          void insert(const Range& range);
+
+          //! Removes a range.
+          std::map<triton::uint64, Range>::iterator remove(std::map<triton::uint64, Range>::iterator it);
+
+          //! Splits the range which contains `address` so that a range starts at `address`.
+          void split(triton::uint64 address);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT SymbolicMemory();
+
+          //! Assigns `size` bytes from `address` to the expression `id`, starting at the byte `offset` of the expression.
+          TRITON_EXPORT void assign(triton::uint64 address, triton::uint64 size, triton::usize id, triton::uint64 offset=0);
+
+          //! Removes the references of `size` bytes from `address`.
+          TRITON_EXPORT void erase(triton::uint64 address, triton::uint64 size);
+
+          //! Removes all references.
+          TRITON_EXPORT void clear(void);
+
+          //! Returns the range which contains `address` clipped to this byte. Returns false if the byte is not referenced.
+          TRITON_EXPORT bool find(triton::uint64 address, Range& range) const;
+
+          //! Returns the ranges which intersect `size` bytes from `address`, clipped to them and in the order of these bytes (an access which wraps around the address space ends with the ranges from address 0).
+          TRITON_EXPORT std::vector<Range> getRanges(triton::uint64 address, triton::uint64 size) const;
+
+          //! Returns the ranges referencing the expression `id`.
+          TRITON_EXPORT std::vector<Range> getExpressionRanges(triton::usize id) const;
+
+          //! Returns all ranges.
+          TRITON_EXPORT const std::map<triton::uint64, Range>& getRanges(void) const;
+
+          //! Returns the number of referenced bytes.
+          TRITON_EXPORT triton::usize size(void) const;
+
+          //! Returns true if no byte is referenced.
+          TRITON_EXPORT bool empty(void) const;
+      };
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SYMBOLICMEMORY_H */
@@ -0,0 +1,235 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SYMBOLICTABLE_H
+#define TRITON_SYMBOLICTABLE_H
+
+#include <utility>
+#include <vector>
+
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      //! The number of bits used to get the index of an id in a chunk of a SymbolicTable.
+      const triton::uint32 SYMBOLIC_TABLE_CHUNK_SHIFT = 12;
+
+      //! The number of ids in a chunk of a SymbolicTable.
+      const triton::usize SYMBOLIC_TABLE_CHUNK_SIZE = (1 << SYMBOLIC_TABLE_CHUNK_SHIFT);
+
+      /*! \class SymbolicTable
+       *  \brief A table of pointers indexed by id.
+       *
+       *  \details
+       *  Symbolic expressions and variables get monotonically increasing ids, so they are stored
+       *  in a vector indexed by id, split into chunks of SYMBOLIC_TABLE_CHUNK_SIZE slots. A removed
+       *  id leaves a tombstone (nullptr) and a chunk is freed once all its slots are tombstones.
+       *  Iterating the table visits the live ids in increasing order, the items behave like the
+       *  ones of a `std::map<usize, T*>` (`first` is the id, `second` the pointer). The table does
+       *  not own the pointers.
+       */
+      template <typename T>
+      class SymbolicTable {
+        private:
+          //! The chunks of slots. A freed chunk is an empty vector.
+          std::vector<std::vector<T*>> chunks;
+
+          //! Number of live slots per chunk.
+          std::vector<triton::usize> counts;
+
+          //! Number of live slots.
+          triton::usize count;
+
+        public:
+          //! Iterates over the live ids in increasing order.
+          class const_iterator {
+            private:
+              //! The table.
+              const SymbolicTable* table;
+
+              //! The current item (id, pointer).
+              std::pair<triton::usize, T*> item;
+
+              //! Moves to the first live id from `id`.
+              void seek(triton::usize id) {
+                triton::usize limit = this->table->chunks.size() << SYMBOLIC_TABLE_CHUNK_SHIFT;
+
+                while (id < limit) {
+                  const std::vector<T*>& chunk = this->table->chunks[id >> SYMBOLIC_TABLE_CHUNK_SHIFT];
+                  /* Skip the freed chunks */
+                  if (chunk.empty()) {
+                    id = ((id >> SYMBOLIC_TABLE_CHUNK_SHIFT) + 1) << SYMBOLIC_TABLE_CHUNK_SHIFT;
+                    continue;
+                  }
+                  if (chunk[id & (SYMBOLIC_TABLE_CHUNK_SIZE - 1)] != nullptr)
+                    break;
+                  id++;
+                }
+
+                this->item.first  = id;
+                this->item.second = (id < limit) ? this->table->get(id) : nullptr;
+              }
+
+            public:
+              //! Constructor.
+              const_iterator(const SymbolicTable* table, triton::usize id)
+                : table(table) {
+                this->seek(id);
+              }
+
+              //! Returns the current item.
+              const std::pair<triton::usize, T*>& operator*(void) const {
+                return this->item;
+              }
+
+              //! Returns the current item.
+              const std::pair<triton::usize, T*>* operator->(void) const {
+                return &this->item;
+              }
+
+              //! Moves to the next live id.
+              const_iterator& operator++(void) {
+                this->seek(this->item.first + 1);
+                return *this;
+              }
+
+              //! Moves to the next live id.
+              const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                this->seek(this->item.first + 1);
+                return tmp;
+              }
+
+              //! Returns true if both iterators are on the same id.
+              bool operator==(const const_iterator& other) const {
+                return this->item.first == other.item.first;
+              }
+
+              //! Returns true if the iterators are on different ids.
+              bool operator!=(const const_iterator& other) const {
+                return this->item.first != other.item.first;
+              }
+          };
+
+          //! Constructor.
+          SymbolicTable()
+            : count(0) {
+          }
+
+          //! Returns the pointer of an id, nullptr if the id is not in the table.
+          T* get(triton::usize id) const {
+            triton::usize index = id >> SYMBOLIC_TABLE_CHUNK_SHIFT;
+
+            if (index >= this->chunks.size() || this->chunks[index].empty())
+              return nullptr;
+
+            return this->chunks[index][id & (SYMBOLIC_TABLE_CHUNK_SIZE - 1)];
+          }
+
+          //! Sets the pointer of an id. `ptr` must not be nullptr.
+          void set(triton::usize id, T* ptr) {
+            triton::usize index = id >> SYMBOLIC_TABLE_CHUNK_SHIFT;
+
+            if (index >= this->chunks.size()) {
+              this->chunks.resize(index + 1);
+              this->counts.resize(index + 1, 0);
+            }
+
+            if (this->chunks[index].empty())
+              this->chunks[index].resize(SYMBOLIC_TABLE_CHUNK_SIZE, nullptr);
+
+            T*& slot = this->chunks[index][id & (SYMBOLIC_TABLE_CHUNK_SIZE - 1)];
+            if (slot == nullptr) {
+              this->counts[index]++;
+              this->count++;
+            }
+            slot = ptr;
+          }
+
+          //! Removes an id. Returns false if the id is not in the table.
+          bool erase(triton::usize id) {
+            triton::usize index = id >> SYMBOLIC_TABLE_CHUNK_SHIFT;
+
+            if (this->get(id) == nullptr)
+              return false;
+
+            this->chunks[index][id & (SYMBOLIC_TABLE_CHUNK_SIZE - 1)] = nullptr;
+            this->count--;
+
+            /* Free the chunk once all its slots are tombstones */
+            if (--this->counts[index] == 0)
+              std::vector<T*>().swap(this->chunks[index]);
+
+            return true;
+          }
+
+          //! Removes all ids.
+          void clear(void) {
+            this->chunks.clear();
+            this->counts.clear();
+            this->count = 0;
+          }
+
+          //! Returns an iterator on the id, end() if the id is not in the table.
+          const_iterator find(triton::usize id) const {
+            if (this->get(id) == nullptr)
+              return this->end();
+            return const_iterator(this, id);
+          }
+
+          //! Returns an iterator on the lowest id.
+          const_iterator begin(void) const {
+            return const_iterator(this, 0);
+          }
+
+          //! Returns the iterator past the highest id.
+          const_iterator end(void) const {
+            return const_iterator(this, this->chunks.size() << SYMBOLIC_TABLE_CHUNK_SHIFT);
+          }
+
+          //! Returns the number of ids.
+          triton::usize size(void) const {
+            return this->count;
+          }
+
+          //! Returns true if the table is empty.
+          bool empty(void) const {
+            return this->count == 0;
+          }
+      };
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SYMBOLICTABLE_H */
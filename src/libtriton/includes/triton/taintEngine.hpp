@@ -9,11 +9,17 @@
 #define TRITON_TAINTENGINE_H
 
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <triton/dllexport.hpp>
+#include <triton/instruction.hpp>
 #include <triton/memoryAccess.hpp>
 #include <triton/register.hpp>
+#include <triton/shadowMemory.hpp>
 #include <triton/symbolicEngine.hpp>
+#include <triton/taintLabels.hpp>
+#include <triton/taintSummary.hpp>
 #include <triton/tritonTypes.hpp>
 
 
@@ -47,6 +53,9 @@ namespace triton {
       //! Defines an untainted item.
       const bool UNTAINTED = !TAINTED;
 
+      //! The maximum number of bytes of a parent register tracked by the taint engine.
+      const triton::uint32 TAINT_REGISTER_BYTES = 64;
+
       /*! \class TaintEngine
           \brief The taint engine class. */
       class TaintEngine {
@@ -54,10 +63,7 @@ namespace triton {
           //! Symbolic Engine API
           triton::engines::symbolic::SymbolicEngine* symbolicEngine;
 
-          //! Cpu use for this taint
-          //
-          // note: Not really use for now but will be usefull to have a bits
-          // precision on registers tainting
+          //! Cpu use for this taint (registers and concrete values).
           //
           // FIXME: We should make sure it is the same as the one in symbolicEngine
           const triton::arch::CpuInterface& cpu;
@@ -66,11 +72,39 @@ namespace triton {
           //! Defines if the taint engine is enabled or disabled.
           bool enableFlag;
 
-          //! The set of tainted addresses.
-          std::set<triton::uint64> taintedMemory;
+          //! The shadow memory (one bit per tainted byte).
+          triton::engines::taint::ShadowMemory taintedMemory;
+
+          /*! \brief The tainted bytes of the registers, indexed by parent register id.
+           *
+           * \details
+           * One bit per byte of the parent register (the least significant bit being the lowest
+           * byte), a flag uses the bit 0. A sub-register only reads and writes its own bytes.
+           */
+          std::vector<triton::uint64> taintedRegisters;
+
+          //! The interned label sets.
+          mutable triton::engines::taint::TaintLabels labels;
+
+          //! True once a label has been introduced, the labels are not tracked before.
+          bool labelFlag;
+
+          //! True while the labels read by an instruction are collected.
+          bool collectFlag;
+
+          //! The union of the labels read by the current instruction.
+          mutable triton::uint32 readLabels;
 
-          //! The set of tainted registers. Currently it is an over approximation of the taint.
-          std::set<triton::arch::registers_e> taintedRegisters;
+          /*! \brief The label sets of the memory bytes, by page.
+           *
+           * \details
+           * **item1**: address >> SHADOW_PAGE_SHIFT<br>
+           * **item2**: the label set id of each byte of the page
+           */
+          std::unordered_map<triton::uint64, std::vector<triton::uint32>> memoryLabels;
+
+          //! The label sets of the register bytes, TAINT_REGISTER_BYTES ids per parent register. Empty until a label is introduced.
+          std::vector<triton::uint32> registerLabels;
 
         public:
           //! Constructor.
@@ -85,8 +119,8 @@ namespace triton {
           //! Enables or disables the taint engine.
           TRITON_EXPORT void enable(bool flag);
 
-          //! Returns the tainted addresses.
-          TRITON_EXPORT const std::set<triton::uint64>& getTaintedMemory(void) const;
+          //! Returns the tainted addresses. The set is built from the shadow memory at each call.
+          TRITON_EXPORT std::set<triton::uint64> getTaintedMemory(void) const;
 
           //! Returns the tainted registers.
           TRITON_EXPORT std::set<const triton::arch::Register*> getTaintedRegisters(void) const;
@@ -175,10 +209,70 @@ namespace triton {
           //! Taints RegisterRegister with assignment. Returns true if the regDst is tainted.
           TRITON_EXPORT bool taintAssignmentRegisterRegister(const triton::arch::Register& regDst, const triton::arch::Register& regSrc);
 
+          //! Taints a memory with a label. The label is added to the labels of each byte.
+          TRITON_EXPORT bool taintMemoryWithLabel(const triton::arch::MemoryAccess& mem, triton::uint32 label);
+
+          //! Taints a register with a label. The label is added to the labels of each byte.
+          TRITON_EXPORT bool taintRegisterWithLabel(const triton::arch::Register& reg, triton::uint32 label);
+
+          //! Returns the labels of a memory (the union of the labels of its bytes).
+          TRITON_EXPORT std::set<triton::uint32> getMemoryTaintLabels(const triton::arch::MemoryAccess& mem) const;
+
+          //! Returns the labels of a register (the union of the labels of its bytes).
+          TRITON_EXPORT std::set<triton::uint32> getRegisterTaintLabels(const triton::arch::Register& reg) const;
+
+          //! Starts (true) or stops (false) collecting the labels read by an instruction. The operands tainted by a flag take the collected labels.
+          TRITON_EXPORT void collectLabels(bool flag);
+
+          //! Spreads the taint of an instruction from the summary of its opcode and its decoded operands, and records its accesses (without AST). Returns true if the instruction is tainted.
+          TRITON_EXPORT bool spreadTaint(const triton::engines::taint::TaintSummary& summary, triton::arch::Instruction& inst);
+
         private:
           //! Copies a TaintEngine.
           void copy(const TaintEngine& other);
 
+          //! Writes the taint of a register as an instruction does (a 32-bit or wider register clears the upper bytes of its parent).
+          void writeRegister(const triton::arch::Register& reg, bool flag, triton::uint32 label);
+
+          //! Writes the taint of the bytes [addr, addr+size).
+          void writeMemory(triton::uint64 addr, triton::uint32 size, bool flag, triton::uint32 label);
+
+          //! Returns the labels taken by an operand tainted by a flag.
+          triton::uint32 getCollectedLabels(void) const;
+
+          //! Returns the label set id of a register and adds it to the collected labels.
+          triton::uint32 getRegisterLabels(const triton::arch::Register& reg) const;
+
+          //! Returns the label set id of the bytes [addr, addr+size) and adds it to the collected labels.
+          triton::uint32 getMemoryLabels(triton::uint64 addr, triton::uint32 size) const;
+
+          //! Sets (or adds when `merge` is true) the label set id of the bytes of a register.
+          void setRegisterLabels(const triton::arch::Register& reg, triton::uint32 label, bool merge);
+
+          //! Sets (or adds when `merge` is true) the label set id of the bytes [addr, addr+size).
+          void setMemoryLabels(triton::uint64 addr, triton::uint32 size, triton::uint32 label, bool merge);
+
+          //! Copies the label set ids of the bytes [src, src+size) to [dst, dst+size), merging them with the destination when `merge` is true.
+          void copyMemoryLabels(triton::uint64 dst, triton::uint64 src, triton::uint32 size, bool merge);
+
+          //! Starts tracking the labels.
+          void initLabels(void);
+
+          //! Initializes the address of a memory access from the concrete values of its registers.
+          void initMemoryAddress(triton::arch::MemoryAccess& mem) const;
+
+          //! Returns true if one of the flags is tainted.
+          bool isFlagTainted(const std::vector<triton::arch::registers_e>& flags) const;
+
+          //! Sets the taint of an operand written by a summary.
+          void setOperandTaint(const triton::arch::OperandWrapper& op, bool flag);
+
+          //! Sets the taint of the symbolic expressions referenced by a memory access.
+          void taintMemoryExpressions(const triton::arch::MemoryAccess& mem, bool flag);
+
+          //! Sets the taint of the symbolic expressions referenced by a memory access from the taint of their bytes.
+          void taintMemoryExpressions(const triton::arch::MemoryAccess& mem);
+
           //! Spreads MemoryImmediate with union.
           bool unionMemoryImmediate(const triton::arch::MemoryAccess& memDst);
 
@@ -0,0 +1,104 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_TAINTLABELS_H
+#define TRITON_TAINTLABELS_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Taint namespace
+    namespace taint {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup taint
+     *  @{
+     */
+
+      //! The id of the empty label set.
+      const triton::uint32 EMPTY_LABEL_SET = 0;
+
+      /*! \class TaintLabels
+       *  \brief The table of the taint label sets.
+       *
+       *  \details
+       *  A label set is interned once and referenced by its id, so that a tainted byte only
+       *  holds a 32-bit id. Two equal sets always have the same id, and the union of two sets
+       *  is memoized: spreading the taint of a byte to another one is a table lookup.
+       */
+      class TaintLabels {
+        private:
+          //! Hashes a label set.
+          struct SetHash {
+            triton::usize operator()(const std::vector<triton::uint32>& labels) const;
+          };
+
+          //! The label sets indexed by id (sorted, without duplicates). The id 0 is the empty set.
+          std::vector<std::vector<triton::uint32>> sets;
+
+          //! map of label set -> id
+          std::unordered_map<std::vector<triton::uint32>, triton::uint32, SetHash> ids;
+
+          /*! \brief map of (id1, id2) -> id of the union
+           *
+           * \details
+           * **item1**: (smallest id << 32) | largest id<br>
+           * **item2**: id of the union
+           */
+          std::unordered_map<triton::uint64, triton::uint32> unions;
+
+          //! Returns the id of a sorted label set, the set is added if it does not exist.
+          triton::uint32 intern(const std::vector<triton::uint32>& labels);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT TaintLabels();
+
+          //! Returns the id of the set which only contains `label`.
+          TRITON_EXPORT triton::uint32 getSingleton(triton::uint32 label);
+
+          //! Returns the id of the union of two sets.
+          TRITON_EXPORT triton::uint32 getUnion(triton::uint32 id1, triton::uint32 id2);
+
+          //! Returns the labels of a set.
+          TRITON_EXPORT const std::vector<triton::uint32>& getLabels(triton::uint32 id) const;
+
+          //! Returns the number of interned sets.
+          TRITON_EXPORT triton::usize size(void) const;
+
+          //! Removes all the sets.
+          TRITON_EXPORT void clear(void);
+      };
+
+    /*! @} End of taint namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TAINTLABELS_H */
@@ -0,0 +1,105 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_TAINTSUMMARY_H
+#define TRITON_TAINTSUMMARY_H
+
+#include <vector>
+
+#include <triton/registers_e.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Taint namespace
+    namespace taint {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup taint
+     *  @{
+     */
+
+      //! The effects of an instruction on the taint of its operands. The destination is the first operand.
+      enum summary_e {
+        SUMMARY_INVALID = 0,  //!< No summary, the taint is spread by the semantics.
+        SUMMARY_NONE,         //!< The operands are only read (`cmp`, `test`, `nop`).
+        SUMMARY_ASSIGN,       //!< The destination takes the taint of the other operands (`mov`, `movzx`).
+        SUMMARY_UNION,        //!< The destination is merged with the taint of the other operands (`add`, `and`, `shl`).
+        SUMMARY_CLEAR,        //!< The destination is untainted.
+        SUMMARY_XCHG,         //!< The destination and the source swap their taint.
+        SUMMARY_LEA,          //!< The destination takes the taint of the base and index registers of the source.
+        SUMMARY_PUSH,         //!< The stack slot below the stack pointer takes the taint of the operand.
+        SUMMARY_POP,          //!< The destination takes the taint of the stack slot at the stack pointer.
+        SUMMARY_BRANCH,       //!< The program counter takes the taint of the operand.
+        SUMMARY_CALL,         //!< The return address is pushed untainted, the program counter takes the taint of the operand.
+        SUMMARY_RET,          //!< The program counter takes the taint of the stack slot at the stack pointer.
+      };
+
+
+      /*! \class TaintSummary
+       *  \brief The taint summary of an opcode.
+       *
+       *  \details
+       *  A summary describes how an opcode spreads the taint from its decoded operands, so that
+       *  the taint engine can process an instruction without building its semantics. The read
+       *  flags are merged into the destination (or into the program counter for a branch). The
+       *  written flags take the taint of the destination, or of the operands if the instruction
+       *  has no destination, and the cleared flags are untainted.
+       */
+      class TaintSummary {
+        public:
+          //! The effect on the operands.
+          summary_e effect;
+
+          //! The flags read by the instruction.
+          std::vector<triton::arch::registers_e> readFlags;
+
+          //! The flags written from the result.
+          std::vector<triton::arch::registers_e> writtenFlags;
+
+          //! The flags set to a constant.
+          std::vector<triton::arch::registers_e> clearedFlags;
+
+          //! True if the destination is untainted when the last two operands are the same register (`xor eax, eax`).
+          bool zeroIdiom;
+
+          //! The minimum number of operands. An instruction with fewer operands (`imul rcx`) is processed by the semantics.
+          triton::uint32 minOperands;
+
+          //! Constructor.
+          TaintSummary(summary_e effect=SUMMARY_INVALID, triton::uint32 minOperands=0)
+            : effect(effect), zeroIdiom(false), minOperands(minOperands) {}
+
+          //! Returns true if the summary can be applied to an instruction with `operands` operands.
+          bool isValid(triton::usize operands) const {
+            return this->effect != SUMMARY_INVALID && operands >= this->minOperands;
+          }
+      };
+
+    /*! @} End of taint namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TAINTSUMMARY_H */
@@ -0,0 +1,69 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_TRACERECORD_H
+#define TRITON_TRACERECORD_H
+
+#include <utility>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/instruction.hpp>
+#include <triton/register.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    /*! \class TraceRecord
+     *  \brief A recorded instruction of a trace and the concrete values set before its processing.
+     *
+     *  \details
+     *  The concrete values are the deltas of the context recorded by a tracer (e.g. the value of a
+     *  register after a syscall or the bytes written by the kernel). See triton::API::processBlock().
+     */
+    class TraceRecord {
+      public:
+        //! The instruction (address and opcode).
+        triton::arch::Instruction instruction;
+
+        //! The concrete values of the registers, set before processing the instruction.
+        std::vector<std::pair<triton::arch::Register, triton::uint512>> registers;
+
+        //! The concrete memory areas (base address and bytes), set before processing the instruction.
+        std::vector<std::pair<triton::uint64, std::vector<triton::uint8>>> memory;
+
+        //! True if the callback of the block is called once the instruction is processed.
+        bool callback;
+
+        //! Constructor.
+        TRITON_EXPORT TraceRecord();
+
+        //! Constructor.
+        TRITON_EXPORT TraceRecord(triton::uint64 address, const triton::uint8* opcode, triton::uint32 opSize);
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TRACERECORD_H */
@@ -8,6 +8,9 @@
 #ifndef TRITON_TRITONTOZ3AST_H
 #define TRITON_TRITONTOZ3AST_H
 
+#include <unordered_map>
+#include <vector>
+
 #include <z3++.h>
 
 #include <triton/ast.hpp>
@@ -32,6 +35,9 @@ namespace triton {
    *  @{
    */
 
+    //! The number of translations a cache of TritonToZ3Ast holds before it is cleared.
+    const triton::usize MAX_TRANSLATION_CACHE_SIZE = 1000000;
+
     //! \class TritonToZ3Ast
     /*! \brief Converts a Triton's AST to Z3's AST. */
     class TritonToZ3Ast {
@@ -42,9 +48,21 @@ namespace triton {
         //! This flag define if the conversion is used to evaluated a node or not.
         bool isEval;
 
+        //! This flag defines if the translations are kept from one conversion to another.
+        bool isCached;
+
         //! The map of symbols. E.g: (let (symbols expr1) expr2)
         std::map<std::string, triton::ast::AbstractNode*> symbols;
 
+        //! The cache of translations. The nodes are retained as long as they are in the cache. Nodes under a let or above a reference are not cached.
+        std::unordered_map<triton::ast::AbstractNode*, z3::expr> cache;
+
+        //! Fills `operands` with the nodes whose translations are needed to translate `node`.
+        void getOperands(triton::ast::AbstractNode* node, std::vector<triton::ast::AbstractNode*>& operands) const;
+
+        //! Translates a node from the translations of its operands (see getOperands()).
+        z3::expr translate(triton::ast::AbstractNode* node, const std::vector<z3::expr>& ops);
+
         //! Returns the integer of the z3 expression (expr must be an int).
         triton::__uint getUintValue(const z3::expr& expr);
 
@@ -56,11 +74,32 @@ namespace triton {
         z3::context context;
 
       public:
-        //! Constructor.
-        TRITON_EXPORT TritonToZ3Ast(triton::engines::symbolic::SymbolicEngine* symbolicEngine, bool eval=true);
-
-        //! Converts to Z3's AST
+        /*!
+         * \brief Constructor.
+         *
+         * \details
+         * If `cache` is true, the translation of each node is kept until clearCache() and reused by the
+         * next conversions. The cached nodes are retained, they must not be freed explicitly meanwhile.
+         * The translations which go through a reference node are not kept, the AST of its expression
+         * may be replaced between two conversions. The cache is cleared once it holds
+         * MAX_TRANSLATION_CACHE_SIZE translations.
+         */
+        TRITON_EXPORT TritonToZ3Ast(triton::engines::symbolic::SymbolicEngine* symbolicEngine, bool eval=true, bool cache=false);
+
+        //! Destructor.
+        TRITON_EXPORT ~TritonToZ3Ast();
+
+        //! Converts to Z3's AST. Each node of the DAG is translated once.
         TRITON_EXPORT z3::expr convert(triton::ast::AbstractNode* node);
+
+        //! Clears the cache of translations and releases the cached nodes.
+        TRITON_EXPORT void clearCache(void);
+
+        //! Returns the number of cached translations.
+        TRITON_EXPORT triton::usize getCacheSize(void) const;
+
+        //! Returns the z3's context.
+        TRITON_EXPORT z3::context& getContext(void);
     };
 
   /*! @} End of ast namespace */
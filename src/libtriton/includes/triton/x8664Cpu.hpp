@@ -15,8 +15,10 @@
 #include <triton/callbacks.hpp>
 #include <triton/cpuInterface.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/externalLibs.hpp>
 #include <triton/instruction.hpp>
 #include <triton/memoryAccess.hpp>
+#include <triton/pagedMemory.hpp>
 #include <triton/register.hpp>
 #include <triton/tritonTypes.hpp>
 #include <triton/x86Specifications.hpp>
@@ -56,17 +58,21 @@ namespace triton {
           //! Callbacks API
           triton::callbacks::Callbacks* callbacks;
 
+          //! Capstone context, opened once per CPU instance and reused by each disassembly.
+          triton::extlibs::capstone::csh handle;
+
           //! Copies a x8664Cpu class.
           void copy(const x8664Cpu& other);
 
+          //! Opens and initializes the Capstone context.
+          void openDisassembler(void);
+
+          //! Closes the Capstone context.
+          void closeDisassembler(void);
+
         protected:
-          /*! \brief map of address -> concrete value
-           *
-           * \details
-           * **item1**: memory address<br>
-           * **item2**: concrete value
-           */
-          std::map<triton::uint64, triton::uint8> memory;
+          //! The concrete memory, split into pages allocated on demand.
+          triton::arch::PagedMemory memory;
 
           //! Concrete value of rax
           triton::uint8 rax[QWORD_SIZE];
@@ -0,0 +1,56 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_X86TAINTSUMMARIES_H
+#define TRITON_X86TAINTSUMMARIES_H
+
+#include <triton/dllexport.hpp>
+#include <triton/taintSummary.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    //! The x86 namespace
+    namespace x86 {
+    /*!
+     *  \ingroup arch
+     *  \addtogroup x86
+     *  @{
+     */
+
+      /*! \brief Returns the taint summary of an x86 opcode (triton::arch::x86::instructions_e).
+       *
+       *  \details
+       *  The table is built at the first call. The opcodes which use implicit operands
+       *  that are not part of the summaries (`mul`, `div`, string instructions...) have an
+       *  invalid summary and must be processed by the semantics.
+       */
+      TRITON_EXPORT const triton::engines::taint::TaintSummary& getTaintSummary(triton::uint32 type);
+
+    /*! @} End of x86 namespace */
+    };
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_X86TAINTSUMMARIES_H */
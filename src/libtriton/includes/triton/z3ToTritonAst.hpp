@@ -8,6 +8,8 @@
 #ifndef TRITON_Z3TOTRITONAST_H
 #define TRITON_Z3TOTRITONAST_H
 
+#include <vector>
+
 #include <z3++.h>
 
 #include <triton/ast.hpp>
@@ -42,11 +44,14 @@ namespace triton {
         //! The Triton's AST context
         triton::ast::AstContext& astCtxt;
 
+        //! Translates an application from the translations of its arguments.
+        triton::ast::AbstractNode* translate(const z3::expr& expr, const std::vector<triton::ast::AbstractNode*>& args);
+
       public:
         //! Constructor.
         TRITON_EXPORT Z3ToTritonAst(triton::engines::symbolic::SymbolicEngine* symbolicEngine, triton::ast::AstContext& ctxt);
 
-        //! Converts to Triton's AST
+        //! Converts to Triton's AST. Each node of the DAG is translated once.
         TRITON_EXPORT triton::ast::AbstractNode* convert(const z3::expr& expr);
     };
 
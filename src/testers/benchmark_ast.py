@@ -0,0 +1,103 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Measures the AST node creation throughput with and without the
+## AST_DICTIONARIES mode. Every expression is built twice.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_ast.py [number of nodes]
+##  [dictionaries off] <n> nodes in <t>s (<n/t> nodes/s)
+##  [dictionaries on ] <n> nodes in <t>s (<n/t> nodes/s)
+##  [dictionaries on ] table size: <s>, load factor: <l>%, probes/lookup: <p>, max probe length: <m>
+##  [  8 bits] <n> nodes in <t>s (<n/t> nodes/s)
+##  ...
+##  [256 bits] <n> nodes in <t>s (<n/t> nodes/s)
+##
+## Each run also reports the arena counters (allocations per second and
+## memory held by the live nodes and the slabs). The last runs build the
+## same expressions on 8, 32, 64, 128 and 256-bit operands: nodes up to
+## 64 bits are evaluated with native integers, wider ones with uint512.
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, MODE
+
+
+NODES = 1000000
+SIZES = [8, 32, 64, 128, 256]
+
+
+def run(name, dictionaries):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableMode(MODE.AST_DICTIONARIES, dictionaries)
+    ast = ctx.getAstContext()
+
+    # Each iteration creates 14 nodes (3 bv and their decimals, bvadd, bvxor, extract and its decimals)
+    count = 0
+    start = time.time()
+    for i in xrange(NODES / 14):
+        value = i % max(NODES / 28, 1)
+        node  = ast.bvadd(ast.bv(value, 64), ast.bv(1, 64))
+        node  = ast.bvxor(node, ast.bv(0xff, 64))
+        node  = ast.extract(31, 0, node)
+        count += 14
+    elapsed = time.time() - start
+    print '[%s] %d nodes in %.2fs (%d nodes/s)' %(name, count, elapsed, count / elapsed)
+
+    arena = ctx.getAstArenaStats()
+    print '[%s] %d allocations (%d/s), live: %d bytes, slabs: %d bytes' %(
+        name,
+        arena['allocations'],
+        arena['allocations'] / elapsed,
+        arena['liveBytes'],
+        arena['slabBytes']
+    )
+
+    if dictionaries:
+        stats = ctx.getAstDictionariesStats()
+        print '[%s] table size: %d, load factor: %d%%, probes/lookup: %.2f, max probe length: %d' %(
+            name,
+            stats['tableSize'],
+            stats['loadFactor'],
+            float(stats['probes']) / max(stats['lookups'], 1),
+            stats['maxProbeLength']
+        )
+    return
+
+
+def runSize(size):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ast  = ctx.getAstContext()
+    mask = (1 << size) - 1
+    x    = ast.bv(0x0123456789abcdef & mask, size)
+    y    = ast.bv(0xfedcba9876543210 & mask, size)
+
+    # Each iteration creates 15 nodes (bvadd, bvxor, bvmul, bvlshr and a bv with its decimals, bvult, ite and 2 extracts with their decimals)
+    count = 0
+    start = time.time()
+    for i in xrange(NODES / 15):
+        node = ast.bvmul(ast.bvxor(ast.bvadd(x, y), y), x)
+        node = ast.bvlshr(node, ast.bv(3, size))
+        node = ast.ite(ast.bvult(node, x), ast.extract(size - 1, 0, node), ast.extract(size - 1, 0, x))
+        count += 15
+    elapsed = time.time() - start
+    print '[%3d bits] %d nodes in %.2fs (%d nodes/s)' %(size, count, elapsed, count / elapsed)
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        NODES = int(sys.argv[1])
+
+    run('dictionaries off', False)
+    run('dictionaries on ', True)
+
+    for size in SIZES:
+        runSize(size)
+
+    sys.exit(0)
@@ -0,0 +1,78 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Processes the .text section of the IR test suite (linear sweep) with the
+## AST_DICTIONARIES mode and reports how many nodes were allocated and how
+## many were found in the dictionaries before being allocated.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_ast_ir.py [binary] [passes]
+##  [ir] <n> instructions processed in <t>s (<n/t> inst/s)
+##  [ir] allocated nodes: <a>, reused nodes: <h>, unique nodes: <u>
+##
+
+import os
+import struct
+import sys
+import time
+
+from triton import TritonContext, ARCH, MODE, Instruction
+
+
+BINARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'samples', 'ir_test_suite', 'ir')
+PASSES = 1
+
+
+def getTextSection(path):
+    data = open(path, 'rb').read()
+    shoff = struct.unpack_from('<Q', data, 0x28)[0]
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x3a)
+
+    sections = [struct.unpack_from('<IIQQQQIIQQ', data, shoff + (i * shentsize)) for i in range(shnum)]
+    strtab = sections[shstrndx][4]
+
+    for (name, _, _, addr, offset, size, _, _, _, _) in sections:
+        if data[strtab + name:].split('\0')[0] == '.text':
+            return addr, data[offset:offset + size]
+
+    raise Exception('No .text section found')
+
+
+def run(addr, code):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableMode(MODE.AST_DICTIONARIES, True)
+
+    count = 0
+    start = time.time()
+    for _ in xrange(PASSES):
+        pc = 0
+        while pc < len(code):
+            inst = Instruction()
+            inst.setOpcode(code[pc:pc+16])
+            inst.setAddress(addr + pc)
+            try:
+                ctx.processing(inst)
+                pc += max(inst.getSize(), 1)
+                count += 1
+            except Exception:
+                pc += 1
+    elapsed = time.time() - start
+
+    stats = ctx.getAstDictionariesStats()
+    print '[ir] %d instructions processed in %.2fs (%d inst/s)' %(count, elapsed, count / elapsed)
+    print '[ir] allocated nodes: %d, reused nodes: %d, unique nodes: %d' %(stats['allocatedNodes'], stats['hits'], stats['allocatedDictionaries'])
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        BINARY = sys.argv[1]
+    if len(sys.argv) > 2:
+        PASSES = int(sys.argv[2])
+
+    addr, code = getTextSection(BINARY)
+    run(addr, code)
+
+    sys.exit(0)
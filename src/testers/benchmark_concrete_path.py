@@ -0,0 +1,81 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Processes the .text section of the IR test suite (linear sweep) with the
+## ONLY_ON_SYMBOLIZED mode, where almost all instructions are concrete, and
+## reports the throughput and the number of nodes allocated per instruction.
+## Run it before and after a change of the IR builder to compare them.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_concrete_path.py [binary] [passes]
+##  [concrete] <n> instructions processed in <t>s (<n/t> inst/s), <a> nodes/inst
+##
+
+import os
+import struct
+import sys
+import time
+
+from triton import TritonContext, ARCH, MODE, Instruction
+
+
+BINARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'samples', 'ir_test_suite', 'ir')
+PASSES = 1
+
+
+def getTextSection(path):
+    data = open(path, 'rb').read()
+    shoff = struct.unpack_from('<Q', data, 0x28)[0]
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x3a)
+
+    sections = [struct.unpack_from('<IIQQQQIIQQ', data, shoff + (i * shentsize)) for i in range(shnum)]
+    strtab = sections[shstrndx][4]
+
+    for (name, _, _, addr, offset, size, _, _, _, _) in sections:
+        if data[strtab + name:].split('\0')[0] == '.text':
+            return addr, data[offset:offset + size]
+
+    raise Exception('No .text section found')
+
+
+def run(addr, code):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+
+    # Keep one symbolic register so that the engine is not trivially empty
+    ctx.convertRegisterToSymbolicVariable(ctx.registers.r15)
+
+    before = ctx.getAstArenaStats()['allocations']
+    count  = 0
+    start  = time.time()
+    for _ in xrange(PASSES):
+        pc = 0
+        while pc < len(code):
+            inst = Instruction()
+            inst.setOpcode(code[pc:pc+16])
+            inst.setAddress(addr + pc)
+            try:
+                ctx.processing(inst)
+                pc += max(inst.getSize(), 1)
+                count += 1
+            except Exception:
+                pc += 1
+    elapsed = time.time() - start
+
+    nodes = ctx.getAstArenaStats()['allocations'] - before
+    print '[concrete] %d instructions processed in %.2fs (%d inst/s), %.1f nodes/inst' %(count, elapsed, count / elapsed, float(nodes) / count)
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        BINARY = sys.argv[1]
+    if len(sys.argv) > 2:
+        PASSES = int(sys.argv[2])
+
+    addr, code = getTextSection(BINARY)
+    run(addr, code)
+
+    sys.exit(0)
@@ -0,0 +1,111 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Compares the disassembly throughput (instructions per second) of the
+## x86 and x86-64 CPUs between two builds of Triton, e.g. one built before
+## the Capstone handle is cached per CPU and one built after. Each build is
+## measured in its own process, with the directory of its triton.so first
+## in PYTHONPATH.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_disassembly.py <before-dir> <after-dir> [iterations]
+##  [x86-64] disassembly : before <n/t> inst/s, after <n/t> inst/s (x<speedup>)
+##  [x86-64] processing  : before <n/t> inst/s, after <n/t> inst/s (x<speedup>)
+##  [x86   ] disassembly : ...
+##
+
+import os
+import subprocess
+import sys
+import time
+
+
+code = {
+    'x86-64': [
+        "\x48\x8b\x05\xb8\x13\x00\x00", # mov     rax, QWORD PTR [rip+0x13b8]
+        "\x48\x8d\x34\xc3",             # lea     rsi, [rbx+rax*8]
+        "\x67\x48\x8D\x74\xC3\x0A",     # lea     rsi, [ebx+eax*8+0xa]
+        "\x66\x0F\xD7\xD1",             # pmovmskb edx, xmm1
+        "\x89\xd0",                     # mov     eax, edx
+        "\x80\xf4\x99",                 # xor     ah, 0x99
+        "\x48\x31\xc0",                 # xor     rax, rax
+        "\x48\x01\xd8",                 # add     rax, rbx
+        "\x0f\xaf\xca",                 # imul    ecx, edx
+        "\x48\xff\xc1",                 # inc     rcx
+        "\x74\x10",                     # je      0x12
+        "\xc3",                         # ret
+    ],
+    'x86': [
+        "\x8b\x05\xb8\x13\x00\x00",     # mov     eax, DWORD PTR [0x13b8]
+        "\x8d\x34\xc3",                 # lea     esi, [ebx+eax*8]
+        "\x66\x0F\xD7\xD1",             # pmovmskb edx, xmm1
+        "\x89\xd0",                     # mov     eax, edx
+        "\x80\xf4\x99",                 # xor     ah, 0x99
+        "\x31\xc0",                     # xor     eax, eax
+        "\x01\xd8",                     # add     eax, ebx
+        "\x0f\xaf\xca",                 # imul    ecx, edx
+        "\x41",                         # inc     ecx
+        "\x74\x10",                     # je      0x12
+        "\xc3",                         # ret
+    ],
+}
+
+ITERATIONS = 100000
+
+
+def bench(name, method):
+    from triton import TritonContext, ARCH, Instruction
+
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64 if name == 'x86-64' else ARCH.X86)
+
+    insts = list()
+    for opcode in code[name]:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        inst.setAddress(0x400000)
+        insts.append(inst)
+
+    func  = getattr(ctx, method)
+    count = ITERATIONS * len(insts)
+    start = time.time()
+    for _ in xrange(ITERATIONS):
+        for inst in insts:
+            func(inst)
+    elapsed = time.time() - start
+
+    return count / elapsed
+
+
+def run(directory):
+    env = dict(os.environ)
+    env['PYTHONPATH'] = os.pathsep.join([directory, env.get('PYTHONPATH', '')])
+    output = subprocess.check_output([sys.executable, __file__, '--run', str(ITERATIONS)], env=env)
+    return [float(line) for line in output.split()]
+
+
+if __name__ == '__main__':
+    benches = [(name, method) for name in ['x86-64', 'x86'] for method in ['disassembly', 'processing']]
+
+    # Child process: measures the build found first in PYTHONPATH
+    if len(sys.argv) == 3 and sys.argv[1] == '--run':
+        ITERATIONS = int(sys.argv[2])
+        for name, method in benches:
+            print '%f' %(bench(name, method))
+        sys.exit(0)
+
+    if len(sys.argv) < 3:
+        print 'Usage: %s <before-dir> <after-dir> [iterations]' %(sys.argv[0])
+        sys.exit(1)
+
+    if len(sys.argv) > 3:
+        ITERATIONS = int(sys.argv[3])
+
+    before = run(sys.argv[1])
+    after  = run(sys.argv[2])
+
+    for (name, method), b, a in zip(benches, before, after):
+        print '[%-6s] %-12s: before %d inst/s, after %d inst/s (x%.2f)' %(name, method, b, a, a / b)
+
+    sys.exit(0)
@@ -0,0 +1,63 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Processes a block of arithmetic instructions whose flags are mostly
+## overwritten before being read, with and without the LAZY_FLAGS mode, and
+## reports the number of AST nodes and symbolic expressions per instruction.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_lazy_flags.py [iterations]
+##  [eager] <n> instructions in <t>s (<n/t> inst/s), <a> nodes/inst, <e> expressions/inst
+##  [lazy]  <n> instructions in <t>s (<n/t> inst/s), <a> nodes/inst, <e> expressions/inst
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, MODE, Instruction
+
+
+ITERATIONS = 100000
+
+CODE = [
+    "\x48\x01\xd8",             # add rax, rbx
+    "\x48\x29\xc8",             # sub rax, rcx
+    "\x48\x31\xd0",             # xor rax, rdx
+    "\x48\x83\xc0\x01",         # add rax, 1
+    "\x48\xff\xc9",             # dec rcx
+    "\x48\x39\xd8",             # cmp rax, rbx
+    "\x75\x00",                 # jne +0
+]
+
+
+def run(lazy):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableMode(MODE.LAZY_FLAGS, lazy)
+    ctx.convertRegisterToSymbolicVariable(ctx.registers.rbx)
+
+    before = ctx.getAstArenaStats()['allocations']
+    count  = 0
+    start  = time.time()
+    for _ in xrange(ITERATIONS):
+        for opcode in CODE:
+            ctx.processing(Instruction(opcode))
+            count += 1
+    elapsed = time.time() - start
+
+    nodes = ctx.getAstArenaStats()['allocations'] - before
+    exprs = len(ctx.getSymbolicExpressions())
+    label = '[lazy] ' if lazy else '[eager]'
+    print '%s %d instructions in %.2fs (%d inst/s), %.1f nodes/inst, %.1f expressions/inst' %(
+        label, count, elapsed, count / elapsed, float(nodes) / count, float(exprs) / count)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        ITERATIONS = int(sys.argv[1])
+
+    run(False)
+    run(True)
+
+    sys.exit(0)
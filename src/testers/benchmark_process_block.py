@@ -0,0 +1,71 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Compares the replay of a recorded trace from Python with one call to
+## processing() per instruction and with a single call to processBlock().
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_process_block.py [instructions]
+##  [processing] <n> instructions in <t>s (<n/t> inst/s)
+##  [processBlock] <n> instructions in <t>s (<n/t> inst/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction
+
+
+INSTRUCTIONS = 100000
+
+TRACE = [
+    "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+    "\x48\x01\xd3",     # add rbx, rdx
+    "\x48\x89\x18",     # mov qword ptr [rax], rbx
+    "\x48\x83\xc0\x08", # add rax, 8
+    "\x48\x39\xc8",     # cmp rax, rcx
+    "\x75\x00",         # jne +0
+]
+
+
+def record():
+    trace   = list()
+    address = 0x400000
+    while len(trace) < INSTRUCTIONS:
+        for opcode in TRACE:
+            trace.append((address, opcode))
+            address += len(opcode)
+    return trace
+
+
+def context():
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableSymbolicEngine(False)
+    ctx.setConcreteRegisterValue(ctx.registers.rax, 0x10000000)
+    return ctx
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        INSTRUCTIONS = int(sys.argv[1])
+
+    trace = record()
+
+    ctx = context()
+    start = time.time()
+    for address, opcode in trace:
+        inst = Instruction(opcode)
+        inst.setAddress(address)
+        ctx.processing(inst)
+    elapsed = time.time() - start
+    print '[processing] %d instructions in %.2fs (%d inst/s)' %(len(trace), elapsed, len(trace) / elapsed)
+
+    ctx = context()
+    start = time.time()
+    ctx.processBlock(trace)
+    elapsed = time.time() - start
+    print '[processBlock] %d instructions in %.2fs (%d inst/s)' %(len(trace), elapsed, len(trace) / elapsed)
+
+    sys.exit(0)
@@ -0,0 +1,98 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Compares the cost of negating each branch of a trace: one getModel() per
+## branch on the conjunction of the previous path constraints, and the
+## incremental solver session (addSolverConstraint / pushSolver / popSolver).
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_solver_session.py [branches]
+##  [getModel] <n> branches in <t>s (<n/t> branch/s)
+##  [session]  <n> branches in <t>s (<n/t> branch/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction
+
+
+BRANCHES = 200
+
+TRACE = [
+    "\x48\x01\xd8",     # add rax, rbx
+    "\x48\x31\xc3",     # xor rbx, rax
+    "\x48\x83\xf8\x10", # cmp rax, 0x10
+    "\x75\x00",         # jne +0
+]
+
+
+def trace(branches):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+    ctx.convertRegisterToSymbolicVariable(ctx.registers.rbx)
+
+    for _ in range(branches):
+        for opcode in TRACE:
+            ctx.processing(Instruction(opcode))
+
+    return ctx
+
+
+def negated(pc):
+    for branch in pc.getBranchConstraints():
+        if not branch['isTaken']:
+            return branch['constraint']
+    return None
+
+
+def run_models(ctx):
+    ast    = ctx.getAstContext()
+    prefix = [ast.equal(ast.bvtrue(), ast.bvtrue())]
+    count  = 0
+
+    for pc in ctx.getPathConstraints():
+        node = negated(pc)
+        if node is not None:
+            ctx.getModel(ast.land(prefix + [node]))
+            count += 1
+        prefix.append(pc.getTakenPathConstraintAst())
+
+    return count
+
+
+def run_session(ctx):
+    count = 0
+
+    for pc in ctx.getPathConstraints():
+        node = negated(pc)
+        if node is not None:
+            ctx.pushSolver()
+            ctx.addSolverConstraint(node)
+            ctx.getSolverModel()
+            ctx.popSolver()
+            count += 1
+        ctx.addSolverConstraint(pc.getTakenPathConstraintAst())
+
+    return count
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        BRANCHES = int(sys.argv[1])
+
+    ctx = trace(BRANCHES)
+
+    start = time.time()
+    count = run_models(ctx)
+    elapsed = time.time() - start
+    print '[getModel] %d branches in %.2fs (%d branch/s)' %(count, elapsed, count / elapsed)
+
+    start = time.time()
+    count = run_session(ctx)
+    elapsed = time.time() - start
+    print '[session]  %d branches in %.2fs (%d branch/s)' %(count, elapsed, count / elapsed)
+
+    sys.exit(0)
@@ -0,0 +1,64 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Measures the lookup throughput of the symbolic expressions by id once
+## the symbolic engine holds a large number of them.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_symbolic_expressions.py [expressions] [lookups]
+##  [create] <n> expressions in <t>s (<n/t> expressions/s)
+##  [exists] <n> lookups in <t>s (<n/t> lookups/s)
+##  [lookup] <n> lookups in <t>s (<n/t> lookups/s)
+##  [iterate] <n> expressions in <t>s (<n/t> expressions/s)
+##
+## The default of 10M expressions needs several GB of memory.
+##
+
+import random
+import sys
+import time
+
+from triton import TritonContext, ARCH
+
+
+EXPRESSIONS = 10000000
+LOOKUPS     = 1000000
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        EXPRESSIONS = int(sys.argv[1])
+    if len(sys.argv) > 2:
+        LOOKUPS = int(sys.argv[2])
+
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ast  = ctx.getAstContext()
+    node = ast.bv(1, 64)
+
+    start = time.time()
+    for i in xrange(EXPRESSIONS):
+        ctx.newSymbolicExpression(node)
+    elapsed = time.time() - start
+    print '[create] %d expressions in %.2fs (%d expressions/s)' %(EXPRESSIONS, elapsed, EXPRESSIONS / elapsed)
+
+    ids = [random.randrange(EXPRESSIONS) for i in xrange(LOOKUPS)]
+    start = time.time()
+    for i in ids:
+        ctx.isSymbolicExpressionIdExists(i)
+    elapsed = time.time() - start
+    print '[exists] %d lookups in %.2fs (%d lookups/s)' %(LOOKUPS, elapsed, LOOKUPS / elapsed)
+
+    start = time.time()
+    for i in ids:
+        ctx.getSymbolicExpressionFromId(i)
+    elapsed = time.time() - start
+    print '[lookup] %d lookups in %.2fs (%d lookups/s)' %(LOOKUPS, elapsed, LOOKUPS / elapsed)
+
+    start = time.time()
+    count = len(ctx.getSymbolicExpressions())
+    elapsed = time.time() - start
+    print '[iterate] %d expressions in %.2fs (%d expressions/s)' %(count, elapsed, count / elapsed)
+
+    sys.exit(0)
@@ -0,0 +1,68 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Measures the cost of concrete instructions in the ONLY_ON_SYMBOLIZED mode
+## while a large part of the memory is symbolic. The expressions of these
+## instructions are removed right after their processing, which must not
+## depend on the amount of symbolic memory.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_symbolic_memory.py [symbolic bytes] [instructions]
+##  [symbolize] <n> bytes in <t>s
+##  [processing] <n> instructions in <t>s (<n/t> instructions/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, MODE, Instruction, MemoryAccess, CPUSIZE
+
+
+DATA  = 0x10000000
+STACK = 0x7fff0000
+SIZE  = 1024 * 1024
+INSTS = 100000
+
+trace = [
+    "\x48\xc7\xc0\x01\x00\x00\x00",     # mov rax, 1
+    "\x48\x01\xd8",                     # add rax, rbx
+    "\x48\x89\x04\x24",                 # mov qword ptr [rsp], rax
+    "\x48\x8b\x0c\x24",                 # mov rcx, qword ptr [rsp]
+]
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        SIZE = int(sys.argv[1])
+    if len(sys.argv) > 2:
+        INSTS = int(sys.argv[2])
+
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+
+    start = time.time()
+    for addr in xrange(DATA, DATA + SIZE, CPUSIZE.QWORD):
+        ctx.convertMemoryToSymbolicVariable(MemoryAccess(addr, CPUSIZE.QWORD))
+    print '[symbolize] %d bytes in %.2fs' %(SIZE, time.time() - start)
+
+    insts = list()
+    for opcode in trace:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        insts.append(inst)
+
+    ctx.setConcreteRegisterValue(ctx.registers.rsp, STACK)
+    start = time.time()
+    for i in xrange(INSTS / len(insts)):
+        for inst in insts:
+            ctx.processing(inst)
+    elapsed = time.time() - start
+    print '[processing] %d instructions in %.2fs (%d instructions/s)' %(INSTS, elapsed, INSTS / elapsed)
+
+    # Sanity check
+    if not all(ctx.isMemorySymbolized(MemoryAccess(addr, CPUSIZE.QWORD)) for addr in xrange(DATA, DATA + SIZE, CPUSIZE.QWORD)):
+        print '[processing] error: the symbolic memory has changed'
+
+    sys.exit(0)
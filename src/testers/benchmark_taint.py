@@ -0,0 +1,100 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Measures the taint propagation cost of memcpy/strcpy-like traces on a
+## tainted input buffer. Run it against two builds to compare the memory
+## taint backends.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_taint.py [buffer size] [copies]
+##  [memcpy api ] <n> bytes copied in <t>s (<n/t> bytes/s)
+##  [memcpy insn] <n> bytes copied in <t>s (<n/t> bytes/s)
+##  [strcpy insn] <n> bytes copied in <t>s (<n/t> bytes/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction, MemoryAccess, CPUSIZE
+
+
+SRC  = 0x10000000
+DST  = 0x20000000
+SIZE = 1024 * 1024
+COPY = 4
+
+# movsq ; qword per instruction
+memcpyTrace = [
+    "\x48\xa5",         # movsq
+]
+
+# strcpy loop ; byte per iteration
+strcpyTrace = [
+    "\x8a\x06",         # mov al, byte ptr [rsi]
+    "\x88\x07",         # mov byte ptr [rdi], al
+    "\x48\xff\xc6",     # inc rsi
+    "\x48\xff\xc7",     # inc rdi
+]
+
+
+def newContext():
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableSymbolicEngine(False)
+    for addr in xrange(SRC, SRC + SIZE, CPUSIZE.DQQWORD):
+        ctx.setTaintMemory(MemoryAccess(addr, CPUSIZE.DQQWORD), True)
+    return ctx
+
+
+def report(name, count, elapsed):
+    print '[%s] %d bytes copied in %.2fs (%d bytes/s)' %(name, count, elapsed, count / elapsed)
+    return
+
+
+def memcpyApi():
+    ctx   = newContext()
+    start = time.time()
+    for i in xrange(COPY):
+        src = SRC if i == 0 else DST + ((i - 1) * SIZE)
+        dst = DST + (i * SIZE)
+        for offset in xrange(0, SIZE, CPUSIZE.QWORD):
+            ctx.taintAssignmentMemoryMemory(MemoryAccess(dst + offset, CPUSIZE.QWORD), MemoryAccess(src + offset, CPUSIZE.QWORD))
+    report('memcpy api ', COPY * SIZE, time.time() - start)
+    return
+
+
+def runTrace(name, trace, step):
+    ctx   = newContext()
+    insts = list()
+    for opcode in trace:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        insts.append(inst)
+
+    start = time.time()
+    for i in xrange(COPY):
+        ctx.setConcreteRegisterValue(ctx.registers.rsi, SRC)
+        ctx.setConcreteRegisterValue(ctx.registers.rdi, DST + (i * SIZE))
+        for _ in xrange(0, SIZE, step):
+            for inst in insts:
+                ctx.processing(inst)
+    report(name, COPY * SIZE, time.time() - start)
+
+    # Sanity check
+    if not ctx.isMemoryTainted(MemoryAccess(DST + ((COPY - 1) * SIZE), CPUSIZE.QWORD)):
+        print '[%s] error: the destination is not tainted' %(name)
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        SIZE = int(sys.argv[1])
+    if len(sys.argv) > 2:
+        COPY = int(sys.argv[2])
+
+    memcpyApi()
+    runTrace('memcpy insn', memcpyTrace, CPUSIZE.QWORD)
+    runTrace('strcpy insn', strcpyTrace, CPUSIZE.BYTE)
+
+    sys.exit(0)
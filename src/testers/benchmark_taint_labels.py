@@ -0,0 +1,81 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Compares the cost of attributing the taint of a trace to several sources:
+## one pass per source with the boolean taint, and a single pass with one
+## label per source (taintMemoryWithLabel).
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_taint_labels.py [instructions] [sources]
+##  [passes] <n> instructions in <t>s (<n/t> inst/s)
+##  [labels] <n> instructions in <t>s (<n/t> inst/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction, MemoryAccess, CPUSIZE, MODE
+
+
+INSTRUCTIONS = 100000
+SOURCES      = 8
+
+TRACE = [
+    "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+    "\x48\x01\xd3",     # add rbx, rdx
+    "\x48\x89\x18",     # mov qword ptr [rax], rbx
+    "\x48\x83\xc0\x08", # add rax, 8
+    "\x48\x39\xc8",     # cmp rax, rcx
+    "\x75\x00",         # jne +0
+]
+
+
+def run(sources, labels):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableSymbolicEngine(False)
+    ctx.enableMode(MODE.TAINT_SUMMARIES, True)
+    ctx.setConcreteRegisterValue(ctx.registers.rax, 0x10000000)
+    ctx.setConcreteRegisterValue(ctx.registers.rcx, 0xffffffffffffffff)
+
+    for source in sources:
+        mem = MemoryAccess(0x10000000 + source * CPUSIZE.QWORD, CPUSIZE.QWORD)
+        if labels:
+            ctx.taintMemoryWithLabel(mem, source)
+        else:
+            ctx.taintMemory(mem)
+
+    insts = list()
+    for opcode in TRACE:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        insts.append(inst)
+
+    count = 0
+    while count < INSTRUCTIONS:
+        for inst in insts:
+            ctx.processing(inst)
+        count += len(insts)
+    return count
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        INSTRUCTIONS = int(sys.argv[1])
+    if len(sys.argv) > 2:
+        SOURCES = int(sys.argv[2])
+
+    count = 0
+    start = time.time()
+    for source in range(SOURCES):
+        count += run([source], False)
+    elapsed = time.time() - start
+    print '[passes] %d instructions in %.2fs (%d inst/s)' %(count, elapsed, count / elapsed)
+
+    start = time.time()
+    count = run(range(SOURCES), True)
+    elapsed = time.time() - start
+    print '[labels] %d instructions in %.2fs (%d inst/s)' %(count, elapsed, count / elapsed)
+
+    sys.exit(0)
@@ -0,0 +1,76 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Measures the throughput of the taint-only processing (symbolic engine
+## disabled) once the symbolic engine holds a large state. The throughput
+## should not depend on the size of the symbolic state.
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_taint_only.py [expressions] [instructions]
+##  [taint-only] <e> expressions: <n> instructions in <t>s (<n/t> inst/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction, MemoryAccess, CPUSIZE
+
+
+EXPRESSIONS  = [0, 10000, 100000, 1000000]
+INSTRUCTIONS = 100000
+
+TRACE = [
+    "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+    "\x48\x01\xd3",     # add rbx, rdx
+    "\x48\x89\x18",     # mov qword ptr [rax], rbx
+    "\x48\x83\xc0\x08", # add rax, 8
+    "\x48\x39\xc8",     # cmp rax, rcx
+    "\x75\x00",         # jne +0
+]
+
+
+def run(expressions):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+
+    # Build a symbolic state of <expressions> expressions spread over the memory
+    ast  = ctx.getAstContext()
+    node = ast.bv(1, 64)
+    for i in xrange(expressions):
+        se = ctx.newSymbolicExpression(node)
+        ctx.assignSymbolicExpressionToMemory(se, MemoryAccess(0x80000000 + (i * CPUSIZE.QWORD), CPUSIZE.QWORD))
+
+    ctx.enableSymbolicEngine(False)
+    ctx.setConcreteRegisterValue(ctx.registers.rax, 0x10000000)
+    ctx.setConcreteRegisterValue(ctx.registers.rcx, 0xffffffffffffffff)
+    ctx.taintMemory(MemoryAccess(0x10000000, CPUSIZE.QWORD))
+
+    insts = list()
+    for opcode in TRACE:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        insts.append(inst)
+
+    count = 0
+    start = time.time()
+    while count < INSTRUCTIONS:
+        for inst in insts:
+            ctx.processing(inst)
+        count += len(insts)
+    elapsed = time.time() - start
+
+    print '[taint-only] %d expressions: %d instructions in %.2fs (%d inst/s)' %(expressions, count, elapsed, count / elapsed)
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        EXPRESSIONS = [int(sys.argv[1])]
+    if len(sys.argv) > 2:
+        INSTRUCTIONS = int(sys.argv[2])
+
+    for expressions in EXPRESSIONS:
+        run(expressions)
+
+    sys.exit(0)
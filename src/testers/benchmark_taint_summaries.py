@@ -0,0 +1,69 @@
+#!/usr/bin/env python2
+## -*- coding: utf-8 -*-
+##
+## Compares the throughput of the taint-only processing (symbolic engine
+## disabled) when the taint is spread by the semantics and when it is
+## spread from the opcode summaries (MODE.TAINT_SUMMARIES).
+##
+## Usage:
+##
+##  $ python src/testers/benchmark_taint_summaries.py [instructions]
+##  [semantics] <n> instructions in <t>s (<n/t> inst/s)
+##  [summaries] <n> instructions in <t>s (<n/t> inst/s)
+##
+
+import sys
+import time
+
+from triton import TritonContext, ARCH, Instruction, MemoryAccess, CPUSIZE, MODE
+
+
+INSTRUCTIONS = 100000
+
+TRACE = [
+    "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+    "\x48\x01\xd3",     # add rbx, rdx
+    "\x48\x31\xf6",     # xor rsi, rsi
+    "\x48\x89\x18",     # mov qword ptr [rax], rbx
+    "\x48\x83\xc0\x08", # add rax, 8
+    "\x48\x39\xc8",     # cmp rax, rcx
+    "\x0f\x95\xc2",     # setne dl
+    "\x75\x00",         # jne +0
+]
+
+
+def run(summaries):
+    ctx = TritonContext()
+    ctx.setArchitecture(ARCH.X86_64)
+    ctx.enableSymbolicEngine(False)
+    ctx.enableMode(MODE.TAINT_SUMMARIES, summaries)
+    ctx.setConcreteRegisterValue(ctx.registers.rax, 0x10000000)
+    ctx.setConcreteRegisterValue(ctx.registers.rcx, 0xffffffffffffffff)
+    ctx.taintMemory(MemoryAccess(0x10000000, CPUSIZE.QWORD))
+
+    insts = list()
+    for opcode in TRACE:
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        insts.append(inst)
+
+    count = 0
+    start = time.time()
+    while count < INSTRUCTIONS:
+        for inst in insts:
+            ctx.processing(inst)
+        count += len(insts)
+    elapsed = time.time() - start
+
+    print '[%s] %d instructions in %.2fs (%d inst/s)' %('summaries' if summaries else 'semantics', count, elapsed, count / elapsed)
+    return
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        INSTRUCTIONS = int(sys.argv[1])
+
+    run(False)
+    run(True)
+
+    sys.exit(0)
@@ -0,0 +1,127 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the AST nodes arena."""
+
+import unittest
+
+from triton import ARCH, MODE, TritonContext, Instruction
+
+
+class TestAstArena(unittest.TestCase):
+
+    """Testing the AST nodes arena."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.Triton.getAstContext()
+
+    def test_stats(self):
+        before = self.Triton.getAstArenaStats()
+
+        # bv = bv node + 2 decimal nodes
+        nodes = [self.astCtxt.bv(i, 32) for i in range(100)]
+
+        after = self.Triton.getAstArenaStats()
+        self.assertEqual(after['allocations'] - before['allocations'], 300)
+        self.assertEqual(after['liveNodes'] - before['liveNodes'], 300)
+        self.assertGreater(after['liveBytes'], before['liveBytes'])
+        self.assertGreaterEqual(after['slabBytes'], after['liveBytes'])
+        self.assertGreaterEqual(after['slabs'], 1)
+
+    def test_layout(self):
+        before = self.Triton.getAstArenaStats()
+
+        # 64-bit values, children and parents are stored inside the nodes
+        nodes = [self.astCtxt.bvadd(self.astCtxt.bv(i, 64), self.astCtxt.bv(i + 1, 64)) for i in range(1000)]
+
+        after = self.Triton.getAstArenaStats()
+        nodes = after['liveNodes'] - before['liveNodes']
+        size  = after['liveBytes'] - before['liveBytes']
+
+        # Bytes per node, arena header included
+        self.assertEqual(nodes, 7000)
+        self.assertLessEqual(size / nodes, 160)
+
+    def test_wide_values(self):
+        node = self.astCtxt.bv((1 << 200) + 1, 256)
+        self.assertEqual(node.evaluate(), (1 << 200) + 1)
+        self.assertEqual(self.astCtxt.bvadd(node, node).evaluate(), (1 << 201) + 2)
+
+    def test_reset(self):
+        nodes = [self.astCtxt.bv(i, 32) for i in range(100)]
+
+        self.Triton.reset()
+
+        stats = self.Triton.getAstArenaStats()
+        self.assertEqual(stats['liveNodes'], 0)
+        self.assertEqual(stats['liveBytes'], 0)
+        self.assertEqual(stats['slabs'], 0)
+
+    def test_python_release(self):
+        before = self.Triton.getAstArenaStats()
+
+        nodes = [self.astCtxt.bvadd(self.astCtxt.bv(i, 64), self.astCtxt.bv(i + 1, 64)) for i in range(100)]
+        self.assertEqual(self.Triton.getAstArenaStats()['liveNodes'] - before['liveNodes'], 700)
+
+        # The nodes are freed with their Python objects
+        del nodes
+        self.assertEqual(self.Triton.getAstArenaStats()['liveNodes'], before['liveNodes'])
+
+        # A node may outlive its context
+        node = self.astCtxt.bv(1, 8)
+        del self.astCtxt
+        del self.Triton
+        del node
+
+    def test_instruction_release(self):
+        inst = Instruction()
+        inst.setOpcode("\x48\x8d\x04\x5b") # lea rax, [rbx+rbx*2]
+
+        # The nodes retained by the first processing belong to the first context
+        self.Triton.processing(inst)
+        self.Triton.processing(inst)
+
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.processing(inst)
+        self.assertTrue(inst.getReadRegisters())
+
+        # The instruction outlives the context of its nodes
+        del ctx
+        del inst
+
+    def test_taint_only_rollback(self):
+        self.Triton.enableSymbolicEngine(False)
+
+        inst = Instruction()
+        inst.setOpcode("\x48\x01\xd8") # add rax, rbx
+
+        self.Triton.processing(inst)
+        before = self.Triton.getAstArenaStats()
+
+        self.Triton.processing(inst)
+        after = self.Triton.getAstArenaStats()
+
+        # Nodes built for the taint propagation are released after each instruction
+        self.assertGreater(after['allocations'], before['allocations'])
+        self.assertEqual(after['liveNodes'], before['liveNodes'])
+
+    def test_only_on_symbolized_dictionaries(self):
+        self.Triton.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        self.Triton.enableMode(MODE.AST_DICTIONARIES, True)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rbx, 1)
+
+        inst = Instruction()
+        inst.setOpcode("\x48\x01\xd8") # add rax, rbx
+
+        self.Triton.processing(inst)
+        before = self.Triton.getAstArenaStats()
+
+        self.Triton.processing(inst)
+        after = self.Triton.getAstArenaStats()
+
+        # Concrete expressions are removed and their nodes are freed even with the dictionaries
+        self.assertGreater(after['allocations'], before['allocations'])
+        self.assertEqual(after['liveNodes'], before['liveNodes'])
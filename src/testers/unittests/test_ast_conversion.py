@@ -261,6 +261,42 @@ class TestAstConversion(unittest.TestCase):
             self.assertEqual(n.evaluate(), self.Triton.evaluateAstViaZ3(n))
             self.assertEqual(n.evaluate(), self.Triton.simplify(n, True).evaluate())
 
+    def test_let_shadowing(self):
+        """A nested let shadows a symbol until it ends, the same symbol node is shared."""
+        cv1 = random.randint(0, 255)
+        cv2 = random.randint(0, 255)
+        self.Triton.setConcreteSymbolicVariableValue(self.sv1, cv1)
+        self.Triton.setConcreteSymbolicVariableValue(self.sv2, cv2)
+        b = self.astCtxt.string("b")
+        n = self.astCtxt.let("b", self.astCtxt.bvadd(self.v1, self.v2), self.astCtxt.bvadd(self.astCtxt.let("b", self.v1, b), b))
+        self.assertEqual((cv1 + cv1 + cv2) % 256, self.Triton.evaluateAstViaZ3(n))
+
+    def test_shared_dag(self):
+        """
+        Convert a DAG of 1M nodes to z3.
+
+        Each node uses its child twice, so the tree behind the DAG is
+        exponential. Each node must be translated only once.
+        """
+        cv1 = random.randint(0, 255)
+        self.Triton.setConcreteSymbolicVariableValue(self.sv1, cv1)
+
+        n   = self.v1
+        ref = cv1
+        for _ in xrange(500000):
+            n   = self.astCtxt.bvxor(self.astCtxt.bvadd(n, n), self.v1)
+            ref = ((ref + ref) % 256) ^ cv1
+        self.assertEqual(ref, n.evaluate())
+        self.assertEqual(ref, self.Triton.evaluateAstViaZ3(n))
+
+    def test_shared_dag_from_z3(self):
+        """Convert a deep DAG back from z3, each node uses the two previous ones."""
+        prev = self.v1
+        n    = self.v2
+        for _ in xrange(100000):
+            prev, n = n, self.astCtxt.bvudiv(n, prev)
+        self.assertEqual(self.Triton.simplify(n, True).getBitvectorSize(), 8)
+
     def test_fuzz(self):
         """
         Fuzz test an ast evaluation.
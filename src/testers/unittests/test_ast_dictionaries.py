@@ -31,9 +31,9 @@ class TestAstDictionaries(unittest.TestCase):
         self.assertEqual(d['bv'], 2)
         self.assertEqual(d['decimal'], 3)
         self.assertEqual(d['allocatedDictionaries'], 5)
-        self.assertEqual(d['allocatedNodes'], 6)
+        self.assertEqual(d['allocatedNodes'], 5)
 
-        # Same allocation
+        # Same allocation, nodes are found before being allocated
         bv1 = self.astCtxt.bv(1, 8)
         bv2 = self.astCtxt.bv(2, 8)
 
@@ -41,4 +41,32 @@ class TestAstDictionaries(unittest.TestCase):
         self.assertEqual(d['bv'], 2)
         self.assertEqual(d['decimal'], 3)
         self.assertEqual(d['allocatedDictionaries'], 5)
-        self.assertEqual(d['allocatedNodes'], 12)
+        self.assertEqual(d['allocatedNodes'], 5)
+        self.assertEqual(d['hits'], 8)
+
+    def test_lookup_before_allocate(self):
+        a = self.astCtxt.bv(1, 32)
+        b = self.astCtxt.bv(2, 32)
+        first = self.astCtxt.extract(15, 0, self.astCtxt.bvadd(a, b))
+
+        before = self.Triton.getAstDictionariesStats()
+        node = self.astCtxt.extract(15, 0, self.astCtxt.bvadd(a, b))
+        after = self.Triton.getAstDictionariesStats()
+
+        self.assertEqual(after['allocatedNodes'], before['allocatedNodes'])
+        self.assertEqual(after['allocatedDictionaries'], before['allocatedDictionaries'])
+        self.assertEqual(node.evaluate(), 3)
+
+    def test_table_stats(self):
+        d = self.Triton.getAstDictionariesStats()
+        self.assertEqual(d['tableSize'], 0)
+        self.assertEqual(d['loadFactor'], 0)
+
+        nodes = [self.astCtxt.bvadd(self.astCtxt.bv(i, 32), self.astCtxt.bv(1, 32)) for i in range(2048)]
+
+        d = self.Triton.getAstDictionariesStats()
+        self.assertEqual(d['bvadd'], 2048)
+        self.assertLess(d['loadFactor'], 70)
+        self.assertGreaterEqual(d['lookups'], d['allocatedNodes'])
+        self.assertGreaterEqual(d['probes'], d['lookups'])
+        self.assertGreaterEqual(d['maxProbeLength'], 1)
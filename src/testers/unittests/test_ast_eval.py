@@ -802,6 +802,30 @@ class TestAstEval(unittest.TestCase):
         ]
         self.check_ast(tests)
 
+    def test_widths(self):
+        """Check operations around the 64-bit boundary (native and uint512 evaluations)."""
+        tests = []
+        for size in [1, 8, 63, 64, 65, 128, 256]:
+            mask = (1 << size) - 1
+            x = self.astCtxt.bv(0xfedcba9876543210fedcba9876543210 & mask, size)
+            y = self.astCtxt.bv(0x8000000000000001 & mask, size)
+            tests += [
+                self.astCtxt.bvadd(x, y),
+                self.astCtxt.bvmul(x, y),
+                self.astCtxt.bvneg(x),
+                self.astCtxt.bvnot(x),
+                self.astCtxt.bvshl(x, self.astCtxt.bv(size & mask, size)),
+                self.astCtxt.bvlshr(x, self.astCtxt.bv((size - 1) & mask, size)),
+                self.astCtxt.bvslt(x, y),
+                self.astCtxt.bvsge(x, y),
+                self.astCtxt.bvult(x, y),
+                self.astCtxt.sx(64, x),
+                self.astCtxt.zx(64, x),
+                self.astCtxt.concat([x, y]),
+                self.astCtxt.extract(size - 1, 0, self.astCtxt.concat([x, y])),
+            ]
+        self.check_ast(tests)
+
     def test_reference(self):
         """Check evaluation of reference node after variable update."""
         self.sv1 = self.Triton.newSymbolicVariable(8)
@@ -812,3 +836,17 @@ class TestAstEval(unittest.TestCase):
         self.Triton.setConcreteSymbolicVariableValue(self.sv1, 10)
         trv = final_node.evaluate()
         self.assertEqual(trv, 12)
+
+    def test_extract_bounds(self):
+        """Check that an extraction out of its child is rejected."""
+        x = self.astCtxt.bv(0x1122334455667788, 64)
+        self.assertEqual(self.astCtxt.extract(63, 56, x).evaluate(), 0x11)
+
+        with self.assertRaises(TypeError):
+            self.astCtxt.extract(127, 64, x)
+
+        with self.assertRaises(TypeError):
+            self.astCtxt.extract(64, 0, x)
+
+        with self.assertRaises(TypeError):
+            self.astCtxt.extract(7, 8, x)
@@ -53,3 +53,34 @@ class TestAstReference(unittest.TestCase):
         exp1 = self.Triton.newSymbolicExpression(self.astCtxt.reference(self.Triton.getSymbolicExpressionFromId(0)), "exp1")
         exp2 = self.Triton.newSymbolicExpression(self.astCtxt.reference(self.Triton.getSymbolicExpressionFromId(1)), "exp2")
         self.assertEqual(str(self.Triton.unrollAst(exp2.getAst())), "SymVar_0")
+
+    def test_unroll_keeps_ast(self):
+        v0   = self.astCtxt.variable(self.Triton.newSymbolicVariable(8))
+        exp0 = self.Triton.newSymbolicExpression(v0, "exp0")
+        ref0 = self.astCtxt.reference(exp0)
+        node = ref0 + ref0
+        self.assertEqual(str(self.Triton.unrollAst(node)), "(bvadd SymVar_0 SymVar_0)")
+        self.assertEqual(str(node), "(bvadd ref!0 ref!0)")
+
+    def test_unroll_cache(self):
+        v0   = self.astCtxt.variable(self.Triton.newSymbolicVariable(8))
+        expr = self.Triton.newSymbolicExpression(v0, "exp0")
+        first = expr
+        # Each expression references the previous one twice
+        for i in range(10000):
+            ref  = self.astCtxt.reference(expr)
+            expr = self.Triton.newSymbolicExpression(ref | ref, "exp%d" %(i + 1))
+
+        node = self.Triton.unrollAstFromId(expr.getId())
+        self.assertEqual(node.getHash(), self.Triton.unrollAstFromId(expr.getId()).getHash())
+        self.assertEqual(node.evaluate(), 0)
+
+        # Replacing an expression outside of the engine unrolls again the ones which reference it
+        first.setAst(self.astCtxt.bv(1, 8))
+        node = self.Triton.unrollAst(self.astCtxt.reference(expr) + 1)
+        self.assertEqual(node.evaluate(), 2)
+        self.assertEqual(self.Triton.unrollAstFromId(first.getId() + 1).evaluate(), 1)
+
+        # Replacing the unrolled expression itself is seen
+        expr.setAst(self.astCtxt.bv(2, 8))
+        self.assertEqual(str(self.Triton.unrollAstFromId(expr.getId())), "(_ bv2 8)")
@@ -0,0 +1,64 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the traversal of deep and shared ASTs."""
+
+import unittest
+
+from triton import ARCH, Instruction, TritonContext
+
+
+class TestAstTraversal(unittest.TestCase):
+
+    """Testing the traversal of deep and shared ASTs."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.Triton.getAstContext()
+
+    def test_deep_print(self):
+        node = self.astCtxt.variable(self.Triton.newSymbolicVariable(8))
+        for _ in range(100000):
+            node = self.astCtxt.bvnot(node)
+
+        # The printer does not recurse on the depth of the tree
+        text = str(node)
+        self.assertTrue(text.startswith("(bvnot (bvnot "))
+        self.assertEqual(text.count("(bvnot "), 100000)
+
+    def test_print_nul(self):
+        # The text of a node may hold any character, e.g. a nul in an alias
+        x = self.astCtxt.bv(1, 8)
+        node = self.astCtxt.let("a\x00b", x, self.astCtxt.bvadd(x, x))
+        self.assertEqual(str(node), "(let ((a\x00b (_ bv1 8))) (bvadd (_ bv1 8) (_ bv1 8)))")
+
+    def test_shared_hash(self):
+        # Each node is used twice by its parent, 2^100000 paths
+        node1 = self.astCtxt.variable(self.Triton.newSymbolicVariable(8))
+        node2 = self.astCtxt.variable(self.Triton.newSymbolicVariable(8))
+        for _ in range(100000):
+            node1 = self.astCtxt.bvadd(node1, node1)
+            node2 = self.astCtxt.bvadd(node2, node2)
+
+        self.assertEqual(node1.getHash(), node1.getHash())
+        self.assertNotEqual(node1.getHash(), node2.getHash())
+
+    def test_shared_expressions(self):
+        # Each expression references the previous one twice
+        trace = [
+            "\x48\x01\xc0", # add rax, rax
+        ] * 20000
+
+        self.Triton.convertRegisterToSymbolicVariable(self.Triton.registers.rax)
+        for opcode in trace:
+            self.Triton.processing(Instruction(opcode))
+
+        expr  = self.Triton.getSymbolicRegister(self.Triton.registers.rax)
+        slice = self.Triton.sliceExpressions(expr)
+        self.assertGreater(len(slice), 20000)
+        self.assertIn(expr.getId(), slice)
+
+        node = self.Triton.unrollAst(expr.getAst())
+        self.assertEqual(node.getBitvectorSize(), 64)
+        self.assertEqual(node.getHash(), node.getHash())
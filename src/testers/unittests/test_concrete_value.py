@@ -4,7 +4,7 @@
 
 import unittest
 
-from triton import ARCH, TritonContext
+from triton import ARCH, CPUSIZE, MemoryAccess, TritonContext
 
 
 class TestX86ConcreteRegisterValue(unittest.TestCase):
@@ -176,3 +176,30 @@ class TestX8664ConcreteMemoryValue(unittest.TestCase):
         self.Triton.setConcreteMemoryAreaValue(0x1000, "\x11\x22\x33\x44\x55\x66")
         self.Triton.setConcreteMemoryAreaValue(0x1006, [0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc])
         self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x1000, 12), "\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc")
+
+    def test_page_boundaries(self):
+        # A qword spanning two pages
+        mem = MemoryAccess(0x1ffc, CPUSIZE.QWORD)
+        self.Triton.setConcreteMemoryValue(mem, 0x1122334455667788)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(mem), 0x1122334455667788)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x1fff), 0x55)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x2000), 0x44)
+        self.assertTrue(self.Triton.isMemoryMapped(0x1ffc, 8))
+        self.assertFalse(self.Triton.isMemoryMapped(0x1ffb, 8))
+        self.assertFalse(self.Triton.isMemoryMapped(0x1ffc, 9))
+
+        # Unmapping a part of the area only unmaps these bytes
+        self.Triton.unmapMemory(0x1ffe, 4)
+        self.assertTrue(self.Triton.isMemoryMapped(0x1ffc, 2))
+        self.assertFalse(self.Triton.isMemoryMapped(0x1ffe, 1))
+        self.assertTrue(self.Triton.isMemoryMapped(0x2002, 2))
+        self.assertEqual(self.Triton.getConcreteMemoryValue(mem), 0x1122000000007788)
+
+        # A large area over several pages
+        data = "".join(chr(x & 0xff) for x in range(3 * 4096 + 100))
+        self.Triton.setConcreteMemoryAreaValue(0x10010, data)
+        self.assertTrue(self.Triton.isMemoryMapped(0x10010, len(data)))
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x10010, len(data)), data)
+        self.Triton.unmapMemory(0x10010, len(data))
+        self.assertFalse(self.Triton.isMemoryMapped(0x10010, 1))
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x10010, 4), "\x00\x00\x00\x00")
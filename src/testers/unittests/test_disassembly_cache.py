@@ -0,0 +1,95 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test DISASSEMBLY_CACHE mode."""
+
+import unittest
+
+from triton import ARCH, MODE, OPCODE, Instruction, TritonContext
+
+
+class TestDisassemblyCache(unittest.TestCase):
+
+    """Testing the DISASSEMBLY_CACHE mode."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.Triton.enableMode(MODE.DISASSEMBLY_CACHE, True)
+
+    def disass(self, addr, opcode):
+        inst = Instruction()
+        inst.setOpcode(opcode)
+        inst.setAddress(addr)
+        self.Triton.disassembly(inst)
+        return inst
+
+    def test_hits_and_misses(self):
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 0)
+        self.assertEqual(d['misses'], 0)
+        self.assertEqual(d['entries'], 0)
+
+        i1 = self.disass(0x1000, "\x48\x8d\x34\xc3") # lea rsi, [rbx+rax*8]
+        i2 = self.disass(0x1000, "\x48\x8d\x34\xc3") # lea rsi, [rbx+rax*8]
+
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 1)
+        self.assertEqual(d['misses'], 1)
+        self.assertEqual(d['entries'], 1)
+
+        self.assertEqual(str(i1), str(i2))
+        self.assertEqual(i1.getType(), i2.getType())
+        self.assertEqual(i2.getType(), OPCODE.LEA)
+        self.assertEqual(i1.getSize(), i2.getSize())
+        self.assertEqual(len(i1.getOperands()), len(i2.getOperands()))
+        for op1, op2 in zip(i1.getOperands(), i2.getOperands()):
+            self.assertEqual(str(op1), str(op2))
+
+    def test_opcode_mismatch(self):
+        self.disass(0x1000, "\x48\x31\xc0") # xor rax, rax
+        inst = self.disass(0x1000, "\x48\x01\xd8") # add rax, rbx
+
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 0)
+        self.assertEqual(d['misses'], 2)
+        self.assertEqual(d['entries'], 1)
+        self.assertEqual(inst.getType(), OPCODE.ADD)
+
+    def test_invalidation(self):
+        self.disass(0x1000, "\x48\x31\xc0") # xor rax, rax
+        self.disass(0x1003, "\x48\x01\xd8") # add rax, rbx
+
+        # Overwrite the last byte of the first instruction
+        self.Triton.setConcreteMemoryAreaValue(0x1002, [0xc3])
+
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['invalidations'], 1)
+        self.assertEqual(d['entries'], 1)
+
+        self.disass(0x1003, "\x48\x01\xd8") # add rax, rbx
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 1)
+
+    def test_processing(self):
+        for _ in range(10):
+            inst = Instruction()
+            inst.setOpcode("\x48\xff\xc0") # inc rax
+            inst.setAddress(0x1000)
+            self.Triton.processing(inst)
+
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rax), 10)
+
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 9)
+        self.assertEqual(d['misses'], 1)
+
+    def test_disabled(self):
+        self.Triton.enableMode(MODE.DISASSEMBLY_CACHE, False)
+        self.disass(0x1000, "\x48\x31\xc0") # xor rax, rax
+        self.disass(0x1000, "\x48\x31\xc0") # xor rax, rax
+
+        d = self.Triton.getDisassemblyCacheStats()
+        self.assertEqual(d['hits'], 0)
+        self.assertEqual(d['misses'], 0)
+        self.assertEqual(d['entries'], 0)
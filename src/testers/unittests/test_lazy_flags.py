@@ -0,0 +1,106 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test LAZY_FLAGS."""
+
+import unittest
+
+from triton import ARCH, MODE, TritonContext, Instruction
+
+
+CODE = [
+    "\x48\x01\xd8",             # add rax, rbx
+    "\x48\x29\xc8",             # sub rax, rcx
+    "\x48\x31\xd0",             # xor rax, rdx
+    "\x48\x39\xd8",             # cmp rax, rbx
+    "\x75\x00",                 # jne +0
+    "\x48\x83\xc0\x01",         # add rax, 1
+    "\x48\x85\xc0",             # test rax, rax
+    "\x74\x00",                 # je +0
+]
+
+FLAGS = ['af', 'cf', 'of', 'pf', 'sf', 'zf']
+
+
+class TestLazyFlags(unittest.TestCase):
+
+    """Testing the LAZY_FLAGS mode."""
+
+    def run_code(self, lazy):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.LAZY_FLAGS, lazy)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x7fffffffffffffff)
+        ctx.setConcreteRegisterValue(ctx.registers.rbx, 0x1337)
+        ctx.setConcreteRegisterValue(ctx.registers.rcx, 0x7fffffffffffffff)
+        ctx.setConcreteRegisterValue(ctx.registers.rdx, 0x1338)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rbx)
+
+        for opcode in CODE:
+            inst = Instruction(opcode)
+            self.assertTrue(ctx.processing(inst))
+
+        return ctx
+
+    def test_same_state(self):
+        eager = self.run_code(False)
+        lazy  = self.run_code(True)
+
+        for name in FLAGS:
+            e = eager.getConcreteRegisterValue(getattr(eager.registers, name))
+            l = lazy.getConcreteRegisterValue(getattr(lazy.registers, name))
+            self.assertEqual(e, l)
+
+            e = eager.getSymbolicExpressionFromId(eager.getSymbolicRegisterId(getattr(eager.registers, name)))
+            l = lazy.getSymbolicExpressionFromId(lazy.getSymbolicRegisterId(getattr(lazy.registers, name)))
+            self.assertEqual(e.getAst().evaluate(), l.getAst().evaluate())
+            self.assertEqual(e.getAst().isSymbolized(), l.getAst().isSymbolized())
+
+        self.assertEqual(eager.getConcreteRegisterValue(eager.registers.eflags), lazy.getConcreteRegisterValue(lazy.registers.eflags))
+
+    def test_path_constraints(self):
+        eager = self.run_code(False)
+        lazy  = self.run_code(True)
+
+        e = eager.getPathConstraints()
+        l = lazy.getPathConstraints()
+        self.assertEqual(len(e), len(l))
+
+        for pe, pl in zip(e, l):
+            be = pe.getBranchConstraints()
+            bl = pl.getBranchConstraints()
+            self.assertEqual(len(be), len(bl))
+            for x, y in zip(be, bl):
+                self.assertEqual(x['isTaken'], y['isTaken'])
+                self.assertEqual(x['dstAddr'], y['dstAddr'])
+                self.assertEqual(x['constraint'].evaluate(), y['constraint'].evaluate())
+
+    def test_fewer_expressions(self):
+        eager = self.run_code(False)
+        lazy  = self.run_code(True)
+        self.assertLess(len(lazy.getSymbolicExpressions()), len(eager.getSymbolicExpressions()))
+
+    def test_overwritten_flags(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.LAZY_FLAGS, True)
+
+        self.assertTrue(ctx.processing(Instruction("\x48\x01\xd8"))) # add rax, rbx
+        self.assertTrue(ctx.processing(Instruction("\xf8")))         # clc
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.cf), 0)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.zf), 1)
+
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 1)
+        self.assertTrue(ctx.processing(Instruction("\x48\x01\xc0"))) # add rax, rax
+        ctx.setConcreteRegisterValue(ctx.registers.zf, 1)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.zf), 1)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.sf), 0)
+
+    def test_symbolic_variable(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.LAZY_FLAGS, True)
+
+        self.assertTrue(ctx.processing(Instruction("\x48\x31\xc0"))) # xor rax, rax
+        var = ctx.convertRegisterToSymbolicVariable(ctx.registers.zf)
+        self.assertEqual(ctx.getConcreteSymbolicVariableValue(var), 1)
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.zf))
@@ -165,3 +165,80 @@ class TestOnlySymbolizedMode(unittest.TestCase):
         self.assertEqual(inst.getOperands()[1].getAddress(), 0x1337)
         self.assertIsNotNone(inst.getOperands()[1].getLeaAst())
 
+
+    def test_9(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1000, CPUSIZE.QWORD))
+        ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x2000, CPUSIZE.QWORD))
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x1000)
+
+        inst = Instruction("\x48\x89\x18") # mov qword ptr [rax], rbx
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(checkAstIntegrity(inst))
+
+        # The concrete store replaces the symbolic bytes, its expressions are removed
+        self.assertFalse(ctx.isMemorySymbolized(MemoryAccess(0x1000, CPUSIZE.QWORD)))
+        self.assertTrue(ctx.isMemorySymbolized(MemoryAccess(0x2000, CPUSIZE.QWORD)))
+        self.assertEqual(len(ctx.getSymbolicMemory()), 8)
+
+    def test_10(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0xffffffffffffffff)
+        ctx.setConcreteRegisterValue(ctx.registers.rbx, 1)
+
+        # Concrete instructions only update the concrete state
+        inst = Instruction("\x48\x01\xd8") # add rax, rbx
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(checkAstIntegrity(inst))
+        self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+        self.assertEqual(len(ctx.getSymbolicExpressions()), 0)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 0)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.zf), 1)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.cf), 1)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rip), inst.getNextAddress())
+
+        inst = Instruction("\x88\xdc") # mov ah, bl
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 0x100)
+
+        inst = Instruction("\x89\xd8") # mov eax, ebx
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0xffffffffffffffff)
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 1)
+
+    def test_11(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+
+        # A concrete byte written into a symbolic register keeps the register symbolic
+        inst = Instruction("\xb0\x01") # mov al, 1
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.rax))
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.al), 1)
+
+        # A concrete register overwrites the symbolic one
+        inst = Instruction("\x48\x89\xd8") # mov rax, rbx
+        self.assertTrue(ctx.processing(inst))
+        self.assertFalse(ctx.isRegisterSymbolized(ctx.registers.rax))
+
+    def test_12(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.taintRegister(ctx.registers.rbx)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x1000)
+        ctx.setConcreteRegisterValue(ctx.registers.rbx, 0x1337)
+
+        # The taint is spread by the concrete instructions
+        inst = Instruction("\x48\x89\x18") # mov qword ptr [rax], rbx
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(inst.isTainted())
+        self.assertTrue(ctx.isMemoryTainted(MemoryAccess(0x1000, CPUSIZE.QWORD)))
+        self.assertEqual(ctx.getConcreteMemoryValue(MemoryAccess(0x1000, CPUSIZE.QWORD)), 0x1337)
+        self.assertEqual(len(inst.getStoreAccess()), 0)
@@ -0,0 +1,103 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the batched processing of trace records."""
+
+import struct
+import unittest
+
+from triton import ARCH, CPUSIZE, Instruction, MemoryAccess, TritonContext
+
+
+class TestProcessBlock(unittest.TestCase):
+
+    """Testing processBlock."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+
+    def test_same_as_processing(self):
+        trace = [
+            (0x400000, "\x48\xc7\xc0\x01\x00\x00\x00"),  # mov rax, 1
+            (0x400007, "\x48\x01\xc3"),                  # add rbx, rax
+            (0x40000a, "\x48\x89\x19"),                  # mov qword ptr [rcx], rbx
+        ]
+
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        for address, opcode in trace:
+            inst = Instruction(opcode)
+            inst.setAddress(address)
+            self.assertTrue(ctx.processing(inst))
+
+        self.assertEqual(self.Triton.processBlock(trace), 3)
+        for reg in [ctx.registers.rax, ctx.registers.rbx, ctx.registers.rip]:
+            self.assertEqual(self.Triton.getConcreteRegisterValue(reg), ctx.getConcreteRegisterValue(reg))
+        self.assertEqual(len(self.Triton.getSymbolicExpressions()), len(ctx.getSymbolicExpressions()))
+
+    def test_deltas(self):
+        rax = self.Triton.registers.rax
+        rsi = self.Triton.registers.rsi
+
+        # The recorded values are set before the instruction
+        trace = [
+            (0x400000, "\x0f\x05", [(rax, 0x27)]),                                   # syscall
+            (0x400002, "\x48\x8b\x1e", [(rax, 0x1337), (rsi, 0x1000)], [(0x1000, "\x41\x42")]), # mov rbx, qword ptr [rsi]
+        ]
+        self.assertEqual(self.Triton.processBlock(trace), 2)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(rax), 0x1337)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rbx), 0x4241)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(MemoryAccess(0x1000, CPUSIZE.WORD)), 0x4241)
+
+    def test_callback(self):
+        seen = list()
+
+        def callback(ctx, inst):
+            seen.append((inst.getAddress(), ctx.getConcreteRegisterValue(ctx.registers.rax)))
+
+        trace = [
+            (0x400000, "\x48\xff\xc0"),                    # inc rax
+            (0x400003, "\x48\xff\xc0", None, None, True),  # inc rax
+            (0x400006, "\x48\xff\xc0", None, None, False), # inc rax
+        ]
+        self.assertEqual(self.Triton.processBlock(trace, callback), 3)
+        self.assertEqual(seen, [(0x400003, 2)])
+
+    def test_buffer(self):
+        seen = list()
+
+        def callback(ctx, inst):
+            seen.append((inst.getAddress(), ctx.getConcreteRegisterValue(ctx.registers.rax), len(inst.getWrittenRegisters()) > 0))
+
+        trace  = struct.pack('<QB', 0x400000, 3) + "\x48\xff\xc0"         # inc rax
+        trace += struct.pack('<QB', 0x400003, 3 | 0x80) + "\x48\xff\xc0"  # inc rax
+        trace += struct.pack('<QB', 0x400006, 3) + "\x48\xff\xc0"         # inc rax
+
+        self.assertEqual(self.Triton.processBlock(trace, callback), 3)
+        self.assertEqual(self.Triton.processBlock(bytearray(trace)), 3)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rax), 6)
+        self.assertEqual(seen, [(0x400003, 2, True)])
+
+        with self.assertRaises(TypeError):
+            self.Triton.processBlock(trace[:-1])
+
+    def test_unsupported(self):
+        trace = [
+            (0x400000, "\x48\xff\xc0"),  # inc rax
+            (0x400003, "\x0f\x0b"),      # ud2
+            (0x400005, "\x48\xff\xc0"),  # inc rax
+        ]
+        # The unsupported instructions are skipped
+        self.assertEqual(self.Triton.processBlock(trace), 2)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rax), 2)
+
+    def test_invalid(self):
+        with self.assertRaises(TypeError):
+            self.Triton.processBlock([(0x400000,)])
+
+        with self.assertRaises(TypeError):
+            self.Triton.processBlock([(0x400000, "\x90", [(0, 1)])])
+
+        with self.assertRaises(TypeError):
+            self.Triton.processBlock([(0x400000, "\x90")], 1)
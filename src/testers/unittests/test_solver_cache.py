@@ -0,0 +1,183 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the solver cache."""
+
+import os
+import tempfile
+import unittest
+
+from triton import ARCH, TritonContext
+
+
+class TestSolverCache(unittest.TestCase):
+
+    """Testing the solver cache."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.setSolverCacheSize(16)
+        self.ast = self.ctx.getAstContext()
+
+    def test_disabled(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ast = ctx.getAstContext()
+        var = ast.variable(ctx.newSymbolicVariable(8))
+
+        self.assertEqual(ctx.getSolverCacheSize(), 0)
+        ctx.getModel(ast.equal(var, ast.bv(1, 8)))
+        self.assertEqual(ctx.getSolverCacheStats()['queries'], 0)
+
+    def test_hits(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        # The same structure is built twice
+        model1 = self.ctx.getModel(self.ast.equal(var, self.ast.bv(42, 8)))
+        model2 = self.ctx.getModel(self.ast.equal(var, self.ast.bv(42, 8)))
+        self.assertEqual(model1[0].getValue(), 42)
+        self.assertEqual(model2[0].getValue(), 42)
+
+        self.assertEqual(self.ctx.getModel(self.ast.land([self.ast.bvugt(var, self.ast.bv(1, 8)), self.ast.bvult(var, self.ast.bv(1, 8))])), dict())
+        self.assertEqual(self.ctx.getModel(self.ast.land([self.ast.bvugt(var, self.ast.bv(1, 8)), self.ast.bvult(var, self.ast.bv(1, 8))])), dict())
+
+        stats = self.ctx.getSolverCacheStats()
+        self.assertEqual(stats['queries'], 4)
+        self.assertEqual(stats['hits'], 2)
+        self.assertEqual(stats['misses'], 2)
+        self.assertEqual(stats['entries'], 2)
+
+    def test_model_hits(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        self.ctx.getModel(self.ast.equal(var, self.ast.bv(42, 8)))
+
+        # The previous model satisfies the new constraint
+        model = self.ctx.getModel(self.ast.bvugt(var, self.ast.bv(10, 8)))
+        self.assertEqual(model[0].getValue(), 42)
+        self.assertEqual(self.ctx.getSolverCacheStats()['modelHits'], 1)
+
+        # It does not satisfy this one
+        model = self.ctx.getModel(self.ast.bvult(var, self.ast.bv(10, 8)))
+        self.assertLess(model[0].getValue(), 10)
+        self.assertEqual(self.ctx.getSolverCacheStats()['misses'], 2)
+
+    def test_model_variables(self):
+        var1   = self.ast.variable(self.ctx.newSymbolicVariable(8))
+        symvar = self.ctx.newSymbolicVariable(8)
+        var2   = self.ast.variable(symvar)
+        self.ctx.setConcreteSymbolicVariableValue(symvar, 7)
+
+        # The solver may leave var2 free, it is part of the model anyway
+        model1 = self.ctx.getModel(self.ast.equal(var1 + var2 * 0, self.ast.bv(5, 8)))
+        model2 = self.ctx.getModel(self.ast.equal(var1 + var2 * 0, self.ast.bv(5, 8)))
+        self.assertEqual(self.ctx.getSolverCacheStats()['hits'], 1)
+        self.assertEqual(sorted(model1.keys()), [0, 1])
+        self.assertEqual(sorted(model2.keys()), [0, 1])
+        self.assertEqual(model1[0].getValue(), 5)
+        self.assertEqual(model2[0].getValue(), 5)
+        self.assertEqual(model1[1].getValue(), model2[1].getValue())
+
+    def test_references(self):
+        var  = self.ast.variable(self.ctx.newSymbolicVariable(8))
+        exp1 = self.ctx.newSymbolicExpression(var + 1)
+        exp2 = self.ctx.newSymbolicExpression(var + 1)
+
+        # Both constraints are the same once unrolled
+        self.ctx.getModel(self.ast.equal(self.ast.reference(exp1), self.ast.bv(5, 8)))
+        model = self.ctx.getModel(self.ast.equal(self.ast.reference(exp2), self.ast.bv(5, 8)))
+        self.assertEqual(model[0].getValue(), 4)
+        self.assertEqual(self.ctx.getSolverCacheStats()['hits'], 1)
+
+    def test_collisions(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        # The hash of bv(151, 8) is 0, both constraints share the same hash
+        self.assertEqual(self.ctx.getModel(self.ast.land([self.ast.equal(var, self.ast.bv(151, 8)), self.ast.equal(var, self.ast.bv(1, 8))])), dict())
+        model = self.ctx.getModel(self.ast.land([self.ast.equal(var, self.ast.bv(151, 8)), self.ast.equal(var, self.ast.bv(151, 8))]))
+        self.assertEqual(model[0].getValue(), 151)
+        self.assertEqual(self.ctx.getSolverCacheStats()['hits'], 0)
+
+    def test_shared_dag(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        # The tree behind this DAG is exponential, the hit is confirmed on the DAG
+        node = var
+        for _ in range(200):
+            node = node + node
+        self.ctx.getModel(self.ast.equal(node + var, self.ast.bv(1, 8)))
+        self.ctx.getModel(self.ast.equal(node + var, self.ast.bv(1, 8)))
+        self.assertEqual(self.ctx.getSolverCacheStats()['hits'], 1)
+
+    def test_eviction(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        self.ctx.setSolverCacheSize(4)
+        for i in range(10):
+            self.ctx.getModel(self.ast.equal(var, self.ast.bv(i, 8)))
+
+        stats = self.ctx.getSolverCacheStats()
+        self.assertEqual(stats['entries'], 4)
+        self.assertEqual(stats['evictions'], 6)
+
+        self.ctx.clearSolverCache()
+        self.assertEqual(self.ctx.getSolverCacheStats()['entries'], 0)
+
+    def test_file(self):
+        fd, path = tempfile.mkstemp()
+        os.close(fd)
+
+        try:
+            var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+            self.ctx.setSolverCacheFile(path)
+            self.assertEqual(self.ctx.getSolverCacheFile(), path)
+            self.ctx.getModel(self.ast.equal(var, self.ast.bv(42, 8)))
+            self.ctx.getModel(self.ast.equal(var, self.ast.bvadd(var, self.ast.bv(1, 8))))
+
+            # Another run on the same program
+            ctx = TritonContext()
+            ctx.setArchitecture(ARCH.X86_64)
+            ctx.setSolverCacheSize(16)
+            ctx.setSolverCacheFile(path)
+            ast = ctx.getAstContext()
+            var = ast.variable(ctx.newSymbolicVariable(8))
+
+            # The model of the file is checked, the unsatisfiable answer is not kept
+            model = ctx.getModel(ast.equal(var, ast.bv(42, 8)))
+            self.assertEqual(model[0].getValue(), 42)
+            self.assertEqual(ctx.getModel(ast.equal(var, ast.bvadd(var, ast.bv(1, 8)))), dict())
+
+            stats = ctx.getSolverCacheStats()
+            self.assertEqual(stats['hits'], 1)
+            self.assertEqual(stats['misses'], 1)
+        finally:
+            os.remove(path)
+
+    def test_file_size(self):
+        fd, path = tempfile.mkstemp()
+        os.close(fd)
+
+        try:
+            var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+            self.ctx.setSolverCacheSize(4)
+            self.ctx.setSolverCacheFile(path)
+
+            # The file is rewritten with the entries kept once it holds twice the size of the cache
+            for i in range(30):
+                self.ctx.getModel(self.ast.equal(var, self.ast.bv(i, 8)))
+                with open(path) as f:
+                    self.assertLessEqual(len(f.readlines()), 8)
+        finally:
+            os.remove(path)
+
+    def test_invalid(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+
+        # The size must be set first
+        with self.assertRaises(TypeError):
+            ctx.setSolverCacheFile("queries.cache")
+
+        with self.assertRaises(TypeError):
+            self.ctx.setSolverCacheSize("16")
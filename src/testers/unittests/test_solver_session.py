@@ -0,0 +1,122 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the incremental solver session."""
+
+import unittest
+
+from triton import ARCH, Instruction, TritonContext
+
+
+class TestSolverSession(unittest.TestCase):
+
+    """Testing the incremental solver session."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ast = self.ctx.getAstContext()
+
+    def test_scopes(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        self.ctx.addSolverConstraint(self.ast.bvugt(var, self.ast.bv(10, 8)))
+        self.assertTrue(self.ctx.isSolverSat())
+
+        self.ctx.pushSolver()
+        self.assertEqual(self.ctx.getSolverScopes(), 1)
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(5, 8)))
+        self.assertFalse(self.ctx.isSolverSat())
+        self.assertEqual(self.ctx.getSolverModel(), dict())
+        self.ctx.popSolver()
+        self.assertEqual(self.ctx.getSolverScopes(), 0)
+
+        self.ctx.pushSolver()
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(42, 8)))
+        model = self.ctx.getSolverModel()
+        self.assertEqual(len(model), 1)
+        self.assertEqual(model.values()[0].getValue(), 42)
+        self.ctx.popSolver()
+
+        # The constraint of the first scope is still there
+        model = self.ctx.getSolverModel()
+        self.assertGreater(model.values()[0].getValue(), 10)
+
+    def test_reset(self):
+        var = self.ast.variable(self.ctx.newSymbolicVariable(8))
+
+        self.ctx.pushSolver()
+        self.ctx.pushSolver()
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(1, 8)))
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(2, 8)))
+        self.assertFalse(self.ctx.isSolverSat())
+
+        self.ctx.popSolver(2)
+        self.assertTrue(self.ctx.isSolverSat())
+
+        self.ctx.pushSolver()
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(1, 8)))
+        self.ctx.addSolverConstraint(self.ast.equal(var, self.ast.bv(2, 8)))
+        self.ctx.resetSolver()
+        self.assertEqual(self.ctx.getSolverScopes(), 0)
+        self.assertTrue(self.ctx.isSolverSat())
+
+    def test_set_ast(self):
+        var  = self.ast.variable(self.ctx.newSymbolicVariable(8))
+        expr = self.ctx.newSymbolicExpression(self.ast.bvadd(var, self.ast.bv(1, 8)))
+        node = self.ast.equal(self.ast.reference(expr), self.ast.bv(10, 8))
+
+        self.ctx.pushSolver()
+        self.ctx.addSolverConstraint(node)
+        self.assertEqual(self.ctx.getSolverModel().values()[0].getValue(), 9)
+        self.ctx.popSolver()
+
+        # The translation of a reference follows the new AST of its expression
+        expr.setAst(self.ast.bvadd(var, self.ast.bv(2, 8)))
+        self.ctx.addSolverConstraint(node)
+        self.assertEqual(self.ctx.getSolverModel().values()[0].getValue(), 8)
+
+    def test_invalid(self):
+        with self.assertRaises(TypeError):
+            self.ctx.popSolver()
+
+        with self.assertRaises(TypeError):
+            self.ctx.addSolverConstraint(self.ast.bv(1, 8))
+
+        with self.assertRaises(TypeError):
+            self.ctx.addSolverConstraint(1)
+
+    def test_path_constraints(self):
+        trace = [
+            "\x48\x83\xf8\x10",         # cmp rax, 0x10
+            "\x72\x00",                 # jb +0
+            "\x48\x83\xfb\x20",         # cmp rbx, 0x20
+            "\x74\x00",                 # je +0
+            "\x48\x01\xd8",             # add rax, rbx
+            "\x48\x3d\x00\x01\x00\x00", # cmp rax, 0x100
+            "\x77\x00",                 # ja +0
+        ]
+
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rax)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rbx)
+        for opcode in trace:
+            self.ctx.processing(Instruction(opcode))
+
+        # Each branch is negated on top of the previous path constraints
+        prefix = [self.ast.equal(self.ast.bvtrue(), self.ast.bvtrue())]
+        for pc in self.ctx.getPathConstraints():
+            for branch in pc.getBranchConstraints():
+                if branch['isTaken']:
+                    continue
+                self.ctx.pushSolver()
+                self.ctx.addSolverConstraint(branch['constraint'])
+                session = self.ctx.getSolverModel()
+                self.ctx.popSolver()
+
+                model = self.ctx.getModel(self.ast.land(prefix + [branch['constraint']]))
+                self.assertEqual(len(session) > 0, len(model) > 0)
+
+            prefix.append(pc.getTakenPathConstraintAst())
+            self.ctx.addSolverConstraint(pc.getTakenPathConstraintAst())
+
+        self.assertTrue(self.ctx.isSolverSat())
@@ -4,7 +4,7 @@
 
 import unittest
 
-from triton import ARCH, Instruction, CPUSIZE, MemoryAccess, Immediate, TritonContext
+from triton import ARCH, Instruction, CPUSIZE, MemoryAccess, Immediate, TritonContext, MODE
 
 
 class TestSymbolic(unittest.TestCase):
@@ -77,6 +77,83 @@ class TestSymbolic(unittest.TestCase):
 
         self.assertEqual(self.Triton.getSymbolicMemoryValue(mem), 0x11223344)
 
+    def test_partial_memory_overlap(self):
+        """Check loads and stores which partially overlap a wider store."""
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rax, 0x1122334455667788)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rbx, 0x1000)
+        self.Triton.convertRegisterToSymbolicVariable(self.Triton.registers.rax)
+        self.Triton.processing(Instruction("\x48\x89\x03")) # mov qword ptr [rbx], rax
+        self.Triton.setConcreteMemoryValue(MemoryAccess(0x1008, CPUSIZE.BYTE), 0x99)
+
+        # The load covers the upper bytes of the store and two concrete bytes
+        node = self.Triton.buildSymbolicMemory(MemoryAccess(0x1006, CPUSIZE.DWORD))
+        self.assertEqual(node.evaluate(), 0x00991122)
+        self.assertEqual(node.getBitvectorSize(), CPUSIZE.DWORD_BIT)
+        self.assertTrue(node.isSymbolized())
+
+        # A store in the middle splits the wider one
+        expr = self.Triton.newSymbolicExpression(self.astCtxt.bv(0xaabb, 16))
+        self.Triton.assignSymbolicExpressionToMemory(expr, MemoryAccess(0x1002, CPUSIZE.WORD))
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0x1000, CPUSIZE.QWORD)), 0x11223344aabb7788)
+        self.assertTrue(self.Triton.isMemorySymbolized(MemoryAccess(0x1004, CPUSIZE.DWORD)))
+        self.assertFalse(self.Triton.isMemorySymbolized(MemoryAccess(0x1002, CPUSIZE.WORD)))
+
+        # Each byte still has its own expression
+        expr = self.Triton.getSymbolicExpressionFromId(self.Triton.getSymbolicMemoryId(0x1005))
+        self.assertEqual(expr.getAst().evaluate(), 0x33)
+        self.assertEqual(len(self.Triton.getSymbolicMemory()), 8)
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0x1000, CPUSIZE.QWORD)), 0x11223344aabb7788)
+
+        # The expressions of the bytes are built once, the queries do not modify the memory
+        count = len(self.Triton.getSymbolicExpressions())
+        self.assertEqual(self.Triton.getSymbolicMemoryId(0x1005), expr.getId())
+        self.assertEqual(len(self.Triton.getSymbolicMemory()), 8)
+        self.assertEqual(len(self.Triton.getSymbolicExpressions()), count)
+
+        # Until the byte is assigned again
+        self.Triton.assignSymbolicExpressionToMemory(self.Triton.newSymbolicExpression(self.astCtxt.bv(0xcc, 8)), MemoryAccess(0x1005, CPUSIZE.BYTE))
+        self.assertNotEqual(self.Triton.getSymbolicMemoryId(0x1005), expr.getId())
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0x1000, CPUSIZE.QWORD)), 0x1122cc44aabb7788)
+
+    def test_expressions_table(self):
+        """Check the expressions keep their ids once some of them are removed."""
+        self.Triton.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        self.Triton.convertRegisterToSymbolicVariable(self.Triton.registers.rax)
+        for i in range(5000):
+            self.Triton.processing(Instruction("\x48\x31\xc9")) # xor rcx, rcx
+        self.Triton.processing(Instruction("\x48\xff\xc0")) # inc rax
+
+        # Only the expressions of the symbolic variable and of inc are kept
+        exprs = self.Triton.getSymbolicExpressions()
+        ids = sorted(exprs.keys())
+        self.assertEqual(ids[0], 0)
+        self.assertGreater(ids[1], 5000)
+        for i in ids:
+            self.assertEqual(exprs[i].getId(), i)
+            self.assertTrue(self.Triton.isSymbolicExpressionIdExists(i))
+        self.assertFalse(self.Triton.isSymbolicExpressionIdExists(1))
+        with self.assertRaises(Exception):
+            self.Triton.getSymbolicExpressionFromId(1)
+
+    def test_wrapping_memory(self):
+        """Check a store which wraps around the address space."""
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rax, 0x1122334455667788)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rbx, 0xfffffffffffffffc)
+        self.Triton.convertRegisterToSymbolicVariable(self.Triton.registers.rax)
+        self.Triton.processing(Instruction("\x48\x89\x03")) # mov qword ptr [rbx], rax
+
+        # The upper bytes of the store are at address 0
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0xfffffffffffffffc, CPUSIZE.QWORD)), 0x1122334455667788)
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0, CPUSIZE.DWORD)), 0x11223344)
+        self.assertTrue(self.Triton.isMemorySymbolized(MemoryAccess(0, CPUSIZE.DWORD)))
+        self.assertFalse(self.Triton.isMemorySymbolized(MemoryAccess(4, CPUSIZE.DWORD)))
+        self.assertEqual(len(self.Triton.getSymbolicMemory()), 8)
+
+        # A store over the last byte of the address space leaves the other ones
+        expr = self.Triton.newSymbolicExpression(self.astCtxt.bv(0xaa, 8))
+        self.Triton.assignSymbolicExpressionToMemory(expr, MemoryAccess(0xffffffffffffffff, CPUSIZE.BYTE))
+        self.assertEqual(self.Triton.getSymbolicMemoryValue(MemoryAccess(0xfffffffffffffffc, CPUSIZE.QWORD)), 0x11223344aa667788)
+
     def test_bind_expr_to_register(self):
         """Check symbolic expression binded to register."""
         expr1 = self.Triton.newSymbolicExpression(self.astCtxt.bv(0x11223344, 64))
@@ -4,7 +4,7 @@
 
 import unittest
 
-from triton import ARCH, Instruction, MemoryAccess, TritonContext
+from triton import ARCH, CPUSIZE, Instruction, MemoryAccess, MODE, TritonContext
 
 
 class TestTaint(unittest.TestCase):
@@ -85,6 +85,52 @@ class TestTaint(unittest.TestCase):
         self.assertFalse(Triton.isRegisterTainted(Triton.registers.eax))
         self.assertFalse(Triton.isRegisterTainted(Triton.registers.ax))
 
+    def test_taint_sub_registers(self):
+        """Check the byte precision of the register taint."""
+        Triton = TritonContext()
+        Triton.setArchitecture(ARCH.X86_64)
+
+        Triton.taintRegister(Triton.registers.al)
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.rax))
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.ax))
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.ah))
+        Triton.untaintRegister(Triton.registers.rax)
+
+        # Only the low byte of rax is controlled
+        Triton.setConcreteRegisterValue(Triton.registers.rbx, 0x1000)
+        Triton.taintMemory(0x1000)
+        Triton.processing(Instruction("\x66\xb8\x22\x11")) # mov ax, 0x1122
+        Triton.processing(Instruction("\x8a\x03"))         # mov al, byte ptr [rbx]
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.al))
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.ah))
+
+        inst = Instruction("\x80\xfc\x99")                 # cmp ah, 0x99
+        Triton.processing(inst)
+        self.assertFalse(inst.isTainted())
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.zf))
+
+        # A byte operation spreads the taint to the whole destination
+        Triton.processing(Instruction("\x66\x01\xc1"))     # add cx, ax
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.cl))
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.ch))
+
+        # A 16-bit write keeps the taint of the upper bytes
+        Triton.taintRegister(Triton.registers.rdx)
+        Triton.processing(Instruction("\x66\x89\xf2"))     # mov dx, si
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.dx))
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.rdx))
+
+        # A 32-bit write zeroes the upper bytes
+        Triton.processing(Instruction("\x89\xf2"))         # mov edx, esi
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.rdx))
+
+        # Flags
+        Triton.processing(Instruction("\x38\xc4"))         # cmp ah, al
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.zf))
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.cf))
+        self.assertFalse(Triton.isRegisterTainted(Triton.registers.df))
+
+
     def test_taint_assignement_memory_immediate(self):
         """Check tainting assignment memory <- immediate."""
         Triton = TritonContext()
@@ -469,3 +515,198 @@ class TestTaint(unittest.TestCase):
         Triton.setTaintRegister(Triton.registers.rax, False)
         self.assertTrue(Triton.isRegisterTainted(Triton.registers.rax))
 
+
+    def test_taint_only_processing(self):
+        """Taint propagation with the symbolic engine disabled"""
+        Triton = TritonContext()
+        Triton.setArchitecture(ARCH.X86_64)
+        Triton.convertRegisterToSymbolicVariable(Triton.registers.rcx)
+        Triton.enableSymbolicEngine(False)
+
+        Triton.setConcreteRegisterValue(Triton.registers.rax, 0x1000)
+        Triton.setConcreteRegisterValue(Triton.registers.rbx, 0x41)
+        Triton.taintRegister(Triton.registers.rbx)
+        expressions = len(Triton.getSymbolicExpressions())
+
+        trace = [
+            "\x48\x89\x18",     # mov qword ptr [rax], rbx
+            "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+            "\x48\x31\xc9",     # xor rcx, rcx
+            "\x48\x39\xd3",     # cmp rbx, rdx
+            "\x74\x00",         # je +0
+        ]
+        for opcode in trace:
+            inst = Instruction(opcode)
+            self.assertTrue(Triton.processing(inst))
+            self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+
+        # The taint and the concrete state are updated
+        self.assertTrue(Triton.isMemoryTainted(MemoryAccess(0x1000, 8)))
+        self.assertTrue(Triton.isRegisterTainted(Triton.registers.rdx))
+        self.assertEqual(Triton.getConcreteRegisterValue(Triton.registers.rdx), 0x41)
+        self.assertEqual(Triton.getConcreteRegisterValue(Triton.registers.rcx), 0)
+        self.assertEqual(Triton.getConcreteRegisterValue(Triton.registers.zf), 1)
+
+        # The symbolic state is left as is
+        self.assertEqual(len(Triton.getSymbolicExpressions()), expressions)
+        self.assertEqual(len(Triton.getPathConstraints()), 0)
+        self.assertTrue(Triton.isRegisterSymbolized(Triton.registers.rcx))
+        self.assertFalse(Triton.isMemorySymbolized(MemoryAccess(0x1000, 8)))
+
+
+    def test_taint_summaries(self):
+        """Taint propagation from the opcode summaries"""
+        trace = [
+            "\x48\x89\x18",     # mov qword ptr [rax], rbx
+            "\x48\x8b\x10",     # mov rdx, qword ptr [rax]
+            "\x48\x31\xc9",     # xor rcx, rcx
+            "\x48\x01\xd6",     # add rsi, rdx
+            "\x48\x39\xd7",     # cmp rdi, rdx
+            "\x0f\x94\xc1",     # sete cl
+            "\x52",             # push rdx
+            "\x4c\x8d\x24\x16", # lea r12, [rsi + rdx]
+            "\x74\x00",         # je +0
+        ]
+
+        def run(summaries):
+            Triton = TritonContext()
+            Triton.setArchitecture(ARCH.X86_64)
+            Triton.enableSymbolicEngine(False)
+            Triton.enableMode(MODE.TAINT_SUMMARIES, summaries)
+            Triton.setConcreteRegisterValue(Triton.registers.rax, 0x1000)
+            Triton.setConcreteRegisterValue(Triton.registers.rsp, 0x2000)
+            Triton.taintRegister(Triton.registers.rbx)
+            for opcode in trace:
+                inst = Instruction(opcode)
+                self.assertTrue(Triton.processing(inst))
+                self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+            return Triton
+
+        semantics = run(False)
+        summaries = run(True)
+
+        # The summaries spread the same taint as the semantics on this trace
+        for reg in [summaries.registers.rbx, summaries.registers.rdx, summaries.registers.rsi,
+                    summaries.registers.rcx, summaries.registers.r12, summaries.registers.zf,
+                    summaries.registers.cf, summaries.registers.rip]:
+            self.assertEqual(summaries.isRegisterTainted(reg), semantics.isRegisterTainted(reg))
+        self.assertEqual(summaries.getTaintedMemory(), semantics.getTaintedMemory())
+        self.assertTrue(summaries.isRegisterTainted(summaries.registers.rip))
+        self.assertTrue(summaries.isMemoryTainted(MemoryAccess(0x1ff8, CPUSIZE.QWORD)))
+
+        # The concrete state is not updated by the summaries, it is provided by the caller
+        self.assertEqual(summaries.getConcreteMemoryValue(MemoryAccess(0x1000, CPUSIZE.QWORD)), 0)
+        self.assertEqual(summaries.getConcreteRegisterValue(summaries.registers.rsp), 0x2000)
+        summaries.setConcreteRegisterValue(summaries.registers.rsp, 0x1ff8)
+        inst = Instruction("\x41\x5f") # pop r15
+        self.assertTrue(summaries.processing(inst))
+        self.assertTrue(summaries.isRegisterTainted(summaries.registers.r15))
+
+        # The accesses are still recorded, without AST
+        self.assertEqual([(m.getAddress(), m.getSize(), n) for m, n in inst.getLoadAccess()], [(0x1ff8, CPUSIZE.QWORD, None)])
+        self.assertEqual(len(inst.getStoreAccess()), 0)
+        self.assertEqual([r.getName() for r, n in inst.getReadRegisters()], ['rsp'])
+        self.assertEqual(sorted([r.getName() for r, n in inst.getWrittenRegisters()]), ['r15', 'rip', 'rsp'])
+
+        # Opcodes without summary are processed by the semantics
+        inst = Instruction("\x48\xf7\xe3") # mul rbx
+        self.assertTrue(summaries.processing(inst))
+        self.assertTrue(summaries.isRegisterTainted(summaries.registers.rax))
+
+
+    def test_taint_memory_across_pages(self):
+        """Memory to memory taint propagation across page boundaries"""
+        Triton = TritonContext()
+        Triton.setArchitecture(ARCH.X86_64)
+
+        # Only the bytes 0x1ffe and 0x2001 are tainted
+        Triton.taintMemory(0x1ffe)
+        Triton.taintMemory(0x2001)
+        self.assertTrue(Triton.isMemoryTainted(MemoryAccess(0x1ffc, 8)))
+        self.assertFalse(Triton.isMemoryTainted(MemoryAccess(0x1ff6, 8)))
+
+        # Assignment copies the taint byte per byte
+        self.assertTrue(Triton.taintAssignmentMemoryMemory(MemoryAccess(0x5ffc, 8), MemoryAccess(0x1ffc, 8)))
+        self.assertEqual(sorted(a for a in Triton.getTaintedMemory() if a >= 0x5000), [0x5ffe, 0x6001])
+
+        # Assignment from an untainted area untaints the destination
+        self.assertFalse(Triton.taintAssignmentMemoryMemory(MemoryAccess(0x5ffc, 8), MemoryAccess(0x9000, 8)))
+        self.assertFalse(Triton.isMemoryTainted(MemoryAccess(0x5ffc, 8)))
+
+        # Union keeps the destination taint
+        Triton.taintMemory(0x8000)
+        self.assertTrue(Triton.taintUnionMemoryMemory(MemoryAccess(0x8000, 4), MemoryAccess(0x1fff, 4)))
+        self.assertEqual(sorted(a for a in Triton.getTaintedMemory() if a >= 0x5000), [0x8000, 0x8002])
+
+        # Large untaint
+        Triton.untaintMemory(MemoryAccess(0x1ffe, 4))
+        self.assertFalse(Triton.isMemoryTainted(MemoryAccess(0x1ff0, 32)))
+
+
+    def test_taint_labels(self):
+        """Taint propagation of several labelled sources in one pass"""
+        def run(summaries):
+            Triton = TritonContext()
+            Triton.setArchitecture(ARCH.X86_64)
+            Triton.enableSymbolicEngine(not summaries)
+            Triton.enableMode(MODE.TAINT_SUMMARIES, summaries)
+            Triton.setConcreteRegisterValue(Triton.registers.rsi, 0x1000)
+            Triton.setConcreteRegisterValue(Triton.registers.rdi, 0x2000)
+            Triton.taintMemoryWithLabel(MemoryAccess(0x1000, CPUSIZE.QWORD), 1)
+            Triton.taintMemoryWithLabel(MemoryAccess(0x2000, CPUSIZE.QWORD), 2)
+            Triton.taintRegister(Triton.registers.r8)
+
+            trace = [
+                "\x48\x8b\x06",     # mov rax, qword ptr [rsi]
+                "\x48\x8b\x1f",     # mov rbx, qword ptr [rdi]
+                "\x48\x89\xc1",     # mov rcx, rax
+                "\x48\x01\xd9",     # add rcx, rbx
+                "\x4c\x01\xc3",     # add rbx, r8
+                "\x48\x89\x0f",     # mov qword ptr [rdi], rcx
+                "\x48\x39\xd8",     # cmp rax, rbx
+                "\x74\x00",         # je +0
+            ]
+            for opcode in trace:
+                self.assertTrue(Triton.processing(Instruction(opcode)))
+            return Triton
+
+        for Triton in [run(False), run(True)]:
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rax), [1])
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rbx), [2])
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rcx), [1, 2])
+            self.assertEqual(Triton.getMemoryTaintLabels(MemoryAccess(0x2000, CPUSIZE.QWORD)), [1, 2])
+            self.assertEqual(Triton.getMemoryTaintLabels(MemoryAccess(0x1000, CPUSIZE.DWORD)), [1])
+
+            # The flags and the branch take the labels of both operands
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.zf), [1, 2])
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rip), [1, 2])
+
+            # A byte tainted without label is tainted with an empty set
+            self.assertTrue(Triton.isRegisterTainted(Triton.registers.r8))
+            self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.r8), [])
+            self.assertTrue(Triton.isMemoryTainted(MemoryAccess(0x2000, CPUSIZE.QWORD)))
+
+        # The labels are per byte and are removed with the taint
+        Triton = TritonContext()
+        Triton.setArchitecture(ARCH.X86_64)
+        Triton.taintRegisterWithLabel(Triton.registers.al, 1)
+        Triton.taintRegisterWithLabel(Triton.registers.ah, 2)
+        Triton.taintRegisterWithLabel(Triton.registers.ah, 3)
+        self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.al), [1])
+        self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.ah), [2, 3])
+        self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rax), [1, 2, 3])
+        Triton.untaintRegister(Triton.registers.ah)
+        self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.rax), [1])
+
+        Triton.taintAssignmentMemoryRegister(MemoryAccess(0x1000, CPUSIZE.WORD), Triton.registers.al)
+        self.assertEqual(Triton.getMemoryTaintLabels(MemoryAccess(0x1001, CPUSIZE.BYTE)), [1])
+        Triton.untaintMemory(MemoryAccess(0x1000, CPUSIZE.WORD))
+        self.assertEqual(Triton.getMemoryTaintLabels(MemoryAccess(0x1000, CPUSIZE.WORD)), [])
+
+        # A plain taint keeps the labels
+        Triton.taintRegister(Triton.registers.al)
+        self.assertEqual(Triton.getRegisterTaintLabels(Triton.registers.al), [1])
+        Triton.taintMemoryWithLabel(MemoryAccess(0x3000, CPUSIZE.BYTE), 4)
+        Triton.taintMemory(MemoryAccess(0x3000, CPUSIZE.WORD))
+        self.assertEqual(Triton.getMemoryTaintLabels(MemoryAccess(0x3000, CPUSIZE.WORD)), [4])
+        self.assertTrue(Triton.isMemoryTainted(MemoryAccess(0x3001, CPUSIZE.BYTE)))
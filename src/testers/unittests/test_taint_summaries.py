@@ -0,0 +1,348 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the taint summaries against the semantics."""
+
+import unittest
+
+from triton import ARCH, MODE, TritonContext, Instruction
+
+
+# The summary spreads exactly the taint of the semantics
+EXACT   = 0
+# The summary over-approximates the semantics
+OVER    = 1
+# The summary is more precise than the semantics on its destination and on
+# the flags (setcc, bt* and tzcnt), the rest of the state is equal
+PRECISE = 2
+# Zero idiom, the summary untaints its destination
+IDIOM   = 3
+
+# One instruction per opcode of the x86 summary table
+CODE = [
+    # Moves
+    ("\x48\x89\xd8", EXACT),                    # mov rax, rbx
+    ("\x48\x8b\x01", EXACT),                    # mov rax, qword ptr [rcx]
+    ("\x48\x89\x01", EXACT),                    # mov qword ptr [rcx], rax
+    ("\x48\xb8\x88\x77\x66\x55\x44\x33\x22\x11", EXACT), # movabs rax, 0x1122334455667788
+    ("\x0f\xb6\xc3", EXACT),                    # movzx eax, bl
+    ("\x48\x0f\xbf\xc3", EXACT),                # movsx rax, bx
+    ("\x48\x63\xc3", EXACT),                    # movsxd rax, ebx
+    ("\x66\x0f\x6e\xc3", EXACT),                # movd xmm0, ebx
+    ("\x66\x48\x0f\x6e\xc3", EXACT),            # movq xmm0, rbx
+    ("\xf3\x0f\x7e\xc1", PRECISE, 'xmm0'),      # movq xmm0, xmm1
+    ("\x66\x0f\x28\xc1", EXACT),                # movapd xmm0, xmm1
+    ("\x0f\x28\xc1", EXACT),                    # movaps xmm0, xmm1
+    ("\x66\x0f\x6f\xc1", EXACT),                # movdqa xmm0, xmm1
+    ("\xf3\x0f\x6f\x01", EXACT),                # movdqu xmm0, xmmword ptr [rcx]
+    ("\x66\x0f\x10\xc1", EXACT),                # movupd xmm0, xmm1
+    ("\x0f\x11\x01", EXACT),                    # movups xmmword ptr [rcx], xmm0
+    ("\x48\x0f\xc3\x19", EXACT),                # movnti qword ptr [rcx], rbx
+    ("\x66\x0f\xe7\x09", EXACT),                # movntdq xmmword ptr [rcx], xmm1
+    ("\x66\x0f\x2b\x01", EXACT),                # movntpd xmmword ptr [rcx], xmm0
+    ("\x0f\x2b\x09", EXACT),                    # movntps xmmword ptr [rcx], xmm1
+    ("\x0f\xe7\x09", EXACT),                    # movntq qword ptr [rcx], mm1
+    ("\xf2\x0f\x12\xc1", EXACT),                # movddup xmm0, xmm1
+    ("\xf3\x0f\x16\xc1", EXACT),                # movshdup xmm0, xmm1
+    ("\xf3\x0f\x12\xc1", EXACT),                # movsldup xmm0, xmm1
+    ("\x66\x0f\x50\xc1", EXACT),                # movmskpd eax, xmm1
+    ("\x0f\x50\xc1", EXACT),                    # movmskps eax, xmm1
+    ("\xf2\x0f\xd6\xc1", EXACT),                # movdq2q mm0, xmm1
+    ("\xf3\x0f\xd6\xc1", EXACT),                # movq2dq xmm0, mm1
+    ("\xf2\x0f\xf0\x01", EXACT),                # lddqu xmm0, xmmword ptr [rcx]
+    ("\xc5\xfd\x6f\xc1", EXACT),                # vmovdqa ymm0, ymm1
+    ("\xc5\xfe\x6f\x01", EXACT),                # vmovdqu ymm0, ymmword ptr [rcx]
+    ("\x66\x0f\xd7\xc1", EXACT),                # pmovmskb eax, xmm1
+    ("\x66\x0f\x70\xc1\x1b", EXACT),            # pshufd xmm0, xmm1, 0x1b
+    ("\xf3\x0f\x70\xc1\x1b", EXACT),            # pshufhw xmm0, xmm1, 0x1b
+    ("\xf2\x0f\x70\xc1\x1b", EXACT),            # pshuflw xmm0, xmm1, 0x1b
+    ("\x0f\x70\xc1\x1b", EXACT),                # pshufw mm0, mm1, 0x1b
+    ("\xc5\xf9\x70\xc1\x1b", EXACT),            # vpshufd xmm0, xmm1, 0x1b
+    ("\x66\x0f\x38\x21\xc1", EXACT),            # pmovsxbd xmm0, xmm1
+    ("\x66\x0f\x38\x22\xc1", EXACT),            # pmovsxbq xmm0, xmm1
+    ("\x66\x0f\x38\x20\xc1", EXACT),            # pmovsxbw xmm0, xmm1
+    ("\x66\x0f\x38\x25\xc1", EXACT),            # pmovsxdq xmm0, xmm1
+    ("\x66\x0f\x38\x23\xc1", EXACT),            # pmovsxwd xmm0, xmm1
+    ("\x66\x0f\x38\x24\xc1", EXACT),            # pmovsxwq xmm0, xmm1
+    ("\x66\x0f\x38\x31\xc1", EXACT),            # pmovzxbd xmm0, xmm1
+    ("\x66\x0f\x38\x32\xc1", EXACT),            # pmovzxbq xmm0, xmm1
+    ("\x66\x0f\x38\x30\xc1", EXACT),            # pmovzxbw xmm0, xmm1
+    ("\x66\x0f\x38\x35\xc1", EXACT),            # pmovzxdq xmm0, xmm1
+    ("\x66\x0f\x38\x33\xc1", EXACT),            # pmovzxwd xmm0, xmm1
+    ("\x66\x0f\x38\x34\xc1", EXACT),            # pmovzxwq xmm0, xmm1
+    # Partial moves
+    ("\x0f\x16\x01", EXACT),                    # movhps xmm0, qword ptr [rcx]
+    ("\x0f\x12\x01", EXACT),                    # movlps xmm0, qword ptr [rcx]
+    ("\x66\x0f\x16\x01", EXACT),                # movhpd xmm0, qword ptr [rcx]
+    ("\x66\x0f\x12\x01", EXACT),                # movlpd xmm0, qword ptr [rcx]
+    ("\x0f\x12\xc1", EXACT),                    # movhlps xmm0, xmm1
+    ("\x0f\x16\xc1", EXACT),                    # movlhps xmm0, xmm1
+    # Vector operations
+    ("\x66\x0f\xdb\xc1", EXACT),                # pand xmm0, xmm1
+    ("\x66\x0f\xdf\xc1", EXACT),                # pandn xmm0, xmm1
+    ("\x66\x0f\xeb\x01", EXACT),                # por xmm0, xmmword ptr [rcx]
+    ("\x66\x0f\xef\xc1", EXACT),                # pxor xmm0, xmm1
+    ("\x66\x0f\xef\xc0", IDIOM, 'xmm0'),        # pxor xmm0, xmm0
+    ("\x66\x0f\x54\xc1", EXACT),                # andpd xmm0, xmm1
+    ("\x0f\x54\xc1", EXACT),                    # andps xmm0, xmm1
+    ("\x66\x0f\x55\xc1", EXACT),                # andnpd xmm0, xmm1
+    ("\x0f\x55\xc1", EXACT),                    # andnps xmm0, xmm1
+    ("\x66\x0f\x56\xc1", EXACT),                # orpd xmm0, xmm1
+    ("\x0f\x56\xc1", EXACT),                    # orps xmm0, xmm1
+    ("\x66\x0f\x57\xc1", EXACT),                # xorpd xmm0, xmm1
+    ("\x66\x0f\x57\xc0", IDIOM, 'xmm0'),        # xorpd xmm0, xmm0
+    ("\x0f\x57\xc1", EXACT),                    # xorps xmm0, xmm1
+    ("\x0f\x57\xc0", IDIOM, 'xmm0'),            # xorps xmm0, xmm0
+    ("\x66\x0f\xfc\xc1", EXACT),                # paddb xmm0, xmm1
+    ("\x66\x0f\xfe\xc1", EXACT),                # paddd xmm0, xmm1
+    ("\x66\x0f\xd4\xc1", EXACT),                # paddq xmm0, xmm1
+    ("\x66\x0f\xfd\xc1", EXACT),                # paddw xmm0, xmm1
+    ("\x66\x0f\xf8\xc1", EXACT),                # psubb xmm0, xmm1
+    ("\x66\x0f\xf8\xc0", IDIOM, 'xmm0'),        # psubb xmm0, xmm0
+    ("\x66\x0f\xfa\xc1", EXACT),                # psubd xmm0, xmm1
+    ("\x66\x0f\xfa\xc0", IDIOM, 'xmm0'),        # psubd xmm0, xmm0
+    ("\x66\x0f\xfb\xc1", EXACT),                # psubq xmm0, xmm1
+    ("\x66\x0f\xfb\xc0", IDIOM, 'xmm0'),        # psubq xmm0, xmm0
+    ("\x66\x0f\xf9\xc1", EXACT),                # psubw xmm0, xmm1
+    ("\x66\x0f\xf9\xc0", IDIOM, 'xmm0'),        # psubw xmm0, xmm0
+    ("\x66\x0f\xe0\xc1", EXACT),                # pavgb xmm0, xmm1
+    ("\x66\x0f\xe3\xc1", EXACT),                # pavgw xmm0, xmm1
+    ("\x66\x0f\x74\xc1", OVER),                 # pcmpeqb xmm0, xmm1
+    ("\x66\x0f\x76\xc1", OVER),                 # pcmpeqd xmm0, xmm1
+    ("\x66\x0f\x75\xc1", OVER),                 # pcmpeqw xmm0, xmm1
+    ("\x66\x0f\x64\xc1", OVER),                 # pcmpgtb xmm0, xmm1
+    ("\x66\x0f\x66\xc1", OVER),                 # pcmpgtd xmm0, xmm1
+    ("\x66\x0f\x65\xc1", OVER),                 # pcmpgtw xmm0, xmm1
+    ("\x66\x0f\x38\x3c\xc1", EXACT),            # pmaxsb xmm0, xmm1
+    ("\x66\x0f\x38\x3d\xc1", EXACT),            # pmaxsd xmm0, xmm1
+    ("\x66\x0f\xee\xc1", EXACT),                # pmaxsw xmm0, xmm1
+    ("\x66\x0f\xde\xc1", EXACT),                # pmaxub xmm0, xmm1
+    ("\x66\x0f\x38\x3f\xc1", EXACT),            # pmaxud xmm0, xmm1
+    ("\x66\x0f\x38\x3e\xc1", EXACT),            # pmaxuw xmm0, xmm1
+    ("\x66\x0f\x38\x38\xc1", EXACT),            # pminsb xmm0, xmm1
+    ("\x66\x0f\x38\x39\xc1", EXACT),            # pminsd xmm0, xmm1
+    ("\x66\x0f\xea\xc1", EXACT),                # pminsw xmm0, xmm1
+    ("\x66\x0f\xda\xc1", EXACT),                # pminub xmm0, xmm1
+    ("\x66\x0f\x38\x3b\xc1", EXACT),            # pminud xmm0, xmm1
+    ("\x66\x0f\x38\x3a\xc1", EXACT),            # pminuw xmm0, xmm1
+    ("\x66\x0f\x68\xc1", EXACT),                # punpckhbw xmm0, xmm1
+    ("\x66\x0f\x6a\xc1", EXACT),                # punpckhdq xmm0, xmm1
+    ("\x66\x0f\x6d\xc1", EXACT),                # punpckhqdq xmm0, xmm1
+    ("\x66\x0f\x69\xc1", EXACT),                # punpckhwd xmm0, xmm1
+    ("\x66\x0f\x60\xc1", EXACT),                # punpcklbw xmm0, xmm1
+    ("\x66\x0f\x62\xc1", EXACT),                # punpckldq xmm0, xmm1
+    ("\x66\x0f\x6c\xc1", EXACT),                # punpcklqdq xmm0, xmm1
+    ("\x66\x0f\x61\xc1", EXACT),                # punpcklwd xmm0, xmm1
+    ("\x66\x0f\x15\xc1", EXACT),                # unpckhpd xmm0, xmm1
+    ("\x0f\x15\xc1", EXACT),                    # unpckhps xmm0, xmm1
+    ("\x66\x0f\x14\xc1", EXACT),                # unpcklpd xmm0, xmm1
+    ("\x0f\x14\xc1", EXACT),                    # unpcklps xmm0, xmm1
+    ("\x66\x0f\x73\xf8\x04", EXACT),            # pslldq xmm0, 4
+    ("\x66\x0f\x73\xd8\x04", EXACT),            # psrldq xmm0, 4
+    ("\xc5\xf1\xdb\xc2", EXACT),                # vpand xmm0, xmm1, xmm2
+    ("\xc5\xf1\xdf\xc2", EXACT),                # vpandn xmm0, xmm1, xmm2
+    ("\xc5\xf1\xeb\xc2", EXACT),                # vpor xmm0, xmm1, xmm2
+    ("\xc5\xf1\xef\xc2", EXACT),                # vpxor xmm0, xmm1, xmm2
+    ("\xc5\xf1\xef\xc1", IDIOM, 'xmm0'),        # vpxor xmm0, xmm1, xmm1
+    # Arithmetic
+    ("\x48\x01\xd8", EXACT),                    # add rax, rbx
+    ("\x48\x01\x19", EXACT),                    # add qword ptr [rcx], rbx
+    ("\x48\x11\xd8", EXACT),                    # adc rax, rbx
+    ("\x48\x29\xd8", EXACT),                    # sub rax, rbx
+    ("\x48\x29\xc0", IDIOM, 'rax'),             # sub rax, rax
+    ("\x48\x1b\x01", EXACT),                    # sbb rax, qword ptr [rcx]
+    ("\x48\xf7\xd8", EXACT),                    # neg rax
+    ("\x48\xff\xc0", EXACT),                    # inc rax
+    ("\x48\xff\x09", EXACT),                    # dec qword ptr [rcx]
+    ("\x48\x39\xd8", EXACT),                    # cmp rax, rbx
+    ("\x48\x0f\xaf\xc3", EXACT),                # imul rax, rbx
+    ("\x48\x6b\xc3\x03", OVER),                 # imul rax, rbx, 3
+    # Logic
+    ("\x48\x21\xd8", EXACT),                    # and rax, rbx
+    ("\x48\x0b\x01", EXACT),                    # or rax, qword ptr [rcx]
+    ("\x48\x31\xd8", EXACT),                    # xor rax, rbx
+    ("\x31\xc0", IDIOM, 'eax'),                 # xor eax, eax
+    ("\x48\x85\xd8", EXACT),                    # test rax, rbx
+    ("\xc4\xe2\xe0\xf2\xc2", EXACT),            # andn rax, rbx, rdx
+    ("\x48\xf7\xd0", EXACT),                    # not rax
+    # Shifts and rotates
+    ("\x48\xc1\xe0\x03", EXACT),                # shl rax, 3
+    ("\x48\xd3\xe8", EXACT),                    # shr rax, cl
+    ("\x48\xc1\xf8\x03", EXACT),                # sar rax, 3
+    ("\x48\xd3\xf0", EXACT),                    # sal rax, cl
+    ("\x48\x0f\xa4\xd8\x04", OVER),             # shld rax, rbx, 4
+    ("\x48\x0f\xad\xd8", OVER),                 # shrd rax, rbx, cl
+    ("\x48\xc1\xc0\x03", EXACT),                # rol rax, 3
+    ("\x48\xd3\xc8", EXACT),                    # ror rax, cl
+    ("\x48\xc1\xd0\x03", EXACT),                # rcl rax, 3
+    ("\x48\xc1\xd8\x03", EXACT),                # rcr rax, 3
+    ("\xc4\xe2\xe9\xf7\xc3", EXACT),            # shlx rax, rbx, rdx
+    ("\xc4\xe2\xeb\xf7\xc3", EXACT),            # shrx rax, rbx, rdx
+    ("\xc4\xe2\xea\xf7\xc3", EXACT),            # sarx rax, rbx, rdx
+    ("\xc4\xe3\xfb\xf0\xc3\x03", EXACT),        # rorx rax, rbx, 3
+    # Bits
+    ("\x48\x0f\xc8", EXACT),                    # bswap rax
+    ("\x48\x0f\xbc\xc3", EXACT),                # bsf rax, rbx
+    ("\x48\x0f\xbd\xc3", EXACT),                # bsr rax, rbx
+    ("\xf3\x48\x0f\xbc\xc3", PRECISE, 'rax'),   # tzcnt rax, rbx
+    ("\xc4\xe2\xf8\xf3\xdb", EXACT),            # blsi rax, rbx
+    ("\xc4\xe2\xf8\xf3\xd3", EXACT),            # blsmsk rax, rbx
+    ("\xc4\xe2\xf8\xf3\xcb", EXACT),            # blsr rax, rbx
+    ("\xc4\xe2\xe8\xf7\xc3", EXACT),            # bextr rax, rbx, rdx
+    ("\x48\x0f\xa3\xd8", PRECISE, 'rax'),       # bt rax, rbx
+    ("\x48\x0f\xba\xf8\x03", PRECISE, 'rax'),   # btc rax, 3
+    ("\x48\x0f\xb3\xd8", PRECISE, 'rax'),       # btr rax, rbx
+    ("\x48\x0f\xab\xd8", PRECISE, 'rax'),       # bts rax, rbx
+    # Flags
+    ("\xf8", EXACT),                            # clc
+    ("\xf9", EXACT),                            # stc
+    ("\xfc", EXACT),                            # cld
+    ("\xfd", EXACT),                            # std
+    ("\xf5", EXACT),                            # cmc
+    # Conditions
+    ("\x0f\x97\xc0", PRECISE, 'al'),            # seta al
+    ("\x0f\x93\xc0", PRECISE, 'al'),            # setae al
+    ("\x0f\x92\xc0", PRECISE, 'al'),            # setb al
+    ("\x0f\x96\xc0", PRECISE, 'al'),            # setbe al
+    ("\x0f\x94\xc0", PRECISE, 'al'),            # sete al
+    ("\x0f\x95\xc0", PRECISE, 'al'),            # setne al
+    ("\x0f\x9f\xc0", PRECISE, 'al'),            # setg al
+    ("\x0f\x9d\xc0", PRECISE, 'al'),            # setge al
+    ("\x0f\x9c\xc0", PRECISE, 'al'),            # setl al
+    ("\x0f\x9e\xc0", PRECISE, 'al'),            # setle al
+    ("\x0f\x90\xc0", PRECISE, 'al'),            # seto al
+    ("\x0f\x91\xc0", PRECISE, 'al'),            # setno al
+    ("\x0f\x9a\xc0", PRECISE, 'al'),            # setp al
+    ("\x0f\x9b\xc0", PRECISE, 'al'),            # setnp al
+    ("\x0f\x98\xc0", PRECISE, 'al'),            # sets al
+    ("\x0f\x99\xc0", PRECISE, 'al'),            # setns al
+    ("\x48\x0f\x47\xc3", OVER),                 # cmova rax, rbx
+    ("\x48\x0f\x43\xc3", OVER),                 # cmovae rax, rbx
+    ("\x48\x0f\x42\xc3", OVER),                 # cmovb rax, rbx
+    ("\x48\x0f\x46\xc3", OVER),                 # cmovbe rax, rbx
+    ("\x48\x0f\x44\xc3", OVER),                 # cmove rax, rbx
+    ("\x48\x0f\x45\xc3", OVER),                 # cmovne rax, rbx
+    ("\x48\x0f\x4f\xc3", OVER),                 # cmovg rax, rbx
+    ("\x48\x0f\x4d\xc3", OVER),                 # cmovge rax, rbx
+    ("\x48\x0f\x4c\xc3", OVER),                 # cmovl rax, rbx
+    ("\x48\x0f\x4e\x01", OVER),                 # cmovle rax, qword ptr [rcx]
+    ("\x48\x0f\x40\xc3", OVER),                 # cmovo rax, rbx
+    ("\x48\x0f\x41\xc3", OVER),                 # cmovno rax, rbx
+    ("\x48\x0f\x4a\xc3", OVER),                 # cmovp rax, rbx
+    ("\x48\x0f\x4b\xc3", OVER),                 # cmovnp rax, rbx
+    ("\x48\x0f\x48\xc3", OVER),                 # cmovs rax, rbx
+    ("\x48\x0f\x49\xc3", OVER),                 # cmovns rax, rbx
+    ("\x70\x00", EXACT),                        # jo +0
+    ("\x71\x00", EXACT),                        # jno +0
+    ("\x72\x00", EXACT),                        # jb +0
+    ("\x73\x00", EXACT),                        # jae +0
+    ("\x74\x00", EXACT),                        # je +0
+    ("\x75\x00", EXACT),                        # jne +0
+    ("\x76\x00", EXACT),                        # jbe +0
+    ("\x77\x00", EXACT),                        # ja +0
+    ("\x78\x00", EXACT),                        # js +0
+    ("\x79\x00", EXACT),                        # jns +0
+    ("\x7a\x00", EXACT),                        # jp +0
+    ("\x7b\x00", EXACT),                        # jnp +0
+    ("\x7c\x00", EXACT),                        # jl +0
+    ("\x7d\x00", EXACT),                        # jge +0
+    ("\x7e\x00", EXACT),                        # jle +0
+    ("\x7f\x00", EXACT),                        # jg +0
+    # Control flow and stack
+    ("\xff\xe3", EXACT),                        # jmp rbx
+    ("\xff\xd3", EXACT),                        # call rbx
+    ("\xc3", EXACT),                            # ret
+    ("\x53", EXACT),                            # push rbx
+    ("\xff\x31", EXACT),                        # push qword ptr [rcx]
+    ("\x58", EXACT),                            # pop rax
+    ("\x48\x8d\x44\x53\x08", EXACT),            # lea rax, [rbx + rdx*2 + 8]
+    ("\x48\x93", EXACT),                        # xchg rax, rbx
+    ("\x48\x87\x19", EXACT),                    # xchg qword ptr [rcx], rbx
+    # No taint effect
+    ("\x90", EXACT),                            # nop
+    ("\xf3\x90", EXACT),                        # pause
+    ("\x0f\xae\xe8", EXACT),                    # lfence
+    ("\x0f\xae\xf0", EXACT),                    # mfence
+    ("\x0f\xae\xf8", EXACT),                    # sfence
+    ("\x0f\x0d\x01", EXACT),                    # prefetch byte ptr [rcx]
+    ("\x0f\x18\x01", EXACT),                    # prefetchnta byte ptr [rcx]
+    ("\x0f\x18\x09", EXACT),                    # prefetcht0 byte ptr [rcx]
+    ("\x0f\x18\x11", EXACT),                    # prefetcht1 byte ptr [rcx]
+    ("\x0f\x18\x19", EXACT),                    # prefetcht2 byte ptr [rcx]
+    ("\x0f\x0d\x09", EXACT),                    # prefetchw byte ptr [rcx]
+]
+
+FLAGS = ['af', 'cf', 'df', 'if', 'of', 'pf', 'sf', 'tf', 'zf']
+
+
+def taint_sources(ctx):
+    for reg in [ctx.registers.rbx, ctx.registers.rdx, ctx.registers.xmm1, ctx.registers.xmm2, ctx.registers.mm1]:
+        ctx.taintRegister(reg)
+    for addr in range(0x1000, 0x1040) + range(0x2000, 0x2008):
+        ctx.taintMemory(addr)
+
+
+def taint_destination(ctx):
+    for reg in [ctx.registers.rax, ctx.registers.xmm0, ctx.registers.mm0]:
+        ctx.taintRegister(reg)
+
+
+def taint_flags(ctx):
+    for reg in [ctx.registers.cf, ctx.registers.pf, ctx.registers.sf, ctx.registers.zf, ctx.registers.of]:
+        ctx.taintRegister(reg)
+
+
+PATTERNS = [taint_sources, taint_destination, taint_flags]
+
+
+class TestTaintSummaries(unittest.TestCase):
+
+    """Testing MODE.TAINT_SUMMARIES against the semantics."""
+
+    def run_opcode(self, opcode, summaries, pattern):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableSymbolicEngine(False)
+        ctx.enableMode(MODE.TAINT_SUMMARIES, summaries)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x1234)
+        ctx.setConcreteRegisterValue(ctx.registers.rbx, 0x11)
+        ctx.setConcreteRegisterValue(ctx.registers.rcx, 0x1000)
+        ctx.setConcreteRegisterValue(ctx.registers.rdx, 3)
+        ctx.setConcreteRegisterValue(ctx.registers.rsp, 0x2000)
+        pattern(ctx)
+
+        inst = Instruction(opcode)
+        self.assertTrue(ctx.processing(inst))
+
+        registers = set(reg.getName() for reg in ctx.getTaintedRegisters())
+        return inst, registers, set(ctx.getTaintedMemory())
+
+    def parent_name(self, name):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        return ctx.getParentRegister(getattr(ctx.registers, name)).getName()
+
+    def test_summaries(self):
+        """Every opcode of the table spreads the taint of its semantics."""
+        for case in CODE:
+            opcode, relation = case[0], case[1]
+            for pattern in PATTERNS:
+                inst, semRegs, semMem = self.run_opcode(opcode, False, pattern)
+                _,    sumRegs, sumMem = self.run_opcode(opcode, True, pattern)
+                msg = "%s (%s)" % (inst.getDisassembly(), pattern.__name__)
+
+                self.assertEqual(sumMem, semMem, msg)
+
+                if relation == EXACT:
+                    self.assertEqual(sumRegs, semRegs, msg)
+
+                elif relation == OVER:
+                    self.assertTrue(sumRegs >= semRegs, msg)
+
+                else:
+                    dst = self.parent_name(case[2])
+                    ignored = set(FLAGS + [dst])
+                    self.assertEqual(sumRegs - ignored, semRegs - ignored, msg)
+                    if relation == IDIOM:
+                        self.assertNotIn(dst, sumRegs, msg)
+                    elif dst in sumRegs:
+                        self.assertIn(dst, semRegs, msg)